@@ -47,6 +47,7 @@ void ezLongOpProxy_BuildNavMesh::GetReplicationInfo(ezStringBuilder& out_sReplic
   rcCfg.m_fDetailMeshSampleErrorFactor = cfg.GetValue("SampleErrorFactor").Get<float>();
   rcCfg.m_fMaxSimplificationError = cfg.GetValue("MaxSimplification").Get<float>();
   rcCfg.m_fMaxEdgeLength = cfg.GetValue("MaxEdgeLength").Get<float>();
+  rcCfg.m_uiTileSize = cfg.GetValue("TileSize").Get<ezUInt32>();
   rcCfg.Serialize(ref_description).IgnoreResult();
 }
 
@@ -4,6 +4,7 @@
 
 #include <Core/Assets/AssetFileHeader.h>
 #include <EditorEngineProcessFramework/EngineProcess/EngineProcessDocumentContext.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/Utilities/Progress.h>
 
@@ -39,7 +40,21 @@ ezResult ezLongOpWorker_BuildNavMesh::Execute(ezProgress& ref_progress, ezStream
   if (!pgRange.BeginNextStep("Building NavMesh"))
     return EZ_FAILURE;
 
-  EZ_SUCCEED_OR_RETURN(NavMeshBuilder.Build(m_NavMeshConfig, m_ExtractedObjects, desc, ref_progress));
+  // tiled navmeshes only rebuild the tiles whose geometry changed since the last build
+  ezRecastNavMeshResourceDescriptor previousDesc;
+  bool bHasPreviousDesc = false;
+
+  if (m_NavMeshConfig.m_uiTileSize > 0)
+  {
+    ezFileReader file;
+    if (file.Open(m_sOutputPath).Succeeded())
+    {
+      ezAssetFileHeader header;
+      bHasPreviousDesc = header.Read(file).Succeeded() && previousDesc.Deserialize(file).Succeeded();
+    }
+  }
+
+  EZ_SUCCEED_OR_RETURN(NavMeshBuilder.Build(m_NavMeshConfig, m_ExtractedObjects, desc, ref_progress, bHasPreviousDesc ? &previousDesc : nullptr));
 
   if (!pgRange.BeginNextStep("Writing Result"))
     return EZ_FAILURE;
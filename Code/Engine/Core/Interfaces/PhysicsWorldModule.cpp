@@ -82,5 +82,71 @@ EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezMsgBuildStaticMesh, 1, ezRTTIDefaultAllocator<
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 // clang-format on
 
+void ezPhysicsWorldModuleInterface::RaycastBatch(ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, ezArrayPtr<const ezPhysicsRaycastQuery> queries, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection /*= ezPhysicsHitCollection::Closest*/) const
+{
+  EZ_ASSERT_DEV(out_results.GetCount() >= queries.GetCount() && out_hits.GetCount() >= queries.GetCount(), "Output arrays are too small");
+
+  for (ezUInt32 i = 0; i < queries.GetCount(); ++i)
+  {
+    const ezPhysicsRaycastQuery& query = queries[i];
+    out_hits[i] = Raycast(out_results[i], query.m_vStart, query.m_vDir, query.m_fDistance, params, collection);
+  }
+}
+
+void ezPhysicsWorldModuleInterface::SweepTestBatch(ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, ezArrayPtr<const ezPhysicsSweepQuery> queries, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection /*= ezPhysicsHitCollection::Closest*/) const
+{
+  EZ_ASSERT_DEV(out_results.GetCount() >= queries.GetCount() && out_hits.GetCount() >= queries.GetCount(), "Output arrays are too small");
+
+  for (ezUInt32 i = 0; i < queries.GetCount(); ++i)
+  {
+    const ezPhysicsSweepQuery& query = queries[i];
+    const ezPhysicsQueryShape& shape = query.m_Shape;
+
+    switch (shape.m_Type)
+    {
+      case ezPhysicsQueryShape::Type::Sphere:
+        out_hits[i] = SweepTestSphere(out_results[i], shape.m_fRadius, shape.m_Transform.m_vPosition, query.m_vDir, query.m_fDistance, params, collection);
+        break;
+
+      case ezPhysicsQueryShape::Type::Box:
+        out_hits[i] = SweepTestBox(out_results[i], shape.m_vBoxExtents, shape.m_Transform, query.m_vDir, query.m_fDistance, params, collection);
+        break;
+
+      case ezPhysicsQueryShape::Type::Capsule:
+        out_hits[i] = SweepTestCapsule(out_results[i], shape.m_fRadius, shape.m_fCapsuleHeight, shape.m_Transform, query.m_vDir, query.m_fDistance, params, collection);
+        break;
+
+        EZ_DEFAULT_CASE_NOT_IMPLEMENTED;
+    }
+  }
+}
+
+void ezPhysicsWorldModuleInterface::OverlapTestBatch(ezArrayPtr<bool> out_overlaps, ezArrayPtr<const ezPhysicsQueryShape> shapes, const ezPhysicsQueryParameters& params) const
+{
+  EZ_ASSERT_DEV(out_overlaps.GetCount() >= shapes.GetCount(), "Output array is too small");
+
+  for (ezUInt32 i = 0; i < shapes.GetCount(); ++i)
+  {
+    const ezPhysicsQueryShape& shape = shapes[i];
+
+    switch (shape.m_Type)
+    {
+      case ezPhysicsQueryShape::Type::Sphere:
+        out_overlaps[i] = OverlapTestSphere(shape.m_fRadius, shape.m_Transform.m_vPosition, params);
+        break;
+
+      case ezPhysicsQueryShape::Type::Box:
+        out_overlaps[i] = OverlapTestBox(shape.m_vBoxExtents, shape.m_Transform, params);
+        break;
+
+      case ezPhysicsQueryShape::Type::Capsule:
+        out_overlaps[i] = OverlapTestCapsule(shape.m_fRadius, shape.m_fCapsuleHeight, shape.m_Transform, params);
+        break;
+
+        EZ_DEFAULT_CASE_NOT_IMPLEMENTED;
+    }
+  }
+}
+
 
 EZ_STATICLINK_FILE(Core, Core_Interfaces_PhysicsWorldModule);
@@ -101,6 +101,41 @@ enum class ezPhysicsHitCollection
   Any
 };
 
+/// \brief A single ray for ezPhysicsWorldModuleInterface::RaycastBatch()
+struct ezPhysicsRaycastQuery
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezVec3 m_vStart;
+  ezVec3 m_vDir; ///< Must be normalized.
+  float m_fDistance;
+};
+
+/// \brief Describes the shape used by ezPhysicsWorldModuleInterface::SweepTestBatch() and OverlapTestBatch()
+struct ezPhysicsQueryShape
+{
+  enum class Type : ezUInt8
+  {
+    Sphere,
+    Box,
+    Capsule,
+  };
+
+  Type m_Type = Type::Sphere;
+  float m_fRadius = 0.0f;                                ///< Sphere and capsule radius.
+  float m_fCapsuleHeight = 0.0f;                         ///< Height of the cylindrical part of a capsule.
+  ezVec3 m_vBoxExtents = ezVec3::MakeZero();             ///< Full size of a box.
+  ezTransform m_Transform = ezTransform::MakeIdentity(); ///< Spheres only use the position.
+};
+
+/// \brief A single shape cast for ezPhysicsWorldModuleInterface::SweepTestBatch()
+struct ezPhysicsSweepQuery
+{
+  ezPhysicsQueryShape m_Shape;
+  ezVec3 m_vDir; ///< Must be normalized.
+  float m_fDistance = 0.0f;
+};
+
 class EZ_CORE_DLL ezPhysicsWorldModuleInterface : public ezWorldModule
 {
   EZ_ADD_DYNAMIC_REFLECTION(ezPhysicsWorldModuleInterface, ezWorldModule);
@@ -124,10 +159,29 @@ public:
 
   virtual bool OverlapTestSphere(float fSphereRadius, const ezVec3& vPosition, const ezPhysicsQueryParameters& params) const = 0;
 
+  virtual bool OverlapTestBox(ezVec3 vBoxExtends, const ezTransform& transform, const ezPhysicsQueryParameters& params) const = 0;
+
   virtual bool OverlapTestCapsule(float fCapsuleRadius, float fCapsuleHeight, const ezTransform& transform, const ezPhysicsQueryParameters& params) const = 0;
 
   virtual void QueryShapesInSphere(ezPhysicsOverlapResultArray& out_results, float fSphereRadius, const ezVec3& vPosition, const ezPhysicsQueryParameters& params) const = 0;
 
+  //////////////////////////////////////////////////////////////////////////
+  // BATCHED QUERIES
+  //
+  // Execute many queries with the same parameters at once. out_hits[i] and out_results[i] receive the result of queries[i],
+  // the output arrays must be at least as large as the query array.
+  // The default implementations simply call the single query functions, physics integrations should override them
+  // to share the query setup across the whole batch and to distribute the work across threads.
+
+  /// \brief Casts all rays in \a queries. out_results[i] is only valid, if out_hits[i] is true.
+  virtual void RaycastBatch(ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, ezArrayPtr<const ezPhysicsRaycastQuery> queries, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection = ezPhysicsHitCollection::Closest) const;
+
+  /// \brief Sweeps all shapes in \a queries. out_results[i] is only valid, if out_hits[i] is true.
+  virtual void SweepTestBatch(ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, ezArrayPtr<const ezPhysicsSweepQuery> queries, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection = ezPhysicsHitCollection::Closest) const;
+
+  /// \brief Tests for every shape in \a shapes, whether it overlaps with anything.
+  virtual void OverlapTestBatch(ezArrayPtr<bool> out_overlaps, ezArrayPtr<const ezPhysicsQueryShape> shapes, const ezPhysicsQueryParameters& params) const;
+
   virtual ezVec3 GetGravity() const = 0;
 
   //////////////////////////////////////////////////////////////////////////
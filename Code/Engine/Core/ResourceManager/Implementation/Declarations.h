@@ -150,3 +150,30 @@ enum class ezResourcePriority
 };
 
 // clang-format on
+
+/// \brief Upper limits for the memory that resources may use. A value of zero means unlimited.
+///
+/// \sa ezResourceManager::SetMemoryBudget(), ezResourceManager::SetResourceTypeMemoryBudget()
+struct ezResourceMemoryBudget
+{
+  ezUInt64 m_uiMaxMemoryCPU = 0;
+  ezUInt64 m_uiMaxMemoryGPU = 0;
+
+  bool IsUnlimited() const { return m_uiMaxMemoryCPU == 0 && m_uiMaxMemoryGPU == 0; }
+};
+
+/// \brief Telemetry about the memory usage of resources in relation to their memory budget.
+///
+/// \sa ezResourceManager::GetMemoryBudgetStats()
+struct ezResourceMemoryBudgetStats
+{
+  ezResourceMemoryBudget m_Budget;
+
+  ezUInt64 m_uiMemoryCPU = 0;          ///< The CPU memory that is currently used.
+  ezUInt64 m_uiMemoryGPU = 0;          ///< The GPU memory that is currently used.
+  ezUInt32 m_uiNumResources = 0;       ///< The number of resources that currently exist.
+  ezUInt64 m_uiNumEvicted = 0;         ///< How many resources were unloaded (or deleted) to stay within the budget, in total.
+  ezUInt64 m_uiNumDowngraded = 0;      ///< How many times a resource had to discard a quality level to stay within the budget, in total.
+  ezUInt64 m_uiNumTimesExceeded = 0;   ///< In how many updates the budget was exceeded.
+  bool m_bOverBudget = false;          ///< Whether the budget was exceeded in the last update. No additional quality levels are loaded while this is set.
+};
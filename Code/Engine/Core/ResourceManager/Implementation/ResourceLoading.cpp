@@ -6,6 +6,10 @@
 
 ezTypelessResourceHandle ezResourceManager::LoadResourceByType(const ezRTTI* pResourceType, ezStringView sResourceID)
 {
+  ezTypelessResourceHandle hResource;
+  if (!sResourceID.IsEmpty() && TryGetRegisteredResource(pResourceType, ezTempHashedString(sResourceID), hResource))
+    return hResource;
+
   // the mutex here is necessary to prevent a race between resource unloading and storing the pointer in the handle
   EZ_LOCK(s_ResourceMutex);
   return ezTypelessResourceHandle(GetResource(pResourceType, sResourceID, true));
@@ -29,6 +33,10 @@ void ezResourceManager::InternalPreloadResource(ezResource* pResource, bool bHig
     return;
   }
 
+  // while a memory budget is exceeded, do not load additional quality levels, they would just get evicted again
+  if (pResource->GetLoadingState() == ezResourceState::Loaded && IsQualityUpgradeBlockedByMemoryBudget(pResource))
+    return;
+
   EZ_ASSERT_DEV(!s_pState->m_bExportMode, "Resources should not be loaded in export mode");
 
   // if we are already loading this resource, early out
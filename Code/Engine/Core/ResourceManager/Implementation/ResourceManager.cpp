@@ -383,6 +383,12 @@ ezResult ezResourceManager::DeallocateResource(ezResource* pResource)
 {
   //EZ_ASSERT_DEBUG(pResource->m_iLockCount == 0, "Resource '{0}' has a refcount of zero, but is still in an acquired state.", pResource->GetResourceID());
 
+  if (s_pState->m_ResourceRegistry.RemoveUnreferenced(pResource).Failed())
+  {
+    // a lock-free lookup acquired a new reference in the meantime
+    return EZ_FAILURE;
+  }
+
   if (RemoveFromLoadingQueue(pResource).Failed())
   {
     // cannot deallocate resources that are currently queued for loading,
@@ -489,6 +495,11 @@ void ezResourceManager::PerFrameUpdate()
   {
     FreeUnusedResources(s_pState->m_AutoFreeUnusedTimeout, s_pState->m_AutoFreeUnusedThreshold);
   }
+
+  if (HasAnyMemoryBudget())
+  {
+    EnforceMemoryBudgets();
+  }
 }
 
 const ezEvent<const ezResourceEvent&, ezMutex>& ezResourceManager::GetResourceEvents()
@@ -676,6 +687,8 @@ ezResource* ezResourceManager::GetResource(const ezRTTI* pRtti, ezStringView sRe
 
   EZ_ASSERT_DEV(s_ResourceMutex.IsLocked(), "Calling code must lock the mutex until the resource pointer is stored in a handle");
 
+  const ezRTTI* pRequestedType = pRtti;
+
   // redirect requested type to override type, if available
   pRtti = FindResourceTypeOverride(pRtti, sResourceID);
 
@@ -685,17 +698,28 @@ ezResource* ezResourceManager::GetResource(const ezRTTI* pRtti, ezStringView sRe
   ezResource* pResource = nullptr;
   ezTempHashedString sHashedResourceID(sResourceID);
 
+  bool bRedirected = false;
+
   ezHashedString* redirection;
   if (s_pState->m_NamedResources.TryGetValue(sHashedResourceID, redirection))
   {
     sHashedResourceID = *redirection;
     sResourceID = redirection->GetView();
+    bRedirected = true;
   }
 
   LoadedResources& lr = s_pState->m_LoadedResources[pRtti];
 
   if (lr.m_Resources.TryGetValue(sHashedResourceID, pResource))
+  {
+    // named lookups always take the slow path, GetExistingResource() does not resolve them
+    if (!bRedirected)
+    {
+      s_pState->m_ResourceRegistry.Insert(pRequestedType, sHashedResourceID.GetHash(), pResource);
+    }
+
     return pResource;
+  }
 
   ezResource* pNewResource = pRtti->GetAllocator()->Allocate<ezResource>();
   pNewResource->m_Priority = s_pState->m_ResourceTypePriorities.GetValueOrDefault(pRtti, ezResourcePriority::Medium);
@@ -704,11 +728,21 @@ ezResource* ezResourceManager::GetResource(const ezRTTI* pRtti, ezStringView sRe
 
   lr.m_Resources.Insert(sHashedResourceID, pNewResource);
 
+  if (!bRedirected)
+  {
+    s_pState->m_ResourceRegistry.Insert(pRequestedType, sHashedResourceID.GetHash(), pNewResource);
+  }
+
   return pNewResource;
 }
 
 void ezResourceManager::RegisterResourceOverrideType(const ezRTTI* pDerivedTypeToUse, ezDelegate<bool(const ezStringBuilder&)> overrideDecider)
 {
+  EZ_LOCK(s_ResourceMutex);
+
+  // lookups may resolve to different resources now
+  s_pState->m_ResourceRegistry.Clear();
+
   const ezRTTI* pParentType = pDerivedTypeToUse->GetParentType();
   while (pParentType != nullptr && pParentType != ezGetStaticRTTI<ezResource>())
   {
@@ -722,6 +756,11 @@ void ezResourceManager::RegisterResourceOverrideType(const ezRTTI* pDerivedTypeT
 
 void ezResourceManager::UnregisterResourceOverrideType(const ezRTTI* pDerivedTypeToUse)
 {
+  EZ_LOCK(s_ResourceMutex);
+
+  // lookups may resolve to different resources now
+  s_pState->m_ResourceRegistry.Clear();
+
   const ezRTTI* pParentType = pDerivedTypeToUse->GetParentType();
   while (pParentType != nullptr && pParentType != ezGetStaticRTTI<ezResource>())
   {
@@ -782,6 +821,10 @@ ezTypelessResourceHandle ezResourceManager::GetExistingResourceByType(const ezRT
 
   const ezTempHashedString sResourceHash(sResourceID);
 
+  ezTypelessResourceHandle hResource;
+  if (TryGetRegisteredResource(pResourceType, sResourceHash, hResource))
+    return hResource;
+
   EZ_LOCK(s_ResourceMutex);
 
   const ezRTTI* pRtti = FindResourceTypeOverride(pResourceType, sResourceID);
@@ -834,6 +877,9 @@ void ezResourceManager::RegisterNamedResource(ezStringView sLookupName, ezString
   redirection.Assign(sRedirectionResource);
 
   s_pState->m_NamedResources[lookup] = redirection;
+
+  // the lookup name may have been used as a regular resource ID before
+  s_pState->m_ResourceRegistry.Clear();
 }
 
 void ezResourceManager::UnregisterNamedResource(ezStringView sLookupName)
@@ -842,6 +888,8 @@ void ezResourceManager::UnregisterNamedResource(ezStringView sLookupName)
 
   ezTempHashedString hash(sLookupName);
   s_pState->m_NamedResources.Remove(hash);
+
+  s_pState->m_ResourceRegistry.Clear();
 }
 
 void ezResourceManager::SetResourceLowResData(const ezTypelessResourceHandle& hResource, ezStreamReader* pStream)
@@ -919,6 +967,11 @@ ezUInt32 ezResourceManager::GetForceNoFallbackAcquisition()
   return s_pState->m_uiForceNoFallbackAcquisition;
 }
 
+bool ezResourceManager::TryGetRegisteredResource(const ezRTTI* pResourceType, const ezTempHashedString& sResourceID, ezTypelessResourceHandle& out_hResource)
+{
+  return s_pState->m_ResourceRegistry.TryGetResource(pResourceType, sResourceID.GetHash(), out_hResource);
+}
+
 ezTime ezResourceManager::GetLastFrameUpdate()
 {
   return s_pState->m_LastFrameUpdate;
@@ -3,6 +3,7 @@
 #include <Core/CoreInternal.h>
 EZ_CORE_INTERNAL_HEADER
 
+#include <Core/ResourceManager/Implementation/ResourceRegistry.h>
 #include <Core/ResourceManager/ResourceManager.h>
 
 class ezResourceManagerState
@@ -55,6 +56,9 @@ private:
 
   ezHashTable<const ezRTTI*, ezResourceManager::LoadedResources> m_LoadedResources;
 
+  // lock-free lookup of existing resources, mirrors m_LoadedResources (for all non-redirected lookups that happened so far)
+  ezResourceRegistry m_ResourceRegistry;
+
   bool m_bAllowLaunchDataLoadTask = true;
   bool m_bShutdown = false;
 
@@ -102,4 +106,9 @@ private:
   ezTime m_AutoFreeUnusedThreshold = ezTime::MakeZero();
 
   ezMap<const ezRTTI*, ezResourceManager::ResourceTypeInfo> m_TypeInfo;
+
+  // Memory budgets
+  ezResourceMemoryBudgetStats m_MemoryBudgetStats;
+  ezTime m_MemoryBudgetUnloadThreshold = ezTime::MakeZero();
+  bool m_bAnyTypeMemoryBudget = false;
 };
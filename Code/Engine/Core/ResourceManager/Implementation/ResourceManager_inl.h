@@ -11,6 +11,10 @@ ResourceType* ezResourceManager::GetResource(ezStringView sResourceID, bool bIsR
 template <typename ResourceType>
 ezTypedResourceHandle<ResourceType> ezResourceManager::LoadResource(ezStringView sResourceID)
 {
+  ezTypedResourceHandle<ResourceType> hResource;
+  if (!sResourceID.IsEmpty() && TryGetRegisteredResource(ezGetStaticRTTI<ResourceType>(), ezTempHashedString(sResourceID), hResource.m_hTypeless))
+    return hResource;
+
   // the mutex here is necessary to prevent a race between resource unloading and storing the pointer in the handle
   EZ_LOCK(s_ResourceMutex);
   return ezTypedResourceHandle<ResourceType>(GetResource<ResourceType>(sResourceID, true));
@@ -20,6 +24,8 @@ template <typename ResourceType>
 ezTypedResourceHandle<ResourceType> ezResourceManager::LoadResource(ezStringView sResourceID, ezTypedResourceHandle<ResourceType> hLoadingFallback)
 {
   ezTypedResourceHandle<ResourceType> hResource;
+
+  if (sResourceID.IsEmpty() || !TryGetRegisteredResource(ezGetStaticRTTI<ResourceType>(), ezTempHashedString(sResourceID), hResource.m_hTypeless))
   {
     // the mutex here is necessary to prevent a race between resource unloading and storing the pointer in the handle
     EZ_LOCK(s_ResourceMutex);
@@ -41,6 +47,10 @@ ezTypedResourceHandle<ResourceType> ezResourceManager::GetExistingResource(ezStr
 
   const ezTempHashedString sResourceHash(sResourceID);
 
+  ezTypedResourceHandle<ResourceType> hResource;
+  if (TryGetRegisteredResource(ezGetStaticRTTI<ResourceType>(), sResourceHash, hResource.m_hTypeless))
+    return hResource;
+
   EZ_LOCK(s_ResourceMutex);
 
   const ezRTTI* pRtti = FindResourceTypeOverride(ezGetStaticRTTI<ResourceType>(), sResourceID);
@@ -0,0 +1,297 @@
+#include <Core/CorePCH.h>
+
+#include <Core/ResourceManager/Implementation/ResourceManagerState.h>
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/Profiling/Profiling.h>
+
+namespace
+{
+  struct EvictionCandidate
+  {
+    ezResource* m_pResource = nullptr;
+    ezResourcePriority m_Priority = ezResourcePriority::Medium;
+    ezTime m_LastAcquire;
+    ezUInt8 m_uiQualityLevelsDiscardable = 0;
+
+    /// \brief Sorts the least valuable resources to the front.
+    EZ_ALWAYS_INLINE bool operator<(const EvictionCandidate& rhs) const
+    {
+      // higher values mean lower priority
+      if (m_Priority != rhs.m_Priority)
+        return m_Priority > rhs.m_Priority;
+
+      if (m_LastAcquire != rhs.m_LastAcquire)
+        return m_LastAcquire < rhs.m_LastAcquire;
+
+      if (m_uiQualityLevelsDiscardable != rhs.m_uiQualityLevelsDiscardable)
+        return m_uiQualityLevelsDiscardable > rhs.m_uiQualityLevelsDiscardable;
+
+      return m_pResource < rhs.m_pResource;
+    }
+  };
+
+  bool IsOverBudget(const ezResourceMemoryBudgetStats& stats)
+  {
+    return (stats.m_Budget.m_uiMaxMemoryCPU > 0 && stats.m_uiMemoryCPU > stats.m_Budget.m_uiMaxMemoryCPU) ||
+           (stats.m_Budget.m_uiMaxMemoryGPU > 0 && stats.m_uiMemoryGPU > stats.m_Budget.m_uiMaxMemoryGPU);
+  }
+
+  /// \brief Whether evicting a resource with the given memory usage would actually help with the exceeded budget.
+  bool ShouldEvict(const ezResourceMemoryBudgetStats& stats, const ezResource::MemoryUsage& usage)
+  {
+    return (stats.m_Budget.m_uiMaxMemoryCPU > 0 && stats.m_uiMemoryCPU > stats.m_Budget.m_uiMaxMemoryCPU && usage.m_uiMemoryCPU > 0) ||
+           (stats.m_Budget.m_uiMaxMemoryGPU > 0 && stats.m_uiMemoryGPU > stats.m_Budget.m_uiMaxMemoryGPU && usage.m_uiMemoryGPU > 0);
+  }
+
+  void ResetUsage(ezResourceMemoryBudgetStats& ref_stats)
+  {
+    ref_stats.m_uiMemoryCPU = 0;
+    ref_stats.m_uiMemoryGPU = 0;
+    ref_stats.m_uiNumResources = 0;
+  }
+
+  void AddUsage(ezResourceMemoryBudgetStats& ref_stats, const ezResource::MemoryUsage& usage)
+  {
+    ref_stats.m_uiMemoryCPU += usage.m_uiMemoryCPU;
+    ref_stats.m_uiMemoryGPU += usage.m_uiMemoryGPU;
+  }
+
+  void SubtractUsage(ezResourceMemoryBudgetStats& ref_stats, const ezResource::MemoryUsage& before, const ezResource::MemoryUsage& after)
+  {
+    ref_stats.m_uiMemoryCPU -= ezMath::Min(ref_stats.m_uiMemoryCPU, before.m_uiMemoryCPU - ezMath::Min(before.m_uiMemoryCPU, after.m_uiMemoryCPU));
+    ref_stats.m_uiMemoryGPU -= ezMath::Min(ref_stats.m_uiMemoryGPU, before.m_uiMemoryGPU - ezMath::Min(before.m_uiMemoryGPU, after.m_uiMemoryGPU));
+  }
+} // namespace
+
+void ezResourceManager::SetMemoryBudget(const ezResourceMemoryBudget& budget)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  s_pState->m_MemoryBudgetStats.m_Budget = budget;
+  s_pState->m_MemoryBudgetStats.m_bOverBudget = false;
+}
+
+ezResourceMemoryBudget ezResourceManager::GetMemoryBudget()
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  return s_pState->m_MemoryBudgetStats.m_Budget;
+}
+
+void ezResourceManager::SetResourceTypeMemoryBudget(const ezRTTI* pResourceType, const ezResourceMemoryBudget& budget)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  ResourceTypeInfo& info = GetResourceTypeInfo(pResourceType);
+  info.m_MemoryBudgetStats.m_Budget = budget;
+  info.m_MemoryBudgetStats.m_bOverBudget = false;
+
+  s_pState->m_bAnyTypeMemoryBudget = false;
+  for (auto it : s_pState->m_TypeInfo)
+  {
+    if (!it.Value().m_MemoryBudgetStats.m_Budget.IsUnlimited())
+    {
+      s_pState->m_bAnyTypeMemoryBudget = true;
+      break;
+    }
+  }
+}
+
+ezResourceMemoryBudget ezResourceManager::GetResourceTypeMemoryBudget(const ezRTTI* pResourceType)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  return GetResourceTypeInfo(pResourceType).m_MemoryBudgetStats.m_Budget;
+}
+
+void ezResourceManager::SetMemoryBudgetUnloadThreshold(ezTime lastAcquireThreshold)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  s_pState->m_MemoryBudgetUnloadThreshold = lastAcquireThreshold;
+}
+
+bool ezResourceManager::HasAnyMemoryBudget()
+{
+  return s_pState->m_bAnyTypeMemoryBudget || !s_pState->m_MemoryBudgetStats.m_Budget.IsUnlimited();
+}
+
+ezUInt32 ezResourceManager::EnforceMemoryBudgets()
+{
+  EZ_ASSERT_DEV(ezThreadUtils::IsMainThread(), "Memory budgets must be enforced on the main thread, since resources may get unloaded.");
+
+  EZ_LOCK(s_ResourceMutex);
+  EZ_PROFILE_SCOPE("EnforceMemoryBudgets");
+
+  ezResourceMemoryBudgetStats& globalStats = s_pState->m_MemoryBudgetStats;
+  ResetUsage(globalStats);
+
+  // measure the current memory usage, it is not tracked incrementally, because resources may modify their memory usage at any time
+  bool bAnyTypeOverBudget = false;
+  for (auto itType = s_pState->m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+  {
+    ezResourceMemoryBudgetStats& typeStats = GetResourceTypeInfo(itType.Key()).m_MemoryBudgetStats;
+    ResetUsage(typeStats);
+
+    for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+    {
+      const ezResource::MemoryUsage& usage = it.Value()->GetMemoryUsage();
+      AddUsage(typeStats, usage);
+      AddUsage(globalStats, usage);
+    }
+
+    typeStats.m_uiNumResources = itType.Value().m_Resources.GetCount();
+    globalStats.m_uiNumResources += typeStats.m_uiNumResources;
+
+    typeStats.m_bOverBudget = IsOverBudget(typeStats);
+    if (typeStats.m_bOverBudget)
+    {
+      ++typeStats.m_uiNumTimesExceeded;
+      bAnyTypeOverBudget = true;
+    }
+  }
+
+  globalStats.m_bOverBudget = IsOverBudget(globalStats);
+  if (globalStats.m_bOverBudget)
+  {
+    ++globalStats.m_uiNumTimesExceeded;
+  }
+
+  if (!globalStats.m_bOverBudget && !bAnyTypeOverBudget)
+    return 0;
+
+  // gather everything that could be evicted to meet the exceeded budgets
+  ezDynamicArray<EvictionCandidate> candidates;
+  for (auto itType = s_pState->m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+  {
+    if (!globalStats.m_bOverBudget && !GetResourceTypeInfo(itType.Key()).m_MemoryBudgetStats.m_bOverBudget)
+      continue;
+
+    for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+    {
+      ezResource* pResource = it.Value();
+
+      if (pResource->GetPriority() == ezResourcePriority::Critical || IsQueuedForLoading(pResource))
+        continue;
+
+      const ezResource::MemoryUsage& usage = pResource->GetMemoryUsage();
+      if (usage.m_uiMemoryCPU == 0 && usage.m_uiMemoryGPU == 0)
+        continue;
+
+      EvictionCandidate& candidate = candidates.ExpandAndGetRef();
+      candidate.m_pResource = pResource;
+      candidate.m_Priority = pResource->GetPriority();
+      candidate.m_LastAcquire = pResource->GetLastAcquireTime();
+      candidate.m_uiQualityLevelsDiscardable = pResource->GetNumQualityLevelsDiscardable();
+    }
+  }
+
+  candidates.Sort();
+
+  const ezTime tNow = ezTime::Now();
+  const ezTime unloadThreshold = s_pState->m_MemoryBudgetUnloadThreshold;
+
+  ezUInt32 uiNumEvicted = 0;
+
+  for (const EvictionCandidate& candidate : candidates)
+  {
+    ezResource* pResource = candidate.m_pResource;
+    const ezRTTI* pType = pResource->GetDynamicRTTI();
+    ezResourceMemoryBudgetStats& typeStats = GetResourceTypeInfo(pType).m_MemoryBudgetStats;
+
+    const ezResource::MemoryUsage usageBefore = pResource->GetMemoryUsage();
+
+    if (!ShouldEvict(typeStats, usageBefore) && !ShouldEvict(globalStats, usageBefore))
+      continue;
+
+    if (pResource->GetReferenceCount() == 0)
+    {
+      const ezTempHashedString sResourceID(pResource->GetResourceID());
+
+      if (DeallocateResource(pResource).Failed())
+        continue;
+
+      s_pState->m_LoadedResources[pType].m_Resources.Remove(sResourceID);
+
+      const ezResource::MemoryUsage usageAfter;
+      SubtractUsage(typeStats, usageBefore, usageAfter);
+      SubtractUsage(globalStats, usageBefore, usageAfter);
+      --typeStats.m_uiNumResources;
+      --globalStats.m_uiNumResources;
+
+      ++typeStats.m_uiNumEvicted;
+      ++globalStats.m_uiNumEvicted;
+    }
+    else if (pResource->GetNumQualityLevelsDiscardable() > 0)
+    {
+      pResource->CallUnloadData(ezResource::Unload::OneQualityLevel);
+      pResource->UpdateMemoryUsage(pResource->m_MemoryUsage);
+
+      SubtractUsage(typeStats, usageBefore, pResource->GetMemoryUsage());
+      SubtractUsage(globalStats, usageBefore, pResource->GetMemoryUsage());
+
+      ++typeStats.m_uiNumDowngraded;
+      ++globalStats.m_uiNumDowngraded;
+    }
+    else if (unloadThreshold.IsPositive() && pResource->GetLoadingState() == ezResourceState::Loaded && tNow - pResource->GetLastAcquireTime() > unloadThreshold)
+    {
+      pResource->CallUnloadData(ezResource::Unload::AllQualityLevels);
+      pResource->UpdateMemoryUsage(pResource->m_MemoryUsage);
+
+      SubtractUsage(typeStats, usageBefore, pResource->GetMemoryUsage());
+      SubtractUsage(globalStats, usageBefore, pResource->GetMemoryUsage());
+
+      ++typeStats.m_uiNumEvicted;
+      ++globalStats.m_uiNumEvicted;
+    }
+    else
+    {
+      continue;
+    }
+
+    ++uiNumEvicted;
+  }
+
+  return uiNumEvicted;
+}
+
+ezResourceMemoryBudgetStats ezResourceManager::GetMemoryBudgetStats(const ezRTTI* pResourceType /*= nullptr*/)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  ezResourceMemoryBudgetStats stats = pResourceType != nullptr ? GetResourceTypeInfo(pResourceType).m_MemoryBudgetStats : s_pState->m_MemoryBudgetStats;
+  ResetUsage(stats);
+
+  // always report the current usage, not the one from the last update
+  for (auto itType = s_pState->m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+  {
+    if (pResourceType != nullptr && itType.Key() != pResourceType)
+      continue;
+
+    for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+    {
+      AddUsage(stats, it.Value()->GetMemoryUsage());
+    }
+
+    stats.m_uiNumResources += itType.Value().m_Resources.GetCount();
+  }
+
+  return stats;
+}
+
+bool ezResourceManager::IsQualityUpgradeBlockedByMemoryBudget(const ezResource* pResource)
+{
+  EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "");
+
+  if (!HasAnyMemoryBudget())
+    return false;
+
+  if (s_pState->m_MemoryBudgetStats.m_bOverBudget)
+    return true;
+
+  auto it = s_pState->m_TypeInfo.Find(pResource->GetDynamicRTTI());
+  return it.IsValid() && it.Value().m_MemoryBudgetStats.m_bOverBudget;
+}
+
+
+EZ_STATICLINK_FILE(Core, Core_ResourceManager_Implementation_ResourceMemoryBudget);
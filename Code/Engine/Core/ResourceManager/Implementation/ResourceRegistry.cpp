@@ -0,0 +1,295 @@
+#include <Core/CorePCH.h>
+
+#include <Core/ResourceManager/Implementation/ResourceRegistry.h>
+#include <Core/ResourceManager/Resource.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+namespace
+{
+  /// \brief Protects a lookup against concurrent writers of the same shard. See ezResourceRegistry::WaitForReaders().
+  template <typename Shard>
+  class ReadScope
+  {
+  public:
+    EZ_ALWAYS_INLINE explicit ReadScope(Shard& ref_shard)
+      : m_Shard(ref_shard)
+    {
+      while (true)
+      {
+        const ezUInt32 uiEpoch = m_Shard.m_uiEpoch.load();
+        m_uiCounter = uiEpoch & 1;
+        m_Shard.m_iNumReaders[m_uiCounter].fetch_add(1);
+
+        // if a writer switched the counters in between, it may not wait for us, so register again with the new counter
+        if (m_Shard.m_uiEpoch.load() == uiEpoch)
+          break;
+
+        m_Shard.m_iNumReaders[m_uiCounter].fetch_sub(1);
+      }
+    }
+
+    EZ_ALWAYS_INLINE ~ReadScope() { m_Shard.m_iNumReaders[m_uiCounter].fetch_sub(1); }
+
+  private:
+    Shard& m_Shard;
+    ezUInt32 m_uiCounter = 0;
+  };
+} // namespace
+
+ezResourceRegistry::Entry ezResourceRegistry::s_Tombstone;
+
+ezResourceRegistry::ezResourceRegistry() = default;
+
+ezResourceRegistry::~ezResourceRegistry()
+{
+  for (Shard& shard : m_Shards)
+  {
+    FreeTable(shard.m_pTable.exchange(nullptr), true);
+  }
+}
+
+bool ezResourceRegistry::TryGetResource(const ezRTTI* pRequestedType, ezUInt64 uiResourceIDHash, ezTypelessResourceHandle& out_hResource) const
+{
+  Shard& shard = const_cast<Shard&>(m_Shards[GetShardIndex(uiResourceIDHash)]);
+
+  ReadScope<Shard> scope(shard);
+
+  const Table* pTable = shard.m_pTable.load();
+  if (pTable == nullptr)
+    return false;
+
+  const ezUInt32 uiMask = pTable->m_uiCapacity - 1;
+  ezUInt32 uiSlot = static_cast<ezUInt32>(GetSlotHash(pRequestedType, uiResourceIDHash)) & uiMask;
+
+  for (ezUInt32 i = 0; i < pTable->m_uiCapacity; ++i, uiSlot = (uiSlot + 1) & uiMask)
+  {
+    const Entry* pEntry = pTable->m_pSlots[uiSlot].load();
+
+    if (pEntry == nullptr)
+      return false;
+
+    if (pEntry != &s_Tombstone && pEntry->m_uiResourceIDHash == uiResourceIDHash && pEntry->m_pType == pRequestedType)
+    {
+      // increases the refcount while we are still protected by the read scope
+      out_hResource = ezTypelessResourceHandle(pEntry->m_pResource);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ezResourceRegistry::Insert(const ezRTTI* pRequestedType, ezUInt64 uiResourceIDHash, ezResource* pResource)
+{
+  Shard& shard = m_Shards[GetShardIndex(uiResourceIDHash)];
+  EZ_LOCK(shard.m_WriteMutex);
+
+  Table* pTable = shard.m_pTable.load();
+
+  if (pTable != nullptr)
+  {
+    const ezUInt32 uiMask = pTable->m_uiCapacity - 1;
+    ezUInt32 uiSlot = static_cast<ezUInt32>(GetSlotHash(pRequestedType, uiResourceIDHash)) & uiMask;
+
+    for (ezUInt32 i = 0; i < pTable->m_uiCapacity; ++i, uiSlot = (uiSlot + 1) & uiMask)
+    {
+      const Entry* pEntry = pTable->m_pSlots[uiSlot].load();
+
+      if (pEntry == nullptr)
+        break;
+
+      if (pEntry != &s_Tombstone && pEntry->m_uiResourceIDHash == uiResourceIDHash && pEntry->m_pType == pRequestedType)
+      {
+        EZ_ASSERT_DEV(pEntry->m_pResource == pResource, "Resource ID hash collision or stale registry entry.");
+        return;
+      }
+    }
+  }
+
+  // keep the load factor below 3/4, tombstones included
+  if (pTable == nullptr || (pTable->m_uiNumUsedSlots + 1) * 4 > pTable->m_uiCapacity * 3)
+  {
+    const ezUInt32 uiNumEntries = pTable != nullptr ? pTable->m_uiNumEntries : 0;
+    Table* pNewTable = AllocateTable(ezMath::Max(16u, ezMath::PowerOfTwo_Ceil((uiNumEntries + 1) * 2)));
+
+    if (pTable != nullptr)
+    {
+      for (ezUInt32 i = 0; i < pTable->m_uiCapacity; ++i)
+      {
+        Entry* pEntry = pTable->m_pSlots[i].load();
+        if (pEntry != nullptr && pEntry != &s_Tombstone)
+        {
+          InsertEntry(pNewTable, pEntry);
+        }
+      }
+    }
+
+    shard.m_pTable.store(pNewTable);
+
+    if (pTable != nullptr)
+    {
+      // the entries are still used by the new table
+      WaitForReaders(shard);
+      FreeTable(pTable, false);
+    }
+
+    pTable = pNewTable;
+  }
+
+  Entry* pEntry = EZ_DEFAULT_NEW(Entry);
+  pEntry->m_pType = pRequestedType;
+  pEntry->m_uiResourceIDHash = uiResourceIDHash;
+  pEntry->m_pResource = pResource;
+
+  InsertEntry(pTable, pEntry);
+}
+
+ezResult ezResourceRegistry::RemoveUnreferenced(ezResource* pResource)
+{
+  const ezUInt64 uiResourceIDHash = pResource->GetResourceIDHash();
+
+  Shard& shard = m_Shards[GetShardIndex(uiResourceIDHash)];
+  EZ_LOCK(shard.m_WriteMutex);
+
+  Table* pTable = shard.m_pTable.load();
+  if (pTable == nullptr)
+    return EZ_SUCCESS;
+
+  ezHybridArray<Entry*, 4> removedEntries;
+
+  // the resource may have been registered for its own type and for any of its base types
+  const ezRTTI* pResourceBaseType = ezGetStaticRTTI<ezResource>();
+  for (const ezRTTI* pType = pResource->GetDynamicRTTI(); pType != nullptr; pType = pType->GetParentType())
+  {
+    const ezUInt32 uiMask = pTable->m_uiCapacity - 1;
+    ezUInt32 uiSlot = static_cast<ezUInt32>(GetSlotHash(pType, uiResourceIDHash)) & uiMask;
+
+    for (ezUInt32 i = 0; i < pTable->m_uiCapacity; ++i, uiSlot = (uiSlot + 1) & uiMask)
+    {
+      Entry* pEntry = pTable->m_pSlots[uiSlot].load();
+
+      if (pEntry == nullptr)
+        break;
+
+      if (pEntry != &s_Tombstone && pEntry->m_pResource == pResource && pEntry->m_pType == pType)
+      {
+        pTable->m_pSlots[uiSlot].store(&s_Tombstone);
+        --pTable->m_uiNumEntries;
+        removedEntries.PushBack(pEntry);
+        break;
+      }
+    }
+
+    if (pType == pResourceBaseType)
+      break;
+  }
+
+  if (removedEntries.IsEmpty())
+    return EZ_SUCCESS;
+
+  WaitForReaders(shard);
+
+  for (Entry* pEntry : removedEntries)
+  {
+    EZ_DEFAULT_DELETE(pEntry);
+  }
+
+  // a lookup that found the resource before it was removed may have acquired a new reference
+  return pResource->GetReferenceCount() == 0 ? EZ_SUCCESS : EZ_FAILURE;
+}
+
+void ezResourceRegistry::Clear()
+{
+  for (Shard& shard : m_Shards)
+  {
+    EZ_LOCK(shard.m_WriteMutex);
+
+    Table* pTable = shard.m_pTable.exchange(nullptr);
+    if (pTable == nullptr)
+      continue;
+
+    WaitForReaders(shard);
+    FreeTable(pTable, true);
+  }
+}
+
+ezUInt64 ezResourceRegistry::GetSlotHash(const ezRTTI* pType, ezUInt64 uiResourceIDHash)
+{
+  // the lower bits of the ID hash are already used to select the shard
+  return (uiResourceIDHash >> 6) ^ ezHashingUtils::StringHashTo32(reinterpret_cast<size_t>(pType) * 0x9E3779B97F4A7C15ull);
+}
+
+ezResourceRegistry::Table* ezResourceRegistry::AllocateTable(ezUInt32 uiCapacity)
+{
+  Table* pTable = EZ_DEFAULT_NEW(Table);
+  pTable->m_uiCapacity = uiCapacity;
+  pTable->m_pSlots = EZ_DEFAULT_NEW_RAW_BUFFER(std::atomic<Entry*>, uiCapacity);
+
+  for (ezUInt32 i = 0; i < uiCapacity; ++i)
+  {
+    new (&pTable->m_pSlots[i]) std::atomic<Entry*>(nullptr);
+  }
+
+  return pTable;
+}
+
+void ezResourceRegistry::FreeTable(Table* pTable, bool bFreeEntries)
+{
+  if (pTable == nullptr)
+    return;
+
+  if (bFreeEntries)
+  {
+    for (ezUInt32 i = 0; i < pTable->m_uiCapacity; ++i)
+    {
+      Entry* pEntry = pTable->m_pSlots[i].load();
+      if (pEntry != nullptr && pEntry != &s_Tombstone)
+      {
+        EZ_DEFAULT_DELETE(pEntry);
+      }
+    }
+  }
+
+  EZ_DEFAULT_DELETE_RAW_BUFFER(pTable->m_pSlots);
+  EZ_DEFAULT_DELETE(pTable);
+}
+
+void ezResourceRegistry::InsertEntry(Table* pTable, Entry* pEntry)
+{
+  const ezUInt32 uiMask = pTable->m_uiCapacity - 1;
+  ezUInt32 uiSlot = static_cast<ezUInt32>(GetSlotHash(pEntry->m_pType, pEntry->m_uiResourceIDHash)) & uiMask;
+
+  while (true)
+  {
+    Entry* pExisting = pTable->m_pSlots[uiSlot].load();
+
+    if (pExisting == nullptr || pExisting == &s_Tombstone)
+    {
+      if (pExisting == nullptr)
+      {
+        ++pTable->m_uiNumUsedSlots;
+      }
+
+      ++pTable->m_uiNumEntries;
+      pTable->m_pSlots[uiSlot].store(pEntry);
+      return;
+    }
+
+    uiSlot = (uiSlot + 1) & uiMask;
+  }
+}
+
+void ezResourceRegistry::WaitForReaders(Shard& ref_shard)
+{
+  // All readers that started before this point are counted in the current counter.
+  // Switch all new readers to the other counter and wait until the current one drains.
+  const ezUInt32 uiCounter = ref_shard.m_uiEpoch.fetch_add(1) & 1;
+
+  while (ref_shard.m_iNumReaders[uiCounter].load() != 0)
+  {
+    ezThreadUtils::YieldTimeSlice();
+  }
+}
+
+EZ_STATICLINK_FILE(Core, Core_ResourceManager_Implementation_ResourceRegistry);
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Core/CoreInternal.h>
+EZ_CORE_INTERNAL_HEADER
+
+#include <Core/ResourceManager/ResourceHandle.h>
+#include <Foundation/Threading/Mutex.h>
+
+#include <atomic>
+
+/// \brief Maps a resource type and a resource ID hash to the resource, such that existing resources can be looked up without locking the
+/// ezResourceManager.
+///
+/// This is only a cache in front of the resource manager's own bookkeeping. Lookups that miss go through the regular (locked) code path,
+/// which then inserts the result into the registry.
+///
+/// Lookups are lock-free. The entries are distributed across shards by their ID hash and every shard has its own mutex, which is only
+/// taken by writers. To make sure that no lookup can still hand out a pointer to a resource that is being deallocated, writers wait for all
+/// lookups in the same shard that might still see the old state (using two alternating reader counters per shard), before memory is freed.
+class ezResourceRegistry
+{
+public:
+  ezResourceRegistry();
+  ~ezResourceRegistry();
+
+  /// \brief Looks up the resource and stores it in out_hResource, if it exists.
+  ///
+  /// The reference count of the resource is increased before the lookup finishes, so the resource can't get deallocated in between.
+  bool TryGetResource(const ezRTTI* pRequestedType, ezUInt64 uiResourceIDHash, ezTypelessResourceHandle& out_hResource) const;
+
+  /// \brief Registers that requesting pRequestedType with the given ID hash yields pResource.
+  ///
+  /// pRequestedType must be the type of pResource or one of its base types.
+  void Insert(const ezRTTI* pRequestedType, ezUInt64 uiResourceIDHash, ezResource* pResource);
+
+  /// \brief Removes all entries that reference pResource, so that it can be deallocated.
+  ///
+  /// Fails, if a concurrent lookup has acquired a new reference to the resource in the meantime. The resource must not be deallocated
+  /// then. All entries stay removed in this case, the next lookup simply has to take the slow path.
+  ezResult RemoveUnreferenced(ezResource* pResource);
+
+  /// \brief Removes all entries, e.g. because the mapping from resource IDs to resources changed.
+  void Clear();
+
+private:
+  struct Entry
+  {
+    const ezRTTI* m_pType = nullptr;
+    ezUInt64 m_uiResourceIDHash = 0;
+    ezResource* m_pResource = nullptr;
+  };
+
+  struct Table
+  {
+    ezUInt32 m_uiCapacity = 0;
+    ezUInt32 m_uiNumUsedSlots = 0; // live entries and tombstones
+    ezUInt32 m_uiNumEntries = 0;
+    std::atomic<Entry*>* m_pSlots = nullptr;
+  };
+
+  struct alignas(64) Shard
+  {
+    ezMutex m_WriteMutex;
+    std::atomic<Table*> m_pTable = nullptr;
+
+    std::atomic<ezUInt32> m_uiEpoch = 0;
+    std::atomic<ezInt32> m_iNumReaders[2] = {};
+  };
+
+  static constexpr ezUInt32 s_uiNumShards = 64;
+
+  /// Marks slots whose entry was removed. Lookups have to continue probing past them.
+  static Entry s_Tombstone;
+
+  static ezUInt32 GetShardIndex(ezUInt64 uiResourceIDHash) { return static_cast<ezUInt32>(uiResourceIDHash) % s_uiNumShards; }
+  static ezUInt64 GetSlotHash(const ezRTTI* pType, ezUInt64 uiResourceIDHash);
+
+  static Table* AllocateTable(ezUInt32 uiCapacity);
+  static void FreeTable(Table* pTable, bool bFreeEntries);
+
+  static void InsertEntry(Table* pTable, Entry* pEntry);
+
+  /// \brief Blocks until all lookups in the shard that might have seen the state before the last modification have finished.
+  static void WaitForReaders(Shard& ref_shard);
+
+  Shard m_Shards[s_uiNumShards];
+};
@@ -239,6 +239,66 @@ public:
 private:
   static ezResult DeallocateResource(ezResource* pResource);
 
+  ///@}
+  /// \name Memory budgets
+  ///@{
+
+public:
+  /// \brief Sets the maximum amount of memory that all resources together may use.
+  ///
+  /// Once per frame (see PerFrameUpdate()) the resource manager checks all budgets. If a budget is exceeded, the least valuable resources
+  /// are evicted until the memory usage is back within the budget. Resources are ranked by their ezResourcePriority first,
+  /// then by how long ago they were acquired last and finally by how many quality levels they could discard.
+  /// Resources with priority 'Critical' are never evicted.
+  ///
+  /// Evicting a resource means:
+  ///  * Resources that are not referenced anymore get deleted.
+  ///  * Referenced resources that have quality levels to discard, unload one quality level (per update).
+  ///  * Referenced resources that have not been acquired for at least the 'unload threshold' are unloaded completely.
+  ///    They get loaded again, once they are acquired the next time.
+  ///
+  /// While a budget is exceeded, resources in that budget will not load any additional quality levels.
+  static void SetMemoryBudget(const ezResourceMemoryBudget& budget);
+
+  /// \brief Returns the budget that was set with SetMemoryBudget().
+  static ezResourceMemoryBudget GetMemoryBudget();
+
+  /// \brief Sets the maximum amount of memory that all resources of the given type may use.
+  ///
+  /// \note This is bound to one specific type. Derived types do not inherit the budget.
+  /// \sa SetMemoryBudget()
+  static void SetResourceTypeMemoryBudget(const ezRTTI* pResourceType, const ezResourceMemoryBudget& budget);
+
+  /// \sa SetResourceTypeMemoryBudget()
+  template <typename ResourceType>
+  static void SetResourceTypeMemoryBudget(const ezResourceMemoryBudget& budget)
+  {
+    SetResourceTypeMemoryBudget(ezGetStaticRTTI<ResourceType>(), budget);
+  }
+
+  /// \brief Returns the budget that was set with SetResourceTypeMemoryBudget().
+  static ezResourceMemoryBudget GetResourceTypeMemoryBudget(const ezRTTI* pResourceType);
+
+  /// \brief Referenced resources are only fully unloaded to meet a budget, if they have not been acquired for at least this long.
+  ///
+  /// Zero disables fully unloading referenced resources. Unreferenced resources are always deleted, if necessary, and quality levels
+  /// are always discarded, if necessary.
+  static void SetMemoryBudgetUnloadThreshold(ezTime lastAcquireThreshold);
+
+  /// \brief Checks all budgets and evicts resources until the memory usage is within the budgets again.
+  ///
+  /// This is called automatically by PerFrameUpdate(), if any budget is set.
+  /// Must be called on the main thread. Returns the number of resources that were deleted, unloaded or downgraded.
+  static ezUInt32 EnforceMemoryBudgets();
+
+  /// \brief Returns the current memory usage and eviction statistics for the given resource type, or for all resources, if nullptr is
+  /// passed in.
+  static ezResourceMemoryBudgetStats GetMemoryBudgetStats(const ezRTTI* pResourceType = nullptr);
+
+private:
+  static bool HasAnyMemoryBudget();
+  static bool IsQualityUpgradeBlockedByMemoryBudget(const ezResource* pResource);
+
   ///@}
   /// \name Miscellaneous
   ///@{
@@ -479,6 +539,10 @@ private:
   static ezHashTable<const ezRTTI*, LoadedResources>& GetLoadedResources();
   static ezDynamicArray<ezResource*>& GetLoadedResourceOfTypeTempContainer();
 
+  /// \brief Looks up an existing resource without locking the resource manager. Only finds resources that were looked up through the
+  /// regular (locked) code path before.
+  static bool TryGetRegisteredResource(const ezRTTI* pResourceType, const ezTempHashedString& sResourceID, ezTypelessResourceHandle& out_hResource);
+
   EZ_ALWAYS_INLINE static bool IsQueuedForLoading(ezResource* pResource) { return pResource->m_Flags.IsSet(ezResourceFlags::IsQueuedForLoading); }
   [[nodiscard]] static ezResult RemoveFromLoadingQueue(ezResource* pResource);
   static void AddToLoadingQueue(ezResource* pResource, bool bHighPriority);
@@ -488,6 +552,8 @@ private:
     bool m_bIncrementalUnload = true;
     bool m_bAllowNestedAcquireCached = false;
 
+    ezResourceMemoryBudgetStats m_MemoryBudgetStats;
+
     ezHybridArray<const ezRTTI*, 8> m_NestedTypes;
   };
 
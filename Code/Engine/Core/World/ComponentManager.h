@@ -71,12 +71,14 @@ protected:
   friend class ezWorldReader;
 
   ezComponentHandle CreateComponentNoInit(ezGameObject* pOwnerObject, ezComponent*& out_pComponent);
+  void ReserveComponents(ezUInt32 uiNumAdditionalComponents);
   void InitializeComponent(ezComponent* pComponent);
   void DeinitializeComponent(ezComponent* pComponent);
   void PatchIdTable(ezComponent* pComponent);
 
   virtual ezComponent* CreateComponentStorage() = 0;
   virtual void DeleteComponentStorage(ezComponent* pComponent, ezComponent*& out_pMovedComponent) = 0;
+  virtual void ReserveComponentStorage(ezUInt32 uiNumComponents) {}
 
   /// \endcond
 
@@ -118,6 +120,7 @@ protected:
 
   virtual ezComponent* CreateComponentStorage() override;
   virtual void DeleteComponentStorage(ezComponent* pComponent, ezComponent*& out_pMovedComponent) override;
+  virtual void ReserveComponentStorage(ezUInt32 uiNumComponents) override;
 
   void RegisterUpdateFunction(UpdateFunctionDesc& desc);
 
@@ -597,6 +597,10 @@ private:
     void UpdateGlobalBounds();
     void UpdateGlobalBoundsAndSpatialData(ezSpatialSystem& ref_spatialSystem);
 
+    /// \brief Updates the global bounds and returns true, if the bounds in the spatial system need to be updated as well.
+    /// Does not touch the spatial system, which allows to call this from multiple threads and apply the changes later.
+    bool UpdateGlobalBoundsAndCheckSpatialData();
+
     void UpdateLastGlobalTransform(ezUInt32 uiUpdateCounter);
 
     void RecreateSpatialData(ezSpatialSystem& ref_spatialSystem);
@@ -90,6 +90,13 @@ ezComponentHandle ezComponentManagerBase::CreateComponentNoInit(ezGameObject* pO
   return pComponent->GetHandle();
 }
 
+void ezComponentManagerBase::ReserveComponents(ezUInt32 uiNumAdditionalComponents)
+{
+  const ezUInt32 uiNumComponents = m_Components.GetCount() + uiNumAdditionalComponents;
+  m_Components.Reserve(uiNumComponents);
+  ReserveComponentStorage(uiNumComponents);
+}
+
 void ezComponentManagerBase::InitializeComponent(ezComponent* pComponent)
 {
   GetWorld()->AddComponentToInitialize(pComponent->GetHandle());
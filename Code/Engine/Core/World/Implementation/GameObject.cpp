@@ -1132,16 +1132,21 @@ void ezGameObject::TransformationData::UpdateGlobalBounds(ezSpatialSystem* pSpat
 }
 
 void ezGameObject::TransformationData::UpdateGlobalBoundsAndSpatialData(ezSpatialSystem& ref_spatialSystem)
+{
+  if (UpdateGlobalBoundsAndCheckSpatialData())
+  {
+    ref_spatialSystem.UpdateSpatialDataBounds(m_hSpatialData, m_globalBounds);
+  }
+}
+
+bool ezGameObject::TransformationData::UpdateGlobalBoundsAndCheckSpatialData()
 {
   ezSimdBBoxSphere oldGlobalBounds = m_globalBounds;
 
   UpdateGlobalBounds();
 
   const bool bIsAlwaysVisible = m_localBounds.m_BoxHalfExtents.w() != ezSimdFloat::MakeZero();
-  if (m_hSpatialData.IsInvalidated() == false && bIsAlwaysVisible == false && m_globalBounds != oldGlobalBounds)
-  {
-    ref_spatialSystem.UpdateSpatialDataBounds(m_hSpatialData, m_globalBounds);
-  }
+  return m_hSpatialData.IsInvalidated() == false && bIsAlwaysVisible == false && m_globalBounds != oldGlobalBounds;
 }
 
 void ezGameObject::TransformationData::RecreateSpatialData(ezSpatialSystem& ref_spatialSystem)
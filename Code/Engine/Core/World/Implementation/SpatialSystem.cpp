@@ -45,6 +45,35 @@ void ezSpatialSystem::FindObjectsInBox(const ezBoundingBox& box, const QueryPara
     });
 }
 
+void ezSpatialSystem::FindVisibleObjectsMultiView(ezArrayPtr<const ezFrustum> frusta, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_objects, ezDynamicArray<ezUInt32>& out_visibilityMasks, ezVisibilityState visType) const
+{
+  EZ_ASSERT_DEV(frusta.GetCount() <= 32, "At most 32 frusta are supported, {} were given", frusta.GetCount());
+
+  ezHashTable<const ezGameObject*, ezUInt32> objectToIndex;
+  ezDynamicArray<const ezGameObject*> visibleObjects;
+
+  for (ezUInt32 uiView = 0; uiView < frusta.GetCount(); ++uiView)
+  {
+    visibleObjects.Clear();
+    FindVisibleObjects(frusta[uiView], queryParams, visibleObjects, {}, visType);
+
+    for (const ezGameObject* pObject : visibleObjects)
+    {
+      bool bExisted = false;
+      ezUInt32& uiIndex = objectToIndex.FindOrAdd(pObject, &bExisted);
+
+      if (!bExisted)
+      {
+        uiIndex = out_objects.GetCount();
+        out_objects.PushBack(pObject);
+        out_visibilityMasks.PushBack(0);
+      }
+
+      out_visibilityMasks[uiIndex] |= EZ_BIT(uiView);
+    }
+  }
+}
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
 void ezSpatialSystem::GetInternalStats(ezStringBuilder& ref_sSb) const
 {
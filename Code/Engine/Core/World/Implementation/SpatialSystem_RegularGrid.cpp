@@ -121,49 +121,90 @@ namespace
     return (cmp_0123 || cmp_4545).NoneSet<4>();
   }
 
-  EZ_FORCE_INLINE ezUInt32 SphereFrustumIntersect(const ezSimdBSphere& sphereA, const ezSimdBSphere& sphereB, const PlaneData& planeData)
+  /// Four bounding spheres in SoA layout, such that they can be tested against one plane with a few instructions.
+  struct SphereGroup
   {
-    ezSimdVec4f posA_xxxx(sphereA.m_CenterAndRadius.x());
-    ezSimdVec4f posA_yyyy(sphereA.m_CenterAndRadius.y());
-    ezSimdVec4f posA_zzzz(sphereA.m_CenterAndRadius.z());
-    ezSimdVec4f posA_rrrr(sphereA.m_CenterAndRadius.w());
-
-    ezSimdVec4f dotA_0123;
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_yyyy, planeData.m_y0y1y2y3, dotA_0123);
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_zzzz, planeData.m_z0z1z2z3, dotA_0123);
-
-    ezSimdVec4f posB_xxxx(sphereB.m_CenterAndRadius.x());
-    ezSimdVec4f posB_yyyy(sphereB.m_CenterAndRadius.y());
-    ezSimdVec4f posB_zzzz(sphereB.m_CenterAndRadius.z());
-    ezSimdVec4f posB_rrrr(sphereB.m_CenterAndRadius.w());
-
-    ezSimdVec4f dotB_0123;
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_yyyy, planeData.m_y0y1y2y3, dotB_0123);
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_zzzz, planeData.m_z0z1z2z3, dotB_0123);
-
-    ezSimdVec4f posAB_xxxx = posA_xxxx.GetCombined<ezSwizzle::XXXX>(posB_xxxx);
-    ezSimdVec4f posAB_yyyy = posA_yyyy.GetCombined<ezSwizzle::XXXX>(posB_yyyy);
-    ezSimdVec4f posAB_zzzz = posA_zzzz.GetCombined<ezSwizzle::XXXX>(posB_zzzz);
-    ezSimdVec4f posAB_rrrr = posA_rrrr.GetCombined<ezSwizzle::XXXX>(posB_rrrr);
-
-    ezSimdVec4f dot_A45B45;
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_yyyy, planeData.m_y4y5y4y5, dot_A45B45);
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_zzzz, planeData.m_z4z5z4z5, dot_A45B45);
-
-    ezSimdVec4b cmp_A0123 = dotA_0123 > posA_rrrr;
-    ezSimdVec4b cmp_B0123 = dotB_0123 > posB_rrrr;
-    ezSimdVec4b cmp_A45B45 = dot_A45B45 > posAB_rrrr;
-
-    ezSimdVec4b cmp_A45 = cmp_A45B45.Get<ezSwizzle::XYXY>();
-    ezSimdVec4b cmp_B45 = cmp_A45B45.Get<ezSwizzle::ZWZW>();
-
-    ezUInt32 result = (cmp_A0123 || cmp_A45).NoneSet<4>() ? 1 : 0;
-    result |= (cmp_B0123 || cmp_B45).NoneSet<4>() ? 2 : 0;
-
-    return result;
+    ezSimdVec4f m_CenterX;
+    ezSimdVec4f m_CenterY;
+    ezSimdVec4f m_CenterZ;
+    ezSimdVec4f m_Radius;
+  };
+
+  /// The frustum planes with every component broadcast to all four lanes, for testing a SphereGroup.
+  struct SoAPlaneData
+  {
+    ezSimdVec4f m_PlaneX[6];
+    ezSimdVec4f m_PlaneY[6];
+    ezSimdVec4f m_PlaneZ[6];
+    ezSimdVec4f m_PlaneW[6];
+  };
+
+  /// Returns a bitmask with one bit for each sphere of the group that intersects the frustum.
+  EZ_FORCE_INLINE ezUInt32 SphereGroupFrustumIntersect(const SphereGroup& group, const SoAPlaneData& planeData)
+  {
+    ezSimdVec4b outside(false);
+
+    for (ezUInt32 i = 0; i < 6; ++i)
+    {
+      ezSimdVec4f dist = ezSimdVec4f::MulAdd(group.m_CenterX, planeData.m_PlaneX[i], planeData.m_PlaneW[i]);
+      dist = ezSimdVec4f::MulAdd(group.m_CenterY, planeData.m_PlaneY[i], dist);
+      dist = ezSimdVec4f::MulAdd(group.m_CenterZ, planeData.m_PlaneZ[i], dist);
+
+      outside = outside || (dist > group.m_Radius);
+    }
+
+    if (outside.AllSet<4>())
+      return 0;
+
+    ezInt32 lanes[4];
+    ezSimdVec4i::Select(outside, ezSimdVec4i::MakeZero(), ezSimdVec4i(1, 2, 4, 8)).Store<4>(lanes);
+    return lanes[0] | lanes[1] | lanes[2] | lanes[3];
+  }
+
+  void ComputePlaneData(const ezFrustum& frustum, PlaneData& out_planeData, SoAPlaneData& out_soaPlaneData)
+  {
+    ezSimdVec4f planes[6];
+    for (ezUInt32 i = 0; i < 6; ++i)
+    {
+      const ezPlane& plane = frustum.GetPlane(i);
+      planes[i] = ezSimdVec4f(plane.m_vNormal.x, plane.m_vNormal.y, plane.m_vNormal.z, plane.m_fNegDistance);
+
+      out_soaPlaneData.m_PlaneX[i] = ezSimdVec4f(plane.m_vNormal.x);
+      out_soaPlaneData.m_PlaneY[i] = ezSimdVec4f(plane.m_vNormal.y);
+      out_soaPlaneData.m_PlaneZ[i] = ezSimdVec4f(plane.m_vNormal.z);
+      out_soaPlaneData.m_PlaneW[i] = ezSimdVec4f(plane.m_fNegDistance);
+    }
+
+    ezSimdMat4f helperMat;
+    helperMat.SetRows(planes[0], planes[1], planes[2], planes[3]);
+
+    out_planeData.m_x0x1x2x3 = helperMat.m_col0;
+    out_planeData.m_y0y1y2y3 = helperMat.m_col1;
+    out_planeData.m_z0z1z2z3 = helperMat.m_col2;
+    out_planeData.m_w0w1w2w3 = helperMat.m_col3;
+
+    helperMat.SetRows(planes[4], planes[5], planes[4], planes[5]);
+
+    out_planeData.m_x4x5x4x5 = helperMat.m_col0;
+    out_planeData.m_y4y5y4y5 = helperMat.m_col1;
+    out_planeData.m_z4z5z4z5 = helperMat.m_col2;
+    out_planeData.m_w4w5w4w5 = helperMat.m_col3;
+  }
+
+  ezSimdBBox ComputeFrustumBox(const ezFrustum& frustum)
+  {
+    ezVec3 cornerPoints[8];
+    frustum.ComputeCornerPoints(cornerPoints);
+
+    ezSimdVec4f simdCornerPoints[8];
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      simdCornerPoints[i] = ezSimdConversion::ToVec3(cornerPoints[i]);
+    }
+
+    ezSimdBBox simdBox;
+    simdBox.SetFromPoints(simdCornerPoints, 8);
+    return simdBox;
   }
 } // namespace
 
@@ -181,6 +222,7 @@ struct ezSpatialSystem_RegularGrid::Cell
 {
   Cell(ezAllocatorBase* pAlignedAlloctor, ezAllocatorBase* pAllocator)
     : m_BoundingSpheres(pAlignedAlloctor)
+    , m_SphereGroups(pAlignedAlloctor)
     , m_BoundingBoxHalfExtents(pAlignedAlloctor)
     , m_TagSets(pAllocator)
     , m_ObjectPointers(pAllocator)
@@ -190,6 +232,8 @@ struct ezSpatialSystem_RegularGrid::Cell
 
   EZ_FORCE_INLINE ezUInt32 AddData(const ezSimdBBoxSphere& bounds, const ezTagSet& tags, ezGameObject* pObject, ezUInt64 uiLastVisibleFrameIdxAndVisType, ezUInt32 uiDataIndex)
   {
+    const ezUInt32 uiCellDataIndex = m_BoundingSpheres.GetCount();
+
     m_BoundingSpheres.PushBack(bounds.GetSphere());
     m_BoundingBoxHalfExtents.PushBack(bounds.m_BoxHalfExtents);
     m_TagSets.PushBack(tags);
@@ -197,7 +241,14 @@ struct ezSpatialSystem_RegularGrid::Cell
     m_DataIndices.PushBack(uiDataIndex);
     m_LastVisibleFrameIdxAndVisType.PushBack(uiLastVisibleFrameIdxAndVisType);
 
-    return m_BoundingSpheres.GetCount() - 1;
+    if ((uiCellDataIndex & 3) == 0)
+    {
+      InvalidateSphereGroup(m_SphereGroups.ExpandAndGetRef());
+    }
+
+    SetSphereGroupLane(uiCellDataIndex, bounds.m_CenterAndRadius);
+
+    return uiCellDataIndex;
   }
 
   // Returns the data index of the moved data
@@ -205,6 +256,15 @@ struct ezSpatialSystem_RegularGrid::Cell
   {
     ezUInt32 uiMovedDataIndex = m_DataIndices.PeekBack();
 
+    const ezUInt32 uiLastIndex = m_BoundingSpheres.GetCount() - 1;
+    SetSphereGroupLane(uiCellDataIndex, m_BoundingSpheres[uiLastIndex].m_CenterAndRadius);
+    SetSphereGroupLane(uiLastIndex, GetInvalidSphere());
+
+    if ((uiLastIndex & 3) == 0)
+    {
+      m_SphereGroups.PopBack();
+    }
+
     m_BoundingSpheres.RemoveAtAndSwap(uiCellDataIndex);
     m_BoundingBoxHalfExtents.RemoveAtAndSwap(uiCellDataIndex);
     m_TagSets.RemoveAtAndSwap(uiCellDataIndex);
@@ -217,11 +277,42 @@ struct ezSpatialSystem_RegularGrid::Cell
     return uiMovedDataIndex;
   }
 
+  EZ_FORCE_INLINE void UpdateBounds(ezUInt32 uiCellDataIndex, const ezSimdBBoxSphere& bounds)
+  {
+    m_BoundingSpheres[uiCellDataIndex] = bounds.GetSphere();
+    m_BoundingBoxHalfExtents[uiCellDataIndex] = bounds.m_BoxHalfExtents;
+
+    SetSphereGroupLane(uiCellDataIndex, bounds.m_CenterAndRadius);
+  }
+
   EZ_ALWAYS_INLINE ezBoundingBox GetBoundingBox() const { return ezSimdConversion::ToBBoxSphere(m_Bounds).GetBox(); }
 
+  // unused lanes get a negative infinite radius, so they are always outside of any frustum
+  EZ_ALWAYS_INLINE static ezSimdVec4f GetInvalidSphere() { return ezSimdVec4f(0.0f, 0.0f, 0.0f, -ezMath::Infinity<float>()); }
+
+  EZ_ALWAYS_INLINE static void InvalidateSphereGroup(SphereGroup& ref_group)
+  {
+    ref_group.m_CenterX = ezSimdVec4f::MakeZero();
+    ref_group.m_CenterY = ezSimdVec4f::MakeZero();
+    ref_group.m_CenterZ = ezSimdVec4f::MakeZero();
+    ref_group.m_Radius = ezSimdVec4f(-ezMath::Infinity<float>());
+  }
+
+  EZ_FORCE_INLINE void SetSphereGroupLane(ezUInt32 uiCellDataIndex, const ezSimdVec4f& vCenterAndRadius)
+  {
+    float* pGroup = reinterpret_cast<float*>(&m_SphereGroups[uiCellDataIndex >> 2]);
+    const ezUInt32 uiLane = uiCellDataIndex & 3;
+
+    pGroup[0 + uiLane] = vCenterAndRadius.x();
+    pGroup[4 + uiLane] = vCenterAndRadius.y();
+    pGroup[8 + uiLane] = vCenterAndRadius.z();
+    pGroup[12 + uiLane] = vCenterAndRadius.w();
+  }
+
   ezSimdBBoxSphere m_Bounds;
 
   ezDynamicArray<ezSimdBSphere> m_BoundingSpheres;
+  ezDynamicArray<SphereGroup> m_SphereGroups; // the same spheres as in m_BoundingSpheres in SoA layout, for frustum culling
   ezDynamicArray<ezSimdVec4f> m_BoundingBoxHalfExtents;
   ezDynamicArray<ezTagSet> m_TagSets;
   ezDynamicArray<ezGameObject*> m_ObjectPointers;
@@ -477,6 +568,7 @@ namespace ezInternal
     struct FrustumQueryData
     {
       PlaneData m_PlaneData;
+      SoAPlaneData m_SoAPlaneData;
       ezDynamicArray<const ezGameObject*>* m_pOutObjects;
       ezUInt64 m_uiFrameCounter;
       ezSpatialSystem::IsOccludedFunc m_IsOccludedCB;
@@ -486,10 +578,9 @@ namespace ezInternal
     static ezVisitorExecution::Enum FrustumQueryCallback(const ezSpatialSystem_RegularGrid::Cell& cell, const ezSpatialSystem::QueryParams& queryParams, ezSpatialSystem_RegularGrid::Stats& ref_stats, void* pUserData, ezVisibilityState visType)
     {
       auto pQueryData = static_cast<FrustumQueryData*>(pUserData);
-      PlaneData planeData = pQueryData->m_PlaneData;
 
       ezSimdBSphere cellSphere = cell.m_Bounds.GetSphere();
-      if (!SphereFrustumIntersect(cellSphere, planeData))
+      if (!SphereFrustumIntersect(cellSphere, pQueryData->m_PlaneData))
         return ezVisitorExecution::Continue;
 
       if constexpr (UseOcclusionCallback)
@@ -503,90 +594,142 @@ namespace ezInternal
       ezSimdBBox bbox;
       auto boundingSpheres = cell.m_BoundingSpheres.GetData();
       auto boundingBoxHalfExtents = cell.m_BoundingBoxHalfExtents.GetData();
+      auto sphereGroups = cell.m_SphereGroups.GetData();
       auto tagSets = cell.m_TagSets.GetData();
       auto objectPointers = cell.m_ObjectPointers.GetData();
       auto lastVisibleFrameIdxAndVisType = cell.m_LastVisibleFrameIdxAndVisType.GetData();
 
       const ezUInt32 numSpheres = cell.m_BoundingSpheres.GetCount();
+      const ezUInt32 numGroups = cell.m_SphereGroups.GetCount();
       ref_stats.m_uiNumObjectsTested += numSpheres;
 
-      ezUInt32 currentIndex = 0;
       const ezUInt64 uiFrameIdxAndType = (pQueryData->m_uiFrameCounter << 4) | static_cast<ezUInt64>(visType);
 
-      while (currentIndex < numSpheres)
+      for (ezUInt32 uiGroup = 0; uiGroup < numGroups; ++uiGroup)
       {
-        if (numSpheres - currentIndex >= 32)
+        // unused lanes of the last group never intersect, so no need to mask them out
+        ezUInt32 mask = SphereGroupFrustumIntersect(sphereGroups[uiGroup], pQueryData->m_SoAPlaneData);
+
+        while (mask > 0)
         {
-          ezUInt32 mask = 0;
+          ezUInt32 i = ezMath::FirstBitLow(mask) + uiGroup * 4;
+          mask &= mask - 1;
 
-          for (ezUInt32 i = 0; i < 32; i += 2)
+          if constexpr (UseTagsFilter)
           {
-            auto& objectSphereA = boundingSpheres[currentIndex + i + 0];
-            auto& objectSphereB = boundingSpheres[currentIndex + i + 1];
-
-            mask |= SphereFrustumIntersect(objectSphereA, objectSphereB, planeData) << i;
+            if (FilterByTags(tagSets[i], queryParams.m_IncludeTags, queryParams.m_ExcludeTags))
+            {
+              ref_stats.m_uiNumObjectsFiltered++;
+              continue;
+            }
           }
 
-          while (mask > 0)
+          if constexpr (UseOcclusionCallback)
           {
-            ezUInt32 i = ezMath::FirstBitLow(mask) + currentIndex;
-            mask &= mask - 1;
-
-            if constexpr (UseTagsFilter)
+            bbox.SetCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
+            if (pQueryData->m_IsOccludedCB(bbox))
             {
-              if (FilterByTags(tagSets[i], queryParams.m_IncludeTags, queryParams.m_ExcludeTags))
-              {
-                ref_stats.m_uiNumObjectsFiltered++;
-                continue;
-              }
+              continue;
             }
+          }
 
-            if constexpr (UseOcclusionCallback)
-            {
-              bbox.SetCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
-              if (pQueryData->m_IsOccludedCB(bbox))
-              {
-                continue;
-              }
-            }
+          lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
+          pQueryData->m_pOutObjects->PushBack(objectPointers[i]);
 
-            lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
-            pQueryData->m_pOutObjects->PushBack(objectPointers[i]);
+          ref_stats.m_uiNumObjectsPassed++;
+        }
+      }
 
-            ref_stats.m_uiNumObjectsPassed++;
-          }
+      return ezVisitorExecution::Continue;
+    }
+
+    struct MultiViewFrustumQueryData
+    {
+      struct View
+      {
+        PlaneData m_PlaneData;
+        SoAPlaneData m_SoAPlaneData;
+      };
 
-          currentIndex += 32;
+      ezHybridArray<View, 8, ezAlignedAllocatorWrapper> m_Views;
+      ezDynamicArray<const ezGameObject*>* m_pOutObjects;
+      ezDynamicArray<ezUInt32>* m_pOutVisibilityMasks;
+      ezUInt64 m_uiFrameCounter;
+    };
+
+    template <bool UseTagsFilter>
+    static ezVisitorExecution::Enum MultiViewFrustumQueryCallback(const ezSpatialSystem_RegularGrid::Cell& cell, const ezSpatialSystem::QueryParams& queryParams, ezSpatialSystem_RegularGrid::Stats& ref_stats, void* pUserData, ezVisibilityState visType)
+    {
+      auto pQueryData = static_cast<MultiViewFrustumQueryData*>(pUserData);
+      const auto views = pQueryData->m_Views.GetArrayPtr();
+
+      // determine in which views the cell is visible at all, objects are only tested against those
+      const ezSimdBSphere cellSphere = cell.m_Bounds.GetSphere();
+      ezUInt32 uiCellViewMask = 0;
+      for (ezUInt32 uiView = 0; uiView < views.GetCount(); ++uiView)
+      {
+        if (SphereFrustumIntersect(cellSphere, views[uiView].m_PlaneData))
+        {
+          uiCellViewMask |= EZ_BIT(uiView);
         }
-        else
+      }
+
+      if (uiCellViewMask == 0)
+        return ezVisitorExecution::Continue;
+
+      auto sphereGroups = cell.m_SphereGroups.GetData();
+      auto tagSets = cell.m_TagSets.GetData();
+      auto objectPointers = cell.m_ObjectPointers.GetData();
+      auto lastVisibleFrameIdxAndVisType = cell.m_LastVisibleFrameIdxAndVisType.GetData();
+
+      const ezUInt32 numSpheres = cell.m_BoundingSpheres.GetCount();
+      const ezUInt32 numGroups = cell.m_SphereGroups.GetCount();
+      ref_stats.m_uiNumObjectsTested += numSpheres;
+
+      const ezUInt64 uiFrameIdxAndType = (pQueryData->m_uiFrameCounter << 4) | static_cast<ezUInt64>(visType);
+
+      for (ezUInt32 uiGroup = 0; uiGroup < numGroups; ++uiGroup)
+      {
+        const SphereGroup& group = sphereGroups[uiGroup];
+
+        // one visibility bitmask per lane, bit N is set if the object is visible in view N
+        ezUInt32 viewMasks[4] = {0, 0, 0, 0};
+        ezUInt32 uiAnyVisibleMask = 0;
+
+        ezUInt32 uiViewMask = uiCellViewMask;
+        while (uiViewMask > 0)
         {
-          ezUInt32 i = currentIndex;
-          ++currentIndex;
+          const ezUInt32 uiView = ezMath::FirstBitLow(uiViewMask);
+          uiViewMask &= uiViewMask - 1;
 
-          if (!SphereFrustumIntersect(boundingSpheres[i], planeData))
-            continue;
+          const ezUInt32 uiVisibleMask = SphereGroupFrustumIntersect(group, views[uiView].m_SoAPlaneData);
+          uiAnyVisibleMask |= uiVisibleMask;
 
-          if constexpr (UseTagsFilter)
+          for (ezUInt32 uiLaneMask = uiVisibleMask; uiLaneMask > 0; uiLaneMask &= uiLaneMask - 1)
           {
-            if (FilterByTags(tagSets[i], queryParams.m_IncludeTags, queryParams.m_ExcludeTags))
-            {
-              ref_stats.m_uiNumObjectsFiltered++;
-              continue;
-            }
+            viewMasks[ezMath::FirstBitLow(uiLaneMask)] |= EZ_BIT(uiView);
           }
+        }
 
-          if constexpr (UseOcclusionCallback)
-          {
-            bbox.SetCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
+        while (uiAnyVisibleMask > 0)
+        {
+          const ezUInt32 uiLane = ezMath::FirstBitLow(uiAnyVisibleMask);
+          uiAnyVisibleMask &= uiAnyVisibleMask - 1;
 
-            if (pQueryData->m_IsOccludedCB(bbox))
+          const ezUInt32 i = uiLane + uiGroup * 4;
+
+          if constexpr (UseTagsFilter)
+          {
+            if (FilterByTags(tagSets[i], queryParams.m_IncludeTags, queryParams.m_ExcludeTags))
             {
+              ref_stats.m_uiNumObjectsFiltered++;
               continue;
             }
           }
 
           lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
           pQueryData->m_pOutObjects->PushBack(objectPointers[i]);
+          pQueryData->m_pOutVisibilityMasks->PushBack(viewMasks[uiLane]);
 
           ref_stats.m_uiNumObjectsPassed++;
         }
@@ -769,8 +912,7 @@ void ezSpatialSystem_RegularGrid::UpdateSpatialDataBounds(const ezSpatialDataHan
 
       if (pOldCell->m_Bounds.GetBox().Contains(bounds.GetBox()))
       {
-        pOldCell->m_BoundingSpheres[mapping.m_uiCellDataIndex] = bounds.GetSphere();
-        pOldCell->m_BoundingBoxHalfExtents[mapping.m_uiCellDataIndex] = bounds.m_BoxHalfExtents;
+        pOldCell->UpdateBounds(mapping.m_uiCellDataIndex, bounds);
       }
       else
       {
@@ -839,42 +981,11 @@ void ezSpatialSystem_RegularGrid::FindVisibleObjects(const ezFrustum& frustum, c
   ezStopwatch timer;
 #endif
 
-  ezVec3 cornerPoints[8];
-  frustum.ComputeCornerPoints(cornerPoints);
-
-  ezSimdVec4f simdCornerPoints[8];
-  for (ezUInt32 i = 0; i < 8; ++i)
-  {
-    simdCornerPoints[i] = ezSimdConversion::ToVec3(cornerPoints[i]);
-  }
-
-  ezSimdBBox simdBox;
-  simdBox.SetFromPoints(simdCornerPoints, 8);
+  const ezSimdBBox simdBox = ComputeFrustumBox(frustum);
 
   ezInternal::QueryHelper::FrustumQueryData queryData;
   {
-    // Compiler is too stupid to properly unroll a constant loop so we do it by hand
-    ezSimdVec4f plane0 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(0).m_vNormal.x)));
-    ezSimdVec4f plane1 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(1).m_vNormal.x)));
-    ezSimdVec4f plane2 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(2).m_vNormal.x)));
-    ezSimdVec4f plane3 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(3).m_vNormal.x)));
-    ezSimdVec4f plane4 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(4).m_vNormal.x)));
-    ezSimdVec4f plane5 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(5).m_vNormal.x)));
-
-    ezSimdMat4f helperMat;
-    helperMat.SetRows(plane0, plane1, plane2, plane3);
-
-    queryData.m_PlaneData.m_x0x1x2x3 = helperMat.m_col0;
-    queryData.m_PlaneData.m_y0y1y2y3 = helperMat.m_col1;
-    queryData.m_PlaneData.m_z0z1z2z3 = helperMat.m_col2;
-    queryData.m_PlaneData.m_w0w1w2w3 = helperMat.m_col3;
-
-    helperMat.SetRows(plane4, plane5, plane4, plane5);
-
-    queryData.m_PlaneData.m_x4x5x4x5 = helperMat.m_col0;
-    queryData.m_PlaneData.m_y4y5y4y5 = helperMat.m_col1;
-    queryData.m_PlaneData.m_z4z5z4z5 = helperMat.m_col2;
-    queryData.m_PlaneData.m_w4w5w4w5 = helperMat.m_col3;
+    ComputePlaneData(frustum, queryData.m_PlaneData, queryData.m_SoAPlaneData);
 
     queryData.m_pOutObjects = &out_Objects;
     queryData.m_uiFrameCounter = m_uiFrameCounter;
@@ -905,6 +1016,49 @@ void ezSpatialSystem_RegularGrid::FindVisibleObjects(const ezFrustum& frustum, c
 #endif
 }
 
+void ezSpatialSystem_RegularGrid::FindVisibleObjectsMultiView(ezArrayPtr<const ezFrustum> frusta, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_Objects, ezDynamicArray<ezUInt32>& out_VisibilityMasks, ezVisibilityState visType) const
+{
+  EZ_PROFILE_SCOPE("FindVisibleObjectsMultiView");
+  EZ_ASSERT_DEV(frusta.GetCount() <= 32, "At most 32 frusta are supported, {} were given", frusta.GetCount());
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ezStopwatch timer;
+#endif
+
+  if (frusta.IsEmpty())
+    return;
+
+  ezSimdBBox simdBox = ComputeFrustumBox(frusta[0]);
+
+  ezInternal::QueryHelper::MultiViewFrustumQueryData queryData;
+  queryData.m_Views.SetCount(frusta.GetCount());
+  queryData.m_pOutObjects = &out_Objects;
+  queryData.m_pOutVisibilityMasks = &out_VisibilityMasks;
+  queryData.m_uiFrameCounter = m_uiFrameCounter;
+
+  for (ezUInt32 i = 0; i < frusta.GetCount(); ++i)
+  {
+    if (i > 0)
+    {
+      simdBox.ExpandToInclude(ComputeFrustumBox(frusta[i]));
+    }
+
+    ComputePlaneData(frusta[i], queryData.m_Views[i].m_PlaneData, queryData.m_Views[i].m_SoAPlaneData);
+  }
+
+  ForEachCellInBoxInMatchingGrids(simdBox, queryParams,
+    &ezInternal::QueryHelper::MultiViewFrustumQueryCallback<false>,
+    &ezInternal::QueryHelper::MultiViewFrustumQueryCallback<true>,
+    &queryData, visType);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_TimeTaken = timer.GetRunningTotal();
+  }
+#endif
+}
+
 ezVisibilityState ezSpatialSystem_RegularGrid::GetVisibilityState(const ezSpatialDataHandle& hData, ezUInt32 uiNumFramesBeforeInvisible) const
 {
   Data* pData = nullptr;
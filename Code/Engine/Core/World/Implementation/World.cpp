@@ -230,6 +230,15 @@ ezGameObjectHandle ezWorld::CreateObject(const ezGameObjectDesc& desc, ezGameObj
   return ezGameObjectHandle(newId);
 }
 
+void ezWorld::ReserveObjects(ezUInt32 uiNumAdditionalObjects)
+{
+  CheckForWriteAccess();
+
+  const ezUInt32 uiNumObjects = m_Data.m_Objects.GetCount() + uiNumAdditionalObjects;
+  m_Data.m_Objects.Reserve(uiNumObjects);
+  m_Data.m_ObjectStorage.Reserve(uiNumObjects);
+}
+
 void ezWorld::DeleteObjectNow(const ezGameObjectHandle& hObject0, bool bAlsoDeleteEmptyParents /*= true*/)
 {
   CheckForWriteAccess();
@@ -379,7 +388,7 @@ void ezWorld::PostMessage(const ezGameObjectHandle& receiverObject, const ezMess
     ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Data.m_Allocator);
 
     metaData.m_Due = m_Data.m_Clock.GetAccumulatedTime() + delay;
-    m_Data.m_TimedMessageQueues[queueType].Enqueue(pMsgCopy, metaData);
+    m_Data.m_TimedMessagesToSchedule[queueType].Enqueue(pMsgCopy, metaData);
   }
   else
   {
@@ -410,7 +419,7 @@ void ezWorld::PostMessage(const ezComponentHandle& hReceiverComponent, const ezM
     ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Data.m_Allocator);
 
     metaData.m_Due = m_Data.m_Clock.GetAccumulatedTime() + delay;
-    m_Data.m_TimedMessageQueues[queueType].Enqueue(pMsgCopy, metaData);
+    m_Data.m_TimedMessagesToSchedule[queueType].Enqueue(pMsgCopy, metaData);
   }
   else
   {
@@ -862,40 +871,47 @@ void ezWorld::ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType)
 
   // regular messages
   {
-    ezInternal::WorldData::MessageQueue& queue = m_Data.m_MessageQueues[queueType];
-    queue.Sort(MessageComparer());
+    ezDynamicArray<ezInternal::WorldData::MessageQueue::Entry> messages(m_Data.m_StackAllocator.GetCurrentAllocator());
+    m_Data.m_MessageQueues[queueType].DequeueAll(messages);
+    messages.Sort(MessageComparer());
 
     m_Data.m_ProcessingMessageQueue = queueType;
-    for (ezUInt32 i = 0; i < queue.GetCount(); ++i)
+    for (auto& entry : messages)
     {
-      ProcessQueuedMessage(queue[i]);
+      ProcessQueuedMessage(entry);
 
       // no need to deallocate these messages, they are allocated through a frame allocator
     }
     m_Data.m_ProcessingMessageQueue = ezObjectMsgQueueType::COUNT;
-
-    queue.Clear();
   }
 
   // timed messages
   {
-    ezInternal::WorldData::MessageQueue& queue = m_Data.m_TimedMessageQueues[queueType];
-    queue.Sort(MessageComparer());
-
     const ezTime now = m_Data.m_Clock.GetAccumulatedTime();
 
-    m_Data.m_ProcessingMessageQueue = queueType;
-    while (!queue.IsEmpty())
+    // messages that were posted since the last time are moved into the timing wheel first
     {
-      auto& entry = queue.Peek();
-      if (entry.m_MetaData.m_Due > now)
-        break;
+      ezDynamicArray<ezInternal::WorldData::TimedMessageQueue::Entry> newMessages(m_Data.m_StackAllocator.GetCurrentAllocator());
+      m_Data.m_TimedMessagesToSchedule[queueType].DequeueAll(newMessages);
+
+      ezInternal::WorldData::TimedMessageQueue& timedQueue = m_Data.m_TimedMessageQueues[queueType];
+      for (auto& entry : newMessages)
+      {
+        timedQueue.Enqueue(entry.m_pMessage, entry.m_MetaData);
+      }
+    }
 
+    // only the messages that are due are taken out of the queue, so the pending ones don't need to be sorted every frame
+    ezDynamicArray<ezInternal::WorldData::TimedMessageQueue::Entry> dueMessages(m_Data.m_StackAllocator.GetCurrentAllocator());
+    m_Data.m_TimedMessageQueues[queueType].DequeueDue(now, dueMessages);
+    dueMessages.Sort(MessageComparer());
+
+    m_Data.m_ProcessingMessageQueue = queueType;
+    for (auto& entry : dueMessages)
+    {
       ProcessQueuedMessage(entry);
 
       EZ_DELETE(&m_Data.m_Allocator, entry.m_pMessage);
-
-      queue.Dequeue();
     }
     m_Data.m_ProcessingMessageQueue = ezObjectMsgQueueType::COUNT;
   }
@@ -43,7 +43,7 @@ namespace ezInternal
     , m_Allocator(desc.m_sName, ezFoundation::GetDefaultAllocator())
     , m_AllocatorWrapper(&m_Allocator)
     , m_BlockAllocator(desc.m_sName, &m_Allocator)
-    , m_StackAllocator(desc.m_sName, ezFoundation::GetAlignedAllocator())
+    , m_StackAllocator(desc.m_sName, ezFoundation::GetAlignedAllocator(), ezStackAllocatorThreading::PerThreadLanes)
     , m_ObjectStorage(&m_BlockAllocator, &m_Allocator)
     , m_MaxInitializationTimePerFrame(desc.m_MaxComponentInitializationTimePerFrame)
     , m_Clock(desc.m_sName)
@@ -177,13 +177,13 @@ namespace ezInternal
       }
 
       {
-        MessageQueue& queue = m_TimedMessageQueues[i];
-        while (!queue.IsEmpty())
+        ezDynamicArray<TimedMessageQueue::Entry> entries;
+        m_TimedMessagesToSchedule[i].DequeueAll(entries);
+        m_TimedMessageQueues[i].DequeueAll(entries);
+
+        for (TimedMessageQueue::Entry& entry : entries)
         {
-          MessageQueue::Entry& entry = queue.Peek();
           EZ_DELETE(&m_Allocator, entry.m_pMessage);
-
-          queue.Dequeue();
         }
       }
     }
@@ -311,12 +311,10 @@ namespace ezInternal
   {
     struct UserData
     {
-      ezSpatialSystem* m_pSpatialSystem;
       ezUInt32 m_uiUpdateCounter;
     };
 
     UserData userData;
-    userData.m_pSpatialSystem = m_pSpatialSystem.Borrow();
     userData.m_uiUpdateCounter = m_uiUpdateCounter;
 
     struct RootLevel
@@ -339,33 +337,12 @@ namespace ezInternal
       }
     };
 
-    struct RootLevelWithSpatialData
-    {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData0)
-      {
-        auto pUserData = static_cast<UserData*>(pUserData0);
-        WorldData::UpdateGlobalTransformAndSpatialData(pData, pUserData->m_uiUpdateCounter, *pUserData->m_pSpatialSystem);
-        return ezVisitorExecution::Continue;
-      }
-    };
-
-    struct WithParentWithSpatialData
-    {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData0)
-      {
-        auto pUserData = static_cast<UserData*>(pUserData0);
-        WorldData::UpdateGlobalTransformWithParentAndSpatialData(pData, pUserData->m_uiUpdateCounter, *pUserData->m_pSpatialSystem);
-        return ezVisitorExecution::Continue;
-      }
-    };
-
     Hierarchy& hierarchy = m_Hierarchies[HierarchyType::Dynamic];
     if (!hierarchy.m_Data.IsEmpty())
     {
       auto dataPtr = hierarchy.m_Data.GetData();
 
-      // If we have no spatial system, we perform multi-threaded update as we do not
-      // have to acquire a write lock in the process.
+      // If we have no spatial system, we can simply update everything multi-threaded.
       if (m_pSpatialSystem == nullptr)
       {
         TraverseHierarchyLevelMultiThreaded<RootLevel>(*dataPtr[0], &userData);
@@ -377,16 +354,93 @@ namespace ezInternal
       }
       else
       {
-        TraverseHierarchyLevel<RootLevelWithSpatialData>(*dataPtr[0], &userData);
+        // The spatial system is not thread-safe, so the tasks only record which spatial data needs new bounds
+        // and the spatial system is updated afterwards on this thread.
+        UpdateGlobalTransformsAndRecordSpatialData<false>(*dataPtr[0], 0);
 
         for (ezUInt32 i = 1; i < hierarchy.m_Data.GetCount(); ++i)
         {
-          TraverseHierarchyLevel<WithParentWithSpatialData>(*dataPtr[i], &userData);
+          UpdateGlobalTransformsAndRecordSpatialData<true>(*dataPtr[i], i);
         }
+
+        ApplySpatialDataBoundsUpdates();
       }
     }
   }
 
+  template <bool WithParent>
+  void WorldData::UpdateGlobalTransformsAndRecordSpatialData(Hierarchy::DataBlockArray& blocks, ezUInt32 uiHierarchyLevel)
+  {
+    const ezUInt32 uiUpdateCounter = m_uiUpdateCounter;
+
+    auto updateBlocks = [this, &blocks, uiHierarchyLevel, uiUpdateCounter](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+    {
+      ezHybridArray<SpatialDataBoundsUpdate, 64, ezAlignedAllocatorWrapper> updates;
+
+      for (ezUInt32 uiBlockIndex = uiStartIndex; uiBlockIndex < uiEndIndex; ++uiBlockIndex)
+      {
+        Hierarchy::DataBlock& block = blocks[uiBlockIndex];
+
+        ezGameObject::TransformationData* pCurrentData = block.m_pData;
+        ezGameObject::TransformationData* pEndData = block.m_pData + block.m_uiCount;
+
+        while (pCurrentData < pEndData)
+        {
+          if constexpr (WithParent)
+            pCurrentData->UpdateGlobalTransformWithParent(uiUpdateCounter);
+          else
+            pCurrentData->UpdateGlobalTransformWithoutParent(uiUpdateCounter);
+
+          if (pCurrentData->UpdateGlobalBoundsAndCheckSpatialData())
+          {
+            auto& update = updates.ExpandAndGetRef();
+            update.m_GlobalBounds = pCurrentData->m_globalBounds;
+            update.m_hSpatialData = pCurrentData->m_hSpatialData;
+          }
+
+          ++pCurrentData;
+        }
+      }
+
+      if (updates.IsEmpty())
+        return;
+
+      EZ_LOCK(m_SpatialDataBoundsUpdatesMutex);
+
+      auto& range = m_SpatialDataBoundsUpdateRanges.ExpandAndGetRef();
+      range.m_uiSortKey = (ezUInt64(uiHierarchyLevel) << 32) | uiStartIndex;
+      range.m_uiFirstUpdate = m_SpatialDataBoundsUpdates.GetCount();
+      range.m_uiNumUpdates = updates.GetCount();
+
+      m_SpatialDataBoundsUpdates.PushBackRange(updates);
+    };
+
+    ezParallelForParams parallelForParams;
+    parallelForParams.m_uiBinSize = 100;
+    parallelForParams.m_uiMaxTasksPerThread = 2;
+    parallelForParams.m_pTaskAllocator = m_StackAllocator.GetCurrentAllocator();
+
+    ezTaskSystem::ParallelForIndexed(0u, blocks.GetCount(), updateBlocks, "World DataBlock Traversal Task", parallelForParams);
+  }
+
+  void WorldData::ApplySpatialDataBoundsUpdates()
+  {
+    // apply the updates in the same order as a single threaded update would have done, to keep the spatial system deterministic
+    m_SpatialDataBoundsUpdateRanges.Sort();
+
+    for (const auto& range : m_SpatialDataBoundsUpdateRanges)
+    {
+      for (ezUInt32 i = range.m_uiFirstUpdate; i < range.m_uiFirstUpdate + range.m_uiNumUpdates; ++i)
+      {
+        const auto& update = m_SpatialDataBoundsUpdates[i];
+        m_pSpatialSystem->UpdateSpatialDataBounds(update.m_hSpatialData, update.m_GlobalBounds);
+      }
+    }
+
+    m_SpatialDataBoundsUpdates.Clear();
+    m_SpatialDataBoundsUpdateRanges.Clear();
+  }
+
   void WorldData::ResourceEventHandler(const ezResourceEvent& e)
   {
     if (e.m_Type != ezResourceEvent::Type::ResourceContentUnloading)
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Foundation/Communication/MessageQueue.h>
+#include <Foundation/Communication/PerThreadMessageQueue.h>
+#include <Foundation/Communication/TimedMessageQueue.h>
 #include <Foundation/Containers/HashTable.h>
 #include <Foundation/Math/Random.h>
 #include <Foundation/Memory/FrameAllocator.h>
@@ -137,11 +139,36 @@ namespace ezInternal
     static void UpdateGlobalTransform(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter);
     static void UpdateGlobalTransformWithParent(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter);
 
-    static void UpdateGlobalTransformAndSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, ezSpatialSystem& spatialSystem);
-    static void UpdateGlobalTransformWithParentAndSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, ezSpatialSystem& spatialSystem);
+    struct SpatialDataBoundsUpdate
+    {
+      ezSimdBBoxSphere m_GlobalBounds;
+      ezSpatialDataHandle m_hSpatialData;
+    };
+
+    /// A consecutive range in m_SpatialDataBoundsUpdates that was recorded by one task.
+    /// The sort key is built from the hierarchy level and the first data block of the task, such that sorting the ranges
+    /// restores the order in which a single threaded traversal would have produced the updates.
+    struct SpatialDataBoundsUpdateRange
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      ezUInt64 m_uiSortKey;
+      ezUInt32 m_uiFirstUpdate;
+      ezUInt32 m_uiNumUpdates;
+
+      EZ_ALWAYS_INLINE bool operator<(const SpatialDataBoundsUpdateRange& other) const { return m_uiSortKey < other.m_uiSortKey; }
+    };
+
+    template <bool WithParent>
+    void UpdateGlobalTransformsAndRecordSpatialData(Hierarchy::DataBlockArray& blocks, ezUInt32 uiHierarchyLevel);
+    void ApplySpatialDataBoundsUpdates();
 
     void UpdateGlobalTransforms();
 
+    ezMutex m_SpatialDataBoundsUpdatesMutex;
+    ezDynamicArray<SpatialDataBoundsUpdate, ezAlignedAllocatorWrapper> m_SpatialDataBoundsUpdates;
+    ezDynamicArray<SpatialDataBoundsUpdateRange, ezLocalAllocatorWrapper> m_SpatialDataBoundsUpdateRanges;
+
     void ResourceEventHandler(const ezResourceEvent& e);
 
     // game object lookups
@@ -231,9 +258,13 @@ namespace ezInternal
       ezTime m_Due;
     };
 
-    using MessageQueue = ezMessageQueue<QueuedMsgMetaData, ezLocalAllocatorWrapper>;
+    // Every thread posts into its own lane, the lanes are merged when the messages are processed
+    using MessageQueue = ezPerThreadMessageQueue<QueuedMsgMetaData, ezLocalAllocatorWrapper>;
     mutable MessageQueue m_MessageQueues[ezObjectMsgQueueType::COUNT];
-    mutable MessageQueue m_TimedMessageQueues[ezObjectMsgQueueType::COUNT];
+    mutable MessageQueue m_TimedMessagesToSchedule[ezObjectMsgQueueType::COUNT];
+
+    using TimedMessageQueue = ezTimedMessageQueue<QueuedMsgMetaData, ezLocalAllocatorWrapper>;
+    TimedMessageQueue m_TimedMessageQueues[ezObjectMsgQueueType::COUNT];
     ezObjectMsgQueueType::Enum m_ProcessingMessageQueue = ezObjectMsgQueueType::COUNT;
 
     ezThreadID m_WriteThreadID;
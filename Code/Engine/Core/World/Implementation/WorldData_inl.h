@@ -73,20 +73,6 @@ namespace ezInternal
     pData->UpdateGlobalBounds();
   }
 
-  // static
-  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransformAndSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, ezSpatialSystem& spatialSystem)
-  {
-    pData->UpdateGlobalTransformWithoutParent(uiUpdateCounter);
-    pData->UpdateGlobalBoundsAndSpatialData(spatialSystem);
-  }
-
-  // static
-  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransformWithParentAndSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, ezSpatialSystem& spatialSystem)
-  {
-    pData->UpdateGlobalTransformWithParent(uiUpdateCounter);
-    pData->UpdateGlobalBoundsAndSpatialData(spatialSystem);
-  }
-
   ///////////////////////////////////////////////////////////////////////////////////////////////////
 
   EZ_ALWAYS_INLINE const ezGameObject& WorldData::ConstObjectIterator::operator*() const
@@ -67,6 +67,15 @@ public:
 
   virtual void FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_objects, IsOccludedFunc isOccluded, ezVisibilityState visType) const = 0;
 
+  /// \brief Finds all objects that are visible in at least one of the given frusta.
+  ///
+  /// This is meant for views that look at mostly the same part of the world, e.g. shadow cascades or the faces of a cube map.
+  /// Implementations may do this in a single traversal, instead of walking the same cells once per frustum.
+  /// Every visible object is appended once to out_objects and for each of them a bitmask is appended to out_visibilityMasks,
+  /// in which bit N is set, if the object is visible in frusta[N]. At most 32 frusta are supported.
+  /// The default implementation calls FindVisibleObjects() once per frustum and merges the results.
+  virtual void FindVisibleObjectsMultiView(ezArrayPtr<const ezFrustum> frusta, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_objects, ezDynamicArray<ezUInt32>& out_visibilityMasks, ezVisibilityState visType) const;
+
   /// \brief Retrieves a state describing how visible the object is.
   ///
   /// An object may be invisible, fully visible, or indirectly visible (through shadows or reflections).
@@ -42,6 +42,7 @@ private:
   void FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const override;
 
   void FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_Objects, ezSpatialSystem::IsOccludedFunc IsOccluded, ezVisibilityState visType) const override;
+  void FindVisibleObjectsMultiView(ezArrayPtr<const ezFrustum> frusta, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_Objects, ezDynamicArray<ezUInt32>& out_VisibilityMasks, ezVisibilityState visType) const override;
 
   ezVisibilityState GetVisibilityState(const ezSpatialDataHandle& hData, ezUInt32 uiNumFramesBeforeInvisible) const override;
 
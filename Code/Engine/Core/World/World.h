@@ -43,6 +43,11 @@ public:
   /// \brief Create a new game object from the given description, writes a pointer to it to out_pObject and returns a handle to it.
   ezGameObjectHandle CreateObject(const ezGameObjectDesc& desc, ezGameObject*& out_pObject);
 
+  /// \brief Makes sure that uiNumAdditionalObjects more objects can be created without growing the internal object tables.
+  ///
+  /// Use this before creating a large number of objects at once, e.g. when spawning many copies of the same prefab.
+  void ReserveObjects(ezUInt32 uiNumAdditionalObjects);
+
   /// \brief Deletes the given object, its children and all components.
   /// \note This function deletes the object immediately! It is unsafe to use this during a game update loop, as other objects
   /// may rely on this object staying valid for the rest of the frame.
@@ -215,6 +220,9 @@ public:
   void SendMessageRecursive(const ezGameObjectHandle& hReceiverObject, ezMessage& ref_msg);
 
   /// \brief Queues the message for the given phase. The message is send to the receiverObject after the given delay in the corresponding phase.
+  ///
+  /// Posting is thread safe. Every thread posts into its own buffer, so posting threads don't contend with each other.
+  /// The buffers are merged when the messages are processed.
   void PostMessage(const ezGameObjectHandle& hReceiverObject, const ezMessage& msg, ezTime delay,
     ezObjectMsgQueueType::Enum queueType = ezObjectMsgQueueType::NextFrame) const;
 
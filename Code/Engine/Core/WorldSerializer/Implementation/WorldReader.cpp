@@ -2,11 +2,60 @@
 
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Foundation/IO/StringDeduplicationContext.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/Progress.h>
 
 ezWorldReader::FindComponentTypeCallback ezWorldReader::s_FindComponentTypeCallback;
 
+// a super simple, but also efficient random number generator
+inline static ezUInt32 NextStableRandomSeed(ezUInt32& ref_uiSeed)
+{
+  ref_uiSeed = 214013L * ref_uiSeed + 2531011L;
+  return ((ref_uiSeed >> 16) & 0x7FFFF);
+}
+
+static void ApplyInstantiationOptions(ezGameObjectDesc& ref_desc, const ezPrefabInstantiationOptions& options, ezUInt32& ref_uiCustomRandomSeed)
+{
+  ref_desc.m_bDynamic |= options.m_bForceDynamic;
+
+  switch (options.m_RandomSeedMode)
+  {
+    case ezPrefabInstantiationOptions::RandomSeedMode::DeterministicFromParent:
+      ref_desc.m_uiStableRandomSeed = 0xFFFFFFFF; // ezWorld::CreateObject() will either derive a deterministic value from the parent object, or assign a random value, if no parent exists
+      break;
+
+    case ezPrefabInstantiationOptions::RandomSeedMode::CompletelyRandom:
+      ref_desc.m_uiStableRandomSeed = 0; // ezWorld::CreateObject() will assign a random value to this object
+      break;
+
+    case ezPrefabInstantiationOptions::RandomSeedMode::FixedFromSerialization:
+      // keep deserialized value
+      break;
+
+    case ezPrefabInstantiationOptions::RandomSeedMode::CustomRootValue:
+      // we use the given seed root value to assign a deterministic (but different) value to each game object
+      ref_desc.m_uiStableRandomSeed = NextStableRandomSeed(ref_uiCustomRandomSeed);
+      break;
+  }
+
+  if (options.m_pOverrideTeamID != nullptr)
+  {
+    ref_desc.m_uiTeamID = *options.m_pOverrideTeamID;
+  }
+}
+
+static void ApplyRootTransform(ezGameObjectDesc& ref_desc, const ezTransform& rootTransform)
+{
+  ezTransform tChild(ref_desc.m_LocalPosition, ref_desc.m_LocalRotation, ref_desc.m_LocalScaling);
+  ezTransform tFinal;
+  tFinal = ezTransform::MakeGlobalTransform(rootTransform, tChild);
+
+  ref_desc.m_LocalPosition = tFinal.m_vPosition;
+  ref_desc.m_LocalRotation = tFinal.m_qRotation;
+  ref_desc.m_LocalScaling = tFinal.m_vScale;
+}
+
 ezWorldReader::ezWorldReader() = default;
 ezWorldReader::~ezWorldReader() = default;
 
@@ -14,64 +63,41 @@ ezResult ezWorldReader::ReadWorldDescription(ezStreamReader& inout_stream, bool
 {
   m_pStream = &inout_stream;
 
-  m_uiVersion = 0;
-  inout_stream >> m_uiVersion;
-
-  if (m_uiVersion < 8 || m_uiVersion > 10)
-  {
-    ezLog::Error("Invalid world version (got {}).", m_uiVersion);
-    return EZ_FAILURE;
-  }
+  EZ_SUCCEED_OR_RETURN(ReadVersion());
 
   // destroy old context first
   m_pStringDedupReadContext = nullptr;
   m_pStringDedupReadContext = EZ_DEFAULT_NEW(ezStringDeduplicationReadContext, inout_stream);
 
-  if (m_uiVersion == 8)
-  {
-    // add tags from the stream
-    EZ_SUCCEED_OR_RETURN(ezTagRegistry::GetGlobalRegistry().Load(inout_stream));
-  }
+  EZ_SUCCEED_OR_RETURN(ReadObjectsAndComponentTypes());
 
-  ezUInt32 uiNumRootObjects = 0;
-  inout_stream >> uiNumRootObjects;
-
-  ezUInt32 uiNumChildObjects = 0;
-  inout_stream >> uiNumChildObjects;
+  // read all component data
+  ReadComponentData(bWarningOnUknownSkip, ezArrayPtr<const ezUInt8>());
+  m_pStringDedupReadContext->SetActive(false);
 
-  ezUInt32 uiNumComponentTypes = 0;
-  inout_stream >> uiNumComponentTypes;
+  return EZ_SUCCESS;
+}
 
-  if (uiNumComponentTypes > ezMath::MaxValue<ezUInt16>())
-  {
-    ezLog::Error("World description has too many component types, got {0} - maximum allowed are {1}", uiNumComponentTypes, ezMath::MaxValue<ezUInt16>());
-    return EZ_FAILURE;
-  }
+ezResult ezWorldReader::ReadWorldDescription(ezArrayPtr<const ezUInt8> data, bool bWarningOnUknownSkip)
+{
+  ezRawMemoryStreamReader stream(data.GetPtr(), data.GetCount());
 
-  m_RootObjectsToCreate.Reserve(uiNumRootObjects);
-  m_ChildObjectsToCreate.Reserve(uiNumChildObjects);
+  m_pStream = &stream;
+  EZ_SCOPE_EXIT(m_pStream = nullptr);
 
-  m_IndexToGameObjectHandle.SetCountUninitialized(uiNumRootObjects + uiNumChildObjects + 1);
+  EZ_SUCCEED_OR_RETURN(ReadVersion());
 
-  for (ezUInt32 i = 0; i < uiNumRootObjects; ++i)
-  {
-    ReadGameObjectDesc(m_RootObjectsToCreate.ExpandAndGetRef());
-  }
+  // destroy old context first
+  m_pStringDedupReadContext = nullptr;
 
-  for (ezUInt32 i = 0; i < uiNumChildObjects; ++i)
-  {
-    ReadGameObjectDesc(m_ChildObjectsToCreate.ExpandAndGetRef());
-  }
+  ezUInt32 uiStringTableSize = 0;
+  m_pStringDedupReadContext = EZ_DEFAULT_NEW(ezStringDeduplicationReadContext, data.GetSubArray(static_cast<ezUInt32>(stream.GetReadPosition())), uiStringTableSize);
+  stream.SkipBytes(uiStringTableSize);
 
-  m_ComponentTypes.SetCount(uiNumComponentTypes);
-  m_ComponentTypeVersions.Reserve(uiNumComponentTypes);
-  for (ezUInt32 i = 0; i < uiNumComponentTypes; ++i)
-  {
-    ReadComponentTypeInfo(i);
-  }
+  EZ_SUCCEED_OR_RETURN(ReadObjectsAndComponentTypes());
 
-  // read all component data
-  ReadComponentDataToMemStream(bWarningOnUknownSkip);
+  // only locate the component data, it is read in place during instantiation
+  ReadComponentData(bWarningOnUknownSkip, data);
   m_pStringDedupReadContext->SetActive(false);
 
   return EZ_SUCCESS;
@@ -93,12 +119,128 @@ ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::InstantiateP
   return Instantiate(ref_world, true, rootTransform, options);
 }
 
+void ezWorldReader::InstantiatePrefabs(ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, const ezPrefabInstantiationOptions& options)
+{
+  EZ_ASSERT_DEV(options.m_ReplaceNamedRootWithParent.IsEmpty(), "m_ReplaceNamedRootWithParent is not supported when instantiating multiple prefabs at once.");
+
+  const ezUInt32 uiNumInstances = rootTransforms.GetCount();
+  if (uiNumInstances == 0)
+    return;
+
+  EZ_PROFILE_SCOPE("ezWorldReader::InstantiatePrefabs");
+
+  EZ_LOCK(ref_world.GetWriteMarker());
+
+  m_pWorld = &ref_world;
+
+  const ezUInt32 uiNumRootObjects = m_RootObjectsToCreate.GetCount();
+  const ezUInt32 uiNumChildObjects = m_ChildObjectsToCreate.GetCount();
+
+  // create the game objects of all instances
+  {
+    EZ_PROFILE_SCOPE("ezWorldReader::CreateGameObjects");
+
+    ref_world.ReserveObjects(uiNumInstances * (uiNumRootObjects + uiNumChildObjects));
+
+    m_IndexToGameObjectHandle.Clear();
+    m_IndexToGameObjectHandle.Reserve(uiNumInstances * (uiNumRootObjects + uiNumChildObjects + 1));
+
+    if (options.m_pCreatedRootObjectsOut != nullptr)
+    {
+      options.m_pCreatedRootObjectsOut->Reserve(options.m_pCreatedRootObjectsOut->GetCount() + uiNumInstances * uiNumRootObjects);
+    }
+
+    if (options.m_pCreatedChildObjectsOut != nullptr)
+    {
+      options.m_pCreatedChildObjectsOut->Reserve(options.m_pCreatedChildObjectsOut->GetCount() + uiNumInstances * uiNumChildObjects);
+    }
+
+    for (ezUInt32 uiInstance = 0; uiInstance < uiNumInstances; ++uiInstance)
+    {
+      // every instance starts with the same seed, just like separate calls to InstantiatePrefab() would
+      ezUInt32 uiCustomRandomSeed = options.m_uiCustomRandomSeedRootValue;
+
+      const ezUInt32 uiFirstHandle = m_IndexToGameObjectHandle.GetCount();
+      m_IndexToGameObjectHandle.PushBack(ezGameObjectHandle());
+
+      for (ezUInt32 i = 0; i < uiNumRootObjects + uiNumChildObjects; ++i)
+      {
+        const bool bIsRoot = i < uiNumRootObjects;
+        auto& godesc = bIsRoot ? m_RootObjectsToCreate[i] : m_ChildObjectsToCreate[i - uiNumRootObjects];
+
+        ezGameObjectDesc desc = godesc.m_Desc; // make a copy
+        desc.m_hParent = bIsRoot ? options.m_hParent : m_IndexToGameObjectHandle[uiFirstHandle + godesc.m_uiParentHandleIdx];
+
+        ApplyInstantiationOptions(desc, options, uiCustomRandomSeed);
+
+        if (bIsRoot)
+        {
+          ApplyRootTransform(desc, rootTransforms[uiInstance]);
+        }
+
+        ezGameObject* pObject = nullptr;
+        m_IndexToGameObjectHandle.PushBack(ref_world.CreateObject(desc, pObject));
+
+        if (!godesc.m_sGlobalKey.IsEmpty())
+        {
+          pObject->SetGlobalKey(godesc.m_sGlobalKey);
+        }
+
+        ezDynamicArray<ezGameObject*>* pCreatedObjectsOut = bIsRoot ? options.m_pCreatedRootObjectsOut : options.m_pCreatedChildObjectsOut;
+        if (pCreatedObjectsOut != nullptr)
+        {
+          pCreatedObjectsOut->PushBack(pObject);
+        }
+      }
+    }
+  }
+
+  // the creation data is the same for all instances, so it only needs to be decoded once
+  ezDynamicArray<ComponentToCreate> componentsToCreate;
+  ReadComponentsToCreate(componentsToCreate);
+
+  // the components are grouped by type and within each type stored one instance after the other
+  ezDynamicArray<ezComponent*> components;
+  CreateComponents(uiNumInstances, componentsToCreate, components);
+
+  if (components.IsEmpty())
+    return;
+
+  if (options.m_bDeserializeComponentsInParallel && uiNumInstances > 1)
+  {
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumInstances, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      { DeserializeComponents(uiStartIndex, uiEndIndex - uiStartIndex, components); },
+      "ezWorldReader::DeserializeComponents");
+  }
+  else
+  {
+    DeserializeComponents(0, uiNumInstances, components);
+  }
+
+  // add the components of all instances to the init batch in one go
+  {
+    EZ_PROFILE_SCOPE("ezWorldReader::AddComponentsToBatch");
+
+    for (ezComponent* pComponent : components)
+    {
+      if (pComponent != nullptr)
+      {
+        pComponent->GetOwningManager()->InitializeComponent(pComponent);
+      }
+    }
+  }
+}
+
 ezGameObjectHandle ezWorldReader::ReadGameObjectHandle()
 {
   ezUInt32 idx = 0;
   *m_pStream >> idx;
 
-  return m_IndexToGameObjectHandle[idx];
+  const ezWorldReader& sharedReader = GetSharedReader();
+  const ezUInt32 uiNumHandlesPerInstance = sharedReader.m_RootObjectsToCreate.GetCount() + sharedReader.m_ChildObjectsToCreate.GetCount() + 1;
+
+  return sharedReader.m_IndexToGameObjectHandle[m_uiInstanceIndex * uiNumHandlesPerInstance + idx];
 }
 
 void ezWorldReader::ReadComponentHandle(ezComponentHandle& out_hComponent)
@@ -111,12 +253,18 @@ void ezWorldReader::ReadComponentHandle(ezComponentHandle& out_hComponent)
 
   out_hComponent.Invalidate();
 
-  if (uiTypeIndex < m_ComponentTypes.GetCount())
+  const ezWorldReader& sharedReader = GetSharedReader();
+  if (uiTypeIndex < sharedReader.m_ComponentTypes.GetCount())
   {
-    auto& indexToHandle = m_ComponentTypes[uiTypeIndex].m_ComponentIndexToHandle;
-    if (uiIndex < indexToHandle.GetCount())
+    auto& compTypeInfo = sharedReader.m_ComponentTypes[uiTypeIndex];
+    if (uiIndex <= compTypeInfo.m_uiNumComponents)
     {
-      out_hComponent = indexToHandle[uiIndex];
+      auto& indexToHandle = compTypeInfo.m_ComponentIndexToHandle;
+      const ezUInt32 uiHandleIndex = m_uiInstanceIndex * (compTypeInfo.m_uiNumComponents + 1) + uiIndex;
+      if (uiHandleIndex < indexToHandle.GetCount())
+      {
+        out_hComponent = indexToHandle[uiHandleIndex];
+      }
     }
   }
 }
@@ -124,7 +272,7 @@ void ezWorldReader::ReadComponentHandle(ezComponentHandle& out_hComponent)
 ezUInt32 ezWorldReader::GetComponentTypeVersion(const ezRTTI* pRtti) const
 {
   ezUInt32 uiVersion = 0xFFFFFFFF;
-  m_ComponentTypeVersions.TryGetValue(pRtti, uiVersion);
+  GetSharedReader().m_ComponentTypeVersions.TryGetValue(pRtti, uiVersion);
 
   return uiVersion;
 }
@@ -146,17 +294,18 @@ void ezWorldReader::ClearAndCompact()
   m_ComponentTypeVersions.Clear();
   m_ComponentTypeVersions.Compact();
 
-  m_ComponentCreationStream.Clear();
-  m_ComponentCreationStream.Compact();
+  m_ComponentData.Clear();
+
+  m_OwnedComponentData.Clear();
+  m_OwnedComponentData.Compact();
 
-  m_ComponentDataStream.Clear();
-  m_ComponentDataStream.Compact();
+  // the context may reference the strings in place
+  m_pStringDedupReadContext = nullptr;
 }
 
 ezUInt64 ezWorldReader::GetHeapMemoryUsage() const
 {
-  return m_IndexToGameObjectHandle.GetHeapMemoryUsage() + m_RootObjectsToCreate.GetHeapMemoryUsage() + m_ChildObjectsToCreate.GetHeapMemoryUsage() + m_ComponentTypes.GetHeapMemoryUsage() + m_ComponentTypeVersions.GetHeapMemoryUsage() + m_ComponentCreationStream.GetHeapMemoryUsage() +
-         m_ComponentDataStream.GetHeapMemoryUsage();
+  return m_IndexToGameObjectHandle.GetHeapMemoryUsage() + m_RootObjectsToCreate.GetHeapMemoryUsage() + m_ChildObjectsToCreate.GetHeapMemoryUsage() + m_ComponentTypes.GetHeapMemoryUsage() + m_ComponentTypeVersions.GetHeapMemoryUsage() + m_OwnedComponentData.GetHeapMemoryUsage();
 }
 
 ezUInt32 ezWorldReader::GetRootObjectCount() const
@@ -180,6 +329,70 @@ ezTime ezWorldReader::GetMaxStepTime(InstantiationContextBase* pContext)
   return static_cast<InstantiationContext*>(pContext)->GetMaxStepTime();
 }
 
+ezResult ezWorldReader::ReadVersion()
+{
+  m_uiVersion = 0;
+  *m_pStream >> m_uiVersion;
+
+  if (m_uiVersion < 8 || m_uiVersion > 10)
+  {
+    ezLog::Error("Invalid world version (got {}).", m_uiVersion);
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezWorldReader::ReadObjectsAndComponentTypes()
+{
+  ezStreamReader& stream = *m_pStream;
+
+  if (m_uiVersion == 8)
+  {
+    // add tags from the stream
+    EZ_SUCCEED_OR_RETURN(ezTagRegistry::GetGlobalRegistry().Load(stream));
+  }
+
+  ezUInt32 uiNumRootObjects = 0;
+  stream >> uiNumRootObjects;
+
+  ezUInt32 uiNumChildObjects = 0;
+  stream >> uiNumChildObjects;
+
+  ezUInt32 uiNumComponentTypes = 0;
+  stream >> uiNumComponentTypes;
+
+  if (uiNumComponentTypes > ezMath::MaxValue<ezUInt16>())
+  {
+    ezLog::Error("World description has too many component types, got {0} - maximum allowed are {1}", uiNumComponentTypes, ezMath::MaxValue<ezUInt16>());
+    return EZ_FAILURE;
+  }
+
+  m_RootObjectsToCreate.Reserve(uiNumRootObjects);
+  m_ChildObjectsToCreate.Reserve(uiNumChildObjects);
+
+  m_IndexToGameObjectHandle.SetCountUninitialized(uiNumRootObjects + uiNumChildObjects + 1);
+
+  for (ezUInt32 i = 0; i < uiNumRootObjects; ++i)
+  {
+    ReadGameObjectDesc(m_RootObjectsToCreate.ExpandAndGetRef());
+  }
+
+  for (ezUInt32 i = 0; i < uiNumChildObjects; ++i)
+  {
+    ReadGameObjectDesc(m_ChildObjectsToCreate.ExpandAndGetRef());
+  }
+
+  m_ComponentTypes.SetCount(uiNumComponentTypes);
+  m_ComponentTypeVersions.Reserve(uiNumComponentTypes);
+  for (ezUInt32 i = 0; i < uiNumComponentTypes; ++i)
+  {
+    ReadComponentTypeInfo(i);
+  }
+
+  return EZ_SUCCESS;
+}
+
 void ezWorldReader::ReadGameObjectDesc(GameObjectToCreate& godesc)
 {
   ezGameObjectDesc& desc = godesc.m_Desc;
@@ -241,10 +454,16 @@ void ezWorldReader::ReadComponentTypeInfo(ezUInt32 uiComponentTypeIdx)
   m_ComponentTypeVersions[pRtti] = uiRttiVersion;
 }
 
-void ezWorldReader::ReadComponentDataToMemStream(bool warningOnUnknownSkip)
+void ezWorldReader::ReadComponentData(bool bWarningOnUnknownSkip, ezArrayPtr<const ezUInt8> inPlaceData)
 {
-  auto WriteToMemStream = [&](ezMemoryStreamWriter& ref_writer, bool bReadNumComponents) {
-    ezUInt8 Temp[4096];
+  // When reading in place, m_pStream reads from inPlaceData and the data blocks of each type only need to be located.
+  // Otherwise the blocks are copied into one contiguous buffer.
+  const bool bInPlace = !inPlaceData.IsEmpty();
+  const ezRawMemoryStreamReader* pInPlaceStream = bInPlace ? static_cast<const ezRawMemoryStreamReader*>(m_pStream) : nullptr;
+
+  m_OwnedComponentData.Clear();
+
+  auto ReadDataBlocks = [&](bool bReadNumComponents) {
     for (auto& compTypeInfo : m_ComponentTypes)
     {
       ezUInt32 uiAllComponentsSize = 0;
@@ -252,44 +471,44 @@ void ezWorldReader::ReadComponentDataToMemStream(bool warningOnUnknownSkip)
 
       if (compTypeInfo.m_pRtti == nullptr)
       {
-        if (warningOnUnknownSkip)
+        if (bWarningOnUnknownSkip)
         {
           ezLog::Warning("Skipping components of unknown type");
         }
 
         m_pStream->SkipBytes(uiAllComponentsSize);
+        continue;
       }
-      else
-      {
-        if (bReadNumComponents)
-        {
-          *m_pStream >> compTypeInfo.m_uiNumComponents;
-          uiAllComponentsSize -= sizeof(ezUInt32);
 
-          m_uiTotalNumComponents += compTypeInfo.m_uiNumComponents;
-        }
+      if (bReadNumComponents)
+      {
+        *m_pStream >> compTypeInfo.m_uiNumComponents;
+        uiAllComponentsSize -= sizeof(ezUInt32);
 
-        while (uiAllComponentsSize > 0)
-        {
-          const ezUInt64 uiRead = m_pStream->ReadBytes(Temp, ezMath::Min<ezUInt32>(uiAllComponentsSize, EZ_ARRAY_SIZE(Temp)));
+        m_uiTotalNumComponents += compTypeInfo.m_uiNumComponents;
+      }
 
-          ref_writer.WriteBytes(Temp, uiRead).IgnoreResult();
+      DataRange& range = bReadNumComponents ? compTypeInfo.m_CreationData : compTypeInfo.m_SerializationData;
+      range.m_uiSize = uiAllComponentsSize;
 
-          uiAllComponentsSize -= (ezUInt32)uiRead;
-        }
+      if (bInPlace)
+      {
+        range.m_uiOffset = static_cast<ezUInt32>(pInPlaceStream->GetReadPosition());
+        m_pStream->SkipBytes(uiAllComponentsSize);
+      }
+      else
+      {
+        range.m_uiOffset = m_OwnedComponentData.GetCount();
+        m_OwnedComponentData.SetCountUninitialized(range.m_uiOffset + uiAllComponentsSize);
+        m_pStream->ReadBytes(m_OwnedComponentData.GetData() + range.m_uiOffset, uiAllComponentsSize);
       }
     }
   };
 
-  {
-    ezMemoryStreamWriter writer(&m_ComponentCreationStream);
-    WriteToMemStream(writer, true);
-  }
+  ReadDataBlocks(true);
+  ReadDataBlocks(false);
 
-  {
-    ezMemoryStreamWriter writer(&m_ComponentDataStream);
-    WriteToMemStream(writer, false);
-  }
+  m_ComponentData = bInPlace ? inPlaceData : ezArrayPtr<const ezUInt8>(m_OwnedComponentData.GetArrayPtr());
 }
 
 void ezWorldReader::ClearHandles()
@@ -323,6 +542,139 @@ ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::Instantiate(
   return std::move(pContext);
 }
 
+void ezWorldReader::ReadComponentsToCreate(ezDynamicArray<ComponentToCreate>& out_componentsToCreate)
+{
+  out_componentsToCreate.Reserve(static_cast<ezUInt32>(m_uiTotalNumComponents));
+
+  ezRawMemoryStreamReader s;
+
+  for (auto& compTypeInfo : m_ComponentTypes)
+  {
+    // will be the case for all abstract component types
+    if (compTypeInfo.m_pRtti == nullptr || compTypeInfo.m_uiNumComponents == 0)
+      continue;
+
+    const ezArrayPtr<const ezUInt8> creationData = GetComponentData(compTypeInfo.m_CreationData);
+    s.Reset(creationData.GetPtr(), creationData.GetCount());
+
+    for (ezUInt32 i = 0; i < compTypeInfo.m_uiNumComponents; ++i)
+    {
+      auto& componentToCreate = out_componentsToCreate.ExpandAndGetRef();
+
+      s >> componentToCreate.m_uiOwnerIdx;
+
+      ezUInt32 uiComponentIdx = 0;
+      s >> uiComponentIdx;
+      EZ_ASSERT_DEBUG(uiComponentIdx == i + 1, "Component index doesn't match");
+
+      s >> componentToCreate.m_bActive;
+      s >> componentToCreate.m_uiUserFlags;
+    }
+  }
+}
+
+void ezWorldReader::CreateComponents(ezUInt32 uiNumInstances, ezArrayPtr<const ComponentToCreate> componentsToCreate, ezDynamicArray<ezComponent*>& out_components)
+{
+  EZ_PROFILE_SCOPE("ezWorldReader::CreateComponents");
+
+  const ezUInt32 uiNumHandlesPerInstance = m_RootObjectsToCreate.GetCount() + m_ChildObjectsToCreate.GetCount() + 1;
+
+  out_components.Reserve(uiNumInstances * componentsToCreate.GetCount());
+
+  for (auto& compTypeInfo : m_ComponentTypes)
+  {
+    compTypeInfo.m_ComponentIndexToHandle.Clear();
+
+    if (compTypeInfo.m_pRtti == nullptr || compTypeInfo.m_uiNumComponents == 0)
+    {
+      compTypeInfo.m_ComponentIndexToHandle.PushBack(ezComponentHandle());
+      continue;
+    }
+
+    ezComponentManagerBase* pManager = m_pWorld->GetOrCreateManagerForComponentType(compTypeInfo.m_pRtti);
+    EZ_ASSERT_DEV(pManager != nullptr, "Cannot create components of type '{0}', manager is not available.", compTypeInfo.m_pRtti->GetTypeName());
+
+    pManager->ReserveComponents(uiNumInstances * compTypeInfo.m_uiNumComponents);
+    compTypeInfo.m_ComponentIndexToHandle.Reserve(uiNumInstances * (compTypeInfo.m_uiNumComponents + 1));
+
+    auto typeComponentsToCreate = componentsToCreate.GetSubArray(0, compTypeInfo.m_uiNumComponents);
+    componentsToCreate = componentsToCreate.GetSubArray(compTypeInfo.m_uiNumComponents);
+
+    for (ezUInt32 uiInstance = 0; uiInstance < uiNumInstances; ++uiInstance)
+    {
+      compTypeInfo.m_ComponentIndexToHandle.PushBack(ezComponentHandle());
+
+      for (const ComponentToCreate& componentToCreate : typeComponentsToCreate)
+      {
+        const ezGameObjectHandle hOwner = m_IndexToGameObjectHandle[uiInstance * uiNumHandlesPerInstance + componentToCreate.m_uiOwnerIdx];
+
+        ezGameObject* pOwnerObject = nullptr;
+        if (!m_pWorld->TryGetObject(hOwner, pOwnerObject))
+        {
+          EZ_REPORT_FAILURE("Owner object must be not null");
+        }
+
+        ezComponent* pComponent = nullptr;
+        auto hComponent = pManager->CreateComponentNoInit(pOwnerObject, pComponent);
+
+        pComponent->SetActiveFlag(componentToCreate.m_bActive);
+
+        for (ezUInt8 j = 0; j < 8; ++j)
+        {
+          pComponent->SetUserFlag(j, (componentToCreate.m_uiUserFlags & EZ_BIT(j)) != 0);
+        }
+
+        compTypeInfo.m_ComponentIndexToHandle.PushBack(hComponent);
+        out_components.PushBack(pComponent);
+      }
+    }
+  }
+}
+
+void ezWorldReader::DeserializeComponents(ezUInt32 uiFirstInstance, ezUInt32 uiNumInstances, ezArrayPtr<ezComponent* const> components)
+{
+  EZ_PROFILE_SCOPE("ezWorldReader::DeserializeComponents");
+
+  // each thread reads through its own reader, the handles and type information are taken from this one
+  ezRawMemoryStreamReader stream;
+
+  ezWorldReader instanceReader;
+  instanceReader.m_pStream = &stream;
+  instanceReader.m_pWorld = m_pWorld;
+  instanceReader.m_pSharedReader = this;
+
+  m_pStringDedupReadContext->SetActive(true);
+  EZ_SCOPE_EXIT(m_pStringDedupReadContext->SetActive(false));
+
+  const ezUInt32 uiTotalNumInstances = components.GetCount() / static_cast<ezUInt32>(m_uiTotalNumComponents);
+
+  for (ezUInt32 uiInstance = uiFirstInstance; uiInstance < uiFirstInstance + uiNumInstances; ++uiInstance)
+  {
+    instanceReader.m_uiInstanceIndex = uiInstance;
+
+    ezUInt32 uiFirstComponentOfType = 0;
+
+    for (auto& compTypeInfo : m_ComponentTypes)
+    {
+      if (compTypeInfo.m_pRtti == nullptr || compTypeInfo.m_uiNumComponents == 0)
+        continue;
+
+      const ezArrayPtr<const ezUInt8> serializationData = GetComponentData(compTypeInfo.m_SerializationData);
+      stream.Reset(serializationData.GetPtr(), serializationData.GetCount());
+
+      for (ezComponent* pComponent : components.GetSubArray(uiFirstComponentOfType + uiInstance * compTypeInfo.m_uiNumComponents, compTypeInfo.m_uiNumComponents))
+      {
+        if (pComponent != nullptr)
+        {
+          pComponent->DeserializeComponent(instanceReader);
+        }
+      }
+
+      uiFirstComponentOfType += compTypeInfo.m_uiNumComponents * uiTotalNumInstances;
+    }
+  }
+}
+
 ezWorldReader::InstantiationContext::InstantiationContext(ezWorldReader& ref_worldReader, bool bUseTransform, const ezTransform& rootTransform, const ezPrefabInstantiationOptions& options)
   : m_WorldReader(ref_worldReader)
   , m_bUseTransform(bUseTransform)
@@ -418,14 +770,13 @@ ezWorldReader::InstantiationContext::StepResult ezWorldReader::InstantiationCont
     if (!CreateGameObjects<false>(m_WorldReader.m_ChildObjectsToCreate, ezGameObjectHandle(), m_Options.m_pCreatedChildObjectsOut, endTime))
       return StepResult::Continue;
 
-    m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentCreationStream);
     m_Phase = Phase::CreateComponents;
     BeginNextProgressStep("CreateComponents");
   }
 
   if (m_Phase == Phase::CreateComponents)
   {
-    if (m_WorldReader.m_ComponentCreationStream.GetStorageSize64() > 0)
+    if (m_WorldReader.m_uiTotalNumComponents > 0)
     {
       m_WorldReader.m_pStringDedupReadContext->SetActive(true);
 
@@ -438,14 +789,13 @@ ezWorldReader::InstantiationContext::StepResult ezWorldReader::InstantiationCont
         return StepResult::Continue;
     }
 
-    m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentDataStream);
     m_Phase = Phase::DeserializeComponents;
     BeginNextProgressStep("DeserializeComponents");
   }
 
   if (m_Phase == Phase::DeserializeComponents)
   {
-    if (m_WorldReader.m_ComponentDataStream.GetStorageSize64() > 0)
+    if (m_WorldReader.m_uiTotalNumComponents > 0)
     {
       m_WorldReader.m_pStringDedupReadContext->SetActive(true);
 
@@ -458,7 +808,7 @@ ezWorldReader::InstantiationContext::StepResult ezWorldReader::InstantiationCont
         return StepResult::Continue;
     }
 
-    m_CurrentReader.SetStorage(nullptr);
+    m_CurrentReader.Reset(nullptr, 0);
     m_Phase = Phase::AddComponentsToBatch;
     BeginNextProgressStep("AddComponentsToBatch");
   }
@@ -504,13 +854,6 @@ void ezWorldReader::InstantiationContext::Cancel()
   m_pOverallProgressRange = nullptr;
 }
 
-// a super simple, but also efficient random number generator
-inline static ezUInt32 NextStableRandomSeed(ezUInt32& ref_uiSeed)
-{
-  ref_uiSeed = 214013L * ref_uiSeed + 2531011L;
-  return ((ref_uiSeed >> 16) & 0x7FFFF);
-}
-
 template <bool UseTransform>
 bool ezWorldReader::InstantiationContext::CreateGameObjects(const ezDynamicArray<GameObjectToCreate>& objects, ezGameObjectHandle hParent, ezDynamicArray<ezGameObject*>* out_pCreatedObjects, ezTime endTime)
 {
@@ -522,42 +865,11 @@ bool ezWorldReader::InstantiationContext::CreateGameObjects(const ezDynamicArray
 
     ezGameObjectDesc desc = godesc.m_Desc; // make a copy
     desc.m_hParent = hParent.IsInvalidated() ? m_WorldReader.m_IndexToGameObjectHandle[godesc.m_uiParentHandleIdx] : hParent;
-    desc.m_bDynamic |= m_Options.m_bForceDynamic;
-
-    switch (m_Options.m_RandomSeedMode)
-    {
-      case ezPrefabInstantiationOptions::RandomSeedMode::DeterministicFromParent:
-        desc.m_uiStableRandomSeed = 0xFFFFFFFF; // ezWorld::CreateObject() will either derive a deterministic value from the parent object, or assign a random value, if no parent exists
-        break;
-
-      case ezPrefabInstantiationOptions::RandomSeedMode::CompletelyRandom:
-        desc.m_uiStableRandomSeed = 0; // ezWorld::CreateObject() will assign a random value to this object
-        break;
-
-      case ezPrefabInstantiationOptions::RandomSeedMode::FixedFromSerialization:
-        // keep deserialized value
-        break;
-
-      case ezPrefabInstantiationOptions::RandomSeedMode::CustomRootValue:
-        // we use the given seed root value to assign a deterministic (but different) value to each game object
-        desc.m_uiStableRandomSeed = NextStableRandomSeed(m_Options.m_uiCustomRandomSeedRootValue);
-        break;
-    }
-
-    if (m_Options.m_pOverrideTeamID != nullptr)
-    {
-      desc.m_uiTeamID = *m_Options.m_pOverrideTeamID;
-    }
+    ApplyInstantiationOptions(desc, m_Options, m_Options.m_uiCustomRandomSeedRootValue);
 
     if (UseTransform)
     {
-      ezTransform tChild(desc.m_LocalPosition, desc.m_LocalRotation, desc.m_LocalScaling);
-      ezTransform tFinal;
-      tFinal = ezTransform::MakeGlobalTransform(m_RootTransform, tChild);
-
-      desc.m_LocalPosition = tFinal.m_vPosition;
-      desc.m_LocalRotation = tFinal.m_qRotation;
-      desc.m_LocalScaling = tFinal.m_vScale;
+      ApplyRootTransform(desc, m_RootTransform);
     }
 
     ezGameObject* pObject = nullptr;
@@ -605,6 +917,12 @@ bool ezWorldReader::InstantiationContext::CreateComponents(ezTime endTime)
     ezComponentManagerBase* pManager = m_WorldReader.m_pWorld->GetOrCreateManagerForComponentType(compTypeInfo.m_pRtti);
     EZ_ASSERT_DEV(pManager != nullptr, "Cannot create components of type '{0}', manager is not available.", compTypeInfo.m_pRtti->GetTypeName());
 
+    if (m_uiCurrentIndex == 0)
+    {
+      const ezArrayPtr<const ezUInt8> creationData = m_WorldReader.GetComponentData(compTypeInfo.m_CreationData);
+      m_CurrentReader.Reset(creationData.GetPtr(), creationData.GetCount());
+    }
+
     while (m_uiCurrentIndex < compTypeInfo.m_uiNumComponents)
     {
       const ezGameObjectHandle hOwner = m_WorldReader.ReadGameObjectHandle();
@@ -670,6 +988,12 @@ bool ezWorldReader::InstantiationContext::DeserializeComponents(ezTime endTime)
     if (compTypeInfo.m_pRtti == nullptr)
       continue;
 
+    if (m_uiCurrentIndex == 0)
+    {
+      const ezArrayPtr<const ezUInt8> serializationData = m_WorldReader.GetComponentData(compTypeInfo.m_SerializationData);
+      m_CurrentReader.Reset(serializationData.GetPtr(), serializationData.GetCount());
+    }
+
     while (m_uiCurrentIndex < compTypeInfo.m_ComponentIndexToHandle.GetCount())
     {
       ezComponent* pComponent = nullptr;
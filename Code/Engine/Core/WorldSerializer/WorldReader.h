@@ -37,6 +37,12 @@ struct ezPrefabInstantiationOptions
   ezTime m_MaxStepTime = ezTime::MakeZero();
 
   ezProgress* m_pProgress = nullptr;
+
+  /// \brief Only used by ezWorldReader::InstantiatePrefabs(). If set, the components of the different instances are deserialized on multiple threads.
+  ///
+  /// Only enable this, if the DeserializeComponent() functions of all component types in the prefab just read their data.
+  /// Registering the component anywhere or modifying the world is not allowed during deserialization then.
+  bool m_bDeserializeComponentsInParallel = false;
 };
 
 /// \brief Reads a world description from a stream. Allows to instantiate that world multiple times
@@ -84,6 +90,14 @@ public:
   /// types. The warnings can be suppressed by setting warningOnUnkownSkip to false.
   ezResult ReadWorldDescription(ezStreamReader& inout_stream, bool bWarningOnUnkownSkip = true);
 
+  /// \brief Reads all information about the world directly from memory, e.g. from an ezMemoryMappedFile.
+  ///
+  /// In contrast to the stream version, the component data and the deduplicated strings are not copied into internal buffers,
+  /// but accessed in place during instantiation. This reduces both the load time and the peak memory usage for large worlds.
+  /// Therefore \a data must stay valid and unchanged until ClearAndCompact() is called, another world description is read
+  /// or the reader is destroyed.
+  ezResult ReadWorldDescription(ezArrayPtr<const ezUInt8> data, bool bWarningOnUnkownSkip = true);
+
   /// \brief Creates one instance of the world that was previously read by ReadWorldDescription().
   ///
   /// This is identical to calling InstantiatePrefab() with identity values, however, it is a bit
@@ -117,6 +131,17 @@ public:
   /// has to be valid as long as the instantiation is in progress.
   ezUniquePtr<InstantiationContextBase> InstantiatePrefab(ezWorld& ref_world, const ezTransform& rootTransform, const ezPrefabInstantiationOptions& options);
 
+  /// \brief Creates one instance of the world that was previously read by ReadWorldDescription() for every given root transform.
+  ///
+  /// This is much more efficient than calling InstantiatePrefab() in a loop, e.g. when spawning many projectiles or a crowd:
+  /// The storage for all game objects and components is reserved once, the component creation data is only decoded once
+  /// and the components of all instances are added to the component init batch in one go.
+  /// If options.m_bDeserializeComponentsInParallel is set, the components of the different instances are deserialized on multiple threads.
+  ///
+  /// The created objects are appended to the output arrays of the options, one instance after the other.
+  /// The instantiation is always finished when the function returns. m_MaxStepTime, m_pProgress and m_ReplaceNamedRootWithParent are not supported.
+  void InstantiatePrefabs(ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, const ezPrefabInstantiationOptions& options);
+
   /// \brief Gives access to the stream of data. Use this inside component deserialization functions to read data.
   ezStreamReader& GetStream() const { return *m_pStream; }
 
@@ -163,34 +188,71 @@ private:
     ezUInt32 m_uiParentHandleIdx;
   };
 
+  ezResult ReadVersion();
+  ezResult ReadObjectsAndComponentTypes();
   void ReadGameObjectDesc(GameObjectToCreate& godesc);
   void ReadComponentTypeInfo(ezUInt32 uiComponentTypeIdx);
-  void ReadComponentDataToMemStream(bool warningOnUnknownSkip = true);
+  void ReadComponentData(bool bWarningOnUnknownSkip, ezArrayPtr<const ezUInt8> inPlaceData);
   void ClearHandles();
   ezUniquePtr<InstantiationContextBase> Instantiate(ezWorld& world, bool bUseTransform, const ezTransform& rootTransform, const ezPrefabInstantiationOptions& options);
 
+  struct ComponentToCreate
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiOwnerIdx;
+    bool m_bActive;
+    ezUInt8 m_uiUserFlags;
+  };
+
+  void ReadComponentsToCreate(ezDynamicArray<ComponentToCreate>& out_componentsToCreate);
+  void CreateComponents(ezUInt32 uiNumInstances, ezArrayPtr<const ComponentToCreate> componentsToCreate, ezDynamicArray<ezComponent*>& out_components);
+  void DeserializeComponents(ezUInt32 uiFirstInstance, ezUInt32 uiNumInstances, ezArrayPtr<ezComponent* const> components);
+
+  /// \brief Returns the reader that owns the handles and type information, which is not this one while deserializing a bulk instantiation in parallel.
+  const ezWorldReader& GetSharedReader() const { return m_pSharedReader != nullptr ? *m_pSharedReader : *this; }
+
   ezStreamReader* m_pStream = nullptr;
   ezWorld* m_pWorld = nullptr;
 
+  // The handle tables store the handles of all instances of a bulk instantiation one after the other.
+  // Component deserialization reads the handles of the instance with this index.
+  ezUInt32 m_uiInstanceIndex = 0;
+  const ezWorldReader* m_pSharedReader = nullptr;
+
   ezUInt8 m_uiVersion = 0;
   ezDynamicArray<ezGameObjectHandle> m_IndexToGameObjectHandle;
 
   ezDynamicArray<GameObjectToCreate> m_RootObjectsToCreate;
   ezDynamicArray<GameObjectToCreate> m_ChildObjectsToCreate;
 
+  struct DataRange
+  {
+    ezUInt32 m_uiOffset = 0;
+    ezUInt32 m_uiSize = 0;
+  };
+
   struct ComponentTypeInfo
   {
     const ezRTTI* m_pRtti = nullptr;
     ezDynamicArray<ezComponentHandle> m_ComponentIndexToHandle;
     ezUInt32 m_uiNumComponents = 0;
+
+    // where the creation and the serialized data of all components of this type are located in m_ComponentData
+    DataRange m_CreationData;
+    DataRange m_SerializationData;
   };
 
+  ezArrayPtr<const ezUInt8> GetComponentData(DataRange range) const { return m_ComponentData.GetSubArray(range.m_uiOffset, range.m_uiSize); }
+
   ezDynamicArray<ComponentTypeInfo> m_ComponentTypes;
   ezHashTable<const ezRTTI*, ezUInt32> m_ComponentTypeVersions;
-  ezDefaultMemoryStreamStorage m_ComponentCreationStream;
-  ezDefaultMemoryStreamStorage m_ComponentDataStream;
   ezUInt64 m_uiTotalNumComponents = 0;
 
+  // Either points into the memory that was passed to ReadWorldDescription() or to m_OwnedComponentData, if the data was read from a stream.
+  ezArrayPtr<const ezUInt8> m_ComponentData;
+  ezDynamicArray<ezUInt8> m_OwnedComponentData;
+
   ezUniquePtr<ezStringDeduplicationReadContext> m_pStringDedupReadContext;
 
   class InstantiationContext : public InstantiationContextBase
@@ -247,7 +309,7 @@ private:
     ezUInt32 m_uiCurrentIndex = 0; // object or component
     ezUInt32 m_uiCurrentComponentTypeIndex = 0;
     ezUInt64 m_uiCurrentNumComponentsProcessed = 0;
-    ezMemoryStreamReader m_CurrentReader;
+    ezRawMemoryStreamReader m_CurrentReader;
 
     ezUniquePtr<ezProgressRange> m_pOverallProgressRange;
     ezUniquePtr<ezProgressRange> m_pSubProgressRange;
@@ -35,6 +35,69 @@ void ezSorting::InsertionSort(ezArrayPtr<T>& inout_arrayPtr, const Comparer& com
   InsertionSort(inout_arrayPtr, 0, inout_arrayPtr.GetCount() - 1, comparer);
 }
 
+template <typename T, typename KeyGetter>
+void ezSorting::RadixSort(ezArrayPtr<T> inout_arrayPtr, ezArrayPtr<T> inout_scratch, const KeyGetter& getKey)
+{
+  using KeyType = std::decay_t<decltype(getKey(inout_arrayPtr[0]))>;
+  static_assert(std::is_unsigned<KeyType>::value, "The radix sort key has to be an unsigned integer type");
+
+  constexpr ezUInt32 uiNumDigits = sizeof(KeyType);
+
+  const ezUInt32 uiCount = inout_arrayPtr.GetCount();
+  if (uiCount <= 1)
+    return;
+
+  EZ_ASSERT_DEV(inout_scratch.GetCount() >= uiCount, "Scratch array is too small, {} elements are required but only {} given", uiCount, inout_scratch.GetCount());
+
+  // histograms of all digits in one pass
+  ezUInt32 histograms[uiNumDigits][256] = {};
+  for (ezUInt32 i = 0; i < uiCount; ++i)
+  {
+    const KeyType key = getKey(inout_arrayPtr[i]);
+    for (ezUInt32 d = 0; d < uiNumDigits; ++d)
+    {
+      ++histograms[d][(key >> (d * 8)) & 0xFF];
+    }
+  }
+
+  T* pSource = inout_arrayPtr.GetPtr();
+  T* pTarget = inout_scratch.GetPtr();
+
+  for (ezUInt32 d = 0; d < uiNumDigits; ++d)
+  {
+    ezUInt32* pOffsets = histograms[d];
+    const ezUInt32 uiShift = d * 8;
+
+    // all keys have the same digit, the order would not change
+    if (pOffsets[(getKey(pSource[0]) >> uiShift) & 0xFF] == uiCount)
+      continue;
+
+    ezUInt32 uiOffset = 0;
+    for (ezUInt32 b = 0; b < 256; ++b)
+    {
+      const ezUInt32 uiBucketSize = pOffsets[b];
+      pOffsets[b] = uiOffset;
+      uiOffset += uiBucketSize;
+    }
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      const ezUInt32 uiDigit = (getKey(pSource[i]) >> uiShift) & 0xFF;
+      pTarget[pOffsets[uiDigit]++] = std::move(pSource[i]);
+    }
+
+    std::swap(pSource, pTarget);
+  }
+
+  if (pSource != inout_arrayPtr.GetPtr())
+  {
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      inout_arrayPtr[i] = std::move(pSource[i]);
+    }
+  }
+}
+
 template <typename Container, typename Comparer>
 void ezSorting::QuickSort(Container& inout_container, ezUInt32 uiStartIndex, ezUInt32 uiEndIndex, const Comparer& in_comparer)
 {
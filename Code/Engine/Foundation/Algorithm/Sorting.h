@@ -27,6 +27,14 @@ public:
   template <typename T, typename Comparer>
   static void InsertionSort(ezArrayPtr<T>& inout_arrayPtr, const Comparer& comparer = Comparer()); // [tested]
 
+  /// \brief Sorts the elements in the array by an unsigned integer key using a LSD radix sort (stable, not in-place).
+  ///
+  /// getKey(element) has to return an unsigned integer type. The scratch array has to be at least as large as the array to sort,
+  /// its content is undefined afterwards. Bytes that are equal in all keys are skipped, so small key ranges only need few passes.
+  /// To sort by multiple keys, sort by the least significant key first, since the sort is stable.
+  template <typename T, typename KeyGetter>
+  static void RadixSort(ezArrayPtr<T> inout_arrayPtr, ezArrayPtr<T> inout_scratch, const KeyGetter& getKey); // [tested]
+
 private:
   enum
   {
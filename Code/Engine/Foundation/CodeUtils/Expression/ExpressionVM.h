@@ -3,6 +3,8 @@
 #include <Foundation/CodeUtils/Expression/ExpressionByteCode.h>
 #include <Foundation/Types/UniquePtr.h>
 
+class ezExpressionJITProgram;
+
 class EZ_FOUNDATION_DLL ezExpressionVM
 {
 public:
@@ -14,9 +16,40 @@ public:
 
   ezResult Execute(const ezExpressionByteCode& byteCode, ezArrayPtr<const ezProcessingStream> inputs, ezArrayPtr<ezProcessingStream> outputs, ezUInt32 uiNumInstances, const ezExpression::GlobalData& globalData = ezExpression::GlobalData());
 
+  /// \brief Returns whether the CPU supports the 8-wide AVX2 code path. Always false on platforms other than x86-64.
+  static bool IsAVX2Supported();
+
+  /// \brief Allows or disallows the 8-wide AVX2 code path. It is allowed by default but only used if IsAVX2Supported() returns true.
+  ///
+  /// The results are identical to the 4-wide code path, so this is mainly useful for testing and profiling.
+  void SetAllowAVX2(bool bAllow) { m_bAllowAVX2 = bAllow; }
+  bool GetAllowAVX2() const { return m_bAllowAVX2; }
+
+  /// \brief Returns whether Execute() uses the 8-wide AVX2 code path.
+  bool IsUsingAVX2() const { return m_bAllowAVX2 && IsAVX2Supported(); }
+
+  /// \brief Returns whether byte code can be compiled to native code on this platform. Only Linux x86-64 is supported so far.
+  static bool IsJITSupported();
+
+  /// \brief Allows or disallows compiling byte code to native code. It is disallowed by default.
+  ///
+  /// Native code is generated the first time a byte code is executed with a specific stream layout and then cached in the VM.
+  /// Byte code that can't be compiled, e.g. because it calls functions, is executed by the interpreter as usual.
+  /// The results are identical to the interpreter.
+  void SetAllowJIT(bool bAllow);
+  bool GetAllowJIT() const { return m_bAllowJIT; }
+
+  /// \brief Returns whether the last call to Execute() ran native code.
+  bool GetLastExecutionUsedJIT() const { return m_bLastExecutionUsedJIT; }
+
 private:
   void RegisterDefaultFunctions();
 
+  ezResult ExecuteInterpreter(const ezExpressionByteCode& byteCode, ezUInt32 uiNumInstances, const ezExpression::GlobalData& globalData);
+
+  ezExpressionJITProgram* GetOrCompileJITProgram(const ezExpressionByteCode& byteCode);
+  static void OffsetStreams(ezArrayPtr<ezProcessingStream*> streams, ezUInt32 uiNumInstances);
+
   static ezResult ScalarizeStreams(ezArrayPtr<const ezProcessingStream> streams, ezDynamicArray<ezProcessingStream>& out_ScalarizedStreams);
   static ezResult MapStreams(ezArrayPtr<const ezExpression::StreamDesc> streamDescs, ezArrayPtr<ezProcessingStream> streams, ezStringView sStreamType, ezUInt32 uiNumInstances, ezDynamicArray<ezProcessingStream*>& out_MappedStreams);
   ezResult MapFunctions(ezArrayPtr<const ezExpression::FunctionDesc> functionDescs, const ezExpression::GlobalData& globalData);
@@ -32,4 +65,12 @@ private:
 
   ezDynamicArray<ezExpressionFunction> m_Functions;
   ezHashTable<ezHashedString, ezUInt32> m_FunctionNamesToIndex;
+
+  bool m_bAllowAVX2 = true;
+
+  bool m_bAllowJIT = false;
+  bool m_bLastExecutionUsedJIT = false;
+
+  /// Compiled programs by ezExpressionJITProgram::ComputeProgramKey(). Byte code that failed to compile is stored as nullptr.
+  ezHashTable<ezUInt64, ezUniquePtr<ezExpressionJITProgram>> m_JITPrograms;
 };
@@ -0,0 +1,674 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/CodeUtils/Expression/Implementation/ExpressionJIT.h>
+
+#if EZ_ENABLED(EZ_EXPRESSION_JIT)
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+namespace
+{
+  // Layout of the context that is passed to the generated code (in rdi), one 64 bit value each.
+  enum ContextSlot
+  {
+    SpilledRegisters,
+    Constants,
+    NumIterations,
+    FirstStream, // all input streams followed by all output streams, points to the data of the current iteration
+  };
+
+#if EZ_ENABLED(EZ_EXPRESSION_JIT)
+
+  using OpCode = ezExpressionByteCode::OpCode;
+  using ByteCodeType = ezExpressionByteCode::StorageType;
+
+  enum Gpr : ezUInt8
+  {
+    RAX = 0,
+    RCX = 1,
+    RDX = 2, // constants
+    RSI = 6, // spilled registers
+    RDI = 7, // context
+  };
+
+  // xmm0 is the implicit mask operand of blendvps, temp registers are mapped to xmm1 - xmm11 and spilled to memory after that.
+  constexpr ezUInt8 s_uiFirstRegisterXmm = 1;
+  constexpr ezUInt32 s_uiNumRegistersInXmm = 11;
+  constexpr ezUInt8 s_uiScratchXmm = 12;
+
+  struct Operand
+  {
+    static Operand Xmm(ezUInt8 uiXmm) { return {false, uiXmm, 0}; }
+    static Operand Mem(Gpr base, ezInt32 iDisplacement) { return {true, base, iDisplacement}; }
+
+    bool m_bMemory;
+    ezUInt8 m_uiRegister; // xmm register or base register of a memory operand
+    ezInt32 m_iDisplacement;
+  };
+
+  // Describes an SSE instruction as [prefix] 0F [escape] opcode
+  struct SSEOp
+  {
+    ezUInt8 m_uiPrefix = 0;
+    ezUInt8 m_uiEscape = 0;
+    ezUInt8 m_uiOpCode = 0;
+    ezInt32 m_iImm8 = -1;
+  };
+
+  // clang-format off
+  constexpr SSEOp MOVUPS_LOAD = {0x00, 0x00, 0x10};
+  constexpr SSEOp MOVUPS_STORE = {0x00, 0x00, 0x11};
+  constexpr SSEOp MOVAPS_LOAD = {0x00, 0x00, 0x28};
+  constexpr SSEOp MOVAPS_STORE = {0x00, 0x00, 0x29};
+  constexpr SSEOp SQRTPS = {0x00, 0x00, 0x51};
+  constexpr SSEOp ANDPS = {0x00, 0x00, 0x54};
+  constexpr SSEOp ANDNPS = {0x00, 0x00, 0x55};
+  constexpr SSEOp ORPS = {0x00, 0x00, 0x56};
+  constexpr SSEOp XORPS = {0x00, 0x00, 0x57};
+  constexpr SSEOp ADDPS = {0x00, 0x00, 0x58};
+  constexpr SSEOp MULPS = {0x00, 0x00, 0x59};
+  constexpr SSEOp CVTDQ2PS = {0x00, 0x00, 0x5B};
+  constexpr SSEOp CVTTPS2DQ = {0xF3, 0x00, 0x5B};
+  constexpr SSEOp SUBPS = {0x00, 0x00, 0x5C};
+  constexpr SSEOp MINPS = {0x00, 0x00, 0x5D};
+  constexpr SSEOp DIVPS = {0x00, 0x00, 0x5E};
+  constexpr SSEOp MAXPS = {0x00, 0x00, 0x5F};
+  constexpr SSEOp CMPPS = {0x00, 0x00, 0xC2};
+  constexpr SSEOp MOVD_LOAD = {0x66, 0x00, 0x6E};
+  constexpr SSEOp MOVD_STORE = {0x66, 0x00, 0x7E};
+  constexpr SSEOp PCMPGTD = {0x66, 0x00, 0x66};
+  constexpr SSEOp PSHIFTD_IMM = {0x66, 0x00, 0x72};
+  constexpr SSEOp PCMPEQD = {0x66, 0x00, 0x76};
+  constexpr SSEOp PAND = {0x66, 0x00, 0xDB};
+  constexpr SSEOp POR = {0x66, 0x00, 0xEB};
+  constexpr SSEOp PXOR = {0x66, 0x00, 0xEF};
+  constexpr SSEOp PSUBD = {0x66, 0x00, 0xFA};
+  constexpr SSEOp PADDD = {0x66, 0x00, 0xFE};
+  constexpr SSEOp BLENDVPS = {0x66, 0x38, 0x14};
+  constexpr SSEOp PABSD = {0x66, 0x38, 0x1E};
+  constexpr SSEOp PMINSD = {0x66, 0x38, 0x39};
+  constexpr SSEOp PMAXSD = {0x66, 0x38, 0x3D};
+  constexpr SSEOp PMULLD = {0x66, 0x38, 0x40};
+  constexpr SSEOp ROUNDPS = {0x66, 0x3A, 0x08};
+  constexpr SSEOp PEXTRD = {0x66, 0x3A, 0x16};
+  constexpr SSEOp PINSRD = {0x66, 0x3A, 0x22};
+  // clang-format on
+
+  // cmpps predicates, the same that _mm_cmpeq_ps etc. use
+  enum CmpPredicate
+  {
+    CMP_EQ = 0,
+    CMP_LT = 1,
+    CMP_LE = 2,
+    CMP_NEQ = 4,
+  };
+
+  SSEOp WithImm8(SSEOp op, ezInt32 iImm8)
+  {
+    op.m_iImm8 = iImm8;
+    return op;
+  }
+
+  class Assembler
+  {
+  public:
+    void Byte(ezUInt8 uiByte) { m_Code.PushBack(uiByte); }
+
+    void Int32(ezInt32 iValue)
+    {
+      const ezUInt32 uiValue = static_cast<ezUInt32>(iValue);
+      Byte(uiValue & 0xFF);
+      Byte((uiValue >> 8) & 0xFF);
+      Byte((uiValue >> 16) & 0xFF);
+      Byte((uiValue >> 24) & 0xFF);
+    }
+
+    void PatchInt32(ezUInt32 uiPos, ezInt32 iValue)
+    {
+      const ezUInt32 uiValue = static_cast<ezUInt32>(iValue);
+      m_Code[uiPos + 0] = uiValue & 0xFF;
+      m_Code[uiPos + 1] = (uiValue >> 8) & 0xFF;
+      m_Code[uiPos + 2] = (uiValue >> 16) & 0xFF;
+      m_Code[uiPos + 3] = (uiValue >> 24) & 0xFF;
+    }
+
+    /// uiReg is either an xmm register or the opcode extension for instructions like pslld.
+    void SSE(const SSEOp& op, ezUInt8 uiReg, const Operand& rm)
+    {
+      if (op.m_uiPrefix != 0)
+        Byte(op.m_uiPrefix);
+
+      ezUInt8 uiRex = 0x40;
+      if (uiReg >= 8)
+        uiRex |= 0x04;
+      if (!rm.m_bMemory && rm.m_uiRegister >= 8)
+        uiRex |= 0x01;
+      if (uiRex != 0x40)
+        Byte(uiRex);
+
+      Byte(0x0F);
+      if (op.m_uiEscape != 0)
+        Byte(op.m_uiEscape);
+      Byte(op.m_uiOpCode);
+
+      if (rm.m_bMemory)
+      {
+        // [base + disp32], none of the used base registers needs a SIB byte
+        Byte(0x80 | ((uiReg & 7) << 3) | rm.m_uiRegister);
+        Int32(rm.m_iDisplacement);
+      }
+      else
+      {
+        Byte(0xC0 | ((uiReg & 7) << 3) | (rm.m_uiRegister & 7));
+      }
+
+      if (op.m_iImm8 >= 0)
+        Byte(static_cast<ezUInt8>(op.m_iImm8));
+    }
+
+    /// mov reg, qword ptr [rdi + slot * 8]
+    void LoadContextValue(Gpr reg, ezUInt32 uiSlot)
+    {
+      Byte(0x48);
+      Byte(0x8B);
+      Byte(0x80 | (reg << 3) | RDI);
+      Int32(uiSlot * 8);
+    }
+
+    /// add qword ptr [rdi + slot * 8], imm32
+    void AddToContextValue(ezUInt32 uiSlot, ezInt32 iValue)
+    {
+      Byte(0x48);
+      Byte(0x81);
+      Byte(0x80 | RDI);
+      Int32(uiSlot * 8);
+      Int32(iValue);
+    }
+
+    ezDynamicArray<ezUInt8> m_Code;
+  };
+
+  class CodeGenerator
+  {
+  public:
+    CodeGenerator(ezDynamicArray<ezSimdVec4i, ezAlignedAllocatorWrapper>& ref_constants)
+      : m_Constants(ref_constants)
+    {
+    }
+
+    ezResult Generate(const ezExpressionByteCode& byteCode, ezArrayPtr<ezProcessingStream* const> inputs, ezArrayPtr<ezProcessingStream* const> outputs);
+
+    Assembler m_Asm;
+
+  private:
+    static Operand GetRegister(ezUInt32 uiIndex)
+    {
+      if (uiIndex < s_uiNumRegistersInXmm)
+        return Operand::Xmm(static_cast<ezUInt8>(s_uiFirstRegisterXmm + uiIndex));
+
+      return Operand::Mem(RSI, static_cast<ezInt32>((uiIndex - s_uiNumRegistersInXmm) * sizeof(ezSimdVec4i)));
+    }
+
+    static Operand Scratch() { return Operand::Xmm(s_uiScratchXmm); }
+
+    Operand GetConstant(ezUInt32 uiRawValue)
+    {
+      ezUInt32 uiIndex = 0;
+      if (!m_ConstantIndices.TryGetValue(uiRawValue, uiIndex))
+      {
+        uiIndex = m_Constants.GetCount();
+        m_Constants.PushBack(ezSimdVec4i(static_cast<ezInt32>(uiRawValue)));
+        m_ConstantIndices.Insert(uiRawValue, uiIndex);
+      }
+
+      return Operand::Mem(RDX, static_cast<ezInt32>(uiIndex * sizeof(ezSimdVec4i)));
+    }
+
+    void MoveToScratch(const Operand& src) { m_Asm.SSE(MOVAPS_LOAD, s_uiScratchXmm, src); }
+
+    void MoveFromScratch(const Operand& dst)
+    {
+      if (dst.m_bMemory)
+        m_Asm.SSE(MOVAPS_STORE, s_uiScratchXmm, dst);
+      else
+        m_Asm.SSE(MOVAPS_LOAD, dst.m_uiRegister, Scratch());
+    }
+
+    void Invert() { m_Asm.SSE(XORPS, s_uiScratchXmm, GetConstant(0xFFFFFFFF)); }
+
+    ezResult GenerateUnary(OpCode::Enum opCode, const Operand& r, const Operand& a);
+    ezResult GenerateBinary(OpCode::Enum opCode, const Operand& r, const Operand& a, const Operand& b);
+    ezResult GenerateLoad(const Operand& r, const ezProcessingStream& input, ezProcessingStream::DataType expectedType, ezUInt32 uiSlot);
+    ezResult GenerateStore(const Operand& a, const ezProcessingStream& output, ezProcessingStream::DataType expectedType, ezUInt32 uiSlot);
+
+    ezDynamicArray<ezSimdVec4i, ezAlignedAllocatorWrapper>& m_Constants;
+    ezHashTable<ezUInt32, ezUInt32> m_ConstantIndices;
+  };
+
+  ezResult CodeGenerator::GenerateUnary(OpCode::Enum opCode, const Operand& r, const Operand& a)
+  {
+    switch (opCode)
+    {
+      case OpCode::AbsF_R:
+        MoveToScratch(GetConstant(0x80000000));
+        m_Asm.SSE(ANDNPS, s_uiScratchXmm, a);
+        break;
+      case OpCode::AbsI_R:
+        m_Asm.SSE(PABSD, s_uiScratchXmm, a);
+        break;
+      case OpCode::SqrtF_R:
+        m_Asm.SSE(SQRTPS, s_uiScratchXmm, a);
+        break;
+      case OpCode::RoundF_R:
+        m_Asm.SSE(WithImm8(ROUNDPS, _MM_FROUND_NINT), s_uiScratchXmm, a);
+        break;
+      case OpCode::FloorF_R:
+        m_Asm.SSE(WithImm8(ROUNDPS, _MM_FROUND_FLOOR), s_uiScratchXmm, a);
+        break;
+      case OpCode::CeilF_R:
+        m_Asm.SSE(WithImm8(ROUNDPS, _MM_FROUND_CEIL), s_uiScratchXmm, a);
+        break;
+      case OpCode::TruncF_R:
+        m_Asm.SSE(WithImm8(ROUNDPS, _MM_FROUND_TRUNC), s_uiScratchXmm, a);
+        break;
+      case OpCode::NotI_R:
+      case OpCode::NotB_R:
+        MoveToScratch(a);
+        Invert();
+        break;
+      case OpCode::IToF_R:
+        m_Asm.SSE(CVTDQ2PS, s_uiScratchXmm, a);
+        break;
+      case OpCode::FToI_R:
+        m_Asm.SSE(CVTTPS2DQ, s_uiScratchXmm, a);
+        break;
+
+      default:
+        // transcendental functions and integer log2 are not supported
+        return EZ_FAILURE;
+    }
+
+    MoveFromScratch(r);
+    return EZ_SUCCESS;
+  }
+
+  ezResult CodeGenerator::GenerateBinary(OpCode::Enum opCode, const Operand& r, const Operand& a, const Operand& b)
+  {
+    SSEOp op;
+    bool bSwapOperands = false;
+    bool bInvertResult = false;
+
+    switch (opCode)
+    {
+        // clang-format off
+      case OpCode::AddF_RR: op = ADDPS; break;
+      case OpCode::AddI_RR: op = PADDD; break;
+      case OpCode::SubF_RR: op = SUBPS; break;
+      case OpCode::SubI_RR: op = PSUBD; break;
+      case OpCode::MulF_RR: op = MULPS; break;
+      case OpCode::MulI_RR: op = PMULLD; break;
+      case OpCode::DivF_RR: op = DIVPS; break;
+      case OpCode::MinF_RR: op = MINPS; break;
+      case OpCode::MinI_RR: op = PMINSD; break;
+      case OpCode::MaxF_RR: op = MAXPS; break;
+      case OpCode::MaxI_RR: op = PMAXSD; break;
+      case OpCode::AndI_RR: op = PAND; break;
+      case OpCode::XorI_RR: op = PXOR; break;
+      case OpCode::OrI_RR: op = POR; break;
+
+      case OpCode::EqF_RR: op = WithImm8(CMPPS, CMP_EQ); break;
+      case OpCode::EqI_RR: op = PCMPEQD; break;
+      case OpCode::EqB_RR: op = XORPS; bInvertResult = true; break;
+
+      case OpCode::NEqF_RR: op = WithImm8(CMPPS, CMP_NEQ); break;
+      case OpCode::NEqI_RR: op = PCMPEQD; bInvertResult = true; break;
+      case OpCode::NEqB_RR: op = XORPS; break;
+
+      case OpCode::LtF_RR: op = WithImm8(CMPPS, CMP_LT); break;
+      case OpCode::LtI_RR: op = PCMPGTD; bSwapOperands = true; break;
+
+      case OpCode::LEqF_RR: op = WithImm8(CMPPS, CMP_LE); break;
+      case OpCode::LEqI_RR: op = PCMPGTD; bInvertResult = true; break;
+
+      // a > b is computed as b < a, just like _mm_cmpgt_ps does
+      case OpCode::GtF_RR: op = WithImm8(CMPPS, CMP_LT); bSwapOperands = true; break;
+      case OpCode::GtI_RR: op = PCMPGTD; break;
+
+      case OpCode::GEqF_RR: op = WithImm8(CMPPS, CMP_LE); bSwapOperands = true; break;
+      case OpCode::GEqI_RR: op = PCMPGTD; bSwapOperands = true; bInvertResult = true; break;
+
+      case OpCode::AndB_RR: op = ANDPS; break;
+      case OpCode::OrB_RR: op = ORPS; break;
+        // clang-format on
+
+      default:
+        // integer division and variable shifts are scalar in the interpreter as well
+        return EZ_FAILURE;
+    }
+
+    MoveToScratch(bSwapOperands ? b : a);
+    m_Asm.SSE(op, s_uiScratchXmm, bSwapOperands ? a : b);
+
+    if (bInvertResult)
+    {
+      Invert();
+    }
+
+    MoveFromScratch(r);
+    return EZ_SUCCESS;
+  }
+
+  ezResult CodeGenerator::GenerateLoad(const Operand& r, const ezProcessingStream& input, ezProcessingStream::DataType expectedType, ezUInt32 uiSlot)
+  {
+    if (input.GetDataType() != expectedType)
+      return EZ_FAILURE;
+
+    const ezInt32 iStride = input.GetElementStride();
+
+    m_Asm.LoadContextValue(RAX, uiSlot);
+
+    if (iStride == sizeof(ezUInt32))
+    {
+      m_Asm.SSE(MOVUPS_LOAD, s_uiScratchXmm, Operand::Mem(RAX, 0));
+    }
+    else
+    {
+      m_Asm.SSE(MOVD_LOAD, s_uiScratchXmm, Operand::Mem(RAX, 0));
+      m_Asm.SSE(WithImm8(PINSRD, 1), s_uiScratchXmm, Operand::Mem(RAX, iStride));
+      m_Asm.SSE(WithImm8(PINSRD, 2), s_uiScratchXmm, Operand::Mem(RAX, iStride * 2));
+      m_Asm.SSE(WithImm8(PINSRD, 3), s_uiScratchXmm, Operand::Mem(RAX, iStride * 3));
+    }
+
+    MoveFromScratch(r);
+    return EZ_SUCCESS;
+  }
+
+  ezResult CodeGenerator::GenerateStore(const Operand& a, const ezProcessingStream& output, ezProcessingStream::DataType expectedType, ezUInt32 uiSlot)
+  {
+    if (output.GetDataType() != expectedType)
+      return EZ_FAILURE;
+
+    const ezInt32 iStride = output.GetElementStride();
+
+    MoveToScratch(a);
+    m_Asm.LoadContextValue(RAX, uiSlot);
+
+    if (iStride == sizeof(ezUInt32))
+    {
+      m_Asm.SSE(MOVUPS_STORE, s_uiScratchXmm, Operand::Mem(RAX, 0));
+    }
+    else
+    {
+      m_Asm.SSE(MOVD_STORE, s_uiScratchXmm, Operand::Mem(RAX, 0));
+      m_Asm.SSE(WithImm8(PEXTRD, 1), s_uiScratchXmm, Operand::Mem(RAX, iStride));
+      m_Asm.SSE(WithImm8(PEXTRD, 2), s_uiScratchXmm, Operand::Mem(RAX, iStride * 2));
+      m_Asm.SSE(WithImm8(PEXTRD, 3), s_uiScratchXmm, Operand::Mem(RAX, iStride * 3));
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  ezResult CodeGenerator::Generate(const ezExpressionByteCode& byteCode, ezArrayPtr<ezProcessingStream* const> inputs, ezArrayPtr<ezProcessingStream* const> outputs)
+  {
+    const ezUInt32 uiFirstOutputSlot = ContextSlot::FirstStream + inputs.GetCount();
+
+    // prologue
+    m_Asm.LoadContextValue(RCX, ContextSlot::NumIterations);
+    m_Asm.LoadContextValue(RSI, ContextSlot::SpilledRegisters);
+    m_Asm.LoadContextValue(RDX, ContextSlot::Constants);
+
+    // test rcx, rcx; jz end
+    m_Asm.Byte(0x48);
+    m_Asm.Byte(0x85);
+    m_Asm.Byte(0xC9);
+    m_Asm.Byte(0x0F);
+    m_Asm.Byte(0x84);
+    const ezUInt32 uiSkipLoopJumpPos = m_Asm.m_Code.GetCount();
+    m_Asm.Int32(0);
+
+    const ezUInt32 uiLoopStart = m_Asm.m_Code.GetCount();
+
+    const ByteCodeType* pByteCode = byteCode.GetByteCode();
+    const ByteCodeType* pByteCodeEnd = byteCode.GetByteCodeEnd();
+
+    while (pByteCode < pByteCodeEnd)
+    {
+      const OpCode::Enum opCode = ezExpressionByteCode::GetOpCode(pByteCode);
+
+      if (opCode > OpCode::FirstUnary && opCode < OpCode::LastUnary)
+      {
+        const Operand r = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+        const Operand a = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+        EZ_SUCCEED_OR_RETURN(GenerateUnary(opCode, r, a));
+      }
+      else if (opCode > OpCode::FirstBinary && opCode < OpCode::LastBinary)
+      {
+        const Operand r = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+        const Operand a = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+        const Operand b = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+        EZ_SUCCEED_OR_RETURN(GenerateBinary(opCode, r, a, b));
+      }
+      else if (opCode > OpCode::FirstBinaryWithConstant && opCode < OpCode::LastBinaryWithConstant)
+      {
+        const Operand r = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+        const Operand a = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+        const ezUInt32 uiRawConstant = *pByteCode;
+        ++pByteCode;
+
+        if (opCode == OpCode::ShlI_RC || opCode == OpCode::ShrI_RC)
+        {
+          // pslld / psrad with an immediate behave like the shift by a count register for counts greater than 31
+          MoveToScratch(a);
+          m_Asm.SSE(WithImm8(PSHIFTD_IMM, ezMath::Min(uiRawConstant, 255u)), opCode == OpCode::ShlI_RC ? 6 : 4, Scratch());
+          MoveFromScratch(r);
+        }
+        else
+        {
+          // the constant variants are in the same order as the register variants
+          const OpCode::Enum registerOpCode = static_cast<OpCode::Enum>(opCode - OpCode::FirstBinaryWithConstant + OpCode::FirstBinary);
+          EZ_SUCCEED_OR_RETURN(GenerateBinary(registerOpCode, r, a, GetConstant(uiRawConstant)));
+        }
+      }
+      else if (opCode > OpCode::FirstTernary && opCode < OpCode::LastTernary)
+      {
+        const Operand r = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+        const Operand a = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+        const Operand b = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+        const Operand c = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+
+        // all selects are bitwise, blendvps takes the mask in xmm0
+        m_Asm.SSE(MOVAPS_LOAD, 0, a);
+        MoveToScratch(c);
+        m_Asm.SSE(BLENDVPS, s_uiScratchXmm, b);
+        MoveFromScratch(r);
+      }
+      else if (opCode == OpCode::MovX_R)
+      {
+        const Operand r = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+        const Operand a = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+        MoveToScratch(a);
+        MoveFromScratch(r);
+      }
+      else if (opCode == OpCode::MovX_C)
+      {
+        const Operand r = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+        const ezUInt32 uiRawConstant = *pByteCode;
+        ++pByteCode;
+        MoveToScratch(GetConstant(uiRawConstant));
+        MoveFromScratch(r);
+      }
+      else if (opCode == OpCode::LoadF || opCode == OpCode::LoadI)
+      {
+        const Operand r = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+        const ezUInt32 uiInputIndex = ezExpressionByteCode::GetRegisterIndex(pByteCode);
+        const auto expectedType = opCode == OpCode::LoadF ? ezProcessingStream::DataType::Float : ezProcessingStream::DataType::Int;
+        EZ_SUCCEED_OR_RETURN(GenerateLoad(r, *inputs[uiInputIndex], expectedType, ContextSlot::FirstStream + uiInputIndex));
+      }
+      else if (opCode == OpCode::StoreF || opCode == OpCode::StoreI)
+      {
+        const ezUInt32 uiOutputIndex = ezExpressionByteCode::GetRegisterIndex(pByteCode);
+        const Operand a = GetRegister(ezExpressionByteCode::GetRegisterIndex(pByteCode));
+        const auto expectedType = opCode == OpCode::StoreF ? ezProcessingStream::DataType::Float : ezProcessingStream::DataType::Int;
+        EZ_SUCCEED_OR_RETURN(GenerateStore(a, *outputs[uiOutputIndex], expectedType, uiFirstOutputSlot + uiOutputIndex));
+      }
+      else
+      {
+        // function calls are not supported
+        return EZ_FAILURE;
+      }
+    }
+
+    // advance all stream pointers by 4 elements
+    for (ezUInt32 i = 0; i < inputs.GetCount(); ++i)
+    {
+      m_Asm.AddToContextValue(ContextSlot::FirstStream + i, inputs[i]->GetElementStride() * 4);
+    }
+
+    for (ezUInt32 i = 0; i < outputs.GetCount(); ++i)
+    {
+      m_Asm.AddToContextValue(uiFirstOutputSlot + i, outputs[i]->GetElementStride() * 4);
+    }
+
+    // dec rcx; jnz loop
+    m_Asm.Byte(0x48);
+    m_Asm.Byte(0xFF);
+    m_Asm.Byte(0xC9);
+    m_Asm.Byte(0x0F);
+    m_Asm.Byte(0x85);
+    m_Asm.Int32(static_cast<ezInt32>(uiLoopStart) - static_cast<ezInt32>(m_Asm.m_Code.GetCount() + 4));
+
+    m_Asm.PatchInt32(uiSkipLoopJumpPos, static_cast<ezInt32>(m_Asm.m_Code.GetCount()) - static_cast<ezInt32>(uiSkipLoopJumpPos + 4));
+
+    // ret
+    m_Asm.Byte(0xC3);
+
+    return EZ_SUCCESS;
+  }
+
+#endif
+
+} // namespace
+
+ezExpressionJITProgram::ezExpressionJITProgram() = default;
+
+ezExpressionJITProgram::~ezExpressionJITProgram()
+{
+  FreeCode();
+}
+
+// static
+bool ezExpressionJITProgram::IsSupported()
+{
+#if EZ_ENABLED(EZ_EXPRESSION_JIT)
+  return true;
+#else
+  return false;
+#endif
+}
+
+// static
+ezUInt64 ezExpressionJITProgram::ComputeProgramKey(const ezExpressionByteCode& byteCode, ezArrayPtr<ezProcessingStream* const> inputs, ezArrayPtr<ezProcessingStream* const> outputs)
+{
+  const ezUInt8* pByteCode = reinterpret_cast<const ezUInt8*>(byteCode.GetByteCode());
+  const ezUInt8* pByteCodeEnd = reinterpret_cast<const ezUInt8*>(byteCode.GetByteCodeEnd());
+
+  ezHybridArray<ezUInt32, 32> layout;
+  layout.PushBack(byteCode.GetNumTempRegisters());
+
+  for (const ezProcessingStream* pStream : inputs)
+  {
+    layout.PushBack((static_cast<ezUInt32>(pStream->GetDataType()) << 16) | pStream->GetElementStride());
+  }
+
+  for (const ezProcessingStream* pStream : outputs)
+  {
+    layout.PushBack((static_cast<ezUInt32>(pStream->GetDataType()) << 16) | pStream->GetElementStride());
+  }
+
+  const ezUInt64 uiLayoutHash = ezHashingUtils::xxHash64(layout.GetData(), layout.GetCount() * sizeof(ezUInt32));
+  return ezHashingUtils::xxHash64(pByteCode, pByteCodeEnd - pByteCode, uiLayoutHash);
+}
+
+ezResult ezExpressionJITProgram::Compile(const ezExpressionByteCode& byteCode, ezArrayPtr<ezProcessingStream* const> inputs, ezArrayPtr<ezProcessingStream* const> outputs)
+{
+  FreeCode();
+  m_Constants.Clear();
+  m_SpilledRegisters.Clear();
+
+#if EZ_ENABLED(EZ_EXPRESSION_JIT)
+  CodeGenerator generator(m_Constants);
+  EZ_SUCCEED_OR_RETURN(generator.Generate(byteCode, inputs, outputs));
+
+  const ezUInt32 uiNumTempRegisters = byteCode.GetNumTempRegisters();
+  if (uiNumTempRegisters > s_uiNumRegistersInXmm)
+  {
+    m_SpilledRegisters.SetCount(uiNumTempRegisters - s_uiNumRegistersInXmm);
+  }
+
+  const ezArrayPtr<const ezUInt8> code = generator.m_Asm.m_Code;
+  const size_t uiPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t uiCodeSize = ezMemoryUtils::AlignSize<size_t>(code.GetCount(), uiPageSize);
+
+  void* pCode = mmap(nullptr, uiCodeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (pCode == MAP_FAILED)
+    return EZ_FAILURE;
+
+  ezMemoryUtils::Copy(static_cast<ezUInt8*>(pCode), code.GetPtr(), code.GetCount());
+
+  // never writable and executable at the same time
+  if (mprotect(pCode, uiCodeSize, PROT_READ | PROT_EXEC) != 0)
+  {
+    munmap(pCode, uiCodeSize);
+    return EZ_FAILURE;
+  }
+
+  m_pCode = pCode;
+  m_uiCodeSize = uiCodeSize;
+  return EZ_SUCCESS;
+#else
+  return EZ_FAILURE;
+#endif
+}
+
+void ezExpressionJITProgram::Execute(ezArrayPtr<ezProcessingStream* const> inputs, ezArrayPtr<ezProcessingStream* const> outputs, ezUInt32 uiNumInstances)
+{
+  EZ_ASSERT_DEV(m_pCode != nullptr, "Program has not been compiled");
+
+  ezHybridArray<ezUInt64, 32> context;
+  context.SetCountUninitialized(ContextSlot::FirstStream + inputs.GetCount() + outputs.GetCount());
+  context[ContextSlot::SpilledRegisters] = reinterpret_cast<size_t>(m_SpilledRegisters.GetData());
+  context[ContextSlot::Constants] = reinterpret_cast<size_t>(m_Constants.GetData());
+  context[ContextSlot::NumIterations] = uiNumInstances / 4;
+
+  ezUInt32 uiSlot = ContextSlot::FirstStream;
+  for (const ezProcessingStream* pStream : inputs)
+  {
+    context[uiSlot++] = reinterpret_cast<size_t>(pStream->GetData());
+  }
+
+  for (const ezProcessingStream* pStream : outputs)
+  {
+    context[uiSlot++] = reinterpret_cast<size_t>(pStream->GetWritableData());
+  }
+
+  using ProgramFunc = void (*)(ezUInt64* pContext);
+  reinterpret_cast<ProgramFunc>(m_pCode)(context.GetData());
+}
+
+void ezExpressionJITProgram::FreeCode()
+{
+#if EZ_ENABLED(EZ_EXPRESSION_JIT)
+  if (m_pCode != nullptr)
+  {
+    munmap(m_pCode, m_uiCodeSize);
+  }
+#endif
+
+  m_pCode = nullptr;
+  m_uiCodeSize = 0;
+}
+
+
+EZ_STATICLINK_FILE(Foundation, Foundation_CodeUtils_Expression_Implementation_ExpressionJIT);
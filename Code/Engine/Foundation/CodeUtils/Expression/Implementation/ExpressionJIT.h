@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Foundation/FoundationInternal.h>
+EZ_FOUNDATION_INTERNAL_HEADER
+
+#include <Foundation/CodeUtils/Expression/ExpressionByteCode.h>
+
+// Native code generation is only implemented for x86-64 with the System V calling convention so far.
+#if EZ_ENABLED(EZ_PLATFORM_LINUX) && EZ_ENABLED(EZ_PLATFORM_ARCH_X86) && EZ_ENABLED(EZ_PLATFORM_64BIT) && EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+#  define EZ_EXPRESSION_JIT EZ_ON
+#else
+#  define EZ_EXPRESSION_JIT EZ_OFF
+#endif
+
+/// \brief Native x86-64 code for an ezExpressionByteCode program, compiled for one specific layout of the input and output streams.
+///
+/// The generated code is a single loop over all instances, four at a time. The temp registers of the byte code are kept in SSE registers
+/// (or in a small spill area that stays in the L1 cache), so inputs are read and outputs are written exactly once, instead of every instruction
+/// going through the register arrays of the interpreter. The same SSE instructions as in the interpreter are used, so the results are bit identical.
+///
+/// Not every program can be compiled. Function calls, transcendental functions, integer division, variable shifts and streams that are not
+/// plain float or int fail to compile, in which case ezExpressionVM falls back to the interpreter.
+class ezExpressionJITProgram
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezExpressionJITProgram);
+
+public:
+  ezExpressionJITProgram();
+  ~ezExpressionJITProgram();
+
+  /// \brief Returns whether native code can be generated and executed on this platform.
+  static bool IsSupported();
+
+  /// \brief Computes a key that identifies the byte code together with the layout of the given streams.
+  static ezUInt64 ComputeProgramKey(const ezExpressionByteCode& byteCode, ezArrayPtr<ezProcessingStream* const> inputs, ezArrayPtr<ezProcessingStream* const> outputs);
+
+  /// \brief Generates native code for the byte code and the layout of the given streams. Fails if anything is not supported.
+  ezResult Compile(const ezExpressionByteCode& byteCode, ezArrayPtr<ezProcessingStream* const> inputs, ezArrayPtr<ezProcessingStream* const> outputs);
+
+  /// \brief Executes the first (uiNumInstances & ~3) instances. The remaining instances have to be executed by the caller.
+  ///
+  /// The streams must have the same layout as the ones passed to Compile().
+  void Execute(ezArrayPtr<ezProcessingStream* const> inputs, ezArrayPtr<ezProcessingStream* const> outputs, ezUInt32 uiNumInstances);
+
+private:
+  void FreeCode();
+
+  void* m_pCode = nullptr;
+  size_t m_uiCodeSize = 0;
+
+  ezDynamicArray<ezSimdVec4i, ezAlignedAllocatorWrapper> m_Constants;
+  ezDynamicArray<ezSimdVec4i, ezAlignedAllocatorWrapper> m_SpilledRegisters;
+};
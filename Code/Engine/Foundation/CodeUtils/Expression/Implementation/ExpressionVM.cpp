@@ -3,7 +3,9 @@
 #include <Foundation/CodeUtils/Expression/ExpressionAST.h>
 #include <Foundation/CodeUtils/Expression/ExpressionByteCode.h>
 #include <Foundation/CodeUtils/Expression/ExpressionVM.h>
+#include <Foundation/CodeUtils/Expression/Implementation/ExpressionJIT.h>
 #include <Foundation/CodeUtils/Expression/Implementation/ExpressionVMOperations.h>
+#include <Foundation/CodeUtils/Expression/Implementation/ExpressionVMOperationsAVX2.h>
 #include <Foundation/Logging/Log.h>
 
 ezExpressionVM::ezExpressionVM()
@@ -45,7 +47,72 @@ ezResult ezExpressionVM::Execute(const ezExpressionByteCode& byteCode, ezArrayPt
   EZ_SUCCEED_OR_RETURN(MapStreams(byteCode.GetOutputs(), m_ScalarizedOutputs, "Output", uiNumInstances, m_MappedOutputs));
   EZ_SUCCEED_OR_RETURN(MapFunctions(byteCode.GetFunctions(), globalData));
 
-  const ezUInt32 uiTotalNumRegisters = byteCode.GetNumTempRegisters() * ((uiNumInstances + 3) / 4);
+  m_bLastExecutionUsedJIT = false;
+
+  if (m_bAllowJIT && uiNumInstances >= 4)
+  {
+    if (ezExpressionJITProgram* pProgram = GetOrCompileJITProgram(byteCode))
+    {
+      pProgram->Execute(m_MappedInputs, m_MappedOutputs, uiNumInstances);
+      m_bLastExecutionUsedJIT = true;
+
+      const ezUInt32 uiNumExecutedInstances = uiNumInstances & ~3u;
+      if (uiNumExecutedInstances == uiNumInstances)
+        return EZ_SUCCESS;
+
+      // the interpreter takes care of the remaining instances
+      OffsetStreams(m_MappedInputs, uiNumExecutedInstances);
+      OffsetStreams(m_MappedOutputs, uiNumExecutedInstances);
+      uiNumInstances -= uiNumExecutedInstances;
+    }
+  }
+
+  return ExecuteInterpreter(byteCode, uiNumInstances, globalData);
+}
+
+// static
+bool ezExpressionVM::IsAVX2Supported()
+{
+#if EZ_ENABLED(EZ_EXPRESSION_VM_AVX2)
+  static const bool s_bSupported = DetectAVX2Support();
+  return s_bSupported;
+#else
+  return false;
+#endif
+}
+
+// static
+bool ezExpressionVM::IsJITSupported()
+{
+  return ezExpressionJITProgram::IsSupported();
+}
+
+void ezExpressionVM::SetAllowJIT(bool bAllow)
+{
+  m_bAllowJIT = bAllow && IsJITSupported();
+
+  if (!m_bAllowJIT)
+  {
+    m_JITPrograms.Clear();
+  }
+}
+
+ezResult ezExpressionVM::ExecuteInterpreter(const ezExpressionByteCode& byteCode, ezUInt32 uiNumInstances, const ezExpression::GlobalData& globalData)
+{
+  const OpFunc* pFuncs = s_Simd4Funcs;
+  ezUInt32 uiNumSimd4Instances = (uiNumInstances + 3) / 4;
+
+#if EZ_ENABLED(EZ_EXPRESSION_VM_AVX2)
+  if (IsUsingAVX2())
+  {
+    pFuncs = s_Simd8Funcs;
+
+    // the 8-wide operations always process two ezSimd4 registers at once
+    uiNumSimd4Instances = ezMemoryUtils::AlignSize(uiNumSimd4Instances, 2u);
+  }
+#endif
+
+  const ezUInt32 uiTotalNumRegisters = byteCode.GetNumTempRegisters() * uiNumSimd4Instances;
   m_Registers.SetCountUninitialized(uiTotalNumRegisters);
 
   // Execute bytecode
@@ -55,7 +122,7 @@ ezResult ezExpressionVM::Execute(const ezExpressionByteCode& byteCode, ezArrayPt
   ExecutionContext context;
   context.m_pRegisters = m_Registers.GetData();
   context.m_uiNumInstances = uiNumInstances;
-  context.m_uiNumSimd4Instances = (uiNumInstances + 3) / 4;
+  context.m_uiNumSimd4Instances = uiNumSimd4Instances;
   context.m_Inputs = m_MappedInputs;
   context.m_Outputs = m_MappedOutputs;
   context.m_Functions = m_MappedFunctions;
@@ -65,7 +132,7 @@ ezResult ezExpressionVM::Execute(const ezExpressionByteCode& byteCode, ezArrayPt
   {
     ezExpressionByteCode::OpCode::Enum opCode = ezExpressionByteCode::GetOpCode(pByteCode);
 
-    OpFunc func = s_Simd4Funcs[opCode];
+    OpFunc func = pFuncs[opCode];
     if (func != nullptr)
     {
       func(pByteCode, context);
@@ -81,6 +148,46 @@ ezResult ezExpressionVM::Execute(const ezExpressionByteCode& byteCode, ezArrayPt
   return EZ_SUCCESS;
 }
 
+ezExpressionJITProgram* ezExpressionVM::GetOrCompileJITProgram(const ezExpressionByteCode& byteCode)
+{
+  const ezUInt64 uiKey = ezExpressionJITProgram::ComputeProgramKey(byteCode, m_MappedInputs, m_MappedOutputs);
+
+  if (auto pExisting = m_JITPrograms.GetValue(uiKey))
+  {
+    return pExisting->Borrow();
+  }
+
+  // byte code is usually owned by resources and components, so without any way to know when it is destroyed, simply start over at some point
+  constexpr ezUInt32 uiMaxCachedPrograms = 64;
+  if (m_JITPrograms.GetCount() >= uiMaxCachedPrograms)
+  {
+    m_JITPrograms.Clear();
+  }
+
+  ezUniquePtr<ezExpressionJITProgram> pProgram = EZ_DEFAULT_NEW(ezExpressionJITProgram);
+  if (pProgram->Compile(byteCode, m_MappedInputs, m_MappedOutputs).Failed())
+  {
+    pProgram.Clear();
+  }
+
+  ezExpressionJITProgram* pResult = pProgram.Borrow();
+  m_JITPrograms.Insert(uiKey, std::move(pProgram));
+  return pResult;
+}
+
+// static
+void ezExpressionVM::OffsetStreams(ezArrayPtr<ezProcessingStream*> streams, ezUInt32 uiNumInstances)
+{
+  // the mapped streams are the VM's own copies, so they can simply be replaced
+  for (ezProcessingStream* pStream : streams)
+  {
+    const ezUInt64 uiOffset = static_cast<ezUInt64>(pStream->GetElementStride()) * uiNumInstances;
+    auto data = ezMakeArrayPtr(pStream->GetWritableData<ezUInt8>() + uiOffset, static_cast<ezUInt32>(pStream->GetDataSize() - uiOffset));
+
+    *pStream = ezProcessingStream(pStream->GetName(), data, pStream->GetDataType(), pStream->GetElementStride());
+  }
+}
+
 void ezExpressionVM::RegisterDefaultFunctions()
 {
   RegisterFunction(ezDefaultExpressionFunctions::s_RandomFunc);
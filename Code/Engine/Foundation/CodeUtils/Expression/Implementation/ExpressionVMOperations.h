@@ -10,7 +10,7 @@ namespace
   {
     ezExpression::Register* m_pRegisters = nullptr;
     ezUInt32 m_uiNumInstances = 0;
-    ezUInt32 m_uiNumSimd4Instances = 0;
+    ezUInt32 m_uiNumSimd4Instances = 0; // number of ezSimd4 registers per temp register, might be padded to a multiple of the execution width
     ezArrayPtr<ezProcessingStream*> m_Inputs;
     ezArrayPtr<ezProcessingStream*> m_Outputs;
     ezArrayPtr<const ezExpressionFunction*> m_Functions;
@@ -24,6 +24,12 @@ namespace
   ezExpression::Register* r = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances; \
   ezExpression::Register* re = r + context.m_uiNumSimd4Instances;
 
+// Registers might be padded, so loads and stores have to compute the end from the actual number of instances.
+// re points to the register that holds the remainder instances, if there are any.
+#define DEFINE_STREAM_REGISTER()                                                                                                        \
+  ezExpression::Register* r = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances; \
+  ezExpression::Register* re = r + (context.m_uiNumInstances / 4);
+
 #define DEFINE_OP_REGISTER(name) \
   const ezExpression::Register* name = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances;
 
@@ -163,8 +169,9 @@ namespace
   DEFINE_BINARY_OP(MaxF, r->f = a->f.CompMax(b->f));
   DEFINE_BINARY_OP(MaxI, r->i = a->i.CompMax(b->i));
 
-  DEFINE_BINARY_OP(ShlI, r->i = a->i << b->i);
-  DEFINE_BINARY_OP(ShrI, r->i = a->i >> b->i);
+  // The shift count is masked to 5 bits like the x86 shift instructions do, shifting by 32 or more is undefined in C++.
+  DEFINE_BINARY_OP(ShlI, r->i = a->i << (b->i & ezSimdVec4i(31)));
+  DEFINE_BINARY_OP(ShrI, r->i = a->i >> (b->i & ezSimdVec4i(31)));
   DEFINE_BINARY_OP(ShlI_C, r->i = a->i << bRaw);
   DEFINE_BINARY_OP(ShrI_C, r->i = a->i >> bRaw);
   DEFINE_BINARY_OP(AndI, r->i = a->i & b->i);
@@ -323,13 +330,21 @@ namespace
     }
   }
 
+  // Copies the last loaded or computed register into the padding registers, so operations on them can't produce exceptions (e.g. integer division by zero).
+  EZ_ALWAYS_INLINE void FillPaddingRegisters(ezExpression::Register* r, const ExecutionContext& context)
+  {
+    const ezUInt32 uiNumUsedRegisters = (context.m_uiNumInstances + 3) / 4;
+    for (ezUInt32 i = uiNumUsedRegisters; i < context.m_uiNumSimd4Instances; ++i)
+    {
+      r[i] = r[uiNumUsedRegisters - 1];
+    }
+  }
+
   void VM_LoadF_4(const ByteCodeType*& pByteCode, ExecutionContext& context)
   {
     const ezUInt32 uiNumRemainderInstances = context.m_uiNumInstances & 0x3;
 
-    DEFINE_TARGET_REGISTER();
-    if (uiNumRemainderInstances > 0)
-      --re;
+    DEFINE_STREAM_REGISTER();
 
     const ezUInt32 uiInputIndex = ezExpressionByteCode::GetRegisterIndex(pByteCode);
     auto& input = *context.m_Inputs[uiInputIndex];
@@ -343,15 +358,15 @@ namespace
       EZ_ASSERT_DEBUG(input.GetDataType() == ezProcessingStream::DataType::Half, "Unsupported input type '{}' for LoadF instruction", ezProcessingStream::GetDataTypeName(input.GetDataType()));
       LoadInput<ezSimdVec4f, float, ezFloat16>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(re), input, uiNumRemainderInstances);
     }
+
+    FillPaddingRegisters(r, context);
   }
 
   void VM_LoadI_4(const ByteCodeType*& pByteCode, ExecutionContext& context)
   {
     const ezUInt32 uiNumRemainderInstances = context.m_uiNumInstances & 0x3;
 
-    DEFINE_TARGET_REGISTER();
-    if (uiNumRemainderInstances > 0)
-      --re;
+    DEFINE_STREAM_REGISTER();
 
     const ezUInt32 uiInputIndex = ezExpressionByteCode::GetRegisterIndex(pByteCode);
     auto& input = *context.m_Inputs[uiInputIndex];
@@ -369,6 +384,8 @@ namespace
       EZ_ASSERT_DEBUG(input.GetDataType() == ezProcessingStream::DataType::Byte, "Unsupported input type '{}' for LoadI instruction", ezProcessingStream::GetDataTypeName(input.GetDataType()));
       LoadInput<ezSimdVec4i, int, ezInt8>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), input, uiNumRemainderInstances);
     }
+
+    FillPaddingRegisters(r, context);
   }
 
   void VM_StoreF_4(const ByteCodeType*& pByteCode, ExecutionContext& context)
@@ -378,10 +395,7 @@ namespace
     ezUInt32 uiOutputIndex = ezExpressionByteCode::GetRegisterIndex(pByteCode);
     auto& output = *context.m_Outputs[uiOutputIndex];
 
-    // actually not target register but operand register in the is case, but we need something to loop over so we use the target register macro here.
-    DEFINE_TARGET_REGISTER();
-    if (uiNumRemainderInstances > 0)
-      --re;
+    DEFINE_STREAM_REGISTER();
 
     if (output.GetDataType() == ezProcessingStream::DataType::Float)
     {
@@ -401,10 +415,7 @@ namespace
     ezUInt32 uiOutputIndex = ezExpressionByteCode::GetRegisterIndex(pByteCode);
     auto& output = *context.m_Outputs[uiOutputIndex];
 
-    // actually not target register but operand register in the is case, but we need something to loop over so we use the target register macro here.
-    DEFINE_TARGET_REGISTER();
-    if (uiNumRemainderInstances > 0)
-      --re;
+    DEFINE_STREAM_REGISTER();
 
     if (output.GetDataType() == ezProcessingStream::DataType::Int)
     {
@@ -440,6 +451,9 @@ namespace
     ezExpression::Output output = ezMakeArrayPtr(r, context.m_uiNumSimd4Instances);
 
     function.m_Func(inputs, output, *context.m_pGlobalData);
+
+    // Functions are not required to write the padding registers.
+    FillPaddingRegisters(r, context);
   }
 
   static constexpr OpFunc s_Simd4Funcs[] = {
@@ -604,6 +618,7 @@ namespace
 } // namespace
 
 #undef DEFINE_TARGET_REGISTER
+#undef DEFINE_STREAM_REGISTER
 #undef DEFINE_OP_REGISTER
 #undef DEFINE_CONSTANT
 #undef UNARY_OP_INNER_LOOP
@@ -0,0 +1,391 @@
+#pragma once
+
+#include <Foundation/CodeUtils/Expression/Implementation/ExpressionVMOperations.h>
+
+// The 8-wide code path uses AVX2 through function level target attributes, so the rest of the engine can still be compiled for SSE4.1.
+// Whether it is actually used is decided at runtime, see ezExpressionVM::IsAVX2Supported().
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86) && EZ_ENABLED(EZ_PLATFORM_64BIT) && EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+#  define EZ_EXPRESSION_VM_AVX2 EZ_ON
+#else
+#  define EZ_EXPRESSION_VM_AVX2 EZ_OFF
+#endif
+
+#if EZ_ENABLED(EZ_EXPRESSION_VM_AVX2)
+
+#  include <immintrin.h>
+
+#  if EZ_ENABLED(EZ_COMPILER_MSVC)
+#    include <intrin.h>
+#  endif
+
+#  if EZ_ENABLED(EZ_COMPILER_MSVC_PURE)
+#    define EZ_AVX2_TARGET
+#  else
+#    define EZ_AVX2_TARGET __attribute__((target("avx2")))
+#  endif
+
+namespace
+{
+  bool DetectAVX2Support()
+  {
+#  if EZ_ENABLED(EZ_COMPILER_MSVC)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+      return false;
+
+    // AVX and OSXSAVE
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+      return false;
+
+    // the OS has to save the YMM registers on context switches
+    if ((_xgetbv(0) & 0x6) != 0x6)
+      return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#  else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#  endif
+  }
+
+  // Each 8-wide operation processes two consecutive ezSimd4 registers. The register count per temp register is padded to an even number
+  // in this mode, so that pairs never cross into the next temp register.
+
+  EZ_ALWAYS_INLINE EZ_AVX2_TARGET __m256 LoadF8(const ezExpression::Register* p)
+  {
+    return _mm256_loadu_ps(reinterpret_cast<const float*>(p));
+  }
+
+  EZ_ALWAYS_INLINE EZ_AVX2_TARGET __m256i LoadI8(const ezExpression::Register* p)
+  {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  }
+
+  EZ_ALWAYS_INLINE EZ_AVX2_TARGET void StoreF8(ezExpression::Register* p, __m256 v)
+  {
+    _mm256_storeu_ps(reinterpret_cast<float*>(p), v);
+  }
+
+  EZ_ALWAYS_INLINE EZ_AVX2_TARGET void StoreI8(ezExpression::Register* p, __m256i v)
+  {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+  }
+
+  EZ_ALWAYS_INLINE EZ_AVX2_TARGET __m256 AllTrue8()
+  {
+    return _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+  }
+
+#  define DEFINE_TARGET_REGISTER()                                                                                                        \
+    ezExpression::Register* r = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances; \
+    ezExpression::Register* re = r + context.m_uiNumSimd4Instances;
+
+#  define DEFINE_OP_REGISTER(name) \
+    const ezExpression::Register* name = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances;
+
+#  define DEFINE_UNARY_OP_8(name, code)                                                                \
+    EZ_AVX2_TARGET void EZ_CONCAT(name, _8)(const ByteCodeType*& pByteCode, ExecutionContext& context) \
+    {                                                                                                  \
+      DEFINE_TARGET_REGISTER();                                                                        \
+      DEFINE_OP_REGISTER(a);                                                                           \
+      while (r != re)                                                                                  \
+      {                                                                                                \
+        code;                                                                                          \
+        r += 2;                                                                                        \
+        a += 2;                                                                                        \
+      }                                                                                                \
+    }
+
+  // Constants are duplicated into a register pair, so they can be loaded like any other operand.
+#  define DEFINE_BINARY_OP_8(name, code)                                                                                             \
+    template <bool RightIsConstant>                                                                                                  \
+    EZ_AVX2_TARGET void EZ_CONCAT(name, _8)(const ByteCodeType*& pByteCode, ExecutionContext& context)                               \
+    {                                                                                                                                \
+      DEFINE_TARGET_REGISTER();                                                                                                      \
+      DEFINE_OP_REGISTER(a);                                                                                                         \
+      ezUInt32 bRaw;                                                                                                                 \
+      ezExpression::Register bConstant[2];                                                                                           \
+      const ezExpression::Register* b;                                                                                               \
+      if constexpr (RightIsConstant)                                                                                                 \
+      {                                                                                                                              \
+        bRaw = *pByteCode;                                                                                                           \
+        bConstant[0] = ezExpressionByteCode::GetConstant(pByteCode);                                                                 \
+        bConstant[1] = bConstant[0];                                                                                                 \
+        b = bConstant;                                                                                                               \
+      }                                                                                                                              \
+      else                                                                                                                           \
+      {                                                                                                                              \
+        b = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances;                \
+      }                                                                                                                              \
+      while (r != re)                                                                                                                \
+      {                                                                                                                              \
+        code;                                                                                                                        \
+        r += 2;                                                                                                                      \
+        a += 2;                                                                                                                      \
+        if constexpr (RightIsConstant == false)                                                                                      \
+        {                                                                                                                            \
+          b += 2;                                                                                                                    \
+        }                                                                                                                            \
+      }                                                                                                                              \
+    }
+
+#  define DEFINE_TERNARY_OP_8(name, code)                                                              \
+    EZ_AVX2_TARGET void EZ_CONCAT(name, _8)(const ByteCodeType*& pByteCode, ExecutionContext& context) \
+    {                                                                                                  \
+      DEFINE_TARGET_REGISTER();                                                                        \
+      DEFINE_OP_REGISTER(a);                                                                           \
+      DEFINE_OP_REGISTER(b);                                                                           \
+      DEFINE_OP_REGISTER(c);                                                                           \
+      while (r != re)                                                                                  \
+      {                                                                                                \
+        code;                                                                                          \
+        r += 2;                                                                                        \
+        a += 2;                                                                                        \
+        b += 2;                                                                                        \
+        c += 2;                                                                                        \
+      }                                                                                                \
+    }
+
+  // The results have to match the 4-wide implementations in ExpressionVMOperations.h bit by bit.
+  // Transcendental functions and integer division have no AVX2 equivalent and use the 4-wide implementation in the table below.
+
+  DEFINE_UNARY_OP_8(AbsF, StoreF8(r, _mm256_andnot_ps(_mm256_set1_ps(-0.0f), LoadF8(a))));
+  DEFINE_UNARY_OP_8(AbsI, StoreI8(r, _mm256_abs_epi32(LoadI8(a))));
+  DEFINE_UNARY_OP_8(SqrtF, StoreF8(r, _mm256_sqrt_ps(LoadF8(a))));
+
+  DEFINE_UNARY_OP_8(RoundF, StoreF8(r, _mm256_round_ps(LoadF8(a), _MM_FROUND_NINT)));
+  DEFINE_UNARY_OP_8(FloorF, StoreF8(r, _mm256_round_ps(LoadF8(a), _MM_FROUND_FLOOR)));
+  DEFINE_UNARY_OP_8(CeilF, StoreF8(r, _mm256_round_ps(LoadF8(a), _MM_FROUND_CEIL)));
+  DEFINE_UNARY_OP_8(TruncF, StoreF8(r, _mm256_round_ps(LoadF8(a), _MM_FROUND_TRUNC)));
+
+  DEFINE_UNARY_OP_8(NotI, StoreI8(r, _mm256_xor_si256(LoadI8(a), _mm256_set1_epi32(-1))));
+  DEFINE_UNARY_OP_8(NotB, StoreF8(r, _mm256_xor_ps(LoadF8(a), AllTrue8())));
+
+  DEFINE_UNARY_OP_8(IToF, StoreF8(r, _mm256_cvtepi32_ps(LoadI8(a))));
+  DEFINE_UNARY_OP_8(FToI, StoreI8(r, _mm256_cvttps_epi32(LoadF8(a))));
+
+  DEFINE_BINARY_OP_8(AddF, StoreF8(r, _mm256_add_ps(LoadF8(a), LoadF8(b))));
+  DEFINE_BINARY_OP_8(AddI, StoreI8(r, _mm256_add_epi32(LoadI8(a), LoadI8(b))));
+
+  DEFINE_BINARY_OP_8(SubF, StoreF8(r, _mm256_sub_ps(LoadF8(a), LoadF8(b))));
+  DEFINE_BINARY_OP_8(SubI, StoreI8(r, _mm256_sub_epi32(LoadI8(a), LoadI8(b))));
+
+  DEFINE_BINARY_OP_8(MulF, StoreF8(r, _mm256_mul_ps(LoadF8(a), LoadF8(b))));
+  DEFINE_BINARY_OP_8(MulI, StoreI8(r, _mm256_mullo_epi32(LoadI8(a), LoadI8(b))));
+
+  DEFINE_BINARY_OP_8(DivF, StoreF8(r, _mm256_div_ps(LoadF8(a), LoadF8(b))));
+
+  DEFINE_BINARY_OP_8(MinF, StoreF8(r, _mm256_min_ps(LoadF8(a), LoadF8(b))));
+  DEFINE_BINARY_OP_8(MinI, StoreI8(r, _mm256_min_epi32(LoadI8(a), LoadI8(b))));
+
+  DEFINE_BINARY_OP_8(MaxF, StoreF8(r, _mm256_max_ps(LoadF8(a), LoadF8(b))));
+  DEFINE_BINARY_OP_8(MaxI, StoreI8(r, _mm256_max_epi32(LoadI8(a), LoadI8(b))));
+
+  // The variable shifts return 0 (or the sign) for counts of 32 or more, so the count is masked like in the 4-wide implementation.
+  DEFINE_BINARY_OP_8(ShlI, StoreI8(r, _mm256_sllv_epi32(LoadI8(a), _mm256_and_si256(LoadI8(b), _mm256_set1_epi32(31)))));
+  DEFINE_BINARY_OP_8(ShrI, StoreI8(r, _mm256_srav_epi32(LoadI8(a), _mm256_and_si256(LoadI8(b), _mm256_set1_epi32(31)))));
+  DEFINE_BINARY_OP_8(ShlI_C, StoreI8(r, _mm256_sll_epi32(LoadI8(a), _mm_cvtsi32_si128(bRaw))));
+  DEFINE_BINARY_OP_8(ShrI_C, StoreI8(r, _mm256_sra_epi32(LoadI8(a), _mm_cvtsi32_si128(bRaw))));
+  DEFINE_BINARY_OP_8(AndI, StoreI8(r, _mm256_and_si256(LoadI8(a), LoadI8(b))));
+  DEFINE_BINARY_OP_8(XorI, StoreI8(r, _mm256_xor_si256(LoadI8(a), LoadI8(b))));
+  DEFINE_BINARY_OP_8(OrI, StoreI8(r, _mm256_or_si256(LoadI8(a), LoadI8(b))));
+
+  DEFINE_BINARY_OP_8(EqF, StoreF8(r, _mm256_cmp_ps(LoadF8(a), LoadF8(b), _CMP_EQ_OQ)));
+  DEFINE_BINARY_OP_8(EqI, StoreI8(r, _mm256_cmpeq_epi32(LoadI8(a), LoadI8(b))));
+  DEFINE_BINARY_OP_8(EqB, StoreF8(r, _mm256_xor_ps(_mm256_xor_ps(LoadF8(a), LoadF8(b)), AllTrue8())));
+
+  DEFINE_BINARY_OP_8(NEqF, StoreF8(r, _mm256_cmp_ps(LoadF8(a), LoadF8(b), _CMP_NEQ_UQ)));
+  DEFINE_BINARY_OP_8(NEqI, StoreI8(r, _mm256_xor_si256(_mm256_cmpeq_epi32(LoadI8(a), LoadI8(b)), _mm256_set1_epi32(-1))));
+  DEFINE_BINARY_OP_8(NEqB, StoreF8(r, _mm256_xor_ps(LoadF8(a), LoadF8(b))));
+
+  DEFINE_BINARY_OP_8(LtF, StoreF8(r, _mm256_cmp_ps(LoadF8(a), LoadF8(b), _CMP_LT_OS)));
+  DEFINE_BINARY_OP_8(LtI, StoreI8(r, _mm256_cmpgt_epi32(LoadI8(b), LoadI8(a))));
+
+  DEFINE_BINARY_OP_8(LEqF, StoreF8(r, _mm256_cmp_ps(LoadF8(a), LoadF8(b), _CMP_LE_OS)));
+  DEFINE_BINARY_OP_8(LEqI, StoreI8(r, _mm256_xor_si256(_mm256_cmpgt_epi32(LoadI8(a), LoadI8(b)), _mm256_set1_epi32(-1))));
+
+  DEFINE_BINARY_OP_8(GtF, StoreF8(r, _mm256_cmp_ps(LoadF8(a), LoadF8(b), _CMP_GT_OS)));
+  DEFINE_BINARY_OP_8(GtI, StoreI8(r, _mm256_cmpgt_epi32(LoadI8(a), LoadI8(b))));
+
+  DEFINE_BINARY_OP_8(GEqF, StoreF8(r, _mm256_cmp_ps(LoadF8(a), LoadF8(b), _CMP_GE_OS)));
+  DEFINE_BINARY_OP_8(GEqI, StoreI8(r, _mm256_xor_si256(_mm256_cmpgt_epi32(LoadI8(b), LoadI8(a)), _mm256_set1_epi32(-1))));
+
+  DEFINE_BINARY_OP_8(AndB, StoreF8(r, _mm256_and_ps(LoadF8(a), LoadF8(b))));
+  DEFINE_BINARY_OP_8(OrB, StoreF8(r, _mm256_or_ps(LoadF8(a), LoadF8(b))));
+
+  DEFINE_TERNARY_OP_8(SelF, StoreF8(r, _mm256_blendv_ps(LoadF8(c), LoadF8(b), LoadF8(a))));
+  DEFINE_TERNARY_OP_8(SelI, StoreF8(r, _mm256_blendv_ps(LoadF8(c), LoadF8(b), LoadF8(a))));
+  DEFINE_TERNARY_OP_8(SelB, StoreF8(r, _mm256_blendv_ps(LoadF8(c), LoadF8(b), LoadF8(a))));
+
+  static constexpr OpFunc s_Simd8Funcs[] = {
+    nullptr, // Nop,
+
+    nullptr, // FirstUnary,
+
+    &AbsF_8,  // AbsF_R,
+    &AbsI_8,  // AbsI_R,
+    &SqrtF_8, // SqrtF_R,
+
+    &ExpF_4,   // ExpF_R,
+    &LnF_4,    // LnF_R,
+    &Log2F_4,  // Log2F_R,
+    &Log2I_4,  // Log2I_R,
+    &Log10F_4, // Log10F_R,
+    &Pow2F_4,  // Pow2F_R,
+
+    &SinF_4, // SinF_R,
+    &CosF_4, // CosF_R,
+    &TanF_4, // TanF_R,
+
+    &ASinF_4, // ASinF_R,
+    &ACosF_4, // ACosF_R,
+    &ATanF_4, // ATanF_R,
+
+    &RoundF_8, // RoundF_R,
+    &FloorF_8, // FloorF_R,
+    &CeilF_8,  // CeilF_R,
+    &TruncF_8, // TruncF_R,
+
+    &NotI_8, // NotI_R,
+    &NotB_8, // NotB_R,
+
+    &IToF_8, // IToF_R,
+    &FToI_8, // FToI_R,
+
+    nullptr, // LastUnary,
+    nullptr, // FirstBinary,
+
+    &AddF_8<false>, // AddF_RR,
+    &AddI_8<false>, // AddI_RR,
+
+    &SubF_8<false>, // SubF_RR,
+    &SubI_8<false>, // SubI_RR,
+
+    &MulF_8<false>, // MulF_RR,
+    &MulI_8<false>, // MulI_RR,
+
+    &DivF_8<false>, // DivF_RR,
+    &DivI_4<false>, // DivI_RR,
+
+    &MinF_8<false>, // MinF_RR,
+    &MinI_8<false>, // MinI_RR,
+
+    &MaxF_8<false>, // MaxF_RR,
+    &MaxI_8<false>, // MaxI_RR,
+
+    &ShlI_8<false>, // ShlI_RR,
+    &ShrI_8<false>, // ShrI_RR,
+    &AndI_8<false>, // AndI_RR,
+    &XorI_8<false>, // XorI_RR,
+    &OrI_8<false>,  // OrI_RR,
+
+    &EqF_8<false>, // EqF_RR,
+    &EqI_8<false>, // EqI_RR,
+    &EqB_8<false>, // EqB_RR,
+
+    &NEqF_8<false>, // NEqF_RR,
+    &NEqI_8<false>, // NEqI_RR,
+    &NEqB_8<false>, // NEqB_RR,
+
+    &LtF_8<false>, // LtF_RR,
+    &LtI_8<false>, // LtI_RR,
+
+    &LEqF_8<false>, // LEqF_RR,
+    &LEqI_8<false>, // LEqI_RR,
+
+    &GtF_8<false>, // GtF_RR,
+    &GtI_8<false>, // GtI_RR,
+
+    &GEqF_8<false>, // GEqF_RR,
+    &GEqI_8<false>, // GEqI_RR,
+
+    &AndB_8<false>, // AndB_RR,
+    &OrB_8<false>,  // OrB_RR,
+
+    nullptr, // LastBinary,
+    nullptr, // FirstBinaryWithConstant,
+
+    &AddF_8<true>, // AddF_RC,
+    &AddI_8<true>, // AddI_RC,
+
+    &SubF_8<true>, // SubF_RC,
+    &SubI_8<true>, // SubI_RC,
+
+    &MulF_8<true>, // MulF_RC,
+    &MulI_8<true>, // MulI_RC,
+
+    &DivF_8<true>, // DivF_RC,
+    &DivI_4<true>, // DivI_RC,
+
+    &MinF_8<true>, // MinF_RC,
+    &MinI_8<true>, // MinI_RC,
+
+    &MaxF_8<true>, // MaxF_RC,
+    &MaxI_8<true>, // MaxI_RC,
+
+    &ShlI_C_8<true>, // ShlI_RC,
+    &ShrI_C_8<true>, // ShrI_RC,
+    &AndI_8<true>,   // AndI_RC,
+    &XorI_8<true>,   // XorI_RC,
+    &OrI_8<true>,    // OrI_RC,
+
+    &EqF_8<true>, // EqF_RC,
+    &EqI_8<true>, // EqI_RC,
+    &EqB_8<true>, // EqB_RC
+
+    &NEqF_8<true>, // NEqF_RC,
+    &NEqI_8<true>, // NEqI_RC,
+    &NEqB_8<true>, // NEqB_RC
+
+    &LtF_8<true>, // LtF_RC,
+    &LtI_8<true>, // LtI_RC
+
+    &LEqF_8<true>, // LEqF_RC,
+    &LEqI_8<true>, // LEqI_RC
+
+    &GtF_8<true>, // GtF_RC,
+    &GtI_8<true>, // GtI_RC
+
+    &GEqF_8<true>, // GEqF_RC,
+    &GEqI_8<true>, // GEqI_RC
+
+    &AndB_8<true>, // AndB_RC,
+    &OrB_8<true>,  // OrB_RC,
+
+    nullptr, // LastBinaryWithConstant,
+    nullptr, // FirstTernary,
+
+    &SelF_8, // SelF_RRR,
+    &SelI_8, // SelI_RRR,
+    &SelB_8, // SelB_RRR,
+
+    nullptr, // LastTernary,
+    nullptr, // FirstSpecial,
+
+    &VM_MovX_R_4, // MovX_R,
+    &VM_MovX_C_4, // MovX_C,
+    &VM_LoadF_4,  // LoadF,
+    &VM_LoadI_4,  // LoadI,
+    &VM_StoreF_4, // StoreF,
+    &VM_StoreI_4, // StoreI,
+
+    &VM_Call, // Call,
+
+    nullptr, // LastSpecial,
+  };
+
+  static_assert(EZ_ARRAY_SIZE(s_Simd8Funcs) == ezExpressionByteCode::OpCode::Count);
+
+} // namespace
+
+#  undef DEFINE_TARGET_REGISTER
+#  undef DEFINE_OP_REGISTER
+#  undef DEFINE_UNARY_OP_8
+#  undef DEFINE_BINARY_OP_8
+#  undef DEFINE_TERNARY_OP_8
+#  undef EZ_AVX2_TARGET
+
+#endif
@@ -0,0 +1,107 @@
+
+template <typename MetaDataType>
+ezPerThreadMessageQueueBase<MetaDataType>::ezPerThreadMessageQueueBase(ezAllocatorBase* pAllocator)
+  : m_pAllocator(pAllocator)
+  , m_Lanes(pAllocator, &CreateLane, this)
+{
+}
+
+template <typename MetaDataType>
+ezPerThreadMessageQueueBase<MetaDataType>::~ezPerThreadMessageQueueBase()
+{
+  for (void* pLaneData : m_Lanes.GetLanes())
+  {
+    Lane* pLane = static_cast<Lane*>(pLaneData);
+    EZ_DELETE(m_pAllocator, pLane);
+  }
+
+  m_Lanes.Clear();
+}
+
+template <typename MetaDataType>
+ezUInt32 ezPerThreadMessageQueueBase<MetaDataType>::GetCount() const
+{
+  EZ_LOCK(m_Lanes.GetMutex());
+
+  ezUInt32 uiCount = 0;
+
+  for (void* pLaneData : m_Lanes.GetLanes())
+  {
+    Lane* pLane = static_cast<Lane*>(pLaneData);
+
+    EZ_LOCK(pLane->m_Mutex);
+    uiCount += pLane->m_Entries.GetCount();
+  }
+
+  return uiCount;
+}
+
+template <typename MetaDataType>
+EZ_ALWAYS_INLINE bool ezPerThreadMessageQueueBase<MetaDataType>::IsEmpty() const
+{
+  return GetCount() == 0;
+}
+
+template <typename MetaDataType>
+void ezPerThreadMessageQueueBase<MetaDataType>::Clear()
+{
+  EZ_LOCK(m_Lanes.GetMutex());
+
+  for (void* pLaneData : m_Lanes.GetLanes())
+  {
+    Lane* pLane = static_cast<Lane*>(pLaneData);
+
+    EZ_LOCK(pLane->m_Mutex);
+    pLane->m_Entries.Clear();
+  }
+}
+
+template <typename MetaDataType>
+EZ_FORCE_INLINE void ezPerThreadMessageQueueBase<MetaDataType>::Enqueue(ezMessage* pMessage, const MetaDataType& metaData)
+{
+  Lane* pLane = static_cast<Lane*>(m_Lanes.GetLaneForCurrentThread());
+
+  // only contended while the lanes are merged or cleared
+  EZ_LOCK(pLane->m_Mutex);
+
+  Entry& entry = pLane->m_Entries.ExpandAndGetRef();
+  entry.m_pMessage = pMessage;
+  entry.m_MetaData = metaData;
+  entry.m_uiMessageHash = 0;
+}
+
+template <typename MetaDataType>
+void ezPerThreadMessageQueueBase<MetaDataType>::DequeueAll(ezDynamicArrayBase<Entry>& out_entries)
+{
+  EZ_LOCK(m_Lanes.GetMutex());
+
+  for (void* pLaneData : m_Lanes.GetLanes())
+  {
+    Lane* pLane = static_cast<Lane*>(pLaneData);
+
+    EZ_LOCK(pLane->m_Mutex);
+    out_entries.PushBackRange(pLane->m_Entries);
+    pLane->m_Entries.Clear();
+  }
+}
+
+// static
+template <typename MetaDataType>
+void* ezPerThreadMessageQueueBase<MetaDataType>::CreateLane(void* pPassThrough)
+{
+  ezAllocatorBase* pAllocator = static_cast<ezPerThreadMessageQueueBase<MetaDataType>*>(pPassThrough)->m_pAllocator;
+  return EZ_NEW(pAllocator, Lane, pAllocator);
+}
+
+
+template <typename MD, typename A>
+ezPerThreadMessageQueue<MD, A>::ezPerThreadMessageQueue()
+  : ezPerThreadMessageQueueBase<MD>(A::GetAllocator())
+{
+}
+
+template <typename MD, typename A>
+ezPerThreadMessageQueue<MD, A>::ezPerThreadMessageQueue(ezAllocatorBase* pAllocator)
+  : ezPerThreadMessageQueueBase<MD>(pAllocator)
+{
+}
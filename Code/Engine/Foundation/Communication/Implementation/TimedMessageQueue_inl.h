@@ -0,0 +1,250 @@
+
+template <typename MetaDataType>
+ezTimedMessageQueueBase<MetaDataType>::ezTimedMessageQueueBase(ezAllocatorBase* pAllocator)
+  : m_Nodes(pAllocator)
+{
+  for (ezUInt32 uiLevel = 0; uiLevel < s_uiNumLevels; ++uiLevel)
+  {
+    for (ezUInt32 uiSlot = 0; uiSlot < s_uiNumSlots; ++uiSlot)
+    {
+      m_Slots[uiLevel][uiSlot] = ezInvalidIndex;
+    }
+  }
+}
+
+template <typename MetaDataType>
+ezTimedMessageQueueBase<MetaDataType>::~ezTimedMessageQueueBase() = default;
+
+template <typename MetaDataType>
+EZ_ALWAYS_INLINE ezUInt32 ezTimedMessageQueueBase<MetaDataType>::GetCount() const
+{
+  return m_uiCount;
+}
+
+template <typename MetaDataType>
+EZ_ALWAYS_INLINE bool ezTimedMessageQueueBase<MetaDataType>::IsEmpty() const
+{
+  return m_uiCount == 0;
+}
+
+template <typename MetaDataType>
+void ezTimedMessageQueueBase<MetaDataType>::Enqueue(ezMessage* pMessage, const MetaDataType& metaData)
+{
+  EZ_LOCK(m_Mutex);
+
+  ezUInt32 uiNode = m_uiFreeList;
+  if (uiNode != ezInvalidIndex)
+  {
+    m_uiFreeList = m_Nodes[uiNode].m_uiNext;
+  }
+  else
+  {
+    uiNode = m_Nodes.GetCount();
+    m_Nodes.ExpandAndGetRef();
+  }
+
+  Entry& entry = m_Nodes[uiNode].m_Entry;
+  entry.m_pMessage = pMessage;
+  entry.m_MetaData = metaData;
+  entry.m_uiMessageHash = 0;
+
+  Insert(uiNode);
+  ++m_uiCount;
+}
+
+template <typename MetaDataType>
+void ezTimedMessageQueueBase<MetaDataType>::DequeueDue(ezTime now, ezDynamicArrayBase<Entry>& out_entries)
+{
+  const ezInt64 iTargetTick = GetTick(now);
+
+  if (iTargetTick - m_iCurrentTick >= static_cast<ezInt64>(s_uiNumSlots))
+  {
+    // A full rotation of the finest level has passed, e.g. because the clock jumped ahead.
+    // Stepping through every tick could take very long, so all messages are redistributed instead.
+    ezUInt32 uiNode = UnlinkAll();
+    m_iCurrentTick = iTargetTick;
+
+    while (uiNode != ezInvalidIndex)
+    {
+      const ezUInt32 uiNext = m_Nodes[uiNode].m_uiNext;
+
+      if (m_Nodes[uiNode].m_Entry.m_MetaData.m_Due <= now)
+      {
+        MoveToOutput(uiNode, out_entries);
+      }
+      else
+      {
+        Insert(uiNode);
+      }
+
+      uiNode = uiNext;
+    }
+
+    return;
+  }
+
+  while (m_iCurrentTick < iTargetTick)
+  {
+    // all messages in the current bucket are due
+    ezUInt32& uiSlot = m_Slots[0][m_iCurrentTick & (s_uiNumSlots - 1)];
+    ezUInt32 uiNode = uiSlot;
+    uiSlot = ezInvalidIndex;
+
+    while (uiNode != ezInvalidIndex)
+    {
+      const ezUInt32 uiNext = m_Nodes[uiNode].m_uiNext;
+      MoveToOutput(uiNode, out_entries);
+      uiNode = uiNext;
+    }
+
+    ++m_iCurrentTick;
+
+    // whenever a level wraps around, the next bucket of the coarser level is distributed to the finer levels
+    for (ezUInt32 uiLevel = 1; uiLevel < s_uiNumLevels; ++uiLevel)
+    {
+      if ((static_cast<ezUInt64>(m_iCurrentTick) >> (s_uiSlotBits * (uiLevel - 1))) & (s_uiNumSlots - 1))
+        break;
+
+      Cascade(uiLevel);
+    }
+  }
+
+  // the current bucket is only partially due
+  ezUInt32* pLink = &m_Slots[0][m_iCurrentTick & (s_uiNumSlots - 1)];
+  while (*pLink != ezInvalidIndex)
+  {
+    const ezUInt32 uiNode = *pLink;
+
+    if (m_Nodes[uiNode].m_Entry.m_MetaData.m_Due <= now)
+    {
+      *pLink = m_Nodes[uiNode].m_uiNext;
+      MoveToOutput(uiNode, out_entries);
+    }
+    else
+    {
+      pLink = &m_Nodes[uiNode].m_uiNext;
+    }
+  }
+}
+
+template <typename MetaDataType>
+void ezTimedMessageQueueBase<MetaDataType>::DequeueAll(ezDynamicArrayBase<Entry>& out_entries)
+{
+  ezUInt32 uiNode = UnlinkAll();
+
+  while (uiNode != ezInvalidIndex)
+  {
+    const ezUInt32 uiNext = m_Nodes[uiNode].m_uiNext;
+    MoveToOutput(uiNode, out_entries);
+    uiNode = uiNext;
+  }
+
+  EZ_ASSERT_DEBUG(m_uiCount == 0, "Implementation error");
+
+  m_Nodes.Clear();
+  m_uiFreeList = ezInvalidIndex;
+}
+
+template <typename MetaDataType>
+EZ_ALWAYS_INLINE void ezTimedMessageQueueBase<MetaDataType>::Lock()
+{
+  m_Mutex.Lock();
+}
+
+template <typename MetaDataType>
+EZ_ALWAYS_INLINE void ezTimedMessageQueueBase<MetaDataType>::Unlock()
+{
+  m_Mutex.Unlock();
+}
+
+// static
+template <typename MetaDataType>
+EZ_ALWAYS_INLINE ezInt64 ezTimedMessageQueueBase<MetaDataType>::GetTick(ezTime time)
+{
+  return static_cast<ezInt64>(ezMath::Floor(time.GetSeconds() * s_fTicksPerSecond));
+}
+
+template <typename MetaDataType>
+void ezTimedMessageQueueBase<MetaDataType>::Insert(ezUInt32 uiNode)
+{
+  constexpr ezUInt64 uiMaxDelta = (1ull << (s_uiSlotBits * s_uiNumLevels)) - 1;
+
+  const ezInt64 iTick = ezMath::Max(GetTick(m_Nodes[uiNode].m_Entry.m_MetaData.m_Due), m_iCurrentTick);
+
+  // messages beyond the range of the wheel are put into the last bucket and get redistributed when it is reached
+  const ezUInt64 uiDelta = ezMath::Min(static_cast<ezUInt64>(iTick - m_iCurrentTick), uiMaxDelta);
+  const ezUInt64 uiTick = static_cast<ezUInt64>(m_iCurrentTick) + uiDelta;
+
+  ezUInt32 uiLevel = 0;
+  while (uiDelta >= (1ull << (s_uiSlotBits * (uiLevel + 1))))
+  {
+    ++uiLevel;
+  }
+
+  ezUInt32& uiSlot = m_Slots[uiLevel][(uiTick >> (s_uiSlotBits * uiLevel)) & (s_uiNumSlots - 1)];
+  m_Nodes[uiNode].m_uiNext = uiSlot;
+  uiSlot = uiNode;
+}
+
+template <typename MetaDataType>
+void ezTimedMessageQueueBase<MetaDataType>::Cascade(ezUInt32 uiLevel)
+{
+  ezUInt32& uiSlot = m_Slots[uiLevel][(static_cast<ezUInt64>(m_iCurrentTick) >> (s_uiSlotBits * uiLevel)) & (s_uiNumSlots - 1)];
+  ezUInt32 uiNode = uiSlot;
+  uiSlot = ezInvalidIndex;
+
+  while (uiNode != ezInvalidIndex)
+  {
+    const ezUInt32 uiNext = m_Nodes[uiNode].m_uiNext;
+    Insert(uiNode);
+    uiNode = uiNext;
+  }
+}
+
+template <typename MetaDataType>
+EZ_ALWAYS_INLINE void ezTimedMessageQueueBase<MetaDataType>::MoveToOutput(ezUInt32 uiNode, ezDynamicArrayBase<Entry>& out_entries)
+{
+  out_entries.PushBack(m_Nodes[uiNode].m_Entry);
+
+  m_Nodes[uiNode].m_uiNext = m_uiFreeList;
+  m_uiFreeList = uiNode;
+  --m_uiCount;
+}
+
+template <typename MetaDataType>
+ezUInt32 ezTimedMessageQueueBase<MetaDataType>::UnlinkAll()
+{
+  ezUInt32 uiFirstNode = ezInvalidIndex;
+
+  for (ezUInt32 uiLevel = 0; uiLevel < s_uiNumLevels; ++uiLevel)
+  {
+    for (ezUInt32 uiSlot = 0; uiSlot < s_uiNumSlots; ++uiSlot)
+    {
+      ezUInt32 uiNode = m_Slots[uiLevel][uiSlot];
+      m_Slots[uiLevel][uiSlot] = ezInvalidIndex;
+
+      while (uiNode != ezInvalidIndex)
+      {
+        const ezUInt32 uiNext = m_Nodes[uiNode].m_uiNext;
+        m_Nodes[uiNode].m_uiNext = uiFirstNode;
+        uiFirstNode = uiNode;
+        uiNode = uiNext;
+      }
+    }
+  }
+
+  return uiFirstNode;
+}
+
+
+template <typename MD, typename A>
+ezTimedMessageQueue<MD, A>::ezTimedMessageQueue()
+  : ezTimedMessageQueueBase<MD>(A::GetAllocator())
+{
+}
+
+template <typename MD, typename A>
+ezTimedMessageQueue<MD, A>::ezTimedMessageQueue(ezAllocatorBase* pAllocator)
+  : ezTimedMessageQueueBase<MD>(pAllocator)
+{
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Foundation/Communication/MessageQueue.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/PerThreadLanes.h>
+
+/// \brief A message queue that many threads can enqueue into without contending with each other.
+///
+/// Every thread that enqueues a message gets its own array of entries (a 'lane'), which is found through ezPerThreadLanes.
+/// The very first Enqueue() of a thread locks a shared mutex to create its lane. After that a thread only locks the mutex of its
+/// own lane, which is uncontended unless DequeueAll() or Clear() run at the same time.
+/// DequeueAll() merges the entries of all lanes, in no particular order, so the caller needs to sort them if deterministic
+/// processing order is required.
+///
+/// All methods are thread safe. Lifetime of the enqueued messages needs to be managed by the user.
+/// \see ezMessageQueue
+template <typename MetaDataType>
+class ezPerThreadMessageQueueBase
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezPerThreadMessageQueueBase);
+
+public:
+  using Entry = typename ezMessageQueueBase<MetaDataType>::Entry;
+
+protected:
+  /// \brief No memory is allocated during construction.
+  ezPerThreadMessageQueueBase(ezAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Destructor.
+  ~ezPerThreadMessageQueueBase(); // [tested]
+
+public:
+  /// \brief Returns the number of messages in all lanes.
+  ezUInt32 GetCount() const; // [tested]
+
+  /// \brief Returns true, if no lane contains any messages.
+  bool IsEmpty() const; // [tested]
+
+  /// \brief Removes all messages from the queue. Does not deallocate any data.
+  void Clear(); // [tested]
+
+  /// \brief Enqueues the given message and meta-data into the lane of the calling thread.
+  void Enqueue(ezMessage* pMessage, const MetaDataType& metaData); // [tested]
+
+  /// \brief Removes the messages of all lanes and appends them to out_entries in no particular order.
+  void DequeueAll(ezDynamicArrayBase<Entry>& out_entries); // [tested]
+
+private:
+  struct Lane
+  {
+    Lane(ezAllocatorBase* pAllocator)
+      : m_Entries(pAllocator)
+    {
+    }
+
+    ezMutex m_Mutex;
+    ezDynamicArray<Entry, ezNullAllocatorWrapper> m_Entries;
+  };
+
+  static void* CreateLane(void* pPassThrough);
+
+  ezAllocatorBase* m_pAllocator = nullptr;
+  ezPerThreadLanes m_Lanes;
+};
+
+/// \brief \see ezPerThreadMessageQueueBase
+template <typename MetaDataType, typename AllocatorWrapper = ezDefaultAllocatorWrapper>
+class ezPerThreadMessageQueue : public ezPerThreadMessageQueueBase<MetaDataType>
+{
+public:
+  ezPerThreadMessageQueue();
+  ezPerThreadMessageQueue(ezAllocatorBase* pAllocator);
+};
+
+#include <Foundation/Communication/Implementation/PerThreadMessageQueue_inl.h>
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Foundation/Communication/MessageQueue.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Time/Time.h>
+
+/// \brief A queue for messages that are due at a certain point in time, implemented as a hierarchical timing wheel.
+///
+/// MetaDataType needs an ezTime member called m_Due. Enqueuing a message is O(1) and DequeueDue() only touches the buckets that
+/// became due since the last call, so the cost does not depend on the number of messages that are still pending. Messages
+/// further in the future are kept in coarser buckets and are moved to finer buckets once their time comes closer.
+///
+/// DequeueDue() returns the due messages in no particular order, the caller is responsible for sorting them if deterministic
+/// processing order is required.
+///
+/// Enqueue is thread safe, all other methods are not. To ensure thread safety for all methods the queue can be locked using
+/// ezLock like a mutex. Lifetime of the enqueued messages needs to be managed by the user.
+/// \see ezMessageQueue
+template <typename MetaDataType>
+class ezTimedMessageQueueBase
+{
+public:
+  using Entry = typename ezMessageQueueBase<MetaDataType>::Entry;
+
+protected:
+  /// \brief No memory is allocated during construction.
+  ezTimedMessageQueueBase(ezAllocatorBase* pAllocator); // [tested]
+
+  /// \brief Destructor.
+  ~ezTimedMessageQueueBase(); // [tested]
+
+public:
+  /// \brief Returns the number of messages in the queue.
+  ezUInt32 GetCount() const; // [tested]
+
+  /// \brief Returns true, if the queue does not contain any messages.
+  bool IsEmpty() const; // [tested]
+
+  /// \brief Enqueues the given message, which will be due at metaData.m_Due. This method is thread safe.
+  void Enqueue(ezMessage* pMessage, const MetaDataType& metaData); // [tested]
+
+  /// \brief Removes all messages that are due at the given time from the queue and appends them to out_entries in no particular order.
+  /// Not thread safe.
+  void DequeueDue(ezTime now, ezDynamicArrayBase<Entry>& out_entries); // [tested]
+
+  /// \brief Removes all messages from the queue and appends them to out_entries in no particular order. Not thread safe.
+  void DequeueAll(ezDynamicArrayBase<Entry>& out_entries); // [tested]
+
+  /// \brief Acquires an exclusive lock on the queue. Do not use this method directly but use ezLock instead.
+  void Lock();
+
+  /// \brief Releases a lock that has been previously acquired. Do not use this method directly but use ezLock instead.
+  void Unlock();
+
+private:
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezTimedMessageQueueBase);
+
+  static constexpr ezUInt32 s_uiSlotBits = 8;
+  static constexpr ezUInt32 s_uiNumSlots = 1 << s_uiSlotBits;
+  static constexpr ezUInt32 s_uiNumLevels = 4;
+
+  /// The width of a bucket in the finest level. With 4 levels of 256 buckets the wheel covers more than two years.
+  static constexpr double s_fTicksPerSecond = 64.0;
+
+  struct Node
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    Entry m_Entry;
+    ezUInt32 m_uiNext;
+  };
+
+  static ezInt64 GetTick(ezTime time);
+
+  void Insert(ezUInt32 uiNode);
+  void Cascade(ezUInt32 uiLevel);
+  void MoveToOutput(ezUInt32 uiNode, ezDynamicArrayBase<Entry>& out_entries);
+  ezUInt32 UnlinkAll();
+
+  ezDynamicArray<Node, ezNullAllocatorWrapper> m_Nodes;
+  ezUInt32 m_uiFreeList = ezInvalidIndex;
+  ezUInt32 m_uiCount = 0;
+
+  /// All ticks before this one have been processed.
+  ezInt64 m_iCurrentTick = 0;
+
+  /// Index of the first node in each bucket, the nodes are linked through m_uiNext.
+  ezUInt32 m_Slots[s_uiNumLevels][s_uiNumSlots];
+
+  ezMutex m_Mutex;
+};
+
+/// \brief \see ezTimedMessageQueueBase
+template <typename MetaDataType, typename AllocatorWrapper = ezDefaultAllocatorWrapper>
+class ezTimedMessageQueue : public ezTimedMessageQueueBase<MetaDataType>
+{
+public:
+  ezTimedMessageQueue();
+  ezTimedMessageQueue(ezAllocatorBase* pAllocator);
+};
+
+#include <Foundation/Communication/Implementation/TimedMessageQueue_inl.h>
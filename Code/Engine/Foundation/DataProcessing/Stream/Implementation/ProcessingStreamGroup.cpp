@@ -6,6 +6,42 @@
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Memory/MemoryUtils.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+namespace
+{
+  /// The chunk which is currently processed on this thread, used to redirect RemoveElement() calls to the pending removes of that chunk.
+  struct ChunkContext
+  {
+    const ezProcessingStreamGroup* m_pStreamGroup = nullptr;
+    ezUInt64 m_uiStartIndex = 0;
+    ezUInt64 m_uiEndIndex = 0;
+    ezDynamicArray<ezUInt64>* m_pPendingRemoveIndices = nullptr;
+  };
+
+  thread_local ChunkContext* tl_pCurrentChunk = nullptr;
+
+  bool ContainsSorted(ezArrayPtr<const ezUInt64> sortedIndices, ezUInt64 uiIndex)
+  {
+    ezUInt32 uiLow = 0;
+    ezUInt32 uiHigh = sortedIndices.GetCount();
+
+    while (uiLow < uiHigh)
+    {
+      const ezUInt32 uiMid = uiLow + (uiHigh - uiLow) / 2;
+      if (sortedIndices[uiMid] < uiIndex)
+      {
+        uiLow = uiMid + 1;
+      }
+      else
+      {
+        uiHigh = uiMid;
+      }
+    }
+
+    return uiLow < sortedIndices.GetCount() && sortedIndices[uiLow] == uiIndex;
+  }
+} // namespace
 
 ezProcessingStreamGroup::ezProcessingStreamGroup()
 {
@@ -142,6 +178,19 @@ void ezProcessingStreamGroup::SetSize(ezUInt64 uiNumElements)
 /// processors).
 void ezProcessingStreamGroup::RemoveElement(ezUInt64 uiElementIndex)
 {
+  if (tl_pCurrentChunk != nullptr && tl_pCurrentChunk->m_pStreamGroup == this)
+  {
+    EZ_ASSERT_DEBUG(uiElementIndex >= tl_pCurrentChunk->m_uiStartIndex && uiElementIndex < tl_pCurrentChunk->m_uiEndIndex,
+      "Chunk safe processors may only remove elements of the chunk that is being processed");
+
+    if (!tl_pCurrentChunk->m_pPendingRemoveIndices->Contains(uiElementIndex))
+    {
+      tl_pCurrentChunk->m_pPendingRemoveIndices->PushBack(uiElementIndex);
+    }
+
+    return;
+  }
+
   if (m_PendingRemoveIndices.Contains(uiElementIndex))
     return;
 
@@ -161,10 +210,27 @@ void ezProcessingStreamGroup::Process()
 {
   EnsureStreamAssignmentValid();
 
+  const bool bUseChunks = m_uiChunkSize > 0 && m_uiNumActiveElements > m_uiChunkSize;
+
   // TODO: Identify which processors work on which streams and find independent groups and use separate tasks for them?
-  for (ezProcessingStreamProcessor* pStreamProcessor : m_Processors)
+  for (ezUInt32 i = 0; i < m_Processors.GetCount();)
   {
-    pStreamProcessor->Process(m_uiNumActiveElements);
+    if (!bUseChunks || !m_Processors[i]->IsChunkSafe())
+    {
+      m_Processors[i]->Process(m_uiNumActiveElements);
+      ++i;
+      continue;
+    }
+
+    // process all consecutive chunk safe processors in one go, so that each chunk stays in the cache of one thread
+    ezUInt32 uiEnd = i + 1;
+    while (uiEnd < m_Processors.GetCount() && m_Processors[uiEnd]->IsChunkSafe())
+    {
+      ++uiEnd;
+    }
+
+    ProcessChunks(m_Processors.GetArrayPtr().GetSubArray(i, uiEnd - i));
+    i = uiEnd;
   }
 
   // Run any pending deletions which happened due to stream processor execution
@@ -175,6 +241,72 @@ void ezProcessingStreamGroup::Process()
   RunPendingSpawns();
 }
 
+void ezProcessingStreamGroup::ProcessChunks(ezArrayPtr<ezProcessingStreamProcessor*> processors)
+{
+  const ezUInt64 uiNumElements = m_uiNumActiveElements;
+  const ezUInt32 uiNumChunks = static_cast<ezUInt32>((uiNumElements + m_uiChunkSize - 1) / m_uiChunkSize);
+
+  if (m_ChunkPendingRemoveIndices.GetCount() < uiNumChunks)
+  {
+    m_ChunkPendingRemoveIndices.SetCount(uiNumChunks);
+  }
+
+  for (ezProcessingStreamProcessor* pStreamProcessor : processors)
+  {
+    pStreamProcessor->PrepareChunks(uiNumChunks);
+  }
+
+  ezTaskSystem::ParallelForIndexed(
+    0u, uiNumChunks,
+    [&](ezUInt32 uiStartChunk, ezUInt32 uiEndChunk) {
+      ChunkContext* pPreviousChunk = tl_pCurrentChunk;
+
+      ChunkContext chunk;
+      chunk.m_pStreamGroup = this;
+      tl_pCurrentChunk = &chunk;
+
+      for (ezUInt32 uiChunk = uiStartChunk; uiChunk < uiEndChunk; ++uiChunk)
+      {
+        chunk.m_uiStartIndex = uiChunk * m_uiChunkSize;
+        chunk.m_uiEndIndex = ezMath::Min(chunk.m_uiStartIndex + m_uiChunkSize, uiNumElements);
+        chunk.m_pPendingRemoveIndices = &m_ChunkPendingRemoveIndices[uiChunk];
+
+        for (ezProcessingStreamProcessor* pStreamProcessor : processors)
+        {
+          pStreamProcessor->ProcessChunk(uiChunk, chunk.m_uiStartIndex, chunk.m_uiEndIndex - chunk.m_uiStartIndex);
+        }
+      }
+
+      tl_pCurrentChunk = pPreviousChunk;
+    },
+    "ezProcessingStreamGroup::ProcessChunks");
+
+  for (ezProcessingStreamProcessor* pStreamProcessor : processors)
+  {
+    pStreamProcessor->FinishChunks();
+  }
+
+  // Merge the removals of all chunks in chunk order, so that the result does not depend on the thread scheduling.
+  // Each index can only be in one chunk, so duplicates are only possible with removals of the serially executed processors.
+  // Those are looked up in a sorted copy, the order of the pending removals itself is kept.
+  ezHybridArray<ezUInt64, 64> sortedSerialRemoveIndices(m_PendingRemoveIndices);
+  sortedSerialRemoveIndices.Sort();
+
+  for (ezUInt32 uiChunk = 0; uiChunk < uiNumChunks; ++uiChunk)
+  {
+    ezDynamicArray<ezUInt64>& chunkRemoveIndices = m_ChunkPendingRemoveIndices[uiChunk];
+
+    for (ezUInt64 uiElementIndex : chunkRemoveIndices)
+    {
+      if (!ContainsSorted(sortedSerialRemoveIndices, uiElementIndex))
+      {
+        m_PendingRemoveIndices.PushBack(uiElementIndex);
+      }
+    }
+
+    chunkRemoveIndices.Clear();
+  }
+}
 
 void ezProcessingStreamGroup::RunPendingDeletions()
 {
@@ -18,6 +18,10 @@ ezProcessingStreamProcessor::~ezProcessingStreamProcessor()
   m_pStreamGroup = nullptr;
 }
 
+void ezProcessingStreamProcessor::ProcessChunk(ezUInt32 uiChunkIndex, ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
+{
+  EZ_REPORT_FAILURE("'{}' is marked as chunk safe, but does not implement ProcessChunk()", GetDynamicRTTI()->GetTypeName());
+}
 
 
 EZ_STATICLINK_FILE(Foundation, Foundation_DataProcessing_Stream_Implementation_ProcessingStreamProcessor);
@@ -3,6 +3,7 @@
 
 #include <Foundation/Basics.h>
 #include <Foundation/Communication/Event.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStream.h>
 
@@ -56,6 +57,16 @@ public:
   /// \brief Resizes all streams to contain storage for uiNumElements. Any pending remove and spawn operations will be reset!
   void SetSize(ezUInt64 uiNumElements);
 
+  /// \brief Enables processing the elements in chunks of the given size on multiple threads. 0 disables it, which is the default.
+  ///
+  /// When the number of active elements exceeds the chunk size, consecutive chunk safe processors (see ezProcessingStreamProcessor::IsChunkSafe())
+  /// are executed chunk by chunk in parallel. All other processors, as well as removing and spawning elements, still run serially.
+  /// The setting is kept when the stream group is cleared.
+  void SetChunkSize(ezUInt64 uiChunkSize) { m_uiChunkSize = uiChunkSize; }
+
+  /// \brief Returns the value set through SetChunkSize().
+  ezUInt64 GetChunkSize() const { return m_uiChunkSize; }
+
   /// \brief Removes an element (e.g. due to the death of a particle etc.), this will be enqueued (and thus is safe to be called from within data
   /// processors).
   void RemoveElement(ezUInt64 uiElementIndex);
@@ -89,12 +100,20 @@ private:
 
   void SortProcessorsByPriority();
 
+  /// \brief Runs the given chunk safe processors on all chunks in parallel and merges the elements they removed afterwards.
+  void ProcessChunks(ezArrayPtr<ezProcessingStreamProcessor*> processors);
+
   ezHybridArray<ezProcessingStreamProcessor*, 8> m_Processors;
 
   ezHybridArray<ezProcessingStream*, 8> m_DataStreams;
 
   ezHybridArray<ezUInt64, 64> m_PendingRemoveIndices;
 
+  /// Elements removed by the processors while processing chunks, one array per chunk, so that no synchronization is needed.
+  ezDynamicArray<ezDynamicArray<ezUInt64>> m_ChunkPendingRemoveIndices;
+
+  ezUInt64 m_uiChunkSize = 0;
+
   ezUInt64 m_uiPendingNumberOfElementsToSpawn;
 
   ezUInt64 m_uiNumElements;
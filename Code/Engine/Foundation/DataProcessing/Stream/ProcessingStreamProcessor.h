@@ -21,6 +21,13 @@ public:
   /// Used for sorting processors, to ensure a certain order. Lower priority == executed first.
   float m_fPriority = 0.0f;
 
+  /// \brief Returns true, if the processor only reads and writes the elements it is called for, so that disjoint ranges of elements can be processed
+  /// on different threads at the same time.
+  ///
+  /// Chunk safe processors must implement PrepareChunks(), ProcessChunk() and FinishChunks(). Removing elements through the stream group is allowed
+  /// from within ProcessChunk(), as long as only elements of the given range are removed.
+  virtual bool IsChunkSafe() const { return false; }
+
 protected:
   friend class ezProcessingStreamGroup;
 
@@ -35,6 +42,17 @@ protected:
   /// \brief The actual method which processes the data, will be called with the number of elements to process.
   virtual void Process(ezUInt64 uiNumElements) = 0;
 
+  /// \brief Called once before the chunks of one processing step are processed. Shared state (e.g. values which are the same for all elements)
+  /// should be updated here, and storage for per chunk results can be prepared.
+  virtual void PrepareChunks(ezUInt32 uiNumChunks) {}
+
+  /// \brief Processes the elements in the range [uiStartIndex; uiStartIndex + uiNumElements). Only called for chunk safe processors, possibly on
+  /// multiple threads at the same time.
+  virtual void ProcessChunk(ezUInt32 uiChunkIndex, ezUInt64 uiStartIndex, ezUInt64 uiNumElements);
+
+  /// \brief Called once after all chunks of one processing step are done. Per chunk results should be merged here.
+  virtual void FinishChunks() {}
+
   /// \brief Back pointer to the stream group - will be set to the owner stream group when adding the stream processor to the group.
   /// Can be used to get stream pointers in UpdateStreamBindings();
   ezProcessingStreamGroup* m_pStreamGroup = nullptr;
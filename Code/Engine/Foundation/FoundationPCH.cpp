@@ -30,6 +30,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_CodeUtils_Expression_Implementation_ExpressionByteCode);
   EZ_STATICLINK_REFERENCE(Foundation_CodeUtils_Expression_Implementation_ExpressionCompiler);
   EZ_STATICLINK_REFERENCE(Foundation_CodeUtils_Expression_Implementation_ExpressionDeclarations);
+  EZ_STATICLINK_REFERENCE(Foundation_CodeUtils_Expression_Implementation_ExpressionJIT);
   EZ_STATICLINK_REFERENCE(Foundation_CodeUtils_Expression_Implementation_ExpressionParser);
   EZ_STATICLINK_REFERENCE(Foundation_CodeUtils_Expression_Implementation_ExpressionVM);
   EZ_STATICLINK_REFERENCE(Foundation_CodeUtils_Implementation_Conditions);
@@ -123,6 +124,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_MemoryTracker);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_MemoryUtils);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_PageAllocator);
+  EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_PerThreadStackAllocator);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Policies_GuardedAllocation);
   EZ_STATICLINK_REFERENCE(Foundation_Profiling_Implementation_Profiling);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_DynamicRTTI);
@@ -164,6 +166,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_ConditionVariable);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_OSThread);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_ParallelFor);
+  EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_PerThreadLanes);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_Semaphore);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_Task);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskGroup);
@@ -172,6 +175,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskSystemTasks);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskSystemThreads);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskSystemUtils);
+  EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskWorkStealingQueues);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_TaskWorkerThread);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_Thread);
   EZ_STATICLINK_REFERENCE(Foundation_Threading_Implementation_ThreadSignal);
@@ -101,6 +101,40 @@ ezStringDeduplicationReadContext::ezStringDeduplicationReadContext(ezStreamReade
   SetContext(this);
 }
 
+ezStringDeduplicationReadContext::ezStringDeduplicationReadContext(ezArrayPtr<const ezUInt8> data, ezUInt32& out_uiStringTableSize)
+  : ezSerializationContext()
+{
+  // We set the context manually to nullptr to get the original string table
+  SetContext(nullptr);
+
+  ezRawMemoryStreamReader stream(data.GetPtr(), data.GetCount());
+
+  /*auto version =*/stream.ReadVersion(s_uiStringDeduplicationVersion);
+
+  ezUInt64 uiNumEntries = 0;
+  stream >> uiNumEntries;
+
+  m_StringOffsets.Reserve(static_cast<ezUInt32>(uiNumEntries));
+
+  // Only remember where each string starts, the views are created on demand
+  for (ezUInt64 i = 0; i < uiNumEntries; ++i)
+  {
+    m_StringOffsets.PushBackUnchecked(static_cast<ezUInt32>(stream.GetReadPosition()));
+
+    ezUInt32 uiLength = 0;
+    stream >> uiLength;
+
+    const ezUInt64 uiSkipped = stream.SkipBytes(uiLength);
+    EZ_ASSERT_DEV(uiSkipped == uiLength, "The string table is truncated.");
+    EZ_IGNORE_UNUSED(uiSkipped);
+  }
+
+  out_uiStringTableSize = static_cast<ezUInt32>(stream.GetReadPosition());
+  m_StringTable = data.GetSubArray(0, out_uiStringTableSize);
+
+  SetContext(this);
+}
+
 ezStringDeduplicationReadContext::~ezStringDeduplicationReadContext() = default;
 
 ezStringView ezStringDeduplicationReadContext::DeserializeString(ezStreamReader& ref_reader)
@@ -108,6 +142,18 @@ ezStringView ezStringDeduplicationReadContext::DeserializeString(ezStreamReader&
   ezUInt32 uiIndex;
   ref_reader >> uiIndex;
 
+  if (!m_StringTable.IsEmpty())
+  {
+    const ezUInt8* pString = m_StringTable.GetPtr() + m_StringOffsets[uiIndex];
+
+    ezRawMemoryStreamReader stringReader(pString, sizeof(ezUInt32));
+
+    ezUInt32 uiLength = 0;
+    stringReader >> uiLength;
+
+    return ezStringView(reinterpret_cast<const char*>(pString + sizeof(ezUInt32)), uiLength);
+  }
+
   return m_DeduplicatedStrings[uiIndex].GetView();
 }
 
@@ -56,6 +56,14 @@ class EZ_FOUNDATION_DLL ezStringDeduplicationReadContext : public ezSerializatio
 public:
   /// \brief Setup the string table used internally.
   ezStringDeduplicationReadContext(ezStreamReader& inout_stream);
+
+  /// \brief Sets up the string table directly on top of the given memory, which has to start with the string table, e.g. a memory mapped file.
+  ///
+  /// The strings are not copied, only their locations are stored. DeserializeString() returns views into the given memory,
+  /// so it must stay valid and unchanged as long as this context is used.
+  /// \a out_uiStringTableSize returns the size of the string table in bytes, the deduplicated data follows directly after it.
+  ezStringDeduplicationReadContext(ezArrayPtr<const ezUInt8> data, ezUInt32& out_uiStringTableSize);
+
   ~ezStringDeduplicationReadContext();
 
   /// \brief Internal method to deserialize a string.
@@ -63,4 +71,8 @@ public:
 
 protected:
   ezDynamicArray<ezHybridString<64>> m_DeduplicatedStrings;
+
+  // Only used when the strings are referenced in place. Stores the offset of every string into m_StringTable.
+  ezArrayPtr<const ezUInt8> m_StringTable;
+  ezDynamicArray<ezUInt32> m_StringOffsets;
 };
@@ -60,6 +60,11 @@ public:
 
   void Clear();
 
+  /// \brief Makes sure that the array of blocks doesn't need to grow before uiCount objects are stored.
+  ///
+  /// The blocks themselves are still taken from the block allocator on demand.
+  void Reserve(ezUInt32 uiCount);
+
   T* Create();
   void Delete(T* pObject);
   void Delete(T* pObject, T*& out_pMovedObject);
@@ -1,14 +1,27 @@
 #pragma once
 
+#include <Foundation/Memory/PerThreadStackAllocator.h>
 #include <Foundation/Memory/StackAllocator.h>
 
+/// \brief Describes how a double buffered stack allocator handles allocations from multiple threads.
+struct ezStackAllocatorThreading
+{
+  enum Enum : ezUInt8
+  {
+    SharedStack,    ///< All threads allocate from one stack, which is protected by a mutex.
+    PerThreadLanes, ///< Every thread allocates from its own lane without any locks or atomics. See ezPerThreadStackAllocator.
+
+    Default = SharedStack
+  };
+};
+
 /// \brief A double buffered stack allocator
 class EZ_FOUNDATION_DLL ezDoubleBufferedStackAllocator
 {
 public:
   using StackAllocatorType = ezStackAllocator<ezMemoryTrackingFlags::RegisterAllocator>;
 
-  ezDoubleBufferedStackAllocator(ezStringView sName, ezAllocatorBase* pParent);
+  ezDoubleBufferedStackAllocator(ezStringView sName, ezAllocatorBase* pParent, ezStackAllocatorThreading::Enum threading = ezStackAllocatorThreading::Default);
   ~ezDoubleBufferedStackAllocator();
 
   EZ_ALWAYS_INLINE ezAllocatorBase* GetCurrentAllocator() const { return m_pCurrentAllocator; }
@@ -16,9 +29,17 @@ public:
   void Swap();
   void Reset();
 
+  EZ_ALWAYS_INLINE ezStackAllocatorThreading::Enum GetThreading() const { return m_Threading; }
+
+  /// \brief Returns the per-thread statistics of the current allocator. Only available in ezStackAllocatorThreading::PerThreadLanes mode, otherwise the array is left empty.
+  void GetCurrentLaneStats(ezDynamicArray<ezPerThreadStackAllocator::LaneStats>& out_stats) const;
+
 private:
-  StackAllocatorType* m_pCurrentAllocator;
-  StackAllocatorType* m_pOtherAllocator;
+  void ResetAllocator(ezAllocatorBase* pAllocator);
+
+  ezStackAllocatorThreading::Enum m_Threading;
+  ezAllocatorBase* m_pCurrentAllocator;
+  ezAllocatorBase* m_pOtherAllocator;
 };
 
 class EZ_FOUNDATION_DLL ezFrameAllocator
@@ -29,6 +50,16 @@ public:
   static void Swap();
   static void Reset();
 
+  /// \brief Switches the frame allocator between a single mutex protected stack and per-thread lanes.
+  ///
+  /// This recreates the underlying allocators, so it must only be called when no frame allocations are in use anymore
+  /// and no other thread allocates from the frame allocator, e.g. right at startup or directly after Reset().
+  static void SetThreading(ezStackAllocatorThreading::Enum threading);
+  static ezStackAllocatorThreading::Enum GetThreading();
+
+  /// \brief Returns the per-thread statistics of this frame. See ezDoubleBufferedStackAllocator::GetCurrentLaneStats().
+  static void GetCurrentLaneStats(ezDynamicArray<ezPerThreadStackAllocator::LaneStats>& out_stats);
+
 private:
   EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, FrameAllocator);
 
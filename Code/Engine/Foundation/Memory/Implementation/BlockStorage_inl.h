@@ -143,6 +143,13 @@ void ezBlockStorage<T, BlockSize, StorageType>::Clear()
   m_Blocks.Clear();
 }
 
+template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
+void ezBlockStorage<T, BlockSize, StorageType>::Reserve(ezUInt32 uiCount)
+{
+  const ezUInt32 uiNumBlocks = (uiCount + ezDataBlock<T, BlockSize>::CAPACITY - 1) / ezDataBlock<T, BlockSize>::CAPACITY;
+  m_Blocks.Reserve(uiNumBlocks);
+}
+
 template <typename T, ezUInt32 BlockSize, ezBlockStorageType::Enum StorageType>
 T* ezBlockStorage<T, BlockSize, StorageType>::Create()
 {
@@ -5,17 +5,24 @@
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Strings/StringBuilder.h>
 
-ezDoubleBufferedStackAllocator::ezDoubleBufferedStackAllocator(ezStringView sName0, ezAllocatorBase* pParent)
+ezDoubleBufferedStackAllocator::ezDoubleBufferedStackAllocator(ezStringView sName0, ezAllocatorBase* pParent, ezStackAllocatorThreading::Enum threading)
+  : m_Threading(threading)
 {
   ezStringBuilder sName = sName0;
   sName.Append("0");
 
-  m_pCurrentAllocator = EZ_DEFAULT_NEW(StackAllocatorType, sName, pParent);
+  if (m_Threading == ezStackAllocatorThreading::PerThreadLanes)
+    m_pCurrentAllocator = EZ_DEFAULT_NEW(ezPerThreadStackAllocator, sName, pParent);
+  else
+    m_pCurrentAllocator = EZ_DEFAULT_NEW(StackAllocatorType, sName, pParent);
 
   sName = sName0;
   sName.Append("1");
 
-  m_pOtherAllocator = EZ_DEFAULT_NEW(StackAllocatorType, sName, pParent);
+  if (m_Threading == ezStackAllocatorThreading::PerThreadLanes)
+    m_pOtherAllocator = EZ_DEFAULT_NEW(ezPerThreadStackAllocator, sName, pParent);
+  else
+    m_pOtherAllocator = EZ_DEFAULT_NEW(StackAllocatorType, sName, pParent);
 }
 
 ezDoubleBufferedStackAllocator::~ezDoubleBufferedStackAllocator()
@@ -28,13 +35,31 @@ void ezDoubleBufferedStackAllocator::Swap()
 {
   ezMath::Swap(m_pCurrentAllocator, m_pOtherAllocator);
 
-  m_pCurrentAllocator->Reset();
+  ResetAllocator(m_pCurrentAllocator);
 }
 
 void ezDoubleBufferedStackAllocator::Reset()
 {
-  m_pCurrentAllocator->Reset();
-  m_pOtherAllocator->Reset();
+  ResetAllocator(m_pCurrentAllocator);
+  ResetAllocator(m_pOtherAllocator);
+}
+
+void ezDoubleBufferedStackAllocator::GetCurrentLaneStats(ezDynamicArray<ezPerThreadStackAllocator::LaneStats>& out_stats) const
+{
+  out_stats.Clear();
+
+  if (m_Threading == ezStackAllocatorThreading::PerThreadLanes)
+  {
+    static_cast<ezPerThreadStackAllocator*>(m_pCurrentAllocator)->GetLaneStats(out_stats);
+  }
+}
+
+void ezDoubleBufferedStackAllocator::ResetAllocator(ezAllocatorBase* pAllocator)
+{
+  if (m_Threading == ezStackAllocatorThreading::PerThreadLanes)
+    static_cast<ezPerThreadStackAllocator*>(pAllocator)->Reset();
+  else
+    static_cast<StackAllocatorType*>(pAllocator)->Reset();
 }
 
 
@@ -73,6 +98,28 @@ void ezFrameAllocator::Reset()
   }
 }
 
+// static
+void ezFrameAllocator::SetThreading(ezStackAllocatorThreading::Enum threading)
+{
+  if (s_pAllocator == nullptr || s_pAllocator->GetThreading() == threading)
+    return;
+
+  EZ_DEFAULT_DELETE(s_pAllocator);
+  s_pAllocator = EZ_DEFAULT_NEW(ezDoubleBufferedStackAllocator, "FrameAllocator", ezFoundation::GetAlignedAllocator(), threading);
+}
+
+// static
+ezStackAllocatorThreading::Enum ezFrameAllocator::GetThreading()
+{
+  return s_pAllocator != nullptr ? s_pAllocator->GetThreading() : ezStackAllocatorThreading::Default;
+}
+
+// static
+void ezFrameAllocator::GetCurrentLaneStats(ezDynamicArray<ezPerThreadStackAllocator::LaneStats>& out_stats)
+{
+  s_pAllocator->GetCurrentLaneStats(out_stats);
+}
+
 // static
 void ezFrameAllocator::Startup()
 {
@@ -0,0 +1,239 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Memory/PerThreadStackAllocator.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Lock.h>
+
+// Stored in front of every allocation. Allocations with a destructor are linked together, so that Reset()
+// can walk them in reverse order. Deallocate() clears m_Func, so that the destructor is not called a second time.
+struct ezPerThreadStackAllocator::AllocationHeader
+{
+  ezMemoryUtils::DestructorFunction m_Func;
+  AllocationHeader* m_pPrev;
+  Lane* m_pLane;
+  size_t m_uiSize;
+};
+
+static constexpr size_t s_uiHeaderSize = 32;
+
+struct ezPerThreadStackAllocator::Lane
+{
+  Lane(ezAllocatorBase* pParent)
+    : m_Allocation(pParent)
+  {
+  }
+
+  ezThreadID m_ThreadID;
+  ezMemoryPolicies::ezStackAllocation m_Allocation;
+  AllocationHeader* m_pLastDestructible = nullptr;
+
+  // only ever modified by the owning thread, thus no atomics needed
+  ezUInt64 m_uiNumAllocations = 0;
+  ezUInt64 m_uiNumDeallocations = 0;
+  ezUInt64 m_uiAllocationSize = 0;
+
+  // deallocations of this lane's memory done by other threads
+  ezAtomicInteger64 m_iNumForeignDeallocations;
+};
+
+ezPerThreadStackAllocator::ezPerThreadStackAllocator(ezStringView sName, ezAllocatorBase* pParent, ezBitflags<ezMemoryTrackingFlags> trackingFlags)
+  : m_pParent(pParent)
+  , m_Lanes(pParent, &CreateLane, this)
+{
+  EZ_CHECK_AT_COMPILETIME(sizeof(AllocationHeader) <= s_uiHeaderSize && s_uiHeaderSize % ezMemoryPolicies::ezStackAllocation::Alignment == 0);
+
+  // individual allocations are never tracked, the whole point of this allocator is to avoid any synchronization
+  m_TrackingFlags = trackingFlags;
+  m_TrackingFlags.Remove(ezMemoryTrackingFlags::EnableAllocationTracking);
+  m_TrackingFlags.Remove(ezMemoryTrackingFlags::EnableStackTrace);
+
+  if (m_TrackingFlags.IsSet(ezMemoryTrackingFlags::RegisterAllocator))
+  {
+    m_Id = ezMemoryTracker::RegisterAllocator(sName, m_TrackingFlags, pParent != nullptr ? pParent->GetId() : ezAllocatorId());
+  }
+
+}
+
+ezPerThreadStackAllocator::~ezPerThreadStackAllocator()
+{
+  Reset();
+
+  for (void* pLaneData : m_Lanes.GetLanes())
+  {
+    Lane* pLane = static_cast<Lane*>(pLaneData);
+    EZ_DELETE(m_pParent, pLane);
+  }
+  m_Lanes.Clear();
+
+  if (m_TrackingFlags.IsSet(ezMemoryTrackingFlags::RegisterAllocator))
+  {
+    ezMemoryTracker::DeregisterAllocator(m_Id);
+  }
+}
+
+void* ezPerThreadStackAllocator::Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc)
+{
+  // zero size allocations always return nullptr (since deallocate nullptr is ignored)
+  if (uiSize == 0)
+    return nullptr;
+
+  EZ_ASSERT_DEBUG(ezMath::IsPowerOf2((ezUInt32)uiAlign), "Alignment must be power of two");
+  EZ_ASSERT_DEV(uiAlign <= ezMemoryPolicies::ezStackAllocation::Alignment, "Unsupported alignment {0}", ((ezUInt32)uiAlign));
+
+  Lane* pLane = static_cast<Lane*>(m_Lanes.GetLaneForCurrentThread());
+
+  const size_t uiTotalSize = uiSize + s_uiHeaderSize;
+  ezUInt8* pMemory = static_cast<ezUInt8*>(pLane->m_Allocation.Allocate(uiTotalSize, ezMemoryPolicies::ezStackAllocation::Alignment));
+  EZ_ASSERT_DEV(pMemory != nullptr, "Could not allocate {0} bytes. Out of memory?", uiSize);
+
+  AllocationHeader* pHeader = reinterpret_cast<AllocationHeader*>(pMemory);
+  pHeader->m_Func = destructorFunc;
+  pHeader->m_pPrev = nullptr;
+  pHeader->m_pLane = pLane;
+  pHeader->m_uiSize = uiSize;
+
+  if (destructorFunc != nullptr)
+  {
+    pHeader->m_pPrev = pLane->m_pLastDestructible;
+    pLane->m_pLastDestructible = pHeader;
+  }
+
+  ++pLane->m_uiNumAllocations;
+  pLane->m_uiAllocationSize += ezMemoryUtils::AlignSize<size_t>(uiTotalSize, ezMemoryPolicies::ezStackAllocation::Alignment);
+
+  return pMemory + s_uiHeaderSize;
+}
+
+void ezPerThreadStackAllocator::Deallocate(void* pPtr)
+{
+  if (pPtr == nullptr)
+    return;
+
+  // the memory itself is only reclaimed on Reset(), but the destructor must not be called again
+  AllocationHeader* pHeader = reinterpret_cast<AllocationHeader*>(static_cast<ezUInt8*>(pPtr) - s_uiHeaderSize);
+  pHeader->m_Func = nullptr;
+
+  Lane* pLane = pHeader->m_pLane;
+  if (pLane->m_ThreadID == ezThreadUtils::GetCurrentThreadID())
+  {
+    ++pLane->m_uiNumDeallocations;
+  }
+  else
+  {
+    pLane->m_iNumForeignDeallocations.Increment();
+  }
+}
+
+size_t ezPerThreadStackAllocator::AllocatedSize(const void* pPtr)
+{
+  const AllocationHeader* pHeader = reinterpret_cast<const AllocationHeader*>(static_cast<const ezUInt8*>(pPtr) - s_uiHeaderSize);
+  return pHeader->m_uiSize;
+}
+
+ezAllocatorId ezPerThreadStackAllocator::GetId() const
+{
+  return m_Id;
+}
+
+ezAllocatorBase::Stats ezPerThreadStackAllocator::GetStats() const
+{
+  Stats stats;
+
+  EZ_LOCK(m_Lanes.GetMutex());
+
+  for (void* pLaneData : m_Lanes.GetLanes())
+  {
+    const Lane* pLane = static_cast<const Lane*>(pLaneData);
+    stats.m_uiNumAllocations += pLane->m_uiNumAllocations;
+    stats.m_uiNumDeallocations += pLane->m_uiNumDeallocations + pLane->m_iNumForeignDeallocations;
+    stats.m_uiPerFrameAllocationSize += pLane->m_uiAllocationSize;
+
+    ezAllocatorBase::Stats laneStats;
+    const_cast<Lane*>(pLane)->m_Allocation.FillStats(laneStats);
+    stats.m_uiAllocationSize += laneStats.m_uiAllocationSize;
+  }
+
+  return stats;
+}
+
+void ezPerThreadStackAllocator::Reset()
+{
+  EZ_LOCK(m_Lanes.GetMutex());
+
+  const ezArrayPtr<void* const> lanes = m_Lanes.GetLanes();
+  for (ezUInt32 i = lanes.GetCount(); i-- > 0;)
+  {
+    Lane* pLane = static_cast<Lane*>(lanes[i]);
+
+    for (AllocationHeader* pHeader = pLane->m_pLastDestructible; pHeader != nullptr; pHeader = pHeader->m_pPrev)
+    {
+      if (pHeader->m_Func != nullptr)
+      {
+        pHeader->m_Func(reinterpret_cast<ezUInt8*>(pHeader) + s_uiHeaderSize);
+      }
+    }
+
+    pLane->m_pLastDestructible = nullptr;
+    pLane->m_Allocation.Reset();
+    pLane->m_uiNumAllocations = 0;
+    pLane->m_uiNumDeallocations = 0;
+    pLane->m_iNumForeignDeallocations = 0;
+    pLane->m_uiAllocationSize = 0;
+  }
+
+  if (m_TrackingFlags.IsSet(ezMemoryTrackingFlags::RegisterAllocator))
+  {
+    ezAllocatorBase::Stats stats;
+    for (void* pLane : lanes)
+    {
+      ezAllocatorBase::Stats laneStats;
+      static_cast<Lane*>(pLane)->m_Allocation.FillStats(laneStats);
+      stats.m_uiNumAllocations += laneStats.m_uiNumAllocations;
+      stats.m_uiAllocationSize += laneStats.m_uiAllocationSize;
+    }
+
+    ezMemoryTracker::SetAllocatorStats(m_Id, stats);
+  }
+}
+
+void ezPerThreadStackAllocator::GetLaneStats(ezDynamicArray<LaneStats>& out_stats) const
+{
+  EZ_LOCK(m_Lanes.GetMutex());
+
+  out_stats.Clear();
+  out_stats.Reserve(m_Lanes.GetLanes().GetCount());
+
+  for (void* pLaneData : m_Lanes.GetLanes())
+  {
+    const Lane* pLane = static_cast<const Lane*>(pLaneData);
+
+    LaneStats& stats = out_stats.ExpandAndGetRef();
+    stats.m_ThreadID = pLane->m_ThreadID;
+    stats.m_uiNumAllocations = pLane->m_uiNumAllocations;
+    stats.m_uiNumDeallocations = pLane->m_uiNumDeallocations + pLane->m_iNumForeignDeallocations;
+    stats.m_uiAllocationSize = pLane->m_uiAllocationSize;
+
+    ezAllocatorBase::Stats laneStats;
+    const_cast<Lane*>(pLane)->m_Allocation.FillStats(laneStats);
+    stats.m_uiReservedSize = laneStats.m_uiAllocationSize;
+  }
+}
+
+ezUInt32 ezPerThreadStackAllocator::GetNumLanes() const
+{
+  EZ_LOCK(m_Lanes.GetMutex());
+  return m_Lanes.GetLanes().GetCount();
+}
+
+// static
+void* ezPerThreadStackAllocator::CreateLane(void* pPassThrough)
+{
+  ezPerThreadStackAllocator* pAllocator = static_cast<ezPerThreadStackAllocator*>(pPassThrough);
+
+  Lane* pLane = EZ_NEW(pAllocator->m_pParent, Lane, pAllocator->m_pParent);
+  pLane->m_ThreadID = ezThreadUtils::GetCurrentThreadID();
+  return pLane;
+}
+
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Memory_Implementation_PerThreadStackAllocator);
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Memory/MemoryTracker.h>
+#include <Foundation/Memory/Policies/StackAllocation.h>
+#include <Foundation/Threading/PerThreadLanes.h>
+
+/// \brief A stack allocator that gives every thread its own lane to allocate from.
+///
+/// Each thread that allocates from this allocator gets its own set of buckets (a 'lane'), from which it bump-allocates without any
+/// locks or atomic operations. The lane is found through ezPerThreadLanes, only the very first allocation of a thread locks a mutex to create it.
+/// Objects that need to be destructed are recorded in a per-lane, append-only list, which is walked in reverse order on Reset().
+///
+/// Deallocate() never frees any memory, it only makes sure that the destructor of the deallocated object is not called a second time
+/// during Reset(). It is valid to deallocate memory on a different thread than the one that allocated it, the deallocation is then
+/// counted in the lane of the allocating thread.
+///
+/// Reset() reclaims the memory of all lanes at once. It must not be called while other threads still allocate from this allocator.
+/// The same applies to GetLaneStats(), which is meant for debugging and profiling at the end of a frame.
+///
+/// Every allocation has an overhead of 32 bytes and the maximum supported alignment is 16 bytes.
+class EZ_FOUNDATION_DLL ezPerThreadStackAllocator : public ezAllocatorBase
+{
+public:
+  ezPerThreadStackAllocator(ezStringView sName, ezAllocatorBase* pParent, ezBitflags<ezMemoryTrackingFlags> trackingFlags = ezMemoryTrackingFlags::RegisterAllocator);
+  ~ezPerThreadStackAllocator();
+
+  // ezAllocatorBase implementation
+  virtual void* Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc = nullptr) override;
+  virtual void Deallocate(void* pPtr) override;
+  virtual size_t AllocatedSize(const void* pPtr) override;
+  virtual ezAllocatorId GetId() const override;
+  virtual Stats GetStats() const override;
+
+  /// \brief Resets the allocator, calls the destructors of all objects that were not deallocated and frees all memory of all lanes.
+  void Reset();
+
+  /// \brief Statistics about the allocations of one thread.
+  struct LaneStats
+  {
+    ezThreadID m_ThreadID;
+    ezUInt64 m_uiNumAllocations = 0;   ///< Number of allocations since the last Reset()
+    ezUInt64 m_uiNumDeallocations = 0; ///< Number of deallocations of memory allocated by this thread since the last Reset()
+    ezUInt64 m_uiAllocationSize = 0;   ///< Bytes allocated since the last Reset(), including the per-allocation overhead
+    ezUInt64 m_uiReservedSize = 0;     ///< Bytes that the lane has requested from the parent allocator
+  };
+
+  /// \brief Returns the statistics of all lanes, one entry per thread that has ever allocated from this allocator.
+  void GetLaneStats(ezDynamicArray<LaneStats>& out_stats) const;
+
+  /// \brief Returns the number of lanes, ie. the number of threads that have ever allocated from this allocator.
+  ezUInt32 GetNumLanes() const;
+
+private:
+  struct AllocationHeader;
+  struct Lane;
+
+  static void* CreateLane(void* pPassThrough);
+
+  ezAllocatorBase* m_pParent = nullptr;
+  ezAllocatorId m_Id;
+  ezBitflags<ezMemoryTrackingFlags> m_TrackingFlags;
+
+  ezPerThreadLanes m_Lanes;
+};
@@ -1,19 +1,145 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Containers/Deque.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Strings/HashedString.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Types/ScopeExit.h>
+
+#include <atomic>
+
+namespace
+{
+  /// Open addressing table with linear probing that maps the hash of a string to its HashedData.
+  ///
+  /// Lookups don't take any lock: Slots are only ever filled (under the mutex) after the HashedData is fully set up.
+  /// When the table needs to grow, a new table is created and published. The old one stays alive, since other threads may still read from it.
+  struct HashedStringTable
+  {
+    ezUInt32 m_uiCapacityMask = 0;
+    ezUInt32 m_uiNumEntries = 0;
+    ezArrayPtr<std::atomic<ezHashedString::HashedData*>> m_Slots;
+    HashedStringTable* m_pPreviousTable = nullptr;
+
+    ezHashedString::HashedData* Find(ezUInt64 uiHash) const
+    {
+      for (ezUInt32 i = static_cast<ezUInt32>(uiHash) & m_uiCapacityMask;; i = (i + 1) & m_uiCapacityMask)
+      {
+        ezHashedString::HashedData* pData = m_Slots[i].load(std::memory_order_acquire);
+
+        if (pData == nullptr || pData->m_uiHash == uiHash)
+          return pData;
+      }
+    }
+
+    void Insert(ezHashedString::HashedData* pData)
+    {
+      ezUInt32 i = static_cast<ezUInt32>(pData->m_uiHash) & m_uiCapacityMask;
+      while (m_Slots[i].load(std::memory_order_relaxed) != nullptr)
+      {
+        i = (i + 1) & m_uiCapacityMask;
+      }
+
+      m_Slots[i].store(pData, std::memory_order_release);
+      ++m_uiNumEntries;
+    }
+  };
+} // namespace
 
 struct HashedStringData
 {
   ezMutex m_Mutex;
-  ezHashedString::StringStorage m_Storage;
+  std::atomic<HashedStringTable*> m_pTable = nullptr;
+
+  // the arena for the strings, a deque never moves its elements
+  ezDeque<ezHashedString::HashedData, ezStaticAllocatorWrapper> m_Storage;
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+  // ClearUnusedStrings() has to wait for all lookups that might still see a removed string.
+  // Lookups are counted per epoch, so that it only waits for the lookups that started before it published the new table, not for new ones.
+  std::atomic<ezUInt32> m_uiLookupEpoch = 0;
+  std::atomic<ezInt32> m_iNumActiveLookups[2] = {};
+  ezDynamicArray<ezHashedString::HashedData*, ezStaticAllocatorWrapper> m_FreeEntries;
+#endif
+
   ezHashedString::HashedType m_Empty;
 };
 
 static HashedStringData* s_pHSData;
 
+static HashedStringTable* CreateHashedStringTable(ezUInt32 uiCapacity, HashedStringTable* pPreviousTable)
+{
+  ezAllocatorBase* pAllocator = ezStaticAllocatorWrapper::GetAllocator();
+
+  auto* pSlots = EZ_NEW_RAW_BUFFER(pAllocator, std::atomic<ezHashedString::HashedData*>, uiCapacity);
+  for (ezUInt32 i = 0; i < uiCapacity; ++i)
+  {
+    new (&pSlots[i]) std::atomic<ezHashedString::HashedData*>(nullptr);
+  }
+
+  HashedStringTable* pTable = EZ_NEW(pAllocator, HashedStringTable);
+  pTable->m_uiCapacityMask = uiCapacity - 1;
+  pTable->m_Slots = ezMakeArrayPtr(pSlots, uiCapacity);
+  pTable->m_pPreviousTable = pPreviousTable;
+
+  return pTable;
+}
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+static void DestroyHashedStringTables(HashedStringTable* pTable)
+{
+  while (pTable != nullptr)
+  {
+    HashedStringTable* pPreviousTable = pTable->m_pPreviousTable;
+
+    // the slots only store pointers, so there is nothing to destruct
+    auto* pSlots = pTable->m_Slots.GetPtr();
+    EZ_DELETE_RAW_BUFFER(ezStaticAllocatorWrapper::GetAllocator(), pSlots);
+    EZ_DELETE(ezStaticAllocatorWrapper::GetAllocator(), pTable);
+
+    pTable = pPreviousTable;
+  }
+}
+#endif
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+/// Registers a lookup in the current epoch and returns the counter that has to be decremented once the lookup is done.
+///
+/// All accesses are sequentially consistent: Once the epoch is confirmed after incrementing its counter, either ClearUnusedStrings() will see
+/// the increment and wait, or it has not flipped the epoch yet.
+static std::atomic<ezInt32>* BeginLookup()
+{
+  while (true)
+  {
+    const ezUInt32 uiEpoch = s_pHSData->m_uiLookupEpoch.load();
+    std::atomic<ezInt32>* pNumActiveLookups = &s_pHSData->m_iNumActiveLookups[uiEpoch & 1];
+    pNumActiveLookups->fetch_add(1);
+
+    if (s_pHSData->m_uiLookupEpoch.load() == uiEpoch)
+      return pNumActiveLookups;
+
+    // ClearUnusedStrings() flipped the epoch in the meantime, count the lookup in the new one
+    pNumActiveLookups->fetch_sub(1);
+  }
+}
+#endif
+
+static void CheckForHashCollision(const ezHashedString::HashedData* pData, ezStringView sString)
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (pData->m_sString != sString)
+  {
+    // TODO: I think this should be a more serious issue
+    ezLog::Error("Hash collision encountered: Strings \"{}\" and \"{}\" both hash to {}.", ezArgSensitive(pData->m_sString), ezArgSensitive(sString), pData->m_uiHash);
+  }
+#else
+  EZ_IGNORE_UNUSED(pData);
+  EZ_IGNORE_UNUSED(sString);
+#endif
+}
+
 EZ_MSVC_ANALYSIS_WARNING_PUSH
 EZ_MSVC_ANALYSIS_WARNING_DISABLE(6011) // Disable warning for null pointer dereference as InitHashedString() will ensure that s_pHSData is set
 
@@ -23,37 +149,82 @@ ezHashedString::HashedType ezHashedString::AddHashedString(ezStringView sString,
   if (s_pHSData == nullptr)
     InitHashedString();
 
+  // try to find the existing string without locking
+  {
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+    std::atomic<ezInt32>* pNumActiveLookups = BeginLookup();
+    EZ_SCOPE_EXIT(pNumActiveLookups->fetch_sub(1));
+#endif
+
+    // sequentially consistent, so that it can't be reordered before the registration of the lookup
+    if (HashedData* pData = s_pHSData->m_pTable.load()->Find(uiHash))
+    {
+      CheckForHashCollision(pData, sString);
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+      pData->m_iRefCount.Increment();
+#endif
+      return pData;
+    }
+  }
+
   EZ_LOCK(s_pHSData->m_Mutex);
 
-  // try to find the existing string
-  bool bExisted = false;
-  auto ret = s_pHSData->m_Storage.FindOrAdd(uiHash, &bExisted);
+  HashedStringTable* pTable = s_pHSData->m_pTable.load(std::memory_order_relaxed);
 
-  // if it already exists, just increase the refcount
-  if (bExisted)
+  // another thread might have added the string in the meantime
+  if (HashedData* pData = pTable->Find(uiHash))
   {
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    if (ret.Value().m_sString != sString)
-    {
-      // TODO: I think this should be a more serious issue
-      ezLog::Error("Hash collision encountered: Strings \"{}\" and \"{}\" both hash to {}.", ezArgSensitive(ret.Value().m_sString), ezArgSensitive(sString), uiHash);
-    }
-#endif
+    CheckForHashCollision(pData, sString);
 
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
-    ret.Value().m_iRefCount.Increment();
+    pData->m_iRefCount.Increment();
 #endif
+    return pData;
+  }
+
+  HashedData* pData = nullptr;
+
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+  if (!s_pHSData->m_FreeEntries.IsEmpty())
+  {
+    pData = s_pHSData->m_FreeEntries.PeekBack();
+    s_pHSData->m_FreeEntries.PopBack();
   }
   else
+#endif
   {
-    ezHashedString::HashedData& d = ret.Value();
+    pData = &s_pHSData->m_Storage.ExpandAndGetRef();
+  }
+
+  pData->m_uiHash = uiHash;
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
-    d.m_iRefCount = 1;
+  pData->m_iRefCount = 1;
 #endif
-    d.m_sString = sString;
+  pData->m_sString = sString;
+
+  // keep the load factor below 50%, so that the probe sequences stay short
+  if ((pTable->m_uiNumEntries + 1) * 2 > pTable->m_Slots.GetCount())
+  {
+    HashedStringTable* pNewTable = CreateHashedStringTable(pTable->m_Slots.GetCount() * 2, pTable);
+
+    for (const auto& slot : pTable->m_Slots)
+    {
+      if (HashedData* pExisting = slot.load(std::memory_order_relaxed))
+      {
+        pNewTable->Insert(pExisting);
+      }
+    }
+
+    pNewTable->Insert(pData);
+    s_pHSData->m_pTable.store(pNewTable, std::memory_order_release);
+  }
+  else
+  {
+    pTable->Insert(pData);
   }
 
-  return ret;
+  return pData;
 }
 
 EZ_MSVC_ANALYSIS_WARNING_POP
@@ -66,13 +237,14 @@ void ezHashedString::InitHashedString()
 
   alignas(EZ_ALIGNMENT_OF(HashedStringData)) static ezUInt8 HashedStringDataBuffer[sizeof(HashedStringData)];
   s_pHSData = new (HashedStringDataBuffer) HashedStringData();
+  s_pHSData->m_pTable = CreateHashedStringTable(1024, nullptr);
 
   // makes sure the empty string exists for the default constructor to use
   s_pHSData->m_Empty = AddHashedString("", ezHashingUtils::StringHash(""));
 
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
   // this one should never get deleted, so make sure its refcount is 2
-  s_pHSData->m_Empty.Value().m_iRefCount.Increment();
+  s_pHSData->m_Empty->m_iRefCount.Increment();
 #endif
 }
 
@@ -81,17 +253,55 @@ ezUInt32 ezHashedString::ClearUnusedStrings()
 {
   EZ_LOCK(s_pHSData->m_Mutex);
 
+  HashedStringTable* pTable = s_pHSData->m_pTable.load(std::memory_order_relaxed);
+
+  // build a new table without the unused strings and publish it, so that new lookups can't find them anymore
+  HashedStringTable* pNewTable = CreateHashedStringTable(pTable->m_Slots.GetCount(), pTable);
+
+  ezHybridArray<HashedData*, 64> unusedEntries;
+
+  for (const auto& slot : pTable->m_Slots)
+  {
+    if (HashedData* pData = slot.load(std::memory_order_relaxed))
+    {
+      if (pData->m_iRefCount == 0)
+        unusedEntries.PushBack(pData);
+      else
+        pNewTable->Insert(pData);
+    }
+  }
+
+  s_pHSData->m_pTable.store(pNewTable);
+
+  // Lookups that started before the new table was published might still revive an unused string.
+  // Lookups that start after the epoch flip see the new table, so only the ones that are already running have to finish.
+  const ezUInt32 uiPreviousEpoch = s_pHSData->m_uiLookupEpoch.fetch_add(1);
+  while (s_pHSData->m_iNumActiveLookups[uiPreviousEpoch & 1].load() > 0)
+  {
+    ezThreadUtils::YieldTimeSlice();
+  }
+
+  // now nobody reads from the old tables anymore
+  DestroyHashedStringTables(pNewTable->m_pPreviousTable);
+  pNewTable->m_pPreviousTable = nullptr;
+
   ezUInt32 uiDeleted = 0;
 
-  for (auto it = s_pHSData->m_Storage.GetIterator(); it.IsValid();)
+  for (HashedData* pData : unusedEntries)
   {
-    if (it.Value().m_iRefCount == 0)
+    if (pData->m_iRefCount > 0)
     {
-      it = s_pHSData->m_Storage.Remove(it);
-      ++uiDeleted;
+      pNewTable->Insert(pData);
     }
     else
-      ++it;
+    {
+      // release the string memory, the entry itself is reused for the next new string
+      ezMemoryUtils::Destruct(&pData->m_sString);
+      ezMemoryUtils::DefaultConstruct(&pData->m_sString);
+
+      s_pHSData->m_FreeEntries.PushBack(pData);
+      ++uiDeleted;
+    }
   }
 
   return uiDeleted;
@@ -112,7 +322,7 @@ ezHashedString::ezHashedString()
 
   m_Data = s_pHSData->m_Empty;
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
-  m_Data.Value().m_iRefCount.Increment();
+  m_Data->m_iRefCount.Increment();
 #endif
 }
 
@@ -131,9 +341,9 @@ void ezHashedString::Clear()
     HashedType tmp = m_Data;
 
     m_Data = s_pHSData->m_Empty;
-    m_Data.Value().m_iRefCount.Increment();
+    m_Data->m_iRefCount.Increment();
 
-    tmp.Value().m_iRefCount.Decrement();
+    tmp->m_iRefCount.Decrement();
   }
 #else
   m_Data = s_pHSData->m_Empty;
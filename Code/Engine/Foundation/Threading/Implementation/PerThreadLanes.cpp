@@ -0,0 +1,80 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/PerThreadLanes.h>
+
+namespace
+{
+  // Maps the serial of every ezPerThreadLanes instance this thread has accessed to the lane of this thread.
+  // Entries of destroyed instances are never removed, so the map is cleared once it gets too big. The lanes are then simply
+  // looked up again in the instances that are still alive.
+  thread_local ezHashTable<ezUInt64, void*, ezHashHelper<ezUInt64>, ezStaticAllocatorWrapper> tl_Lanes;
+  constexpr ezUInt32 s_uiMaxThreadLocalLanes = 4096;
+
+  ezAtomicInteger64 s_iNextSerial;
+} // namespace
+
+ezPerThreadLanes::ezPerThreadLanes(ezAllocatorBase* pAllocator, CreateLaneFunc createLaneFunc, void* pPassThrough)
+  : m_CreateLaneFunc(createLaneFunc)
+  , m_pPassThrough(pPassThrough)
+  , m_Lanes(pAllocator)
+  , m_LaneThreadIDs(pAllocator)
+{
+  m_uiSerial = static_cast<ezUInt64>(s_iNextSerial.Increment());
+}
+
+ezPerThreadLanes::~ezPerThreadLanes()
+{
+  EZ_ASSERT_DEBUG(m_Lanes.IsEmpty(), "The lanes must be deleted and cleared by the user");
+}
+
+void* ezPerThreadLanes::GetLaneForCurrentThread()
+{
+  void* pLane = nullptr;
+  if (tl_Lanes.TryGetValue(m_uiSerial, pLane))
+    return pLane;
+
+  pLane = CreateLaneForCurrentThread();
+
+  if (tl_Lanes.GetCount() >= s_uiMaxThreadLocalLanes)
+  {
+    tl_Lanes.Clear();
+  }
+
+  tl_Lanes.Insert(m_uiSerial, pLane);
+  return pLane;
+}
+
+void ezPerThreadLanes::Clear()
+{
+  EZ_LOCK(m_Mutex);
+
+  m_Lanes.Clear();
+  m_LaneThreadIDs.Clear();
+}
+
+void* ezPerThreadLanes::CreateLaneForCurrentThread()
+{
+  const ezThreadID threadId = ezThreadUtils::GetCurrentThreadID();
+
+  EZ_LOCK(m_Mutex);
+
+  // the lane may already exist, if the thread local map has been cleared
+  // or if a thread with the same ID accessed this object before
+  for (ezUInt32 i = 0; i < m_LaneThreadIDs.GetCount(); ++i)
+  {
+    if (m_LaneThreadIDs[i] == threadId)
+      return m_Lanes[i];
+  }
+
+  void* pLane = m_CreateLaneFunc(m_pPassThrough);
+  m_Lanes.PushBack(pLane);
+  m_LaneThreadIDs.PushBack(threadId);
+
+  return pLane;
+}
+
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Threading_Implementation_PerThreadLanes);
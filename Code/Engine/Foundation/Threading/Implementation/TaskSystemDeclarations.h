@@ -12,6 +12,7 @@ class ezTaskGroup;
 class ezTaskWorkerThread;
 class ezTaskSystemState;
 class ezTaskSystemThreadState;
+struct ezTaskQueueEntry;
 class ezDGMLGraph;
 class ezAllocatorBase;
 
@@ -98,6 +99,27 @@ struct ezWorkerThreadType
   static const char* GetThreadTypeName(ezWorkerThreadType::Enum threadType);
 };
 
+/// \brief Selects how the ezTaskSystem hands out short tasks to its worker threads.
+struct ezTaskSchedulerMode
+{
+  enum Enum : ezUInt8
+  {
+    /// All scheduled tasks are stored in one list per priority, which is protected by a single mutex.
+    /// Every worker thread has to acquire that mutex to pick its next task.
+    GlobalQueue,
+
+    /// Tasks that never wait (ezTaskNesting::Never) with a priority of 'this frame' are put into lock-free queues instead.
+    /// Each short task worker thread owns one deque per priority, into which it pushes the tasks that it schedules itself.
+    /// Tasks scheduled from other threads go into a shared lock-free injection queue per priority.
+    /// Idle workers steal from the deques of randomly chosen other workers.
+    /// All other tasks are still handled through the mutex protected lists.
+    /// This scales much better when many small tasks (e.g. through ParallelFor) are executed on many cores.
+    WorkStealing,
+
+    Default = GlobalQueue
+  };
+};
+
 /// \brief Given out by ezTaskSystem::CreateTaskGroup to identify a task group.
 class EZ_FOUNDATION_DLL ezTaskGroupID
 {
@@ -160,6 +160,9 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
 
     pGroup->m_iNumRemainingTasks = iRemainingTasks;
 
+    // with the work-stealing scheduler, tasks that never wait are put into the lock-free queues, if they are needed this frame
+    // tasks that may wait need to stay in the lists, because waiting threads must be able to filter which tasks they pick up
+    const bool bUseWorkStealing = s_pState->m_SchedulerMode == ezTaskSchedulerMode::WorkStealing && pGroup->m_Priority < ezTaskNumWorkStealingPriorities;
 
     for (ezUInt32 task = 0; task < pGroup->m_Tasks.GetCount(); ++task)
     {
@@ -167,6 +170,21 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
 
       for (ezUInt32 mult = 0; mult < ezMath::Max(1u, pTask->m_uiMultiplicity); ++mult)
       {
+        if (bUseWorkStealing && pTask->m_NestingMode == ezTaskNesting::Never)
+        {
+          pTask->m_bTaskIsScheduled = true;
+
+          ezTaskQueueEntry entry;
+          entry.m_pGroup = pGroup;
+          entry.m_uiTaskIndex = task;
+          entry.m_uiInvocation = mult;
+
+          if (ScheduleWorkStealingTask(pGroup->m_Priority, entry))
+            continue;
+
+          // all queues are full, fall back to the list
+        }
+
         TaskData td;
         td.m_pBelongsToGroup = pGroup;
         td.m_pTask = pTask;
@@ -177,6 +195,8 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
           s_pState->m_Tasks[pGroup->m_Priority].PushFront(td);
         else
           s_pState->m_Tasks[pGroup->m_Priority].PushBack(td);
+
+        s_pState->m_iNumTasksInLists[pGroup->m_Priority].fetch_add(1, std::memory_order_relaxed);
       }
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/Threading/Implementation/TaskWorkStealingQueues.h>
 #include <Foundation/Threading/TaskSystem.h>
 
 class ezTaskSystemThreadState
@@ -31,4 +32,18 @@ private:
 
   // The lists of all scheduled tasks, for each priority.
   ezList<ezTaskSystem::TaskData> m_Tasks[ezTaskPriority::ENUM_COUNT];
+
+  // How many tasks are stored in m_Tasks, per priority. Allows the work-stealing scheduler to skip the mutex for empty lists.
+  std::atomic<ezInt32> m_iNumTasksInLists[ezTaskPriority::ENUM_COUNT] = {};
+
+  // Which scheduler is used for newly scheduled tasks
+  ezTaskSchedulerMode::Enum m_SchedulerMode = ezTaskSchedulerMode::Default;
+
+  // Whether the lock-free queues need to be checked for tasks.
+  // After switching back to ezTaskSchedulerMode::GlobalQueue this stays enabled, until FinishFrameTasks() finds all of them empty.
+  // Written with release semantics while holding the mutex, the worker threads read it with acquire semantics without the mutex.
+  std::atomic<bool> m_bUseWorkStealingQueues = false;
+
+  // Tasks that are scheduled with ezTaskSchedulerMode::WorkStealing from threads that don't own a deque (or whose deque is full).
+  ezTaskInjectionQueue m_InjectionQueues[ezTaskNumWorkStealingPriorities];
 };
@@ -91,6 +91,58 @@ ezTaskSystem::TaskData ezTaskSystem::GetNextTask(ezTaskPriority::Enum FirstPrior
   EZ_ASSERT_DEV(FirstPriority >= ezTaskPriority::EarlyThisFrame && LastPriority < ezTaskPriority::ENUM_COUNT, "Priority Range is invalid: {0} to {1}",
     FirstPriority, LastPriority);
 
+  if (s_pState->m_bUseWorkStealingQueues.load(std::memory_order_acquire))
+  {
+    // go through all the queues that this thread is willing to work on, without holding the mutex
+    for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority; ++prio)
+    {
+      TaskData td;
+
+      // the lock-free queues only contain tasks that never wait, so those are always fine to execute
+      if (prio < ezTaskNumWorkStealingPriorities && GetNextWorkStealingTask((ezTaskPriority::Enum)prio, td))
+        return td;
+
+      if (s_pState->m_iNumTasksInLists[prio].load(std::memory_order_relaxed) > 0)
+      {
+        EZ_LOCK(s_TaskSystemMutex);
+
+        for (auto it = s_pState->m_Tasks[prio].GetIterator(); it.IsValid(); ++it)
+        {
+          if (!bOnlyTasksThatNeverWait || (it->m_pTask->m_NestingMode == ezTaskNesting::Never) || it->m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup)
+          {
+            td = *it;
+
+            s_pState->m_Tasks[prio].Remove(it);
+            s_pState->m_iNumTasksInLists[prio].fetch_sub(1, std::memory_order_relaxed);
+            return td;
+          }
+        }
+      }
+    }
+
+    if (pWorkerState)
+    {
+      EZ_VERIFY(pWorkerState->Set((int)ezTaskWorkerState::Idle) == (int)ezTaskWorkerState::Active, "Corrupt Worker State");
+
+      // Without the mutex, a task may have been queued after we looked at the queues, but before we switched to 'idle'.
+      // In that case the scheduling thread saw this thread as active and did not wake anyone up.
+      // Setting the state is a full memory barrier, so at this point we are guaranteed to see such tasks.
+      bool bHasTasks = HasWorkStealingTasks(FirstPriority, LastPriority);
+
+      for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority && !bHasTasks; ++prio)
+      {
+        bHasTasks = s_pState->m_iNumTasksInLists[prio].load(std::memory_order_relaxed) > 0;
+      }
+
+      if (bHasTasks)
+      {
+        WakeUpThreads(tl_TaskWorkerInfo.m_WorkerType, 1);
+      }
+    }
+
+    return TaskData();
+  }
+
   EZ_LOCK(s_TaskSystemMutex);
 
   // go through all the task lists that this thread is willing to work on
@@ -103,6 +155,7 @@ ezTaskSystem::TaskData ezTaskSystem::GetNextTask(ezTaskPriority::Enum FirstPrior
         TaskData td = *it;
 
         s_pState->m_Tasks[prio].Remove(it);
+        s_pState->m_iNumTasksInLists[prio].fetch_sub(1, std::memory_order_relaxed);
         return td;
       }
     }
@@ -116,6 +169,162 @@ ezTaskSystem::TaskData ezTaskSystem::GetNextTask(ezTaskPriority::Enum FirstPrior
   return TaskData();
 }
 
+namespace
+{
+  /// Cheap per-thread random number generator (xorshift) to pick the workers to steal from.
+  ezUInt32 GetStealRandom()
+  {
+    thread_local ezUInt32 s_uiState = 0;
+
+    if (s_uiState == 0)
+    {
+      s_uiState = static_cast<ezUInt32>(reinterpret_cast<size_t>(&s_uiState) >> 4) | 1u;
+    }
+
+    ezUInt32 x = s_uiState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_uiState = x;
+    return x;
+  }
+} // namespace
+
+bool ezTaskSystem::ScheduleWorkStealingTask(ezTaskPriority::Enum priority, const ezTaskQueueEntry& entry)
+{
+  EZ_ASSERT_DEBUG(priority < ezTaskNumWorkStealingPriorities, "Invalid priority for the work-stealing queues");
+
+  // worker threads keep the tasks that they start themselves, others can steal them if this thread is busy
+  if (tl_TaskWorkerInfo.m_WorkerType == ezWorkerThreadType::ShortTasks && tl_TaskWorkerInfo.m_iWorkerIndex >= 0)
+  {
+    ezTaskWorkerThread* pWorker = s_pThreadState->m_Workers[ezWorkerThreadType::ShortTasks][tl_TaskWorkerInfo.m_iWorkerIndex];
+
+    if (pWorker->m_LocalQueues[priority].Push(entry))
+      return true;
+  }
+
+  return s_pState->m_InjectionQueues[priority].Push(entry);
+}
+
+bool ezTaskSystem::GetNextWorkStealingTask(ezTaskPriority::Enum priority, TaskData& out_taskData)
+{
+  ezTaskQueueEntry entry;
+  bool bFound = false;
+
+  ezInt32 iOwnWorkerIndex = -1;
+  if (tl_TaskWorkerInfo.m_WorkerType == ezWorkerThreadType::ShortTasks)
+  {
+    iOwnWorkerIndex = tl_TaskWorkerInfo.m_iWorkerIndex;
+  }
+
+  // first prefer the own tasks, these are most likely to still be in the cache
+  if (iOwnWorkerIndex >= 0)
+  {
+    bFound = s_pThreadState->m_Workers[ezWorkerThreadType::ShortTasks][iOwnWorkerIndex]->m_LocalQueues[priority].Pop(entry);
+  }
+
+  // then take tasks that were started from outside
+  if (!bFound)
+  {
+    bFound = s_pState->m_InjectionQueues[priority].Pop(entry);
+  }
+
+  // finally try to steal from other workers, starting with a random one, to spread the contention
+  if (!bFound)
+  {
+    const ezUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[ezWorkerThreadType::ShortTasks];
+
+    bool bRetry = uiNumWorkers > 0;
+    while (bRetry && !bFound)
+    {
+      bRetry = false;
+
+      const ezUInt32 uiStartIndex = GetStealRandom() % uiNumWorkers;
+
+      for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
+      {
+        const ezUInt32 uiVictim = (uiStartIndex + i) % uiNumWorkers;
+
+        if ((ezInt32)uiVictim == iOwnWorkerIndex)
+          continue;
+
+        const ezTaskStealResult res = s_pThreadState->m_Workers[ezWorkerThreadType::ShortTasks][uiVictim]->m_LocalQueues[priority].Steal(entry);
+
+        if (res == ezTaskStealResult::Success)
+        {
+          bFound = true;
+          break;
+        }
+
+        // if we lost a race, there may still be work left, so we must not report 'nothing to do'
+        if (res == ezTaskStealResult::Contended)
+        {
+          bRetry = true;
+        }
+      }
+    }
+  }
+
+  if (!bFound)
+    return false;
+
+  out_taskData.m_pBelongsToGroup = entry.m_pGroup;
+  out_taskData.m_pTask = entry.m_pGroup->m_Tasks[entry.m_uiTaskIndex];
+  out_taskData.m_uiInvocation = entry.m_uiInvocation;
+  return true;
+}
+
+bool ezTaskSystem::HasWorkStealingTasks(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority)
+{
+  const ezUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[ezWorkerThreadType::ShortTasks];
+
+  for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority && prio < ezTaskNumWorkStealingPriorities; ++prio)
+  {
+    if (!s_pState->m_InjectionQueues[prio].IsEmpty())
+      return true;
+
+    for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
+    {
+      if (!s_pThreadState->m_Workers[ezWorkerThreadType::ShortTasks][i]->m_LocalQueues[prio].IsEmpty())
+        return true;
+    }
+  }
+
+  return false;
+}
+
+void ezTaskSystem::ReclaimWorkerDequeTasks()
+{
+  EZ_LOCK(s_TaskSystemMutex);
+
+  const ezUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[ezWorkerThreadType::ShortTasks];
+
+  for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
+  {
+    for (ezUInt32 prio = 0; prio < ezTaskNumWorkStealingPriorities; ++prio)
+    {
+      ezTaskWorkStealingDeque& deque = s_pThreadState->m_Workers[ezWorkerThreadType::ShortTasks][i]->m_LocalQueues[prio];
+
+      ezTaskQueueEntry entry;
+      while (deque.Steal(entry) != ezTaskStealResult::Empty)
+      {
+        if (entry.m_pGroup == nullptr)
+          continue;
+
+        TaskData td;
+        td.m_pBelongsToGroup = entry.m_pGroup;
+        td.m_pTask = entry.m_pGroup->m_Tasks[entry.m_uiTaskIndex];
+        td.m_uiInvocation = entry.m_uiInvocation;
+
+        s_pState->m_Tasks[prio].PushBack(td);
+        s_pState->m_iNumTasksInLists[prio].fetch_add(1, std::memory_order_relaxed);
+
+        entry.m_pGroup = nullptr;
+      }
+    }
+  }
+}
+
 bool ezTaskSystem::ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
   const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState)
 {
@@ -182,6 +391,7 @@ ezResult ezTaskSystem::CancelTask(const ezSharedPtr<ezTask>& pTask, ezOnTaskRunn
           if (it->m_pTask == pTask)
           {
             s_pState->m_Tasks[i].Remove(it);
+            s_pState->m_iNumTasksInLists[i].fetch_sub(1, std::memory_order_relaxed);
 
             // we set the task to finished, even though it was not executed
             pTask->m_iRemainingRuns = 0;
@@ -223,6 +433,11 @@ bool ezTaskSystem::HelpExecutingTasks(const ezTaskGroupID& WaitingForGroup)
 
 void ezTaskSystem::ReprioritizeFrameTasks()
 {
+  auto MoveTaskCount = [](ezUInt32 uiFrom, ezUInt32 uiTo)
+  {
+    s_pState->m_iNumTasksInLists[uiTo].fetch_add(s_pState->m_iNumTasksInLists[uiFrom].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+  };
+
   // There should usually be no 'this frame tasks' left at this time
   // however, while we waited to enter the lock, such tasks might have appeared
   // In this case we move them into the highest-priority 'this frame' queue, to ensure they will be executed asap
@@ -239,6 +454,7 @@ void ezTaskSystem::ReprioritizeFrameTasks()
     }
 
     // remove the tasks from their current queue
+    MoveTaskCount(i, ezTaskPriority::EarlyThisFrame);
     s_pState->m_Tasks[i].Clear();
   }
 
@@ -255,6 +471,7 @@ void ezTaskSystem::ReprioritizeFrameTasks()
     }
 
     // remove the tasks from their current queue
+    MoveTaskCount(i, i - 3);
     s_pState->m_Tasks[i].Clear();
   }
 
@@ -272,6 +489,7 @@ void ezTaskSystem::ReprioritizeFrameTasks()
     }
 
     // remove the tasks from their current queue
+    MoveTaskCount(i, i - 1);
     s_pState->m_Tasks[i].Clear();
   }
 }
@@ -382,6 +600,16 @@ void ezTaskSystem::FinishFrameTasks()
     EZ_LOCK(s_TaskSystemMutex);
 
     ReprioritizeFrameTasks();
+
+    // after switching back to the global queue, stop looking at the lock-free queues once they are drained
+    // tasks only get pushed into them while the mutex is held, so they can't get filled up again behind our back
+    if (s_pState->m_bUseWorkStealingQueues.load(std::memory_order_acquire) && s_pState->m_SchedulerMode != ezTaskSchedulerMode::WorkStealing)
+    {
+      if (!HasWorkStealingTasks(ezTaskPriority::EarlyThisFrame, ezTaskPriority::LateThisFrame))
+      {
+        s_pState->m_bUseWorkStealingQueues.store(false, std::memory_order_release);
+      }
+    }
   }
 
   ExecuteSomeFrameTasks(s_pState->m_TargetFrameTime);
@@ -86,6 +86,9 @@ void ezTaskSystem::StopWorkerThreads()
     ezThreadUtils::YieldTimeSlice();
   }
 
+  // the worker deques are deleted together with their threads, don't lose the tasks that are still in there
+  ReclaimWorkerDequeTasks();
+
   for (ezUInt32 type = 0; type < ezWorkerThreadType::ENUM_COUNT; ++type)
   {
     const ezUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[type];
@@ -180,6 +183,26 @@ void ezTaskSystem::WakeUpThreads(ezWorkerThreadType::Enum type, ezUInt32 uiNumTh
   }
 }
 
+void ezTaskSystem::SetSchedulerMode(ezTaskSchedulerMode::Enum mode)
+{
+  // ScheduleGroupTasks() reads the mode while holding the mutex
+  EZ_LOCK(s_TaskSystemMutex);
+
+  s_pState->m_SchedulerMode = mode;
+
+  if (mode == ezTaskSchedulerMode::WorkStealing)
+  {
+    s_pState->m_bUseWorkStealingQueues.store(true, std::memory_order_release);
+  }
+
+  // when switching back to the global queue, m_bUseWorkStealingQueues is reset in FinishFrameTasks(), once all lock-free queues are empty
+}
+
+ezTaskSchedulerMode::Enum ezTaskSystem::GetSchedulerMode()
+{
+  return s_pState->m_SchedulerMode;
+}
+
 ezWorkerThreadType::Enum ezTaskSystem::GetCurrentThreadWorkerType()
 {
   return tl_TaskWorkerInfo.m_WorkerType;
@@ -0,0 +1,163 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Threading/Implementation/TaskWorkStealingQueues.h>
+
+// The deque follows "Correct and Efficient Work-Stealing for Weak Memory Models" (Le, Pop, Cohen, Zappa Nardelli).
+// Since the capacity is fixed, the buffer never needs to be reallocated, Push() simply fails when the deque is full
+// and the task system falls back to one of the shared queues.
+
+bool ezTaskWorkStealingDeque::Push(const ezTaskQueueEntry& entry)
+{
+  const ezInt64 b = m_iBottom.load(std::memory_order_relaxed);
+  const ezInt64 t = m_iTop.load(std::memory_order_acquire);
+
+  if (b - t >= (ezInt64)Capacity)
+    return false;
+
+  m_Entries[b & Mask] = entry;
+
+  std::atomic_thread_fence(std::memory_order_release);
+  m_iBottom.store(b + 1, std::memory_order_relaxed);
+  return true;
+}
+
+bool ezTaskWorkStealingDeque::Pop(ezTaskQueueEntry& out_entry)
+{
+  const ezInt64 b = m_iBottom.load(std::memory_order_relaxed) - 1;
+  m_iBottom.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  ezInt64 t = m_iTop.load(std::memory_order_relaxed);
+
+  if (t > b)
+  {
+    // deque was empty
+    m_iBottom.store(b + 1, std::memory_order_relaxed);
+    return false;
+  }
+
+  out_entry = m_Entries[b & Mask];
+
+  if (t == b)
+  {
+    // this is the last entry, race against the stealing threads for it
+    const bool bWon = m_iTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    m_iBottom.store(b + 1, std::memory_order_relaxed);
+    return bWon;
+  }
+
+  return true;
+}
+
+ezTaskStealResult ezTaskWorkStealingDeque::Steal(ezTaskQueueEntry& out_entry)
+{
+  ezInt64 t = m_iTop.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const ezInt64 b = m_iBottom.load(std::memory_order_acquire);
+
+  if (t >= b)
+    return ezTaskStealResult::Empty;
+
+  // the entry may only be overwritten by the owner after 'top' has moved past it, in which case the CAS below fails
+  const ezTaskQueueEntry entry = m_Entries[t & Mask];
+
+  if (!m_iTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    return ezTaskStealResult::Contended;
+
+  out_entry = entry;
+  return ezTaskStealResult::Success;
+}
+
+bool ezTaskWorkStealingDeque::IsEmpty() const
+{
+  const ezInt64 t = m_iTop.load(std::memory_order_acquire);
+  const ezInt64 b = m_iBottom.load(std::memory_order_acquire);
+  return t >= b;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezTaskInjectionQueue::ezTaskInjectionQueue()
+{
+  for (ezUInt32 i = 0; i < Capacity; ++i)
+  {
+    m_Cells[i].m_uiSequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool ezTaskInjectionQueue::Push(const ezTaskQueueEntry& entry)
+{
+  ezUInt64 pos = m_uiEnqueuePos.load(std::memory_order_relaxed);
+  Cell* pCell = nullptr;
+
+  while (true)
+  {
+    pCell = &m_Cells[pos & Mask];
+    const ezUInt64 seq = pCell->m_uiSequence.load(std::memory_order_acquire);
+    const ezInt64 iDiff = (ezInt64)seq - (ezInt64)pos;
+
+    if (iDiff == 0)
+    {
+      // the cell is free, try to claim it
+      if (m_uiEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    }
+    else if (iDiff < 0)
+    {
+      // the cell still holds an entry from one round earlier -> queue is full
+      return false;
+    }
+    else
+    {
+      // another producer was faster
+      pos = m_uiEnqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  pCell->m_Entry = entry;
+  pCell->m_uiSequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+bool ezTaskInjectionQueue::Pop(ezTaskQueueEntry& out_entry)
+{
+  ezUInt64 pos = m_uiDequeuePos.load(std::memory_order_relaxed);
+  Cell* pCell = nullptr;
+
+  while (true)
+  {
+    pCell = &m_Cells[pos & Mask];
+    const ezUInt64 seq = pCell->m_uiSequence.load(std::memory_order_acquire);
+    const ezInt64 iDiff = (ezInt64)seq - (ezInt64)(pos + 1);
+
+    if (iDiff == 0)
+    {
+      // the cell holds an entry, try to claim it
+      if (m_uiDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        break;
+    }
+    else if (iDiff < 0)
+    {
+      // nothing written into this cell yet -> queue is empty
+      return false;
+    }
+    else
+    {
+      // another consumer was faster
+      pos = m_uiDequeuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  out_entry = pCell->m_Entry;
+  pCell->m_uiSequence.store(pos + Mask + 1, std::memory_order_release);
+  return true;
+}
+
+bool ezTaskInjectionQueue::IsEmpty() const
+{
+  const ezUInt64 uiDequeuePos = m_uiDequeuePos.load(std::memory_order_acquire);
+  const ezUInt64 uiEnqueuePos = m_uiEnqueuePos.load(std::memory_order_acquire);
+  return uiDequeuePos >= uiEnqueuePos;
+}
+
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Threading_Implementation_TaskWorkStealingQueues);
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
+
+#include <atomic>
+
+/// \internal Only tasks with a priority up to (and including) this one are handled by the lock-free queues.
+constexpr ezUInt32 ezTaskNumWorkStealingPriorities = ezTaskPriority::LateThisFrame + 1;
+
+/// \internal A reference to one scheduled invocation of a task, as stored in the lock-free queues of the work-stealing scheduler.
+///
+/// The task itself is identified through its index in ezTaskGroup::m_Tasks. That array is not modified while the group is scheduled,
+/// and the group keeps a reference to all its tasks, so the queues don't need to hold a reference themselves.
+struct ezTaskQueueEntry
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezTaskGroup* m_pGroup = nullptr;
+  ezUInt32 m_uiTaskIndex = 0;
+  ezUInt32 m_uiInvocation = 0;
+};
+
+/// \internal Result of a steal attempt on an ezTaskWorkStealingDeque.
+enum class ezTaskStealResult
+{
+  Success,
+  Empty,
+  Contended, ///< Another thread won the race for the same entry. The deque may still contain work.
+};
+
+/// \internal Fixed capacity Chase-Lev work-stealing deque.
+///
+/// Only the owning worker thread may call Push() and Pop(), which operate on the 'bottom' end in LIFO order.
+/// Any other thread may call Steal() to take entries from the 'top' end in FIFO order.
+/// None of the operations take a lock.
+class ezTaskWorkStealingDeque
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezTaskWorkStealingDeque);
+
+public:
+  static constexpr ezUInt32 Capacity = 1024;
+
+  ezTaskWorkStealingDeque() = default;
+
+  /// \brief Owner only. Returns false, if the deque is full.
+  bool Push(const ezTaskQueueEntry& entry);
+
+  /// \brief Owner only. Takes the most recently pushed entry.
+  bool Pop(ezTaskQueueEntry& out_entry);
+
+  /// \brief May be called from any thread. Takes the oldest entry.
+  ezTaskStealResult Steal(ezTaskQueueEntry& out_entry);
+
+  /// \brief Returns whether the deque currently appears to be empty. The result may be outdated by the time it is returned.
+  bool IsEmpty() const;
+
+private:
+  static constexpr ezUInt32 Mask = Capacity - 1;
+
+  // top and bottom are padded apart, so that stealing threads don't invalidate the owner's cache line all the time
+  std::atomic<ezInt64> m_iTop = {0};
+  ezUInt8 m_Padding0[64 - sizeof(std::atomic<ezInt64>)];
+  std::atomic<ezInt64> m_iBottom = {0};
+  ezUInt8 m_Padding1[64 - sizeof(std::atomic<ezInt64>)];
+  ezTaskQueueEntry m_Entries[Capacity];
+};
+
+/// \internal Fixed capacity multi-producer / multi-consumer queue that is used to inject tasks from threads that don't own a
+/// ezTaskWorkStealingDeque (e.g. the main thread).
+///
+/// This is a bounded queue where every cell carries a sequence number, so that producers and consumers only ever contend on a
+/// single atomic each.
+class ezTaskInjectionQueue
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezTaskInjectionQueue);
+
+public:
+  static constexpr ezUInt32 Capacity = 4096;
+
+  ezTaskInjectionQueue();
+
+  /// \brief Returns false, if the queue is full.
+  bool Push(const ezTaskQueueEntry& entry);
+
+  /// \brief Returns false, if the queue is empty.
+  bool Pop(ezTaskQueueEntry& out_entry);
+
+  /// \brief Returns whether the queue currently appears to be empty. The result may be outdated by the time it is returned.
+  bool IsEmpty() const;
+
+private:
+  static constexpr ezUInt32 Mask = Capacity - 1;
+
+  struct Cell
+  {
+    std::atomic<ezUInt64> m_uiSequence;
+    ezTaskQueueEntry m_Entry;
+  };
+
+  std::atomic<ezUInt64> m_uiEnqueuePos = {0};
+  ezUInt8 m_Padding0[64 - sizeof(std::atomic<ezUInt64>)];
+  std::atomic<ezUInt64> m_uiDequeuePos = {0};
+  ezUInt8 m_Padding1[64 - sizeof(std::atomic<ezUInt64>)];
+  Cell m_Cells[Capacity];
+};
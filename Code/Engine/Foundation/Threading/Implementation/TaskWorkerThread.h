@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
+#include <Foundation/Threading/Implementation/TaskWorkStealingQueues.h>
 
 #include <Foundation/Threading/Thread.h>
 #include <Foundation/Threading/ThreadSignal.h>
@@ -75,6 +76,18 @@ private:
   ezAtomicInteger32 m_iWorkerState; // ezTaskWorkerState
 
   ///@}
+
+  /// \name Work Stealing
+  ///@{
+
+private:
+  friend class ezTaskSystem;
+
+  // The tasks that this thread scheduled itself with ezTaskSchedulerMode::WorkStealing, one deque per priority.
+  // Only this thread pushes and pops, all other threads may steal from them.
+  ezTaskWorkStealingDeque m_LocalQueues[ezTaskNumWorkStealingPriorities];
+
+  ///@}
 };
 
 /// \internal Thread local state used by the task system (and for better debugging)
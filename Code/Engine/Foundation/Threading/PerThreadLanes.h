@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+/// \brief Gives every thread that accesses an object its own 'lane' of that object, e.g. a set of buckets or an array of entries.
+///
+/// The lane of the calling thread is found through a thread local hash map from the unique serial of this instance to the lane,
+/// so looking it up neither locks nor touches memory that is shared with other threads. Only the first access of a thread locks
+/// a mutex to create its lane through the given function. The lanes are owned by the user, who has to delete them before
+/// this object is destroyed.
+class EZ_FOUNDATION_DLL ezPerThreadLanes
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezPerThreadLanes);
+
+public:
+  using CreateLaneFunc = void* (*)(void* pPassThrough);
+
+  ezPerThreadLanes(ezAllocatorBase* pAllocator, CreateLaneFunc createLaneFunc, void* pPassThrough);
+  ~ezPerThreadLanes();
+
+  /// \brief Returns the lane of the calling thread and creates it, if this thread has never accessed this object before.
+  void* GetLaneForCurrentThread();
+
+  /// \brief Returns all lanes in the order of creation. Lock GetMutex() while other threads may create lanes.
+  ezArrayPtr<void* const> GetLanes() const { return m_Lanes; }
+
+  /// \brief Returns the ID of the thread that owns the lane with the given index.
+  ezThreadID GetLaneThreadID(ezUInt32 uiIndex) const { return m_LaneThreadIDs[uiIndex]; }
+
+  /// \brief Removes all lanes. The lanes themselves need to be deleted by the user.
+  void Clear();
+
+  /// \brief The mutex that protects the list of lanes.
+  ezMutex& GetMutex() const { return m_Mutex; }
+
+private:
+  void* CreateLaneForCurrentThread();
+
+  CreateLaneFunc m_CreateLaneFunc = nullptr;
+  void* m_pPassThrough = nullptr;
+
+  /// Unique per instance and never reused, so stale entries in the thread local maps can never produce a false hit.
+  ezUInt64 m_uiSerial = 0;
+
+  mutable ezMutex m_Mutex;
+  ezDynamicArray<void*> m_Lanes;
+  ezDynamicArray<ezThreadID> m_LaneThreadIDs;
+};
@@ -217,6 +217,16 @@ public:
   /// \brief [internal] Wakes up or allocates up to \a uiNumThreads, unless enough threads are currently active and not blocked
   static void WakeUpThreads(ezWorkerThreadType::Enum type, ezUInt32 uiNumThreads);
 
+  /// \brief Selects how short tasks are distributed across the worker threads. See ezTaskSchedulerMode for details.
+  ///
+  /// This can be switched at any time, tasks that are already queued are still executed.
+  /// With ezTaskSchedulerMode::WorkStealing, tasks that sit in one of the lock-free queues can't be removed anymore,
+  /// so CancelTask() will return EZ_FAILURE for them, even though they won't be executed.
+  static void SetSchedulerMode(ezTaskSchedulerMode::Enum mode); // [tested]
+
+  /// \brief Returns the mode that was set through SetSchedulerMode().
+  static ezTaskSchedulerMode::Enum GetSchedulerMode();
+
 private:
   friend class ezTaskWorkerThread;
 
@@ -226,6 +236,18 @@ private:
   /// \brief Shuts down all worker threads. Does NOT finish the remaining tasks that were not started yet. Does not clear them either, though.
   static void StopWorkerThreads();
 
+  /// \brief Tries to put the task invocation into one of the lock-free work-stealing queues. Returns false, if it has to go into a regular list instead.
+  static bool ScheduleWorkStealingTask(ezTaskPriority::Enum priority, const ezTaskQueueEntry& entry);
+
+  /// \brief Takes a task of the given priority out of the lock-free work-stealing queues, if possible.
+  static bool GetNextWorkStealingTask(ezTaskPriority::Enum priority, TaskData& out_taskData);
+
+  /// \brief Returns whether any of the lock-free queues with a priority between \a FirstPriority and \a LastPriority (inclusive) appears to contain work.
+  static bool HasWorkStealingTasks(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority);
+
+  /// \brief Moves the remaining entries of all worker deques into the shared queues. Must only be called while the workers are not running.
+  static void ReclaimWorkerDequeTasks();
+
   /// \brief Uses a thread local variable to know the current thread type and to decide the range of task priorities that it may execute
   static void DetermineTasksToExecuteOnThread(ezTaskPriority::Enum& out_FirstPriority, ezTaskPriority::Enum& out_LastPriority);
 
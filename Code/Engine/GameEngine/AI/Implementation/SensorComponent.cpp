@@ -3,6 +3,10 @@
 #include <Core/Interfaces/PhysicsWorldModule.h>
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/SimdMath/SimdBSphere.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <GameEngine/AI/SensorComponent.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 
@@ -89,6 +93,20 @@ void ezSensorComponent::OnDeactivated()
   UpdateDebugInfo();
 }
 
+void ezSensorComponent::GetObjectsInSensorVolume(ezDynamicArray<ezGameObject*>& out_objects) const
+{
+  ezSpatialSystem::QueryParams params;
+  params.m_uiCategoryBitmask = m_SpatialCategory.GetBitmask();
+
+  ezHybridArray<ezGameObject*, 64> objectsInSphere;
+
+  GetWorld()->GetSpatialSystem()->FindObjectsInSphere(GetSensorBoundingSphere(), params, [&](ezGameObject* pObject) {
+    objectsInSphere.PushBack(pObject);
+    return ezVisitorExecution::Continue; });
+
+  FilterObjectsInSensorVolume(objectsInSphere, out_objects);
+}
+
 void ezSensorComponent::SetSpatialCategory(const char* szCategory)
 {
   m_sSpatialCategory.Assign(szCategory);
@@ -222,20 +240,21 @@ void ezSensorSphereComponent::DeserializeComponent(ezWorldReader& inout_stream)
   s >> m_fRadius;
 }
 
-void ezSensorSphereComponent::GetObjectsInSensorVolume(ezDynamicArray<ezGameObject*>& out_objects) const
+ezBoundingSphere ezSensorSphereComponent::GetSensorBoundingSphere() const
 {
   const ezGameObject* pOwner = GetOwner();
 
   const float scale = pOwner->GetGlobalTransformSimd().GetMaxScale();
-  ezBoundingSphere sphere = ezBoundingSphere::MakeFromCenterAndRadius(pOwner->GetGlobalPosition(), m_fRadius * scale);
-
-  ezSpatialSystem::QueryParams params;
-  params.m_uiCategoryBitmask = m_SpatialCategory.GetBitmask();
+  return ezBoundingSphere::MakeFromCenterAndRadius(pOwner->GetGlobalPosition(), m_fRadius * scale);
+}
 
-  ezSimdMat4f toLocalSpace = pOwner->GetGlobalTransformSimd().GetAsMat4().GetInverse();
+void ezSensorSphereComponent::FilterObjectsInSensorVolume(ezArrayPtr<ezGameObject* const> objects, ezDynamicArray<ezGameObject*>& out_objects) const
+{
+  ezSimdMat4f toLocalSpace = GetOwner()->GetGlobalTransformSimd().GetAsMat4().GetInverse();
   ezSimdFloat radiusSquared = m_fRadius * m_fRadius;
 
-  GetWorld()->GetSpatialSystem()->FindObjectsInSphere(sphere, params, [&](ezGameObject* pObject) {
+  for (ezGameObject* pObject : objects)
+  {
     ezSimdVec4f localSpacePos = toLocalSpace.TransformPosition(pObject->GetGlobalPositionSimd());
     const bool bInRadius = localSpacePos.GetLengthSquared<3>() <= radiusSquared;
 
@@ -243,8 +262,7 @@ void ezSensorSphereComponent::GetObjectsInSensorVolume(ezDynamicArray<ezGameObje
     {
       out_objects.PushBack(pObject);
     }
-
-    return ezVisitorExecution::Continue; });
+  }
 }
 
 void ezSensorSphereComponent::DebugDrawSensorShape() const
@@ -296,7 +314,7 @@ void ezSensorCylinderComponent::DeserializeComponent(ezWorldReader& inout_stream
   s >> m_fHeight;
 }
 
-void ezSensorCylinderComponent::GetObjectsInSensorVolume(ezDynamicArray<ezGameObject*>& out_objects) const
+ezBoundingSphere ezSensorCylinderComponent::GetSensorBoundingSphere() const
 {
   const ezGameObject* pOwner = GetOwner();
 
@@ -304,16 +322,17 @@ void ezSensorCylinderComponent::GetObjectsInSensorVolume(ezDynamicArray<ezGameOb
   const float xyScale = ezMath::Max(scale.x, scale.y);
 
   const float sphereRadius = ezVec2(m_fRadius * xyScale, m_fHeight * 0.5f * scale.z).GetLength();
-  ezBoundingSphere sphere = ezBoundingSphere::MakeFromCenterAndRadius(pOwner->GetGlobalPosition(), sphereRadius);
-
-  ezSpatialSystem::QueryParams params;
-  params.m_uiCategoryBitmask = m_SpatialCategory.GetBitmask();
+  return ezBoundingSphere::MakeFromCenterAndRadius(pOwner->GetGlobalPosition(), sphereRadius);
+}
 
-  ezSimdMat4f toLocalSpace = pOwner->GetGlobalTransformSimd().GetAsMat4().GetInverse();
+void ezSensorCylinderComponent::FilterObjectsInSensorVolume(ezArrayPtr<ezGameObject* const> objects, ezDynamicArray<ezGameObject*>& out_objects) const
+{
+  ezSimdMat4f toLocalSpace = GetOwner()->GetGlobalTransformSimd().GetAsMat4().GetInverse();
   ezSimdFloat radiusSquared = m_fRadius * m_fRadius;
   ezSimdFloat halfHeight = m_fHeight * 0.5f;
 
-  GetWorld()->GetSpatialSystem()->FindObjectsInSphere(sphere, params, [&](ezGameObject* pObject) {
+  for (ezGameObject* pObject : objects)
+  {
     ezSimdVec4f localSpacePos = toLocalSpace.TransformPosition(pObject->GetGlobalPositionSimd());
     const bool bInRadius = localSpacePos.GetLengthSquared<2>() <= radiusSquared;
     const bool bInHeight = localSpacePos.Abs().z() <= halfHeight;
@@ -322,8 +341,7 @@ void ezSensorCylinderComponent::GetObjectsInSensorVolume(ezDynamicArray<ezGameOb
     {
       out_objects.PushBack(pObject);
     }
-
-    return ezVisitorExecution::Continue; });
+  }
 }
 
 void ezSensorCylinderComponent::DebugDrawSensorShape() const
@@ -380,22 +398,23 @@ void ezSensorConeComponent::DeserializeComponent(ezWorldReader& inout_stream)
   s >> m_Angle;
 }
 
-void ezSensorConeComponent::GetObjectsInSensorVolume(ezDynamicArray<ezGameObject*>& out_objects) const
+ezBoundingSphere ezSensorConeComponent::GetSensorBoundingSphere() const
 {
   const ezGameObject* pOwner = GetOwner();
 
   const float scale = pOwner->GetGlobalTransformSimd().GetMaxScale();
-  ezBoundingSphere sphere = ezBoundingSphere::MakeFromCenterAndRadius(pOwner->GetGlobalPosition(), m_fFarDistance * scale);
-
-  ezSpatialSystem::QueryParams params;
-  params.m_uiCategoryBitmask = m_SpatialCategory.GetBitmask();
+  return ezBoundingSphere::MakeFromCenterAndRadius(pOwner->GetGlobalPosition(), m_fFarDistance * scale);
+}
 
-  ezSimdMat4f toLocalSpace = pOwner->GetGlobalTransformSimd().GetAsMat4().GetInverse();
+void ezSensorConeComponent::FilterObjectsInSensorVolume(ezArrayPtr<ezGameObject* const> objects, ezDynamicArray<ezGameObject*>& out_objects) const
+{
+  ezSimdMat4f toLocalSpace = GetOwner()->GetGlobalTransformSimd().GetAsMat4().GetInverse();
   const ezSimdFloat nearSquared = m_fNearDistance * m_fNearDistance;
   const ezSimdFloat farSquared = m_fFarDistance * m_fFarDistance;
   const ezSimdFloat cosAngle = ezMath::Cos(m_Angle * 0.5f);
 
-  GetWorld()->GetSpatialSystem()->FindObjectsInSphere(sphere, params, [&](ezGameObject* pObject) {
+  for (ezGameObject* pObject : objects)
+  {
     ezSimdVec4f localSpacePos = toLocalSpace.TransformPosition(pObject->GetGlobalPositionSimd());
     const ezSimdFloat fDistanceSquared = localSpacePos.GetLengthSquared<3>();
     const bool bInDistance = fDistanceSquared >= nearSquared && fDistanceSquared <= farSquared;
@@ -407,8 +426,7 @@ void ezSensorConeComponent::GetObjectsInSensorVolume(ezDynamicArray<ezGameObject
     {
       out_objects.PushBack(pObject);
     }
-
-    return ezVisitorExecution::Continue; });
+  }
 }
 
 void ezSensorConeComponent::DebugDrawSensorShape() const
@@ -573,75 +591,269 @@ void ezSensorWorldModule::UpdateSensors(const ezWorldModule::UpdateContext& cont
   if (m_pPhysicsWorldModule == nullptr)
     return;
 
+  m_uiNumSensorsToUpdate = 0;
+
   const ezTime deltaTime = GetWorld()->GetClock().GetTimeDiff();
   m_Scheduler.Update(deltaTime, [this](const ezComponentHandle& hComponent, ezTime deltaTime) {
     const ezWorld* pWorld = GetWorld();
     const ezSensorComponent* pSensorComponent = nullptr;
     EZ_VERIFY(pWorld->TryGetComponent(hComponent, pSensorComponent), "Invalid component handle");
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    pSensorComponent->m_LastOccludedObjectPositions.Clear();
-#endif
+    if (m_uiNumSensorsToUpdate == m_SensorData.GetCount())
+    {
+      m_SensorData.ExpandAndGetRef();
+    }
+
+    SensorData& sensorData = m_SensorData[m_uiNumSensorsToUpdate];
+    ++m_uiNumSensorsToUpdate;
+
+    sensorData.m_pSensor = pSensorComponent;
+    sensorData.m_BoundingSphere = pSensorComponent->GetSensorBoundingSphere();
+    sensorData.m_uiSharedQuery = ezInvalidIndex;
+    sensorData.m_uiFirstRay = ezInvalidIndex;
+    sensorData.m_bDetectedObjectsChanged = false;
+    sensorData.m_ObjectsInSensorVolume.Clear(); });
+
+  if (m_uiNumSensorsToUpdate == 0)
+    return;
+
+  // sensors with the same spatial category can share spatial queries and sensors with the same collision layer can share a raycast batch
+  ezArrayPtr<SensorData> sensors = m_SensorData.GetArrayPtr().GetSubArray(0, m_uiNumSensorsToUpdate);
+  ezSorting::QuickSort(sensors, [](const SensorData& a, const SensorData& b) {
+    const ezUInt16 uiCategoryA = a.m_pSensor->m_SpatialCategory.m_uiValue;
+    const ezUInt16 uiCategoryB = b.m_pSensor->m_SpatialCategory.m_uiValue;
+    if (uiCategoryA != uiCategoryB)
+      return uiCategoryA < uiCategoryB;
+
+    return a.m_pSensor->m_uiCollisionLayer < b.m_pSensor->m_uiCollisionLayer; });
+
+  FindObjectsInSensorVolumes();
+  TestVisibility();
+  UpdateDetectedObjects();
+
+  // send the messages from a single thread after all sensors are done, so that their order is deterministic
+  for (const SensorData& sensorData : sensors)
+  {
+    if (!sensorData.m_bDetectedObjectsChanged)
+      continue;
+
+    const ezSensorComponent* pSensorComponent = sensorData.m_pSensor;
+
+    ezMsgSensorDetectedObjectsChanged msg;
+    msg.m_DetectedObjects = pSensorComponent->m_LastDetectedObjects;
+
+    pSensorComponent->GetOwner()->PostEventMessage(msg, pSensorComponent, ezTime::MakeZero(), ezObjectMsgQueueType::PostAsync);
+  }
+}
+
+void ezSensorWorldModule::FindObjectsInSensorVolumes()
+{
+  EZ_PROFILE_SCOPE("FindObjectsInSensorVolumes");
+
+  ezArrayPtr<SensorData> sensors = m_SensorData.GetArrayPtr().GetSubArray(0, m_uiNumSensorsToUpdate);
+
+  m_SharedQueries.Clear();
+  m_SharedQueryObjects.Clear();
+
+  // Sensors of the same category that overlap a lot, e.g. in a crowd, share a single spatial query. Each of them then only has to
+  // test the objects of the shared query, instead of walking the spatial system again.
+  for (ezUInt32 uiFirstSensor = 0; uiFirstSensor < sensors.GetCount();)
+  {
+    const ezSpatialData::Category category = sensors[uiFirstSensor].m_pSensor->m_SpatialCategory;
+
+    ezBoundingBox sharedBox = ezBoundingBox::MakeInvalid();
+    float fSumOfVolumes = 0.0f;
+
+    ezUInt32 uiEndSensor = uiFirstSensor;
+    for (; uiEndSensor < sensors.GetCount() && sensors[uiEndSensor].m_pSensor->m_SpatialCategory == category; ++uiEndSensor)
+    {
+      const ezBoundingSphere& sphere = sensors[uiEndSensor].m_BoundingSphere;
+      sharedBox.ExpandToInclude(ezBoundingBox::MakeFromCenterAndHalfExtents(sphere.m_vCenter, ezVec3(sphere.m_fRadius)));
+
+      const float fDiameter = sphere.m_fRadius * 2.0f;
+      fSumOfVolumes += fDiameter * fDiameter * fDiameter;
+    }
+
+    const ezVec3 vSharedExtents = sharedBox.GetExtents();
+    const bool bShareQuery = (uiEndSensor - uiFirstSensor) > 1 && vSharedExtents.x * vSharedExtents.y * vSharedExtents.z <= fSumOfVolumes;
 
-    m_ObjectsInSensorVolume.Clear();
+    if (bShareQuery)
+    {
+      SharedQuery& sharedQuery = m_SharedQueries.ExpandAndGetRef();
+      sharedQuery.m_uiFirstObject = m_SharedQueryObjects.GetCount();
+
+      ezSpatialSystem::QueryParams params;
+      params.m_uiCategoryBitmask = category.GetBitmask();
+
+      GetWorld()->GetSpatialSystem()->FindObjectsInBox(sharedBox, params, [this](ezGameObject* pObject) {
+        m_SharedQueryObjects.PushBack(pObject);
+        return ezVisitorExecution::Continue; });
 
-    pSensorComponent->GetObjectsInSensorVolume(m_ObjectsInSensorVolume);
-    const ezGameObject* pSensorOwner = pSensorComponent->GetOwner();
+      sharedQuery.m_uiNumObjects = m_SharedQueryObjects.GetCount() - sharedQuery.m_uiFirstObject;
+
+      for (ezUInt32 i = uiFirstSensor; i < uiEndSensor; ++i)
+      {
+        sensors[i].m_uiSharedQuery = m_SharedQueries.GetCount() - 1;
+      }
+    }
+
+    uiFirstSensor = uiEndSensor;
+  }
 
-    m_DetectedObjects.Clear();
+  auto findObjects = [this](ezArrayPtr<SensorData> sensorsSlice) {
+    ezHybridArray<ezGameObject*, 256> objectsInSphere;
 
-    if (pSensorComponent->m_bTestVisibility)
+    for (SensorData& sensorData : sensorsSlice)
     {
-      const ezVec3 rayStart = pSensorOwner->GetGlobalPosition();
-      for (auto pObject : m_ObjectsInSensorVolume)
+      if (sensorData.m_uiSharedQuery == ezInvalidIndex)
       {
-        const ezVec3 rayEnd = pObject->GetGlobalPosition();
-        ezVec3 rayDir = rayEnd - rayStart;
-        const float fDistance = rayDir.GetLengthAndNormalize();
-
-        ezPhysicsCastResult hitResult;
-        ezPhysicsQueryParameters params(pSensorComponent->m_uiCollisionLayer);
-        params.m_bIgnoreInitialOverlap = true;
-        params.m_ShapeTypes = ezPhysicsShapeType::Default;
-
-        // TODO: probably best to expose the ezPhysicsShapeType bitflags on the component
-        params.m_ShapeTypes.Remove(ezPhysicsShapeType::Rope);
-        params.m_ShapeTypes.Remove(ezPhysicsShapeType::Ragdoll);
-        params.m_ShapeTypes.Remove(ezPhysicsShapeType::Trigger);
-        params.m_ShapeTypes.Remove(ezPhysicsShapeType::Query);
-        params.m_ShapeTypes.Remove(ezPhysicsShapeType::Character);
-
-        if (m_pPhysicsWorldModule->Raycast(hitResult, rayStart, rayDir, fDistance, params))
+        sensorData.m_pSensor->GetObjectsInSensorVolume(sensorData.m_ObjectsInSensorVolume);
+        continue;
+      }
+
+      const SharedQuery& sharedQuery = m_SharedQueries[sensorData.m_uiSharedQuery];
+      const ezSimdBSphere sphere(ezSimdConversion::ToVec3(sensorData.m_BoundingSphere.m_vCenter), sensorData.m_BoundingSphere.m_fRadius);
+
+      // the sensor volume is inside its bounding sphere, so this cheap test already rejects most objects of the shared query
+      objectsInSphere.Clear();
+      for (ezGameObject* pObject : m_SharedQueryObjects.GetArrayPtr().GetSubArray(sharedQuery.m_uiFirstObject, sharedQuery.m_uiNumObjects))
+      {
+        if (sphere.Contains(pObject->GetGlobalPositionSimd()))
+        {
+          objectsInSphere.PushBack(pObject);
+        }
+      }
+
+      sensorData.m_pSensor->FilterObjectsInSensorVolume(objectsInSphere, sensorData.m_ObjectsInSensorVolume);
+    }
+  };
+
+  ezParallelForParams parallelForParams;
+  parallelForParams.m_uiBinSize = 8;
+
+  ezTaskSystem::ParallelFor(sensors, findObjects, "FindObjectsInSensorVolume", parallelForParams);
+}
+
+void ezSensorWorldModule::TestVisibility()
+{
+  EZ_PROFILE_SCOPE("TestSensorVisibility");
+
+  ezArrayPtr<SensorData> sensors = m_SensorData.GetArrayPtr().GetSubArray(0, m_uiNumSensorsToUpdate);
+
+  m_RayQueries.Clear();
+
+  for (SensorData& sensorData : sensors)
+  {
+    if (!sensorData.m_pSensor->m_bTestVisibility)
+      continue;
+
+    sensorData.m_uiFirstRay = m_RayQueries.GetCount();
+
+    const ezVec3 rayStart = sensorData.m_pSensor->GetOwner()->GetGlobalPosition();
+    for (const ezGameObject* pObject : sensorData.m_ObjectsInSensorVolume)
+    {
+      ezPhysicsRaycastQuery& ray = m_RayQueries.ExpandAndGetRef();
+      ray.m_vStart = rayStart;
+      ray.m_vDir = pObject->GetGlobalPosition() - rayStart;
+      ray.m_fDistance = ray.m_vDir.GetLengthAndNormalize();
+    }
+  }
+
+  m_RayResults.SetCount(m_RayQueries.GetCount());
+  m_RayHits.SetCountUninitialized(m_RayQueries.GetCount());
+
+  // the sensors are sorted by collision layer within each spatial category, so every run of sensors with the same layer is one batch
+  for (ezUInt32 uiFirstSensor = 0; uiFirstSensor < sensors.GetCount();)
+  {
+    const ezUInt8 uiCollisionLayer = sensors[uiFirstSensor].m_pSensor->m_uiCollisionLayer;
+
+    ezUInt32 uiFirstRay = ezInvalidIndex;
+    ezUInt32 uiEndRay = 0;
+
+    ezUInt32 uiEndSensor = uiFirstSensor;
+    for (; uiEndSensor < sensors.GetCount() && sensors[uiEndSensor].m_pSensor->m_uiCollisionLayer == uiCollisionLayer; ++uiEndSensor)
+    {
+      const SensorData& sensorData = sensors[uiEndSensor];
+      if (sensorData.m_uiFirstRay == ezInvalidIndex)
+        continue;
+
+      uiFirstRay = ezMath::Min(uiFirstRay, sensorData.m_uiFirstRay);
+      uiEndRay = sensorData.m_uiFirstRay + sensorData.m_ObjectsInSensorVolume.GetCount();
+    }
+
+    if (uiFirstRay < uiEndRay)
+    {
+      ezPhysicsQueryParameters params(uiCollisionLayer);
+      params.m_bIgnoreInitialOverlap = true;
+      params.m_ShapeTypes = ezPhysicsShapeType::Default;
+
+      // TODO: probably best to expose the ezPhysicsShapeType bitflags on the component
+      params.m_ShapeTypes.Remove(ezPhysicsShapeType::Rope);
+      params.m_ShapeTypes.Remove(ezPhysicsShapeType::Ragdoll);
+      params.m_ShapeTypes.Remove(ezPhysicsShapeType::Trigger);
+      params.m_ShapeTypes.Remove(ezPhysicsShapeType::Query);
+      params.m_ShapeTypes.Remove(ezPhysicsShapeType::Character);
+
+      const ezUInt32 uiNumRays = uiEndRay - uiFirstRay;
+
+      // any hit in between means the object is occluded, there is no need to find the closest one
+      m_pPhysicsWorldModule->RaycastBatch(m_RayResults.GetArrayPtr().GetSubArray(uiFirstRay, uiNumRays), m_RayHits.GetArrayPtr().GetSubArray(uiFirstRay, uiNumRays),
+        m_RayQueries.GetArrayPtr().GetSubArray(uiFirstRay, uiNumRays), params, ezPhysicsHitCollection::Any);
+    }
+
+    uiFirstSensor = uiEndSensor;
+  }
+}
+
+void ezSensorWorldModule::UpdateDetectedObjects()
+{
+  EZ_PROFILE_SCOPE("UpdateDetectedObjects");
+
+  ezArrayPtr<SensorData> sensors = m_SensorData.GetArrayPtr().GetSubArray(0, m_uiNumSensorsToUpdate);
+
+  auto updateDetectedObjects = [this](ezArrayPtr<SensorData> sensorsSlice) {
+    ezDynamicArray<ezGameObjectHandle> detectedObjects;
+
+    for (SensorData& sensorData : sensorsSlice)
+    {
+      const ezSensorComponent* pSensorComponent = sensorData.m_pSensor;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      pSensorComponent->m_LastOccludedObjectPositions.Clear();
+#endif
+
+      detectedObjects.Clear();
+
+      for (ezUInt32 i = 0; i < sensorData.m_ObjectsInSensorVolume.GetCount(); ++i)
+      {
+        const ezGameObject* pObject = sensorData.m_ObjectsInSensorVolume[i];
+
+        if (sensorData.m_uiFirstRay != ezInvalidIndex && m_RayHits[sensorData.m_uiFirstRay + i])
         {
           // hit something in between -> not visible
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-          pSensorComponent->m_LastOccludedObjectPositions.PushBack(rayEnd);
+          pSensorComponent->m_LastOccludedObjectPositions.PushBack(pObject->GetGlobalPosition());
 #endif
 
           continue;
         }
 
-        m_DetectedObjects.PushBack(pObject->GetHandle());
+        detectedObjects.PushBack(pObject->GetHandle());
       }
-    }
-    else
-    {
-      for (auto pObject : m_ObjectsInSensorVolume)
+
+      detectedObjects.Sort();
+      if (detectedObjects != pSensorComponent->m_LastDetectedObjects)
       {
-        m_DetectedObjects.PushBack(pObject->GetHandle());
+        detectedObjects.Swap(pSensorComponent->m_LastDetectedObjects);
+        sensorData.m_bDetectedObjectsChanged = true;
       }
     }
+  };
 
-    m_DetectedObjects.Sort();
-    if (m_DetectedObjects != pSensorComponent->m_LastDetectedObjects)
-    {
-      m_DetectedObjects.Swap(pSensorComponent->m_LastDetectedObjects);
-
-      ezMsgSensorDetectedObjectsChanged msg;
-      msg.m_DetectedObjects = pSensorComponent->m_LastDetectedObjects;
+  ezParallelForParams parallelForParams;
+  parallelForParams.m_uiBinSize = 8;
 
-      pSensorOwner->PostEventMessage(msg, pSensorComponent, ezTime::MakeZero(), ezObjectMsgQueueType::PostAsync);
-    } });
+  ezTaskSystem::ParallelFor(sensors, updateDetectedObjects, "UpdateDetectedObjects", parallelForParams);
 }
 
 void ezSensorWorldModule::DebugDrawSensors(const ezWorldModule::UpdateContext& context)
@@ -1,12 +1,11 @@
 #pragma once
 
+#include <Core/Interfaces/PhysicsWorldModule.h>
 #include <Core/Messages/EventMessage.h>
 #include <Core/Utils/IntervalScheduler.h>
 #include <Core/World/World.h>
 #include <GameEngine/GameEngineDLL.h>
 
-class ezPhysicsWorldModuleInterface;
-
 struct EZ_GAMEENGINE_DLL ezMsgSensorDetectedObjectsChanged : public ezEventMessage
 {
   EZ_DECLARE_MESSAGE_TYPE(ezMsgSensorDetectedObjectsChanged, ezEventMessage);
@@ -23,6 +22,8 @@ struct EZ_GAMEENGINE_DLL ezMsgSensorDetectedObjectsChanged : public ezEventMessa
 /// with matching spatial category for the sensors to detect them. This can be achieved with components like e.g. ezMarkerComponent.
 /// Visibility tests via raycasts are done afterwards by default but can be disabled.
 /// The components store an array of all their currently detected objects and send an ezMsgSensorDetectedObjectsChanged message if this array changes.
+///
+/// All sensors that are due in a frame are evaluated together by the ezSensorWorldModule, in parallel and with batched raycasts.
 class EZ_GAMEENGINE_DLL ezSensorComponent : public ezComponent
 {
   EZ_DECLARE_ABSTRACT_COMPONENT_TYPE(ezSensorComponent, ezComponent);
@@ -45,7 +46,18 @@ public:
   ezSensorComponent();
   ~ezSensorComponent();
 
-  virtual void GetObjectsInSensorVolume(ezDynamicArray<ezGameObject*>& out_objects) const = 0;
+  /// \brief Appends all objects of the sensor's spatial category that are inside the sensor volume.
+  void GetObjectsInSensorVolume(ezDynamicArray<ezGameObject*>& out_objects) const;
+
+  /// \brief Returns a world space sphere that encloses the entire sensor volume.
+  virtual ezBoundingSphere GetSensorBoundingSphere() const = 0;
+
+  /// \brief Appends those of the given objects to out_objects, that are inside the sensor volume.
+  ///
+  /// The objects have already been filtered by spatial category, but may lie anywhere inside or outside of the bounding sphere.
+  /// Must be thread-safe, since the sensor world module calls this in parallel for many sensors.
+  virtual void FilterObjectsInSensorVolume(ezArrayPtr<ezGameObject* const> objects, ezDynamicArray<ezGameObject*>& out_objects) const = 0;
+
   virtual void DebugDrawSensorShape() const = 0;
 
   void SetSpatialCategory(const char* szCategory); // [ property ]
@@ -104,7 +116,8 @@ public:
   //////////////////////////////////////////////////////////////////////////
   // ezSensorComponent
 
-  virtual void GetObjectsInSensorVolume(ezDynamicArray<ezGameObject*>& out_objects) const override;
+  virtual ezBoundingSphere GetSensorBoundingSphere() const override;
+  virtual void FilterObjectsInSensorVolume(ezArrayPtr<ezGameObject* const> objects, ezDynamicArray<ezGameObject*>& out_objects) const override;
   virtual void DebugDrawSensorShape() const override;
 
   //////////////////////////////////////////////////////////////////////////
@@ -135,7 +148,8 @@ public:
   //////////////////////////////////////////////////////////////////////////
   // ezSensorComponent
 
-  virtual void GetObjectsInSensorVolume(ezDynamicArray<ezGameObject*>& out_objects) const override;
+  virtual ezBoundingSphere GetSensorBoundingSphere() const override;
+  virtual void FilterObjectsInSensorVolume(ezArrayPtr<ezGameObject* const> objects, ezDynamicArray<ezGameObject*>& out_objects) const override;
   virtual void DebugDrawSensorShape() const override;
 
   //////////////////////////////////////////////////////////////////////////
@@ -167,7 +181,8 @@ public:
   //////////////////////////////////////////////////////////////////////////
   // ezSensorComponent
 
-  virtual void GetObjectsInSensorVolume(ezDynamicArray<ezGameObject*>& out_objects) const override;
+  virtual ezBoundingSphere GetSensorBoundingSphere() const override;
+  virtual void FilterObjectsInSensorVolume(ezArrayPtr<ezGameObject* const> objects, ezDynamicArray<ezGameObject*>& out_objects) const override;
   virtual void DebugDrawSensorShape() const override;
 
   //////////////////////////////////////////////////////////////////////////
@@ -204,11 +219,41 @@ private:
   void UpdateSensors(const ezWorldModule::UpdateContext& context);
   void DebugDrawSensors(const ezWorldModule::UpdateContext& context);
 
+  void FindObjectsInSensorVolumes();
+  void TestVisibility();
+  void UpdateDetectedObjects();
+
   ezIntervalScheduler<ezComponentHandle> m_Scheduler;
   ezPhysicsWorldModuleInterface* m_pPhysicsWorldModule = nullptr;
 
-  ezDynamicArray<ezGameObject*> m_ObjectsInSensorVolume;
-  ezDynamicArray<ezGameObjectHandle> m_DetectedObjects;
+  struct SensorData
+  {
+    const ezSensorComponent* m_pSensor = nullptr;
+    ezBoundingSphere m_BoundingSphere;
+    ezUInt32 m_uiSharedQuery = ezInvalidIndex;
+    ezUInt32 m_uiFirstRay = ezInvalidIndex;
+    bool m_bDetectedObjectsChanged = false;
+
+    ezDynamicArray<ezGameObject*> m_ObjectsInSensorVolume;
+  };
+
+  /// A single spatial query for multiple sensors with the same spatial category that overlap a lot.
+  struct SharedQuery
+  {
+    ezUInt32 m_uiFirstObject = 0;
+    ezUInt32 m_uiNumObjects = 0;
+  };
+
+  // Only grows, so that the arrays of objects inside the sensor volume keep their capacity across frames.
+  ezDynamicArray<SensorData> m_SensorData;
+  ezUInt32 m_uiNumSensorsToUpdate = 0;
+
+  ezDynamicArray<SharedQuery> m_SharedQueries;
+  ezDynamicArray<ezGameObject*> m_SharedQueryObjects;
+
+  ezDynamicArray<ezPhysicsRaycastQuery> m_RayQueries;
+  ezDynamicArray<ezPhysicsCastResult> m_RayResults;
+  ezDynamicArray<bool> m_RayHits;
 
   ezDynamicArray<ezComponentHandle> m_DebugComponents;
 };
@@ -11,18 +11,14 @@
 ///
 /// Uses Verlet Integration to update the cloth positions from velocities, and the "Jakobsen method" to enforce distance constraints.
 ///
+/// The nodes are stored as a structure of arrays, one float stream per coordinate, so that four neighboring nodes of a row are processed at once.
+/// The distance constraints are solved in red-black order: all nodes of one color of the checkerboard pattern only have neighbors of the
+/// other color, so they can be moved independently of each other.
+///
 /// Based on https://owlree.blog/posts/simulating-a-rope.html
 class EZ_GAMEENGINE_DLL ezClothSimulator
 {
 public:
-  struct Node
-  {
-    /// Whether this node can swing freely or will remain fixed in place.
-    bool m_bFixed = false;
-    ezSimdVec4f m_vPosition = ezSimdVec4f::MakeZero();
-    ezSimdVec4f m_vPreviousPosition = ezSimdVec4f::MakeZero();
-  };
-
   /// Resolution of the cloth along X
   ezUInt8 m_uiWidth = 32;
 
@@ -38,8 +34,24 @@ public:
   /// The distance along x and y between each neighboring node.
   ezVec2 m_vSegmentLength = ezVec2(0.1f);
 
-  /// All cloth nodes.
-  ezDynamicArray<Node, ezAlignedAllocatorWrapper> m_Nodes;
+  /// \brief Allocates m_uiWidth * m_uiHeight nodes. All nodes start out at the origin and are not fixed.
+  void CreateNodes();
+
+  /// \brief Removes all nodes.
+  void ClearNodes();
+
+  bool HasNodes() const { return m_uiNumRows > 0; }
+
+  /// \brief Places the node at the given position and removes its velocity.
+  void SetNodePosition(ezUInt32 x, ezUInt32 y, const ezVec3& vPosition);
+  ezVec3 GetNodePosition(ezUInt32 x, ezUInt32 y) const;
+
+  /// \brief Whether the node can swing freely or will remain fixed in place.
+  void SetNodeFixed(ezUInt32 x, ezUInt32 y, bool bFixed);
+  bool IsNodeFixed(ezUInt32 x, ezUInt32 y) const;
+
+  /// \brief Writes the positions of all nodes row by row into out_positions, which must have room for m_uiWidth * m_uiHeight entries.
+  void GetNodePositions(ezArrayPtr<ezVec3> out_positions) const;
 
   void SimulateCloth(const ezTime& diff);
   void SimulateStep(const ezSimdFloat fDiffSqr, ezUInt32 uiMaxIterations, ezSimdFloat fAllowedError);
@@ -47,8 +59,26 @@ public:
 
 private:
   ezSimdFloat EnforceDistanceConstraint();
+  void EnforceDistanceConstraint(ezUInt32 uiColor, ezSimdVec4f& inout_vError);
   void UpdateNodePositions(const ezSimdFloat tDiffSqr);
-  ezSimdVec4f MoveTowards(const ezSimdVec4f posThis, const ezSimdVec4f posNext, ezSimdFloat factor, const ezSimdVec4f fallbackDir, ezSimdFloat& inout_fError, ezSimdFloat fSegLen);
+
+  EZ_ALWAYS_INLINE ezUInt32 GetNodeIndex(ezUInt32 x, ezUInt32 y) const { return y * m_uiRowStride + x + 1; }
 
   ezTime m_LeftOverTimeStep;
+
+  /// Number of rows and the width the streams were created with. Every row starts with one padding element, so that the left neighbors
+  /// of the first node can be loaded, and is padded to a multiple of 4 at the end, so that the last four nodes can be loaded at once.
+  ezUInt32 m_uiNumRows = 0;
+  ezUInt32 m_uiNumColumns = 0;
+  ezUInt32 m_uiRowStride = 0;
+
+  ezDynamicArray<float> m_PositionsX;
+  ezDynamicArray<float> m_PositionsY;
+  ezDynamicArray<float> m_PositionsZ;
+  ezDynamicArray<float> m_PreviousPositionsX;
+  ezDynamicArray<float> m_PreviousPositionsY;
+  ezDynamicArray<float> m_PreviousPositionsZ;
+
+  /// 1 for nodes that can move, 0 for fixed nodes and padding elements.
+  ezDynamicArray<float> m_Movable;
 };
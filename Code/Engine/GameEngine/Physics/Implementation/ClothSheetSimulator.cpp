@@ -3,6 +3,86 @@
 #include <Foundation/SimdMath/SimdConversion.h>
 #include <GameEngine/Physics/ClothSheetSimulator.h>
 
+void ezClothSimulator::CreateNodes()
+{
+  m_uiNumColumns = m_uiWidth;
+  m_uiNumRows = m_uiHeight;
+  m_uiRowStride = ezMemoryUtils::AlignSize<ezUInt32>(m_uiNumColumns, 4) + 4;
+
+  const ezUInt32 uiNumElements = m_uiNumRows * m_uiRowStride;
+
+  for (ezDynamicArray<float>* pStream : {&m_PositionsX, &m_PositionsY, &m_PositionsZ, &m_PreviousPositionsX, &m_PreviousPositionsY, &m_PreviousPositionsZ, &m_Movable})
+  {
+    pStream->Clear();
+    pStream->SetCount(uiNumElements, 0.0f);
+  }
+
+  for (ezUInt32 y = 0; y < m_uiNumRows; ++y)
+  {
+    for (ezUInt32 x = 0; x < m_uiNumColumns; ++x)
+    {
+      m_Movable[GetNodeIndex(x, y)] = 1.0f;
+    }
+  }
+
+  m_LeftOverTimeStep = ezTime::MakeZero();
+}
+
+void ezClothSimulator::ClearNodes()
+{
+  m_uiNumColumns = 0;
+  m_uiNumRows = 0;
+  m_uiRowStride = 0;
+
+  for (ezDynamicArray<float>* pStream : {&m_PositionsX, &m_PositionsY, &m_PositionsZ, &m_PreviousPositionsX, &m_PreviousPositionsY, &m_PreviousPositionsZ, &m_Movable})
+  {
+    pStream->Clear();
+  }
+}
+
+void ezClothSimulator::SetNodePosition(ezUInt32 x, ezUInt32 y, const ezVec3& vPosition)
+{
+  const ezUInt32 idx = GetNodeIndex(x, y);
+
+  m_PositionsX[idx] = vPosition.x;
+  m_PositionsY[idx] = vPosition.y;
+  m_PositionsZ[idx] = vPosition.z;
+  m_PreviousPositionsX[idx] = vPosition.x;
+  m_PreviousPositionsY[idx] = vPosition.y;
+  m_PreviousPositionsZ[idx] = vPosition.z;
+}
+
+ezVec3 ezClothSimulator::GetNodePosition(ezUInt32 x, ezUInt32 y) const
+{
+  const ezUInt32 idx = GetNodeIndex(x, y);
+
+  return ezVec3(m_PositionsX[idx], m_PositionsY[idx], m_PositionsZ[idx]);
+}
+
+void ezClothSimulator::SetNodeFixed(ezUInt32 x, ezUInt32 y, bool bFixed)
+{
+  m_Movable[GetNodeIndex(x, y)] = bFixed ? 0.0f : 1.0f;
+}
+
+bool ezClothSimulator::IsNodeFixed(ezUInt32 x, ezUInt32 y) const
+{
+  return m_Movable[GetNodeIndex(x, y)] == 0.0f;
+}
+
+void ezClothSimulator::GetNodePositions(ezArrayPtr<ezVec3> out_positions) const
+{
+  EZ_ASSERT_DEV(out_positions.GetCount() >= m_uiNumColumns * m_uiNumRows, "Output array is too small");
+
+  ezUInt32 uiOutIdx = 0;
+  for (ezUInt32 y = 0; y < m_uiNumRows; ++y)
+  {
+    for (ezUInt32 x = 0; x < m_uiNumColumns; ++x, ++uiOutIdx)
+    {
+      out_positions[uiOutIdx] = GetNodePosition(x, y);
+    }
+  }
+}
+
 void ezClothSimulator::SimulateCloth(const ezTime& diff)
 {
   m_LeftOverTimeStep += diff;
@@ -20,7 +100,7 @@ void ezClothSimulator::SimulateCloth(const ezTime& diff)
 
 void ezClothSimulator::SimulateStep(const ezSimdFloat fDiffSqr, ezUInt32 uiMaxIterations, ezSimdFloat fAllowedError)
 {
-  if (m_Nodes.GetCount() < 4)
+  if (m_uiNumColumns * m_uiNumRows < 4)
     return;
 
   UpdateNodePositions(fDiffSqr);
@@ -35,110 +115,194 @@ void ezClothSimulator::SimulateStep(const ezSimdFloat fDiffSqr, ezUInt32 uiMaxIt
   }
 }
 
+namespace
+{
+  /// \brief Computes how far four nodes have to move towards (or away from) their neighbors, to get the desired segment length.
+  EZ_ALWAYS_INLINE void MoveTowards(const ezSimdVec4f* pThis, const ezSimdVec4f* pNext, const ezSimdVec4f* pFallbackDir, const ezSimdVec4b& bActive, const ezSimdVec4f& vSegLen, ezSimdVec4f* pMove, ezSimdVec4f& inout_vError)
+  {
+    const ezSimdVec4f vHalf(0.5f);
+
+    ezSimdVec4f vDir[3] = {pNext[0] - pThis[0], pNext[1] - pThis[1], pNext[2] - pThis[2]};
+    ezSimdVec4f vLen = (vDir[0].CompMul(vDir[0]) + vDir[1].CompMul(vDir[1]) + vDir[2].CompMul(vDir[2])).GetSqrt();
+
+    // nodes at the same position are pushed apart along the fallback direction
+    const ezSimdVec4b bDegenerate = vLen <= ezSimdVec4f(0.001f);
+    vLen = ezSimdVec4f::Select(bDegenerate, ezSimdVec4f(1.0f), vLen);
+
+    // keep track of how much the cloth had to be moved to fulfill the constraint
+    const ezSimdVec4f vLocalError = ezSimdVec4f::Select(bActive, (vLen - vSegLen).CompMul(vHalf), ezSimdVec4f::MakeZero());
+    inout_vError += vLocalError.Abs();
+
+    const ezSimdVec4f vScale = vLocalError.CompDiv(vLen);
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      vDir[i] = ezSimdVec4f::Select(bDegenerate, pFallbackDir[i], vDir[i]);
+      pMove[i] += vDir[i].CompMul(vScale);
+    }
+  }
+} // namespace
+
 ezSimdFloat ezClothSimulator::EnforceDistanceConstraint()
 {
-  ezSimdFloat fError = ezSimdFloat::MakeZero();
+  ezSimdVec4f vError = ezSimdVec4f::MakeZero();
+
+  // first move all nodes of one color towards their neighbors, which all have the other color, then the other way round
+  EnforceDistanceConstraint(0, vError);
+  EnforceDistanceConstraint(1, vError);
+
+  return vError.HorizontalSum<4>();
+}
+
+void ezClothSimulator::EnforceDistanceConstraint(ezUInt32 uiColor, ezSimdVec4f& inout_vError)
+{
+  const ezSimdVec4f vSegLenX(m_vSegmentLength.x);
+  const ezSimdVec4f vSegLenY(m_vSegmentLength.y);
+
+  const ezSimdVec4f vLeft[3] = {ezSimdVec4f(-1.0f), ezSimdVec4f::MakeZero(), ezSimdVec4f::MakeZero()};
+  const ezSimdVec4f vRight[3] = {ezSimdVec4f(1.0f), ezSimdVec4f::MakeZero(), ezSimdVec4f::MakeZero()};
+  const ezSimdVec4f vUp[3] = {ezSimdVec4f::MakeZero(), ezSimdVec4f(-1.0f), ezSimdVec4f::MakeZero()};
+  const ezSimdVec4f vDown[3] = {ezSimdVec4f::MakeZero(), ezSimdVec4f(1.0f), ezSimdVec4f::MakeZero()};
+
+  const ezSimdVec4f vLaneOffset(0.0f, 1.0f, 2.0f, 3.0f);
+  const ezSimdVec4f vLastColumn(static_cast<float>(m_uiNumColumns - 1));
+  const ezSimdVec4b bEvenLanes(true, false, true, false);
 
-  for (ezUInt32 y = 0; y < m_uiHeight; ++y)
+  const float* pStreams[3] = {m_PositionsX.GetData(), m_PositionsY.GetData(), m_PositionsZ.GetData()};
+  float* pOutStreams[3] = {m_PositionsX.GetData(), m_PositionsY.GetData(), m_PositionsZ.GetData()};
+  const float* pMovable = m_Movable.GetData();
+
+  for (ezUInt32 y = 0; y < m_uiNumRows; ++y)
   {
-    for (ezUInt32 x = 0; x < m_uiWidth; ++x)
+    // each chunk starts at an even x, so the color of a lane only depends on the lane and the row
+    const ezSimdVec4b bColor = ((y + uiColor) & 1) == 0 ? bEvenLanes : !bEvenLanes;
+
+    const bool bHasUp = y > 0;
+    const bool bHasDown = y + 1 < m_uiNumRows;
+
+    for (ezUInt32 x = 0; x < m_uiNumColumns; x += 4)
     {
-      const ezUInt32 idx = (y * m_uiWidth) + x;
+      const ezUInt32 idx = GetNodeIndex(x, y);
 
-      auto& n = m_Nodes[idx];
+      ezSimdVec4f vMovable;
+      vMovable.Load<4>(pMovable + idx);
 
-      if (n.m_bFixed)
+      const ezSimdVec4b bUpdate = bColor && (vMovable > ezSimdVec4f::MakeZero());
+      if (!bUpdate.AnySet())
         continue;
 
-      const ezSimdVec4f posThis = n.m_vPosition;
+      const ezSimdVec4f vX = ezSimdVec4f(static_cast<float>(x)) + vLaneOffset;
+      const ezSimdVec4b bHasLeft = bUpdate && (vX > ezSimdVec4f::MakeZero());
+      const ezSimdVec4b bHasRight = bUpdate && (vX < vLastColumn);
 
-      if (x > 0)
+      ezSimdVec4f vThis[3];
+      ezSimdVec4f vNext[3];
+      ezSimdVec4f vMove[3] = {ezSimdVec4f::MakeZero(), ezSimdVec4f::MakeZero(), ezSimdVec4f::MakeZero()};
+
+      for (ezUInt32 i = 0; i < 3; ++i)
       {
-        const ezSimdVec4f pos = m_Nodes[idx - 1].m_vPosition;
-        n.m_vPosition += MoveTowards(posThis, pos, 0.5f, ezSimdVec4f(-1, 0, 0), fError, m_vSegmentLength.x);
+        vThis[i].Load<4>(pStreams[i] + idx);
       }
 
-      if (x + 1 < m_uiWidth)
+      for (ezUInt32 i = 0; i < 3; ++i)
       {
-        const ezSimdVec4f pos = m_Nodes[idx + 1].m_vPosition;
-        n.m_vPosition += MoveTowards(posThis, pos, 0.5f, ezSimdVec4f(1, 0, 0), fError, m_vSegmentLength.x);
+        vNext[i].Load<4>(pStreams[i] + idx - 1);
       }
+      MoveTowards(vThis, vNext, vLeft, bHasLeft, vSegLenX, vMove, inout_vError);
 
-      if (y > 0)
+      for (ezUInt32 i = 0; i < 3; ++i)
       {
-        const ezSimdVec4f pos = m_Nodes[idx - m_uiWidth].m_vPosition;
-        n.m_vPosition += MoveTowards(posThis, pos, 0.5f, ezSimdVec4f(0, -1, 0), fError, m_vSegmentLength.y);
+        vNext[i].Load<4>(pStreams[i] + idx + 1);
       }
+      MoveTowards(vThis, vNext, vRight, bHasRight, vSegLenX, vMove, inout_vError);
 
-      if (y + 1 < m_uiHeight)
+      if (bHasUp)
       {
-        const ezSimdVec4f pos = m_Nodes[idx + m_uiWidth].m_vPosition;
-        n.m_vPosition += MoveTowards(posThis, pos, 0.5f, ezSimdVec4f(0, 1, 0), fError, m_vSegmentLength.y);
+        for (ezUInt32 i = 0; i < 3; ++i)
+        {
+          vNext[i].Load<4>(pStreams[i] + idx - m_uiRowStride);
+        }
+        MoveTowards(vThis, vNext, vUp, bUpdate, vSegLenY, vMove, inout_vError);
       }
-    }
-  }
 
-  return fError;
-}
-
-ezSimdVec4f ezClothSimulator::MoveTowards(const ezSimdVec4f posThis, const ezSimdVec4f posNext, ezSimdFloat factor, const ezSimdVec4f fallbackDir, ezSimdFloat& inout_fError, ezSimdFloat fSegLen)
-{
-  ezSimdVec4f vDir = (posNext - posThis);
-  ezSimdFloat fLen = vDir.GetLength<3>();
+      if (bHasDown)
+      {
+        for (ezUInt32 i = 0; i < 3; ++i)
+        {
+          vNext[i].Load<4>(pStreams[i] + idx + m_uiRowStride);
+        }
+        MoveTowards(vThis, vNext, vDown, bUpdate, vSegLenY, vMove, inout_vError);
+      }
 
-  if (fLen.IsEqual(ezSimdFloat::MakeZero(), 0.001f))
-  {
-    vDir = fallbackDir;
-    fLen = 1;
+      // nodes of the other color keep their positions, they are the neighbors that this pass reads
+      for (ezUInt32 i = 0; i < 3; ++i)
+      {
+        ezSimdVec4f::Select(bUpdate, vThis[i] + vMove[i], vThis[i]).Store<4>(pOutStreams[i] + idx);
+      }
+    }
   }
-
-  vDir /= fLen;
-  fLen -= fSegLen;
-
-  const ezSimdFloat fLocalError = fLen * factor;
-
-  vDir *= fLocalError;
-
-  // keep track of how much the rope had to be moved to fulfill the constraint
-  inout_fError += fLocalError.Abs();
-
-  return vDir;
 }
 
 void ezClothSimulator::UpdateNodePositions(const ezSimdFloat tDiffSqr)
 {
-  const ezSimdFloat damping = m_fDampingFactor;
-  const ezSimdVec4f acceleration = ezSimdConversion::ToVec3(m_vAcceleration) * tDiffSqr;
-
-  for (auto& n : m_Nodes)
+  const ezSimdVec4f damping(m_fDampingFactor);
+  const ezSimdVec4f acceleration[3] = {
+    ezSimdVec4f(m_vAcceleration.x * tDiffSqr),
+    ezSimdVec4f(m_vAcceleration.y * tDiffSqr),
+    ezSimdVec4f(m_vAcceleration.z * tDiffSqr),
+  };
+
+  float* pPositions[3] = {m_PositionsX.GetData(), m_PositionsY.GetData(), m_PositionsZ.GetData()};
+  float* pPreviousPositions[3] = {m_PreviousPositionsX.GetData(), m_PreviousPositionsY.GetData(), m_PreviousPositionsZ.GetData()};
+  const float* pMovable = m_Movable.GetData();
+
+  // the streams are padded to a multiple of 4, padding elements are not movable
+  for (ezUInt32 idx = 0; idx + 4 <= m_Movable.GetCount(); idx += 4)
   {
-    if (n.m_bFixed)
-    {
-      n.m_vPreviousPosition = n.m_vPosition;
-    }
-    else
-    {
-      // this (simple) logic is the so called 'Verlet integration' (+ damping)
+    ezSimdVec4f vMovable;
+    vMovable.Load<4>(pMovable + idx);
+    const ezSimdVec4b bMovable = vMovable > ezSimdVec4f::MakeZero();
 
-      const ezSimdVec4f previousPos = n.m_vPosition;
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      ezSimdVec4f vPos, vPrevPos;
+      vPos.Load<4>(pPositions[i] + idx);
+      vPrevPos.Load<4>(pPreviousPositions[i] + idx);
 
-      const ezSimdVec4f vel = (n.m_vPosition - n.m_vPreviousPosition) * damping;
+      // this (simple) logic is the so called 'Verlet integration' (+ damping)
+      const ezSimdVec4f vVel = (vPos - vPrevPos).CompMul(damping);
 
       // instead of using a single global acceleration, this could also use individual accelerations per node
-      // this would be needed to affect the rope more localized
-      n.m_vPosition += vel + acceleration;
-      n.m_vPreviousPosition = previousPos;
+      // this would be needed to affect the cloth more localized
+      ezSimdVec4f::Select(bMovable, vPos + vVel + acceleration[i], vPos).Store<4>(pPositions[i] + idx);
+      vPos.Store<4>(pPreviousPositions[i] + idx);
     }
   }
 }
 
 bool ezClothSimulator::HasEquilibrium(ezSimdFloat fAllowedMovement) const
 {
-  const ezSimdFloat fErrorSqr = fAllowedMovement * fAllowedMovement;
+  const ezSimdVec4f vErrorSqr(fAllowedMovement * fAllowedMovement);
+
+  const float* pPositions[3] = {m_PositionsX.GetData(), m_PositionsY.GetData(), m_PositionsZ.GetData()};
+  const float* pPreviousPositions[3] = {m_PreviousPositionsX.GetData(), m_PreviousPositionsY.GetData(), m_PreviousPositionsZ.GetData()};
 
-  for (const auto& n : m_Nodes)
+  // padding elements never move, so they don't need to be excluded
+  for (ezUInt32 idx = 0; idx + 4 <= m_Movable.GetCount(); idx += 4)
   {
-    if ((n.m_vPosition - n.m_vPreviousPosition).GetLengthSquared<3>() > fErrorSqr)
+    ezSimdVec4f vMovementSqr = ezSimdVec4f::MakeZero();
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      ezSimdVec4f vPos, vPrevPos;
+      vPos.Load<4>(pPositions[i] + idx);
+      vPrevPos.Load<4>(pPreviousPositions[i] + idx);
+
+      const ezSimdVec4f vMovement = vPos - vPrevPos;
+      vMovementSqr += vMovement.CompMul(vMovement);
+    }
+
+    if ((vMovementSqr > vErrorSqr).AnySet())
     {
       return false;
     }
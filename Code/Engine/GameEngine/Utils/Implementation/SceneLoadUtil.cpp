@@ -2,6 +2,7 @@
 
 #include <Core/Assets/AssetFileHeader.h>
 #include <Core/Collection/CollectionResource.h>
+#include <Foundation/IO/OSFile.h>
 #include <GameEngine/GameApplication/GameApplication.h>
 #include <GameEngine/Utils/SceneLoadUtil.h>
 
@@ -141,7 +142,22 @@ void ezSceneLoadUtility::TickSceneLoading()
 
     EZ_LOCK(m_pWorld->GetWriteMarker());
 
-    if (m_FileReader.Open(m_sFile).Failed())
+    ezArrayPtr<const ezUInt8> mappedData;
+
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+    // if the scene is a regular file on disk, map it into memory, so that the world reader can use the data in place
+    ezStringBuilder sAbsolutePath;
+    if (ezFileSystem::ResolvePath(m_sFile, &sAbsolutePath, nullptr).Succeeded() && ezOSFile::ExistsFile(sAbsolutePath) &&
+        m_MappedFile.Open(sAbsolutePath, ezMemoryMappedFile::Mode::ReadOnly).Succeeded())
+    {
+      mappedData = ezArrayPtr<const ezUInt8>(static_cast<const ezUInt8*>(m_MappedFile.GetReadPointer()), static_cast<ezUInt32>(m_MappedFile.GetFileSize()));
+    }
+#endif
+
+    ezRawMemoryStreamReader mappedReader(mappedData.GetPtr(), mappedData.GetCount());
+    ezStreamReader& reader = mappedData.IsEmpty() ? static_cast<ezStreamReader&>(m_FileReader) : mappedReader;
+
+    if (mappedData.IsEmpty() && m_FileReader.Open(m_sFile).Failed())
     {
       LoadingFailed("Failed to open the file.");
       return;
@@ -150,10 +166,10 @@ void ezSceneLoadUtility::TickSceneLoading()
     {
       // Read and skip the asset file header
       ezAssetFileHeader header;
-      header.Read(m_FileReader).AssertSuccess();
+      header.Read(reader).AssertSuccess();
 
       char szSceneTag[16];
-      m_FileReader.ReadBytes(szSceneTag, sizeof(char) * 16);
+      reader.ReadBytes(szSceneTag, sizeof(char) * 16);
 
       if (!ezStringUtils::IsEqualN(szSceneTag, "[ezBinaryScene]", 16))
       {
@@ -161,7 +177,9 @@ void ezSceneLoadUtility::TickSceneLoading()
         return;
       }
 
-      if (m_WorldReader.ReadWorldDescription(m_FileReader).Failed())
+      const ezResult readResult = mappedData.IsEmpty() ? m_WorldReader.ReadWorldDescription(m_FileReader) : m_WorldReader.ReadWorldDescription(mappedData.GetSubArray(static_cast<ezUInt32>(mappedReader.GetReadPosition())));
+
+      if (readResult.Failed())
       {
         LoadingFailed("Error reading world description.");
         return;
@@ -3,6 +3,7 @@
 #include <Core/ResourceManager/ResourceHandle.h>
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/MemoryMappedFile.h>
 #include <Foundation/Types/UniquePtr.h>
 #include <Foundation/Utilities/Progress.h>
 #include <GameEngine/GameEngineDLL.h>
@@ -61,6 +62,7 @@ private:
   ezString m_sFile;
   ezCollectionResourceHandle m_hPreloadCollection;
   ezFileReader m_FileReader;
+  ezMemoryMappedFile m_MappedFile; // the world reader accesses the mapped data in place, so it has to stay mapped until the instantiation is finished
   ezWorldReader m_WorldReader;
   ezUniquePtr<ezWorld> m_pWorld;
   ezUniquePtr<ezWorldReader::InstantiationContextBase> m_pInstantiationContext;
@@ -32,6 +32,7 @@ public:
   void AddRenderData(const ezRenderData* pRenderData, ezRenderData::Category category);
   void AddFrameData(const ezRenderData* pFrameData);
 
+  /// \brief Sorts the render data of all categories and groups it into batches. Categories are processed in parallel.
   void SortAndBatch();
 
   void Clear();
@@ -54,6 +55,11 @@ private:
     ezDynamicArray<ezRenderDataBatch::SortableRenderData> m_SortableRenderData;
   };
 
+  static void SortAndBatch(DataPerCategory& ref_dataPerCategory);
+
+  /// \brief Sorts by sorting key and then by batch id. Large arrays are sorted with a radix sort, which needs temporary memory.
+  static void SortRenderData(ezArrayPtr<ezRenderDataBatch::SortableRenderData> data, ezAllocatorBase* pTempAllocator);
+
   ezCamera m_Camera;
   ezCamera m_LodCamera; // Temporary until we have a real LOD system
   ezViewData m_ViewData;
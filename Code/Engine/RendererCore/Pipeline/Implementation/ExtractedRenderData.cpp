@@ -1,6 +1,9 @@
 #include <RendererCore/RendererCorePCH.h>
 
+#include <Foundation/Algorithm/Sorting.h>
+#include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 
 ezExtractedRenderData::ezExtractedRenderData() = default;
@@ -23,50 +26,135 @@ void ezExtractedRenderData::SortAndBatch()
 {
   EZ_PROFILE_SCOPE("SortAndBatch");
 
-  struct RenderDataComparer
-  {
-    EZ_FORCE_INLINE bool Less(const ezRenderDataBatch::SortableRenderData& a, const ezRenderDataBatch::SortableRenderData& b) const
-    {
-      if (a.m_uiSortingKey == b.m_uiSortingKey)
-      {
-        return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
-      }
-
-      return a.m_uiSortingKey < b.m_uiSortingKey;
-    }
-  };
+  ezHybridArray<DataPerCategory*, 16> categoriesToProcess;
+  ezUInt32 uiTotalCount = 0;
 
   for (auto& dataPerCategory : m_DataPerCategory)
   {
     if (dataPerCategory.m_SortableRenderData.IsEmpty())
       continue;
 
-    auto& data = dataPerCategory.m_SortableRenderData;
+    categoriesToProcess.PushBack(&dataPerCategory);
+    uiTotalCount += dataPerCategory.m_SortableRenderData.GetCount();
+  }
 
-    // Sort
-    data.Sort(RenderDataComparer());
+  // not worth the task overhead for small scenes
+  constexpr ezUInt32 uiMinCountForParallelSort = 4096;
+  if (categoriesToProcess.GetCount() <= 1 || uiTotalCount < uiMinCountForParallelSort)
+  {
+    for (DataPerCategory* pDataPerCategory : categoriesToProcess)
+    {
+      SortAndBatch(*pDataPerCategory);
+    }
 
-    // Find batches
-    ezUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
-    ezUInt32 uiCurrentBatchStartIndex = 0;
-    const ezRTTI* pCurrentBatchType = data[0].m_pRenderData->GetDynamicRTTI();
+    return;
+  }
 
-    for (ezUInt32 i = 1; i < data.GetCount(); ++i)
+  auto sortCategories = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+    for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
     {
-      auto pRenderData = data[i].m_pRenderData;
+      SortAndBatch(*categoriesToProcess[i]);
+    }
+  };
+
+  // categories have vastly different sizes, so hand them out one by one
+  ezParallelForParams parallelForParams;
+  parallelForParams.m_uiBinSize = 1;
+  parallelForParams.m_uiMaxTasksPerThread = 4;
+
+  ezTaskSystem::ParallelForIndexed(0u, categoriesToProcess.GetCount(), sortCategories, "SortAndBatch Category", parallelForParams);
+}
+
+// static
+void ezExtractedRenderData::SortRenderData(ezArrayPtr<ezRenderDataBatch::SortableRenderData> data, ezAllocatorBase* pTempAllocator)
+{
+  // the comparison sort is faster for small arrays
+  constexpr ezUInt32 uiMinCountForRadixSort = 1024;
 
-      if (pRenderData->m_uiBatchId != uiCurrentBatchId || pRenderData->GetDynamicRTTI() != pCurrentBatchType)
+  if (data.GetCount() < uiMinCountForRadixSort)
+  {
+    struct RenderDataComparer
+    {
+      EZ_FORCE_INLINE bool Less(const ezRenderDataBatch::SortableRenderData& a, const ezRenderDataBatch::SortableRenderData& b) const
       {
-        dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], i - uiCurrentBatchStartIndex);
+        if (a.m_uiSortingKey == b.m_uiSortingKey)
+        {
+          return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
+        }
 
-        uiCurrentBatchId = pRenderData->m_uiBatchId;
-        uiCurrentBatchStartIndex = i;
-        pCurrentBatchType = pRenderData->GetDynamicRTTI();
+        return a.m_uiSortingKey < b.m_uiSortingKey;
       }
-    }
+    };
+
+    ezSorting::QuickSort(data, RenderDataComparer());
+    return;
+  }
+
+  // The batch id lives in the render data, so it is fetched once up front instead of in every pass.
+  // The render data is then reordered according to the sorted indices.
+  struct RadixSortEntry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiSortingKey;
+    ezUInt32 m_uiBatchId;
+    ezUInt32 m_uiIndex;
+  };
+
+  const ezUInt32 uiCount = data.GetCount();
 
-    dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
+  ezDynamicArray<RadixSortEntry> entries(pTempAllocator);
+  ezDynamicArray<RadixSortEntry> scratch(pTempAllocator);
+  entries.SetCountUninitialized(uiCount);
+  scratch.SetCountUninitialized(uiCount);
+
+  for (ezUInt32 i = 0; i < uiCount; ++i)
+  {
+    entries[i] = {data[i].m_uiSortingKey, data[i].m_pRenderData->m_uiBatchId, i};
   }
+
+  ezSorting::RadixSort<RadixSortEntry>(entries, scratch, [](const RadixSortEntry& e) { return e.m_uiBatchId; });
+  ezSorting::RadixSort<RadixSortEntry>(entries, scratch, [](const RadixSortEntry& e) { return e.m_uiSortingKey; });
+
+  ezDynamicArray<ezRenderDataBatch::SortableRenderData> sortedData(pTempAllocator);
+  sortedData.SetCountUninitialized(uiCount);
+
+  for (ezUInt32 i = 0; i < uiCount; ++i)
+  {
+    sortedData[i] = data[entries[i].m_uiIndex];
+  }
+
+  data.CopyFrom(sortedData);
+}
+
+// static
+void ezExtractedRenderData::SortAndBatch(DataPerCategory& ref_dataPerCategory)
+{
+  auto& data = ref_dataPerCategory.m_SortableRenderData;
+
+  // Sort
+  SortRenderData(data, ezFrameAllocator::GetCurrentAllocator());
+
+  // Find batches
+  ezUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
+  ezUInt32 uiCurrentBatchStartIndex = 0;
+  const ezRTTI* pCurrentBatchType = data[0].m_pRenderData->GetDynamicRTTI();
+
+  for (ezUInt32 i = 1; i < data.GetCount(); ++i)
+  {
+    auto pRenderData = data[i].m_pRenderData;
+
+    if (pRenderData->m_uiBatchId != uiCurrentBatchId || pRenderData->GetDynamicRTTI() != pCurrentBatchType)
+    {
+      ref_dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], i - uiCurrentBatchStartIndex);
+
+      uiCurrentBatchId = pRenderData->m_uiBatchId;
+      uiCurrentBatchStartIndex = i;
+      pCurrentBatchType = pRenderData->GetDynamicRTTI();
+    }
+  }
+
+  ref_dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = ezMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
 }
 
 void ezExtractedRenderData::Clear()
@@ -4,6 +4,7 @@
 
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/SimdMath/SimdVec4f.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Texture/Image/ImageConversion.h>
 #include <Texture/Image/ImageEnums.h>
 #include <Texture/Image/ImageFilter.h>
@@ -734,6 +735,77 @@ inline static void FilterLine(
   }
 }
 
+// Computes one target plane (a row or a depth slice) as the weighted sum of whole source planes.
+// Compared to filtering column by column, this walks through memory linearly and vectorizes across the plane.
+static void FilterPlane(ezUInt32 uiNumSourcePlanes, const ezSimdVec4f* __restrict pSourceBegin, ezSimdVec4f* __restrict pTarget, ezUInt32 uiPlaneSize, const ezImageFilterWeights& weights, ezUInt32 uiTargetPlaneIndex, ezInt32 iFirstSourceIndex, ezImageAddressMode::Enum addressMode, const ezSimdVec4f& vBorderColor)
+{
+  const ezUInt32 numWeights = weights.GetNumWeights();
+
+  for (ezUInt32 weightIdx = 0; weightIdx < numWeights; ++weightIdx)
+  {
+    const ezSimdVec4f weight = ezSimdVec4f(weights.GetWeight(uiTargetPlaneIndex, weightIdx));
+
+    bool useBorderColor = false;
+    const ezUInt32 sourceIdx = ezImageUtils::GetSampleIndex(uiNumSourcePlanes, iFirstSourceIndex + static_cast<ezInt32>(weightIdx), addressMode, useBorderColor);
+
+    if (useBorderColor)
+    {
+      const ezSimdVec4f contribution = vBorderColor.CompMul(weight);
+
+      if (weightIdx == 0)
+      {
+        for (ezUInt32 i = 0; i < uiPlaneSize; ++i)
+          pTarget[i] = contribution;
+      }
+      else
+      {
+        for (ezUInt32 i = 0; i < uiPlaneSize; ++i)
+          pTarget[i] += contribution;
+      }
+    }
+    else
+    {
+      const ezSimdVec4f* __restrict pSource = pSourceBegin + static_cast<ezUInt64>(sourceIdx) * uiPlaneSize;
+
+      if (weightIdx == 0)
+      {
+        for (ezUInt32 i = 0; i < uiPlaneSize; ++i)
+          pTarget[i] = pSource[i].CompMul(weight);
+      }
+      else
+      {
+        for (ezUInt32 i = 0; i < uiPlaneSize; ++i)
+          pTarget[i] = ezSimdVec4f::MulAdd(pSource[i], weight, pTarget[i]);
+      }
+    }
+  }
+}
+
+// Calls the callback for every line of every slice, face and array index of an image, split across the task system.
+template <typename Callback>
+static void ParallelForEachLine(ezUInt32 uiNumArrayIndices, ezUInt32 uiNumFaces, ezUInt32 uiNumSlices, ezUInt32 uiNumLines, ezUInt32 uiLineLength, const Callback& callback)
+{
+  ezParallelForParams params;
+  // small images, like the lower mip levels, are not worth the task overhead
+  params.m_uiBinSize = ezMath::Max(1u, 16384u / ezMath::Max(1u, uiLineLength));
+
+  ezTaskSystem::ParallelForIndexed(
+    0, uiNumArrayIndices * uiNumFaces * uiNumSlices * uiNumLines,
+    [&callback, uiNumFaces, uiNumSlices, uiNumLines](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+    {
+      for (ezUInt32 uiIndex = uiStartIndex; uiIndex < uiEndIndex; ++uiIndex)
+      {
+        const ezUInt32 uiLine = uiIndex % uiNumLines;
+        const ezUInt32 uiSlice = (uiIndex / uiNumLines) % uiNumSlices;
+        const ezUInt32 uiFace = (uiIndex / (uiNumLines * uiNumSlices)) % uiNumFaces;
+        const ezUInt32 uiArrayIndex = uiIndex / (uiNumLines * uiNumSlices * uiNumFaces);
+
+        callback(uiArrayIndex, uiFace, uiSlice, uiLine);
+      }
+    },
+    "ezImageUtils::Scale3D", params);
+}
+
 static void DownScaleFastLine(ezUInt32 uiPixelStride, const ezUInt8* pSrc, ezUInt8* pDest, ezUInt32 uiLengthIn, ezUInt32 uiStrideIn, ezUInt32 uiLengthOut, ezUInt32 uiStrideOut)
 {
   const ezUInt32 downScaleFactor = uiLengthIn / uiLengthOut;
@@ -1001,6 +1073,8 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
   ezHybridArray<ezInt32, 256> firstSampleIndices;
   firstSampleIndices.Reserve(ezMath::Max(uiWidth, uiHeight, uiDepth));
 
+  const ezSimdVec4f vBorderColor(borderColor.r, borderColor.g, borderColor.b, borderColor.a);
+
   if (uiWidth != originalWidth)
   {
     ezImageFilterWeights weights(*pFilter, originalWidth, uiWidth);
@@ -1024,21 +1098,13 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
     stepHeader.SetWidth(uiWidth);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (ezUInt32 face = 0; face < numFaces; ++face)
+    ParallelForEachLine(numArrayElements, numFaces, originalDepth, originalHeight, uiWidth,
+      [&](ezUInt32 arrayIndex, ezUInt32 face, ezUInt32 z, ezUInt32 y)
       {
-        for (ezUInt32 z = 0; z < originalDepth; ++z)
-        {
-          for (ezUInt32 y = 0; y < originalHeight; ++y)
-          {
-            const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
-            ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
-            FilterLine(originalWidth, filterSource, filterTarget, 1, weights, firstSampleIndices, addressModeU, ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
-        }
-      }
-    }
+        const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
+        ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
+        FilterLine(originalWidth, filterSource, filterTarget, 1, weights, firstSampleIndices, addressModeU, vBorderColor);
+      });
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -1067,21 +1133,13 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
     stepHeader.SetHeight(uiHeight);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (ezUInt32 face = 0; face < numFaces; ++face)
+    ParallelForEachLine(numArrayElements, numFaces, originalDepth, uiHeight, uiWidth,
+      [&](ezUInt32 arrayIndex, ezUInt32 face, ezUInt32 z, ezUInt32 y)
       {
-        for (ezUInt32 z = 0; z < originalDepth; ++z)
-        {
-          for (ezUInt32 x = 0; x < uiWidth; ++x)
-          {
-            const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, 0, z);
-            ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, 0, z);
-            FilterLine(originalHeight, filterSource, filterTarget, uiWidth, weights, firstSampleIndices, addressModeV, ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
-        }
-      }
-    }
+        const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, 0, z);
+        ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
+        FilterPlane(originalHeight, filterSource, filterTarget, uiWidth, weights, y, firstSampleIndices[y], addressModeV, vBorderColor);
+      });
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -1110,21 +1168,13 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
     stepHeader.SetDepth(uiDepth);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (ezUInt32 face = 0; face < numFaces; ++face)
+    ParallelForEachLine(numArrayElements, numFaces, 1, uiDepth, uiWidth * uiHeight,
+      [&](ezUInt32 arrayIndex, ezUInt32 face, ezUInt32, ezUInt32 z)
       {
-        for (ezUInt32 y = 0; y < uiHeight; ++y)
-        {
-          for (ezUInt32 x = 0; x < uiWidth; ++x)
-          {
-            const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, y, 0);
-            ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, y, 0);
-            FilterLine(originalHeight, filterSource, filterTarget, uiWidth * uiHeight, weights, firstSampleIndices, addressModeW, ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
-        }
-      }
-    }
+        const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, 0, 0);
+        ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, 0, z);
+        FilterPlane(originalDepth, filterSource, filterTarget, uiWidth * uiHeight, weights, z, firstSampleIndices[z], addressModeW, vBorderColor);
+      });
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -3,6 +3,7 @@
 #include <Foundation/Profiling/Profiling.h>
 #include <Texture/Image/ImageUtils.h>
 #include <Texture/TexConv/TexConvProcessor.h>
+#include <Texture/TexConv/TexConvSourceImageCache.h>
 
 ezResult ezTexConvProcessor::LoadInputImages()
 {
@@ -39,7 +40,7 @@ ezResult ezTexConvProcessor::LoadInputImages()
     for (const auto& file : m_Descriptor.m_InputFiles)
     {
       auto& img = m_Descriptor.m_InputImages.ExpandAndGetRef();
-      if (img.LoadFrom(file).Failed())
+      if (LoadImageFile(file, img).Failed())
       {
         ezLog::Error("Could not load input file '{0}'.", ezArgSensitive(file, "File"));
         return EZ_FAILURE;
@@ -91,6 +92,16 @@ ezResult ezTexConvProcessor::ConvertAndScaleImage(ezStringView sImageName, ezIma
   return EZ_SUCCESS;
 }
 
+ezResult ezTexConvProcessor::LoadImageFile(ezStringView sFile, ezImage& out_image) const
+{
+  if (m_Descriptor.m_pSourceImageCache != nullptr)
+  {
+    return m_Descriptor.m_pSourceImageCache->LoadInputImage(sFile, out_image);
+  }
+
+  return out_image.LoadFrom(sFile);
+}
+
 ezResult ezTexConvProcessor::ConvertAndScaleInputImages(ezUInt32 uiResolutionX, ezUInt32 uiResolutionY, ezEnum<ezTexConvUsage> usage)
 {
   EZ_PROFILE_SCOPE("ConvertAndScaleInputImages");
@@ -0,0 +1,74 @@
+#include <Texture/TexturePCH.h>
+
+#include <Foundation/Profiling/Profiling.h>
+#include <Texture/TexConv/TexConvSourceImageCache.h>
+
+ezTexConvSourceImageCache::ezTexConvSourceImageCache() = default;
+ezTexConvSourceImageCache::~ezTexConvSourceImageCache() = default;
+
+void ezTexConvSourceImageCache::AddExpectedUse(ezStringView sFile)
+{
+  EZ_LOCK(m_Mutex);
+
+  ezSharedPtr<Entry>& pEntry = m_Entries[sFile];
+  if (pEntry == nullptr)
+  {
+    pEntry = EZ_DEFAULT_NEW(Entry);
+  }
+
+  ++pEntry->m_uiRemainingUses;
+}
+
+ezResult ezTexConvSourceImageCache::LoadInputImage(ezStringView sFile, ezImage& out_image)
+{
+  ezSharedPtr<Entry> pEntry;
+  bool bLastUse = false;
+
+  {
+    EZ_LOCK(m_Mutex);
+
+    auto it = m_Entries.Find(sFile);
+    if (it.IsValid())
+    {
+      pEntry = it.Value();
+
+      if (--pEntry->m_uiRemainingUses == 0)
+      {
+        bLastUse = true;
+        m_Entries.Remove(it);
+      }
+    }
+  }
+
+  if (pEntry == nullptr)
+  {
+    return out_image.LoadFrom(sFile);
+  }
+
+  // only one thread decodes the file, all others wait for it
+  EZ_LOCK(pEntry->m_Mutex);
+
+  if (!pEntry->m_bLoaded)
+  {
+    pEntry->m_LoadResult = pEntry->m_Image.LoadFrom(sFile);
+    pEntry->m_bLoaded = true;
+  }
+
+  if (pEntry->m_LoadResult.Failed())
+    return EZ_FAILURE;
+
+  // nobody else can access the entry anymore, so the last user can take the image without a copy
+  if (bLastUse && pEntry->GetRefCount() == 1)
+  {
+    out_image = std::move(pEntry->m_Image);
+  }
+  else
+  {
+    EZ_PROFILE_SCOPE("CopySourceImage");
+    out_image.ResetAndCopy(pEntry->m_Image);
+  }
+
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(Texture, Texture_TexConv_Implementation_SourceImageCache);
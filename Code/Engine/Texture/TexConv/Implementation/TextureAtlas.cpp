@@ -81,7 +81,7 @@ ezResult ezTexConvProcessor::LoadAtlasInputs(const ezTextureAtlasCreationDesc& a
     {
       if (!srcItem.m_sLayerInput[layer].IsEmpty())
       {
-        if (item.m_InputImage[layer].LoadFrom(srcItem.m_sLayerInput[layer]).Failed())
+        if (LoadImageFile(srcItem.m_sLayerInput[layer], item.m_InputImage[layer]).Failed())
         {
           ezLog::Error("Failed to load texture atlas texture '{0}'", ezArgSensitive(srcItem.m_sLayerInput[layer], "File"));
           return EZ_FAILURE;
@@ -105,7 +105,7 @@ ezResult ezTexConvProcessor::LoadAtlasInputs(const ezTextureAtlasCreationDesc& a
     {
       ezImage alphaImg;
 
-      if (alphaImg.LoadFrom(srcItem.m_sAlphaInput).Failed())
+      if (LoadImageFile(srcItem.m_sAlphaInput, alphaImg).Failed())
       {
         ezLog::Error("Failed to load texture atlas alpha mask '{0}'", srcItem.m_sAlphaInput);
         return EZ_FAILURE;
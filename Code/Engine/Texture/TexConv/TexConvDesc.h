@@ -9,6 +9,8 @@
 #include <Texture/Image/Image.h>
 #include <Texture/Image/ImageEnums.h>
 
+class ezTexConvSourceImageCache;
+
 struct ezTexConvChannelMapping
 {
   ezInt8 m_iInputImageIndex = -1;
@@ -37,6 +39,10 @@ public:
   ezHybridArray<ezString, 4> m_InputFiles;
   ezDynamicArray<ezImage> m_InputImages;
 
+  /// Optional. If set, the input files and the texture atlas inputs are loaded through this cache, which shares decoded images with other
+  /// processors.
+  ezTexConvSourceImageCache* m_pSourceImageCache = nullptr;
+
   ezHybridArray<ezTexConvSliceChannelMapping, 6> m_ChannelMappings;
 
   // output type / platform
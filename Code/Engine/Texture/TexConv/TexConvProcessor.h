@@ -27,6 +27,7 @@ private:
   // Modifying the Descriptor
 
   ezResult LoadInputImages();
+  ezResult LoadImageFile(ezStringView sFile, ezImage& out_image) const;
   ezResult ForceSRGBFormats();
   ezResult ConvertAndScaleInputImages(ezUInt32 uiResolutionX, ezUInt32 uiResolutionY, ezEnum<ezTexConvUsage> usage);
   ezResult ConvertToNormalMap(ezImage& bumpMap) const;
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Foundation/Containers/Map.h>
+#include <Foundation/Strings/String.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Types/RefCounted.h>
+#include <Foundation/Types/SharedPtr.h>
+#include <Texture/Image/Image.h>
+
+/// \brief Shares decoded input images between multiple ezTexConvProcessor instances, for example when many textures are converted in one batch.
+///
+/// Only files that were announced through AddExpectedUse() are cached. Every call to LoadInputImage() consumes one expected use and the decoded
+/// image is released once all expected uses are consumed, so a file that is only used once is never kept in memory.
+/// All functions are thread-safe.
+class EZ_TEXTURE_DLL ezTexConvSourceImageCache
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezTexConvSourceImageCache);
+
+public:
+  ezTexConvSourceImageCache();
+  ~ezTexConvSourceImageCache();
+
+  /// \brief Announces that the given file will be loaded through LoadInputImage() one more time.
+  void AddExpectedUse(ezStringView sFile);
+
+  /// \brief Loads the given file. Files with more than one expected use are only decoded once.
+  ///
+  /// \a out_image always receives its own copy of the image data, so it can be modified freely.
+  ezResult LoadInputImage(ezStringView sFile, ezImage& out_image);
+
+private:
+  struct Entry : public ezRefCounted
+  {
+    ezMutex m_Mutex;
+    ezUInt32 m_uiRemainingUses = 0;
+    bool m_bLoaded = false;
+    ezResult m_LoadResult = EZ_FAILURE;
+    ezImage m_Image;
+  };
+
+  ezMutex m_Mutex;
+  ezMap<ezString, ezSharedPtr<Entry>> m_Entries;
+};
@@ -49,6 +49,7 @@ EZ_STATICLINK_LIBRARY(Texture)
   EZ_STATICLINK_REFERENCE(Texture_TexConv_Implementation_InputFiles);
   EZ_STATICLINK_REFERENCE(Texture_TexConv_Implementation_OutputFormat);
   EZ_STATICLINK_REFERENCE(Texture_TexConv_Implementation_Processor);
+  EZ_STATICLINK_REFERENCE(Texture_TexConv_Implementation_SourceImageCache);
   EZ_STATICLINK_REFERENCE(Texture_TexConv_Implementation_Texture2D);
   EZ_STATICLINK_REFERENCE(Texture_TexConv_Implementation_Texture3D);
   EZ_STATICLINK_REFERENCE(Texture_TexConv_Implementation_TextureAtlas);
@@ -40,6 +40,7 @@ EZ_STATICLINK_LIBRARY(JoltPlugin)
   EZ_STATICLINK_REFERENCE(JoltPlugin_System_JoltContacts);
   EZ_STATICLINK_REFERENCE(JoltPlugin_System_JoltCore);
   EZ_STATICLINK_REFERENCE(JoltPlugin_System_JoltDebugRenderer);
+  EZ_STATICLINK_REFERENCE(JoltPlugin_System_JoltJobSystem);
   EZ_STATICLINK_REFERENCE(JoltPlugin_System_JoltQueries);
   EZ_STATICLINK_REFERENCE(JoltPlugin_System_JoltWorldModule);
 }
@@ -0,0 +1,120 @@
+#include <JoltPlugin/JoltPluginPCH.h>
+
+#include <Foundation/Profiling/Profiling.h>
+#include <JoltPlugin/System/JoltJobSystem.h>
+
+ezJoltJobSystem::ezJoltJobSystem(ezUInt32 uiMaxJobs, ezUInt32 uiMaxBarriers)
+  : JPH::JobSystemWithBarrier(uiMaxBarriers)
+{
+  m_Jobs.Init(uiMaxJobs, uiMaxJobs);
+}
+
+ezJoltJobSystem::~ezJoltJobSystem()
+{
+  // tasks for jobs that were already executed by a barrier may still be pending, they hold a reference to their job
+  ezTaskSystem::WaitForCondition([this]()
+    { return m_iNumRunningTasks == 0; });
+}
+
+int ezJoltJobSystem::GetMaxConcurrency() const
+{
+  // the thread that waits on a barrier executes jobs as well
+  return static_cast<int>(ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks)) + 1;
+}
+
+JPH::JobHandle ezJoltJobSystem::CreateJob(const char* szJobName, JPH::ColorArg color, const JobFunction& jobFunction, JPH::uint32 uiNumDependencies)
+{
+  JPH::uint32 uiIndex = m_Jobs.ConstructObject(szJobName, color, this, jobFunction, uiNumDependencies);
+
+  if (uiIndex == JPH::FixedSizeFreeList<NamedJob>::cInvalidObjectIndex)
+  {
+    // Jobs that were executed by a thread waiting on a barrier stay allocated until their task had a chance to run.
+    // If the worker threads lag behind, help executing tasks until a job gets freed.
+    ezTaskSystem::WaitForCondition([&]()
+      {
+        uiIndex = m_Jobs.ConstructObject(szJobName, color, this, jobFunction, uiNumDependencies);
+        return uiIndex != JPH::FixedSizeFreeList<NamedJob>::cInvalidObjectIndex;
+      });
+  }
+
+  NamedJob* pJob = &m_Jobs.Get(uiIndex);
+
+  // construct the handle first to keep a reference, the job is queued below and may immediately complete
+  JobHandle handle(pJob);
+
+  if (uiNumDependencies == 0)
+  {
+    QueueJob(pJob);
+  }
+
+  return handle;
+}
+
+void ezJoltJobSystem::QueueJob(Job* pJob)
+{
+  ezSharedPtr<JobTask> pTask;
+
+  {
+    EZ_LOCK(m_TasksMutex);
+
+    if (!m_FreeTasks.IsEmpty())
+    {
+      pTask = m_FreeTasks.PeekBack();
+      m_FreeTasks.PopBack();
+    }
+  }
+
+  if (pTask == nullptr)
+  {
+    pTask = EZ_DEFAULT_NEW(JobTask);
+    pTask->ConfigureTask("Jolt Job", ezTaskNesting::Never, ezMakeDelegate(&ezJoltJobSystem::TaskFinished, this));
+  }
+
+  // the reference is released by the task, once the job has been executed
+  pJob->AddRef();
+  pTask->m_pJob = static_cast<NamedJob*>(pJob);
+
+  m_iNumRunningTasks.Increment();
+  ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::EarlyThisFrame);
+}
+
+void ezJoltJobSystem::QueueJobs(Job** pJobs, JPH::uint uiNumJobs)
+{
+  for (JPH::uint i = 0; i < uiNumJobs; ++i)
+  {
+    QueueJob(pJobs[i]);
+  }
+}
+
+void ezJoltJobSystem::FreeJob(Job* pJob)
+{
+  m_Jobs.DestructObject(static_cast<NamedJob*>(pJob));
+}
+
+void ezJoltJobSystem::TaskFinished(const ezSharedPtr<ezTask>& pTask)
+{
+  {
+    EZ_LOCK(m_TasksMutex);
+    m_FreeTasks.PushBack(pTask.Downcast<JobTask>());
+  }
+
+  m_iNumRunningTasks.Decrement();
+}
+
+void ezJoltJobSystem::JobTask::Execute()
+{
+  NamedJob* pJob = m_pJob;
+  m_pJob = nullptr;
+
+  {
+    EZ_PROFILE_SCOPE(pJob->m_szJobName);
+
+    // does nothing, if the job has already been executed by a thread that waits on its barrier
+    pJob->Execute();
+  }
+
+  pJob->Release();
+}
+
+
+EZ_STATICLINK_FILE(JoltPlugin, JoltPlugin_System_JoltJobSystem);
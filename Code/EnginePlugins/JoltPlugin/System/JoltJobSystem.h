@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+
+/// \brief Runs Jolt's physics jobs as ezTasks, so that physics shares the worker threads with the rest of the engine.
+///
+/// Every job whose dependencies are fulfilled is started as a single ezTask. The task objects are pooled and reused.
+/// Waiting on a barrier is implemented by JPH::JobSystemWithBarrier, which executes the jobs of the barrier on the waiting
+/// thread, so waiting never deadlocks, even when all worker threads are busy.
+class ezJoltJobSystem final : public JPH::JobSystemWithBarrier
+{
+public:
+  ezJoltJobSystem(ezUInt32 uiMaxJobs, ezUInt32 uiMaxBarriers);
+  ~ezJoltJobSystem();
+
+  // JPH::JobSystem implementation
+  virtual int GetMaxConcurrency() const override;
+  virtual JobHandle CreateJob(const char* szJobName, JPH::ColorArg color, const JobFunction& jobFunction, JPH::uint32 uiNumDependencies = 0) override;
+
+protected:
+  virtual void QueueJob(Job* pJob) override;
+  virtual void QueueJobs(Job** pJobs, JPH::uint uiNumJobs) override;
+  virtual void FreeJob(Job* pJob) override;
+
+private:
+  /// Jolt only stores the job name when its own profiler is enabled, but the ezTasks need it for their profiling scopes.
+  class NamedJob : public Job
+  {
+  public:
+    NamedJob(const char* szJobName, JPH::ColorArg color, JobSystem* pJobSystem, const JobFunction& jobFunction, JPH::uint32 uiNumDependencies)
+      : Job(szJobName, color, pJobSystem, jobFunction, uiNumDependencies)
+      , m_szJobName(szJobName)
+    {
+    }
+
+    const char* m_szJobName;
+  };
+
+  class JobTask final : public ezTask
+  {
+  public:
+    NamedJob* m_pJob = nullptr;
+
+  protected:
+    virtual void Execute() override;
+  };
+
+  void TaskFinished(const ezSharedPtr<ezTask>& pTask);
+
+  JPH::FixedSizeFreeList<NamedJob> m_Jobs;
+
+  ezMutex m_TasksMutex;
+  ezDynamicArray<ezSharedPtr<JobTask>> m_FreeTasks;
+
+  /// Tasks that have been started but not finished yet. They may still reference their job, so the job system must outlive them.
+  ezAtomicInteger32 m_iNumRunningTasks;
+};
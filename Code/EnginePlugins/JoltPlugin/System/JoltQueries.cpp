@@ -1,5 +1,6 @@
 #include <JoltPlugin/JoltPluginPCH.h>
 
+#include <Foundation/Threading/TaskSystem.h>
 #include <JoltPlugin/Actors/JoltActorComponent.h>
 #include <JoltPlugin/Resources/JoltMaterial.h>
 #include <JoltPlugin/Shapes/JoltShapeComponent.h>
@@ -34,6 +35,47 @@ void FillCastResult(ezPhysicsCastResult& ref_result, const ezVec3& vStart, const
   ref_result.m_pInternalPhysicsShape = reinterpret_cast<void*>(uiShapeId);
 }
 
+/// \brief All filters needed for a query. Batched queries create them once and share them across all threads.
+struct ezJoltQueryFilters
+{
+  ezJoltQueryFilters(const ezPhysicsQueryParameters& params)
+    : m_BroadphaseFilter(params.m_ShapeTypes)
+    , m_ObjectFilter(params.m_uiCollisionLayer)
+    , m_BodyFilter(params.m_uiIgnoreObjectFilterID)
+  {
+  }
+
+  ezJoltBroadPhaseLayerFilter m_BroadphaseFilter;
+  ezJoltObjectLayerFilter m_ObjectFilter;
+  ezJoltBodyFilter m_BodyFilter;
+};
+
+/// \brief Runs func(uiQueryIndex, query) for all queries of a batch in parallel.
+///
+/// No lock is held across the batch. The calling thread executes other tasks while it waits, and those may need write access to bodies.
+/// Instead the locking query interface is used, which only takes the broadphase query lock and locks the bodies it touches one by one.
+template <typename Func>
+static void RunQueryBatch(const JPH::PhysicsSystem& system, ezUInt32 uiNumQueries, const char* szTaskName, Func func)
+{
+  if (uiNumQueries == 0)
+    return;
+
+  const JPH::NarrowPhaseQuery& query = system.GetNarrowPhaseQuery();
+
+  auto runQueries = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+    for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+    {
+      func(i, query);
+    }
+  };
+
+  // a single query is cheap, small batches are executed on the calling thread
+  ezParallelForParams parallelForParams;
+  parallelForParams.m_uiBinSize = 64;
+
+  ezTaskSystem::ParallelForIndexed(0u, uiNumQueries, runQueries, szTaskName, parallelForParams);
+}
+
 class ezRayCastCollector : public JPH::CastRayCollector
 {
 public:
@@ -56,13 +98,11 @@ public:
   }
 };
 
-bool ezJoltWorldModule::Raycast(ezPhysicsCastResult& out_result, const ezVec3& vStart, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection /*= ezPhysicsHitCollection::Closest*/) const
+static bool CastRay(ezPhysicsCastResult& out_result, const ezVec3& vStart, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection, const JPH::NarrowPhaseQuery& query, const ezJoltQueryFilters& filters, const JPH::BodyLockInterface& lockInterface, const JPH::BodyInterface& bodyInterface, const ezJoltWorldModule* pModule)
 {
   if (fDistance <= 0.001f || vDir.IsZero())
     return false;
 
-  const JPH::NarrowPhaseQuery& query = m_pSystem->GetNarrowPhaseQuery();
-
   JPH::RRayCast ray;
   ray.mOrigin = ezJoltConversionUtils::ToVec3(vStart);
   ray.mDirection = ezJoltConversionUtils::ToVec3(vDir * fDistance);
@@ -70,35 +110,50 @@ bool ezJoltWorldModule::Raycast(ezPhysicsCastResult& out_result, const ezVec3& v
   ezRayCastCollector collector;
   collector.m_bAnyHit = collection == ezPhysicsHitCollection::Any;
 
-  ezJoltBroadPhaseLayerFilter broadphaseFilter(params.m_ShapeTypes);
-  ezJoltBodyFilter bodyFilter(params.m_uiIgnoreObjectFilterID);
-  ezJoltObjectLayerFilter objectFilter(params.m_uiCollisionLayer);
-
   if (params.m_bIgnoreInitialOverlap)
   {
     JPH::RayCastSettings opt;
     opt.mBackFaceMode = JPH::EBackFaceMode::IgnoreBackFaces;
     opt.mTreatConvexAsSolid = false;
 
-    query.CastRay(ray, opt, collector, broadphaseFilter, objectFilter, bodyFilter);
+    query.CastRay(ray, opt, collector, filters.m_BroadphaseFilter, filters.m_ObjectFilter, filters.m_BodyFilter);
 
     if (collector.m_bFoundAny == false)
       return false;
   }
   else
   {
-    if (!query.CastRay(ray, collector.m_Result, broadphaseFilter, objectFilter, bodyFilter))
+    if (!query.CastRay(ray, collector.m_Result, filters.m_BroadphaseFilter, filters.m_ObjectFilter, filters.m_BodyFilter))
       return false;
   }
 
   out_result.m_fDistance = collector.m_Result.mFraction * fDistance;
   out_result.m_vPosition = vStart + fDistance * collector.m_Result.mFraction * vDir;
 
-  FillCastResult(out_result, vStart, vDir, fDistance, collector.m_Result.mBodyID, collector.m_Result.mSubShapeID2, m_pSystem->GetBodyLockInterfaceNoLock(), m_pSystem->GetBodyInterfaceNoLock(), this);
+  FillCastResult(out_result, vStart, vDir, fDistance, collector.m_Result.mBodyID, collector.m_Result.mSubShapeID2, lockInterface, bodyInterface, pModule);
 
   return true;
 }
 
+bool ezJoltWorldModule::Raycast(ezPhysicsCastResult& out_result, const ezVec3& vStart, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection /*= ezPhysicsHitCollection::Closest*/) const
+{
+  return CastRay(out_result, vStart, vDir, fDistance, params, collection, m_pSystem->GetNarrowPhaseQuery(), ezJoltQueryFilters(params), m_pSystem->GetBodyLockInterfaceNoLock(), m_pSystem->GetBodyInterfaceNoLock(), this);
+}
+
+void ezJoltWorldModule::RaycastBatch(ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, ezArrayPtr<const ezPhysicsRaycastQuery> queries, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection /*= ezPhysicsHitCollection::Closest*/) const
+{
+  EZ_ASSERT_DEV(out_results.GetCount() >= queries.GetCount() && out_hits.GetCount() >= queries.GetCount(), "Output arrays are too small");
+
+  const ezJoltQueryFilters filters(params);
+
+  auto castRay = [&](ezUInt32 i, const JPH::NarrowPhaseQuery& query) {
+    const ezPhysicsRaycastQuery& ray = queries[i];
+    out_hits[i] = CastRay(out_results[i], ray.m_vStart, ray.m_vDir, ray.m_fDistance, params, collection, query, filters, m_pSystem->GetBodyLockInterface(), m_pSystem->GetBodyInterface(), this);
+  };
+
+  RunQueryBatch(*m_pSystem, queries.GetCount(), "Jolt Raycast Batch", castRay);
+}
+
 class ezRayCastCollectorAll : public JPH::CastRayCollector
 {
 public:
@@ -177,6 +232,73 @@ public:
   }
 };
 
+static JPH::Mat44 GetCapsuleTransform(const ezTransform& transform)
+{
+  // Jolt capsules are aligned along Y, ours along Z
+  const ezQuat qFixRot = ezQuat::MakeFromAxisAndAngle(ezVec3(1, 0, 0), ezAngle::MakeFromDegree(90.0f));
+  const ezQuat qRot = transform.m_qRotation * qFixRot;
+
+  return JPH::Mat44::sRotationTranslation(ezJoltConversionUtils::ToQuat(qRot), ezJoltConversionUtils::ToVec3(transform.m_vPosition));
+}
+
+/// \brief Creates the Jolt shape for \a shape on the stack and returns func(joltShape, transform), or false for degenerate shapes.
+template <typename Func>
+static bool WithQueryShape(const ezPhysicsQueryShape& shape, Func func)
+{
+  switch (shape.m_Type)
+  {
+    case ezPhysicsQueryShape::Type::Sphere:
+    {
+      if (shape.m_fRadius <= 0.0f)
+        return false;
+
+      const JPH::SphereShape joltShape(shape.m_fRadius);
+      return func(joltShape, JPH::Mat44::sTranslation(ezJoltConversionUtils::ToVec3(shape.m_Transform.m_vPosition)));
+    }
+
+    case ezPhysicsQueryShape::Type::Box:
+    {
+      const JPH::BoxShape joltShape(ezJoltConversionUtils::ToVec3(shape.m_vBoxExtents * 0.5f));
+      return func(joltShape, JPH::Mat44::sRotationTranslation(ezJoltConversionUtils::ToQuat(shape.m_Transform.m_qRotation), ezJoltConversionUtils::ToVec3(shape.m_Transform.m_vPosition)));
+    }
+
+    case ezPhysicsQueryShape::Type::Capsule:
+    {
+      if (shape.m_fRadius <= 0.0f)
+        return false;
+
+      const JPH::CapsuleShape joltShape(shape.m_fCapsuleHeight * 0.5f, shape.m_fRadius);
+      return func(joltShape, GetCapsuleTransform(shape.m_Transform));
+    }
+
+      EZ_DEFAULT_CASE_NOT_IMPLEMENTED;
+  }
+
+  return false;
+}
+
+static bool CastShape(ezPhysicsCastResult& out_Result, const JPH::Shape& shape, const JPH::Mat44& transform, const ezVec3& vDir, float fDistance, ezPhysicsHitCollection collection, const JPH::NarrowPhaseQuery& query, const ezJoltQueryFilters& filters, const JPH::BodyLockInterface& lockInterface, const JPH::BodyInterface& bodyInterface, const ezJoltWorldModule* pModule)
+{
+  JPH::RShapeCast cast(&shape, JPH::Vec3(1, 1, 1), transform, ezJoltConversionUtils::ToVec3(vDir * fDistance));
+
+  ezJoltShapeCastCollector collector;
+  collector.m_bAnyHit = collection == ezPhysicsHitCollection::Any;
+
+  query.CastShape(cast, {}, JPH::RVec3::sZero(), collector, filters.m_BroadphaseFilter, filters.m_ObjectFilter, filters.m_BodyFilter);
+
+  if (!collector.m_bFoundAny)
+    return false;
+
+  const auto& res = collector.m_Result;
+
+  out_Result.m_fDistance = res.mFraction * fDistance;
+  out_Result.m_vPosition = ezJoltConversionUtils::ToVec3(res.mContactPointOn2);
+
+  FillCastResult(out_Result, ezJoltConversionUtils::ToVec3(transform.GetTranslation()), vDir, fDistance, res.mBodyID2, res.mSubShapeID2, lockInterface, bodyInterface, pModule);
+
+  return true;
+}
+
 bool ezJoltWorldModule::SweepTestSphere(ezPhysicsCastResult& out_result, float fSphereRadius, const ezVec3& vStart, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection) const
 {
   if (fSphereRadius <= 0.0f)
@@ -184,7 +306,7 @@ bool ezJoltWorldModule::SweepTestSphere(ezPhysicsCastResult& out_result, float f
 
   const JPH::SphereShape shape(fSphereRadius);
 
-  return SweepTest(out_result, shape, JPH::Mat44::sTranslation(ezJoltConversionUtils::ToVec3(vStart)), vDir, fDistance, params, collection);
+  return CastShape(out_result, shape, JPH::Mat44::sTranslation(ezJoltConversionUtils::ToVec3(vStart)), vDir, fDistance, collection, m_pSystem->GetNarrowPhaseQuery(), ezJoltQueryFilters(params), m_pSystem->GetBodyLockInterfaceNoLock(), m_pSystem->GetBodyInterfaceNoLock(), this);
 }
 
 bool ezJoltWorldModule::SweepTestBox(ezPhysicsCastResult& out_result, ezVec3 vBoxExtends, const ezTransform& transform, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection) const
@@ -193,7 +315,7 @@ bool ezJoltWorldModule::SweepTestBox(ezPhysicsCastResult& out_result, ezVec3 vBo
 
   const JPH::Mat44 trans = JPH::Mat44::sRotationTranslation(ezJoltConversionUtils::ToQuat(transform.m_qRotation), ezJoltConversionUtils::ToVec3(transform.m_vPosition));
 
-  return SweepTest(out_result, shape, trans, vDir, fDistance, params, collection);
+  return CastShape(out_result, shape, trans, vDir, fDistance, collection, m_pSystem->GetNarrowPhaseQuery(), ezJoltQueryFilters(params), m_pSystem->GetBodyLockInterfaceNoLock(), m_pSystem->GetBodyInterfaceNoLock(), this);
 }
 
 bool ezJoltWorldModule::SweepTestCapsule(ezPhysicsCastResult& out_result, float fCapsuleRadius, float fCapsuleHeight, const ezTransform& transform, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection) const
@@ -203,43 +325,24 @@ bool ezJoltWorldModule::SweepTestCapsule(ezPhysicsCastResult& out_result, float
 
   const JPH::CapsuleShape shape(fCapsuleHeight * 0.5f, fCapsuleRadius);
 
-  ezQuat qFixRot = ezQuat::MakeFromAxisAndAngle(ezVec3(1, 0, 0), ezAngle::MakeFromDegree(90.0f));
-
-  ezQuat qRot;
-  qRot = transform.m_qRotation;
-  qRot = qRot * qFixRot;
-
-  const JPH::Mat44 trans = JPH::Mat44::sRotationTranslation(ezJoltConversionUtils::ToQuat(qRot), ezJoltConversionUtils::ToVec3(transform.m_vPosition));
-
-  return SweepTest(out_result, shape, trans, vDir, fDistance, params, collection);
+  return CastShape(out_result, shape, GetCapsuleTransform(transform), vDir, fDistance, collection, m_pSystem->GetNarrowPhaseQuery(), ezJoltQueryFilters(params), m_pSystem->GetBodyLockInterfaceNoLock(), m_pSystem->GetBodyInterfaceNoLock(), this);
 }
 
-bool ezJoltWorldModule::SweepTest(ezPhysicsCastResult& out_Result, const JPH::Shape& shape, const JPH::Mat44& transform, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection) const
+void ezJoltWorldModule::SweepTestBatch(ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, ezArrayPtr<const ezPhysicsSweepQuery> queries, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection /*= ezPhysicsHitCollection::Closest*/) const
 {
-  const JPH::NarrowPhaseQuery& query = m_pSystem->GetNarrowPhaseQuery();
-
-  ezJoltBroadPhaseLayerFilter broadphaseFilter(params.m_ShapeTypes);
-  ezJoltBodyFilter bodyFilter(params.m_uiIgnoreObjectFilterID);
-  ezJoltObjectLayerFilter objectFilter(params.m_uiCollisionLayer);
-
-  JPH::RShapeCast cast(&shape, JPH::Vec3(1, 1, 1), transform, ezJoltConversionUtils::ToVec3(vDir * fDistance));
-
-  ezJoltShapeCastCollector collector;
-  collector.m_bAnyHit = collection == ezPhysicsHitCollection::Any;
-
-  query.CastShape(cast, {}, JPH::RVec3::sZero(), collector, broadphaseFilter, objectFilter, bodyFilter);
+  EZ_ASSERT_DEV(out_results.GetCount() >= queries.GetCount() && out_hits.GetCount() >= queries.GetCount(), "Output arrays are too small");
 
-  if (!collector.m_bFoundAny)
-    return false;
-
-  const auto& res = collector.m_Result;
+  const ezJoltQueryFilters filters(params);
 
-  out_Result.m_fDistance = res.mFraction * fDistance;
-  out_Result.m_vPosition = ezJoltConversionUtils::ToVec3(res.mContactPointOn2);
+  auto castShape = [&](ezUInt32 i, const JPH::NarrowPhaseQuery& query) {
+    const ezPhysicsSweepQuery& sweep = queries[i];
 
-  FillCastResult(out_Result, ezJoltConversionUtils::ToVec3(transform.GetTranslation()), vDir, fDistance, res.mBodyID2, res.mSubShapeID2, m_pSystem->GetBodyLockInterfaceNoLock(), m_pSystem->GetBodyInterfaceNoLock(), this);
+    out_hits[i] = WithQueryShape(sweep.m_Shape, [&](const JPH::Shape& shape, const JPH::Mat44& transform) {
+      return CastShape(out_results[i], shape, transform, sweep.m_vDir, sweep.m_fDistance, collection, query, filters, m_pSystem->GetBodyLockInterface(), m_pSystem->GetBodyInterface(), this);
+    });
+  };
 
-  return true;
+  RunQueryBatch(*m_pSystem, queries.GetCount(), "Jolt Sweep Batch", castShape);
 }
 
 class ezJoltShapeCollectorAny : public JPH::CollideShapeCollector
@@ -270,6 +373,14 @@ public:
   }
 };
 
+static bool CollideShapeAny(const JPH::Shape& shape, const JPH::Mat44& transform, const JPH::NarrowPhaseQuery& query, const ezJoltQueryFilters& filters)
+{
+  ezJoltShapeCollectorAny collector;
+  query.CollideShape(&shape, JPH::Vec3(1, 1, 1), transform, {}, JPH::RVec3::sZero(), collector, filters.m_BroadphaseFilter, filters.m_ObjectFilter, filters.m_BodyFilter);
+
+  return collector.m_bFoundAny;
+}
+
 bool ezJoltWorldModule::OverlapTestSphere(float fSphereRadius, const ezVec3& vPosition, const ezPhysicsQueryParameters& params) const
 {
   if (fSphereRadius <= 0.0f)
@@ -277,7 +388,16 @@ bool ezJoltWorldModule::OverlapTestSphere(float fSphereRadius, const ezVec3& vPo
 
   const JPH::SphereShape shape(fSphereRadius);
 
-  return OverlapTest(shape, JPH::Mat44::sTranslation(ezJoltConversionUtils::ToVec3(vPosition)), params);
+  return CollideShapeAny(shape, JPH::Mat44::sTranslation(ezJoltConversionUtils::ToVec3(vPosition)), m_pSystem->GetNarrowPhaseQuery(), ezJoltQueryFilters(params));
+}
+
+bool ezJoltWorldModule::OverlapTestBox(ezVec3 vBoxExtends, const ezTransform& transform, const ezPhysicsQueryParameters& params) const
+{
+  const JPH::BoxShape shape(ezJoltConversionUtils::ToVec3(vBoxExtends * 0.5f));
+
+  const JPH::Mat44 trans = JPH::Mat44::sRotationTranslation(ezJoltConversionUtils::ToQuat(transform.m_qRotation), ezJoltConversionUtils::ToVec3(transform.m_vPosition));
+
+  return CollideShapeAny(shape, trans, m_pSystem->GetNarrowPhaseQuery(), ezJoltQueryFilters(params));
 }
 
 bool ezJoltWorldModule::OverlapTestCapsule(float fCapsuleRadius, float fCapsuleHeight, const ezTransform& transform, const ezPhysicsQueryParameters& params) const
@@ -287,29 +407,22 @@ bool ezJoltWorldModule::OverlapTestCapsule(float fCapsuleRadius, float fCapsuleH
 
   const JPH::CapsuleShape shape(fCapsuleHeight * 0.5f, fCapsuleRadius);
 
-  ezQuat qFixRot = ezQuat::MakeFromAxisAndAngle(ezVec3(1, 0, 0), ezAngle::MakeFromDegree(90.0f));
-
-  ezQuat qRot;
-  qRot = transform.m_qRotation;
-  qRot = qRot * qFixRot;
-
-  const JPH::Mat44 trans = JPH::Mat44::sRotationTranslation(ezJoltConversionUtils::ToQuat(qRot), ezJoltConversionUtils::ToVec3(transform.m_vPosition));
-
-  return OverlapTest(shape, trans, params);
+  return CollideShapeAny(shape, GetCapsuleTransform(transform), m_pSystem->GetNarrowPhaseQuery(), ezJoltQueryFilters(params));
 }
 
-bool ezJoltWorldModule::OverlapTest(const JPH::Shape& shape, const JPH::Mat44& transform, const ezPhysicsQueryParameters& params) const
+void ezJoltWorldModule::OverlapTestBatch(ezArrayPtr<bool> out_overlaps, ezArrayPtr<const ezPhysicsQueryShape> shapes, const ezPhysicsQueryParameters& params) const
 {
-  const JPH::NarrowPhaseQuery& query = m_pSystem->GetNarrowPhaseQuery();
+  EZ_ASSERT_DEV(out_overlaps.GetCount() >= shapes.GetCount(), "Output array is too small");
 
-  ezJoltBroadPhaseLayerFilter broadphaseFilter(params.m_ShapeTypes);
-  ezJoltBodyFilter bodyFilter(params.m_uiIgnoreObjectFilterID);
-  ezJoltObjectLayerFilter objectFilter(params.m_uiCollisionLayer);
+  const ezJoltQueryFilters filters(params);
 
-  ezJoltShapeCollectorAny collector;
-  query.CollideShape(&shape, JPH::Vec3(1, 1, 1), transform, {}, JPH::RVec3::sZero(), collector, broadphaseFilter, objectFilter, bodyFilter);
+  auto collideShape = [&](ezUInt32 i, const JPH::NarrowPhaseQuery& query) {
+    out_overlaps[i] = WithQueryShape(shapes[i], [&](const JPH::Shape& shape, const JPH::Mat44& transform) {
+      return CollideShapeAny(shape, transform, query, filters);
+    });
+  };
 
-  return collector.m_bFoundAny;
+  RunQueryBatch(*m_pSystem, shapes.GetCount(), "Jolt Overlap Batch", collideShape);
 }
 
 void ezJoltWorldModule::QueryShapesInSphere(ezPhysicsOverlapResultArray& out_results, float fSphereRadius, const ezVec3& vPosition, const ezPhysicsQueryParameters& params) const
@@ -75,14 +75,25 @@ void ezParticleBehavior_Gravity::CreateRequiredStreams()
 
 void ezParticleBehavior_Gravity::Process(ezUInt64 uiNumElements)
 {
-  EZ_PROFILE_SCOPE("PFX: Gravity");
+  PrepareChunks(1);
+  ProcessChunk(0, 0, uiNumElements);
+}
 
+void ezParticleBehavior_Gravity::PrepareChunks(ezUInt32 uiNumChunks)
+{
   const ezVec3 vGravity = m_pPhysicsModule != nullptr ? m_pPhysicsModule->GetGravity() : ezVec3(0.0f, 0.0f, -10.0f);
 
   const float tDiff = (float)m_TimeDiff.GetSeconds();
-  const ezVec3 addGravity = vGravity * m_fGravityFactor * tDiff;
+  m_vAddGravity = vGravity * m_fGravityFactor * tDiff;
+}
+
+void ezParticleBehavior_Gravity::ProcessChunk(ezUInt32 uiChunkIndex, ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
+{
+  EZ_PROFILE_SCOPE("PFX: Gravity");
+
+  const ezVec3 addGravity = m_vAddGravity;
 
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, uiStartIndex);
 
   while (!itVelocity.HasReachedEnd())
   {
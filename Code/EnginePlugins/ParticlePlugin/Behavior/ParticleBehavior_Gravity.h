@@ -32,15 +32,20 @@ public:
   float m_fGravityFactor;
 
   virtual void CreateRequiredStreams() override;
+  virtual bool IsChunkSafe() const override { return true; }
 
 protected:
   friend class ezParticleBehaviorFactory_Gravity;
 
   virtual void Process(ezUInt64 uiNumElements) override;
+  virtual void PrepareChunks(ezUInt32 uiNumChunks) override;
+  virtual void ProcessChunk(ezUInt32 uiChunkIndex, ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
 
   void RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule) override;
 
   ezPhysicsWorldModuleInterface* m_pPhysicsModule;
 
   ezProcessingStream* m_pStreamVelocity;
+
+  ezVec3 m_vAddGravity = ezVec3::MakeZero();
 };
@@ -74,13 +74,18 @@ void ezParticleBehavior_PullAlong::CreateRequiredStreams()
 }
 
 void ezParticleBehavior_PullAlong::Process(ezUInt64 uiNumElements)
+{
+  ProcessChunk(0, 0, uiNumElements);
+}
+
+void ezParticleBehavior_PullAlong::ProcessChunk(ezUInt32 uiChunkIndex, ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
 {
   EZ_PROFILE_SCOPE("PFX: PullAlong");
 
   if (m_vApplyPull.IsZero())
     return;
 
-  ezProcessingStreamIterator<ezSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, 0);
+  ezProcessingStreamIterator<ezSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, uiStartIndex);
   ezSimdVec4f pull;
   pull.Load<3>(&m_vApplyPull.x);
 
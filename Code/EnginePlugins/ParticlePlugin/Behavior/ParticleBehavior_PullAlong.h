@@ -27,11 +27,13 @@ class EZ_PARTICLEPLUGIN_DLL ezParticleBehavior_PullAlong final : public ezPartic
 
 public:
   virtual void CreateRequiredStreams() override;
+  virtual bool IsChunkSafe() const override { return true; }
 
   float m_fStrength = 0.5;
 
 protected:
   virtual void Process(ezUInt64 uiNumElements) override;
+  virtual void ProcessChunk(ezUInt32 uiChunkIndex, ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
   virtual void StepParticleSystem(const ezTime& tDiff, ezUInt32 uiNumNewParticles) override;
 
   bool m_bFirstTime = true;
@@ -103,8 +103,12 @@ void ezParticleBehavior_Velocity::CreateRequiredStreams()
 
 void ezParticleBehavior_Velocity::Process(ezUInt64 uiNumElements)
 {
-  EZ_PROFILE_SCOPE("PFX: Velocity");
+  PrepareChunks(1);
+  ProcessChunk(0, 0, uiNumElements);
+}
 
+void ezParticleBehavior_Velocity::PrepareChunks(ezUInt32 uiNumChunks)
+{
   const float tDiff = (float)m_TimeDiff.GetSeconds();
   const ezVec3 vDown = m_pPhysicsModule != nullptr ? m_pPhysicsModule->GetGravity().GetNormalized() : ezVec3(0.0f, 0.0f, -1.0f);
   const ezVec3 vRise = vDown * tDiff * -m_fRiseSpeed;
@@ -129,16 +133,23 @@ void ezParticleBehavior_Velocity::Process(ezUInt64 uiNumElements)
     m_iWindSampleIdx = pOwner->AddWindSampleLocation(GetOwnerSystem()->GetTransform().m_vPosition);
   }
 
-  const ezVec3 vAddPos0 = vRise + vWind;
+  m_vAddPosition = vRise + vWind;
+
+  const float fFriction = ezMath::Clamp(m_fFriction, 0.0f, 100.0f);
+  m_fFrictionFactor = ezMath::Pow(0.5f, tDiff * fFriction);
+}
+
+void ezParticleBehavior_Velocity::ProcessChunk(ezUInt32 uiChunkIndex, ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
+{
+  EZ_PROFILE_SCOPE("PFX: Velocity");
 
   ezSimdVec4f vAddPos;
-  vAddPos.Load<3>(&vAddPos0.x);
+  vAddPos.Load<3>(&m_vAddPosition.x);
 
-  const float fFriction = ezMath::Clamp(m_fFriction, 0.0f, 100.0f);
-  const float fFrictionFactor = ezMath::Pow(0.5f, tDiff * fFriction);
+  const float fFrictionFactor = m_fFrictionFactor;
 
-  ezProcessingStreamIterator<ezSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  ezProcessingStreamIterator<ezSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, uiStartIndex);
+  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, uiStartIndex);
 
   while (!itPosition.HasReachedEnd())
   {
@@ -33,6 +33,7 @@ class EZ_PARTICLEPLUGIN_DLL ezParticleBehavior_Velocity final : public ezParticl
 
 public:
   virtual void CreateRequiredStreams() override;
+  virtual bool IsChunkSafe() const override { return true; }
 
   float m_fRiseSpeed = 0;
   float m_fFriction = 0;
@@ -42,6 +43,8 @@ protected:
   friend class ezParticleBehaviorFactory_Velocity;
 
   virtual void Process(ezUInt64 uiNumElements) override;
+  virtual void PrepareChunks(ezUInt32 uiNumChunks) override;
+  virtual void ProcessChunk(ezUInt32 uiChunkIndex, ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
 
   void RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule) override;
 
@@ -54,4 +57,8 @@ protected:
   ezProcessingStream* m_pStreamVelocity;
 
   ezVec3 m_vLastWind = ezVec3::MakeZero();
+
+  // computed once per update in PrepareChunks() and applied to all particles
+  ezVec3 m_vAddPosition = ezVec3::MakeZero();
+  float m_fFrictionFactor = 1.0f;
 };
@@ -104,6 +104,11 @@ void ezParticleFinalizer_Age::InitializeElements(ezUInt64 uiStartIndex, ezUInt64
 }
 
 void ezParticleFinalizer_Age::Process(ezUInt64 uiNumElements)
+{
+  ProcessChunk(0, 0, uiNumElements);
+}
+
+void ezParticleFinalizer_Age::ProcessChunk(ezUInt32 uiChunkIndex, ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
 {
   EZ_PROFILE_SCOPE("PFX: Age");
 
@@ -111,7 +116,7 @@ void ezParticleFinalizer_Age::Process(ezUInt64 uiNumElements)
 
   const float tDiff = (float)m_TimeDiff.GetSeconds();
 
-  for (ezUInt32 i = 0; i < uiNumElements; ++i)
+  for (ezUInt64 i = uiStartIndex; i < uiStartIndex + uiNumElements; ++i)
   {
     pLifeTime[i].x = pLifeTime[i].x - tDiff;
 
@@ -30,6 +30,7 @@ public:
   ~ezParticleFinalizer_Age();
 
   virtual void CreateRequiredStreams() override;
+  virtual bool IsChunkSafe() const override { return true; }
 
   ezVarianceTypeTime m_LifeTime;
   ezTempHashedString m_sOnDeathEvent;
@@ -40,6 +41,7 @@ protected:
 
   virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
   virtual void Process(ezUInt64 uiNumElements) override;
+  virtual void ProcessChunk(ezUInt32 uiChunkIndex, ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
   void OnParticleDeath(const ezStreamGroupElementRemovedEvent& e);
 
   bool m_bHasOnDeathEventHandler = false;
@@ -23,9 +23,11 @@ public:
   ~ezParticleFinalizer_ApplyVelocity();
 
   virtual void CreateRequiredStreams() override;
+  virtual bool IsChunkSafe() const override { return true; }
 
 protected:
   virtual void Process(ezUInt64 uiNumElements) override;
+  virtual void ProcessChunk(ezUInt32 uiChunkIndex, ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
 
   ezProcessingStream* m_pStreamPosition = nullptr;
   ezProcessingStream* m_pStreamVelocity = nullptr;
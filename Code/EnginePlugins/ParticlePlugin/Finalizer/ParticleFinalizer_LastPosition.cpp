@@ -43,11 +43,16 @@ void ezParticleFinalizer_LastPosition::CreateRequiredStreams()
 }
 
 void ezParticleFinalizer_LastPosition::Process(ezUInt64 uiNumElements)
+{
+  ProcessChunk(0, 0, uiNumElements);
+}
+
+void ezParticleFinalizer_LastPosition::ProcessChunk(ezUInt32 uiChunkIndex, ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
 {
   EZ_PROFILE_SCOPE("PFX: LastPosition");
 
-  ezProcessingStreamIterator<ezVec4> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itLastPosition(m_pStreamLastPosition, uiNumElements, 0);
+  ezProcessingStreamIterator<ezVec4> itPosition(m_pStreamPosition, uiNumElements, uiStartIndex);
+  ezProcessingStreamIterator<ezVec3> itLastPosition(m_pStreamLastPosition, uiNumElements, uiStartIndex);
 
   while (!itPosition.HasReachedEnd())
   {
@@ -50,24 +50,37 @@ void ezParticleFinalizer_Volume::Process(ezUInt64 uiNumElements)
   if (uiNumElements == 0)
     return;
 
+  PrepareChunks(1);
+  ProcessChunk(0, 0, uiNumElements);
+  FinishChunks();
+}
+
+void ezParticleFinalizer_Volume::PrepareChunks(ezUInt32 uiNumChunks)
+{
+  m_ChunkVolumes.SetCount(uiNumChunks);
+  m_ChunkMaxSizes.SetCount(uiNumChunks);
+}
+
+void ezParticleFinalizer_Volume::ProcessChunk(ezUInt32 uiChunkIndex, ezUInt64 uiStartIndex, ezUInt64 uiNumElements)
+{
   EZ_PROFILE_SCOPE("PFX: Volume");
 
-  const ezSimdVec4f* pPosition = m_pStreamPosition->GetData<ezSimdVec4f>();
+  const ezSimdVec4f* pPosition = m_pStreamPosition->GetData<ezSimdVec4f>() + uiStartIndex;
 
-  ezSimdBBoxSphere volume;
-  volume.SetFromPoints(pPosition, static_cast<ezUInt32>(uiNumElements));
+  m_ChunkVolumes[uiChunkIndex].SetFromPoints(pPosition, static_cast<ezUInt32>(uiNumElements));
 
   float fMaxSize = 0;
 
   if (m_pStreamSize != nullptr)
   {
-    const ezFloat16* pSize = m_pStreamSize->GetData<ezFloat16>();
+    const ezFloat16* pSize = m_pStreamSize->GetData<ezFloat16>() + uiStartIndex;
 
     ezSimdVec4f vMax;
     vMax.SetZero();
 
+    // only full groups of four, the tail of a chunk must not read into the next chunk
     constexpr ezUInt32 uiElementsPerLoop = 4;
-    for (ezUInt64 i = 0; i < uiNumElements; i += uiElementsPerLoop)
+    for (ezUInt64 i = 0; i + uiElementsPerLoop <= uiNumElements; i += uiElementsPerLoop)
     {
       const float x = pSize[i + 0];
       const float y = pSize[i + 1];
@@ -85,6 +98,20 @@ void ezParticleFinalizer_Volume::Process(ezUInt64 uiNumElements)
     fMaxSize = ezMath::Max(fMaxSize, (float)vMax.HorizontalMax<4>());
   }
 
+  m_ChunkMaxSizes[uiChunkIndex] = fMaxSize;
+}
+
+void ezParticleFinalizer_Volume::FinishChunks()
+{
+  ezSimdBBoxSphere volume = m_ChunkVolumes[0];
+  float fMaxSize = m_ChunkMaxSizes[0];
+
+  for (ezUInt32 i = 1; i < m_ChunkVolumes.GetCount(); ++i)
+  {
+    volume.ExpandToInclude(m_ChunkVolumes[i]);
+    fMaxSize = ezMath::Max(fMaxSize, m_ChunkMaxSizes[i]);
+  }
+
   GetOwnerSystem()->SetBoundingVolume(ezSimdConversion::ToBBoxSphere(volume), fMaxSize);
 }
 
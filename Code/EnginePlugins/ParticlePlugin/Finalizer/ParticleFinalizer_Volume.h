@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/SimdMath/SimdBBoxSphere.h>
 #include <Foundation/Types/VarianceTypes.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer.h>
 
@@ -28,10 +29,18 @@ public:
 
   virtual void CreateRequiredStreams() override;
   virtual void QueryOptionalStreams() override;
+  virtual bool IsChunkSafe() const override { return true; }
 
 protected:
   virtual void Process(ezUInt64 uiNumElements) override;
+  virtual void PrepareChunks(ezUInt32 uiNumChunks) override;
+  virtual void ProcessChunk(ezUInt32 uiChunkIndex, ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override;
+  virtual void FinishChunks() override;
 
   ezProcessingStream* m_pStreamPosition = nullptr;
   const ezProcessingStream* m_pStreamSize = nullptr;
+
+  // the bounds of each chunk, merged into the bounding volume of the system in FinishChunks()
+  ezDynamicArray<ezSimdBBoxSphere, ezAlignedAllocatorWrapper> m_ChunkVolumes;
+  ezDynamicArray<float> m_ChunkMaxSizes;
 };
@@ -351,6 +351,10 @@ void ezParticleSystemInstance::Construct(ezUInt32 uiMaxParticles, ezWorld* pWorl
 
   m_StreamInfo.Clear();
   m_StreamGroup.SetSize(uiMaxParticles);
+
+  // large systems update their chunk safe behaviors and finalizers on multiple threads, small ones are not worth the overhead
+  constexpr ezUInt32 uiParticlesPerChunk = 2048;
+  m_StreamGroup.SetChunkSize(uiMaxParticles > uiParticlesPerChunk ? uiParticlesPerChunk : 0);
 }
 
 void ezParticleSystemInstance::Destruct()
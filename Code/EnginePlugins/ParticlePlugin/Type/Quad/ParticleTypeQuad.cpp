@@ -3,9 +3,11 @@
 #include <ParticlePlugin/Type/Quad/ParticleTypeQuad.h>
 
 #include <Core/World/World.h>
+#include <Foundation/Algorithm/Sorting.h>
 #include <Foundation/Math/Color16f.h>
 #include <Foundation/Math/Float16.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <ParticlePlugin/Effect/ParticleEffectInstance.h>
 #include <ParticlePlugin/Finalizer/ParticleFinalizer_LastPosition.h>
 #include <RendererCore/Pipeline/View.h>
@@ -212,23 +214,9 @@ void ezParticleTypeQuad::ExtractTypeRenderData(ezMsgExtractRenderData& ref_msg,
 
     if (bNeedsSorting)
     {
-      // TODO: Using the frame allocator this way results in memory corruptions.
-      // Not sure, whether this is supposed to work.
-      ezHybridArray<sod, 64> sorted; // (ezFrameAllocator::GetCurrentAllocator());
-      sorted.SetCountUninitialized(numParticles);
+      SortParticles(numParticles, ref_msg.m_pView->GetCullingCamera()->GetCenterPosition());
 
-      const ezVec3 vCameraPos = ref_msg.m_pView->GetCullingCamera()->GetCenterPosition();
-      const ezVec4* pPosition = m_pStreamPosition->GetData<ezVec4>();
-
-      for (ezUInt32 p = 0; p < numParticles; ++p)
-      {
-        sorted[p].dist = (pPosition[p].GetAsVec3() - vCameraPos).GetLengthSquared();
-        sorted[p].index = p;
-      }
-
-      sorted.Sort(sodComparer());
-
-      CreateExtractedData(&sorted);
+      CreateExtractedData(&m_SortedParticles);
     }
     else
     {
@@ -239,17 +227,101 @@ void ezParticleTypeQuad::ExtractTypeRenderData(ezMsgExtractRenderData& ref_msg,
   AddParticleRenderData(ref_msg, instanceTransform);
 }
 
-EZ_ALWAYS_INLINE ezUInt32 noRedirect(ezUInt32 uiIdx, const ezHybridArray<ezParticleTypeQuad::sod, 64>* pSorted)
+void ezParticleTypeQuad::SortParticles(ezUInt32 uiNumParticles, const ezVec3& vCameraPos) const
+{
+  EZ_PROFILE_SCOPE("PFX: Quad Sort");
+
+  // Start with the order of the last frame. Removing a particle moves the last one into its place, so dropping the indices that are out of range
+  // and appending the new particles keeps this a valid permutation, and since particles only move a little per frame, it is mostly sorted already.
+  ezUInt32 uiNumKept = 0;
+  for (ezUInt32 i = 0; i < m_SortedParticles.GetCount(); ++i)
+  {
+    if (m_SortedParticles[i].index < uiNumParticles)
+    {
+      m_SortedParticles[uiNumKept++].index = m_SortedParticles[i].index;
+    }
+  }
+
+  m_SortedParticles.SetCountUninitialized(uiNumParticles);
+
+  for (ezUInt32 p = uiNumKept; p < uiNumParticles; ++p)
+  {
+    m_SortedParticles[p].index = p;
+  }
+
+  const ezVec4* pPosition = m_pStreamPosition->GetData<ezVec4>();
+
+  auto computeDistances = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+    for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+    {
+      m_SortedParticles[i].dist = (pPosition[m_SortedParticles[i].index].GetAsVec3() - vCameraPos).GetLengthSquared();
+    }
+  };
+
+  constexpr ezUInt32 uiParticlesPerTask = 4096;
+  if (uiNumParticles > uiParticlesPerTask)
+  {
+    ezParallelForParams parallelForParams;
+    parallelForParams.m_uiBinSize = uiParticlesPerTask;
+
+    ezTaskSystem::ParallelForIndexed(0u, uiNumParticles, computeDistances, "PFX: Quad Sort Distances", parallelForParams);
+  }
+  else
+  {
+    computeDistances(0, uiNumParticles);
+  }
+
+  // Fix up the order with an insertion sort. That is linear for an almost sorted array, but quadratic when the order changed a lot,
+  // e.g. after a camera cut, so give up after a few moves per particle and sort from scratch.
+  const ezUInt64 uiMaxMoves = 8ull * uiNumParticles;
+  ezUInt64 uiNumMoves = 0;
+
+  for (ezUInt32 i = 1; i < uiNumParticles; ++i)
+  {
+    const sod current = m_SortedParticles[i];
+
+    ezUInt32 j = i;
+    while (j > 0 && m_SortedParticles[j - 1].dist < current.dist)
+    {
+      m_SortedParticles[j] = m_SortedParticles[j - 1];
+      --j;
+    }
+
+    m_SortedParticles[j] = current;
+
+    uiNumMoves += i - j;
+    if (uiNumMoves <= uiMaxMoves)
+      continue;
+
+    // the comparison sort is faster for small arrays
+    constexpr ezUInt32 uiMinCountForRadixSort = 1024;
+
+    if (uiNumParticles < uiMinCountForRadixSort)
+    {
+      m_SortedParticles.Sort(sodComparer());
+    }
+    else
+    {
+      // the distances are never negative, so their bit patterns sort the same way as the floats, inverted for back to front
+      m_SortScratch.SetCountUninitialized(uiNumParticles);
+      ezSorting::RadixSort<sod>(m_SortedParticles, m_SortScratch, [](const sod& s) { return ~ezIntFloatUnion(s.dist).i; });
+    }
+
+    break;
+  }
+}
+
+EZ_ALWAYS_INLINE ezUInt32 noRedirect(ezUInt32 uiIdx, const ezDynamicArray<ezParticleTypeQuad::sod>* pSorted)
 {
   return uiIdx;
 }
 
-EZ_ALWAYS_INLINE ezUInt32 sortedRedirect(ezUInt32 uiIdx, const ezHybridArray<ezParticleTypeQuad::sod, 64>* pSorted)
+EZ_ALWAYS_INLINE ezUInt32 sortedRedirect(ezUInt32 uiIdx, const ezDynamicArray<ezParticleTypeQuad::sod>* pSorted)
 {
   return (*pSorted)[uiIdx].index;
 }
 
-void ezParticleTypeQuad::CreateExtractedData(const ezHybridArray<sod, 64>* pSorted) const
+void ezParticleTypeQuad::CreateExtractedData(const ezDynamicArray<sod>* pSorted) const
 {
   auto redirect = (pSorted != nullptr) ? sortedRedirect : noRedirect;
 
@@ -94,7 +94,8 @@ protected:
   virtual void Process(ezUInt64 uiNumElements) override {}
   void AllocateParticleData(const ezUInt32 numParticles, const bool bNeedsBillboardData, const bool bNeedsTangentData) const;
   void AddParticleRenderData(ezMsgExtractRenderData& msg, const ezTransform& instanceTransform) const;
-  void CreateExtractedData(const ezHybridArray<sod, 64>* pSorted) const;
+  void CreateExtractedData(const ezDynamicArray<sod>* pSorted) const;
+  void SortParticles(ezUInt32 uiNumParticles, const ezVec3& vCameraPos) const;
 
   ezProcessingStream* m_pStreamLifeTime = nullptr;
   ezProcessingStream* m_pStreamPosition = nullptr;
@@ -109,4 +110,8 @@ protected:
   mutable ezArrayPtr<ezBaseParticleShaderData> m_BaseParticleData;
   mutable ezArrayPtr<ezBillboardQuadParticleShaderData> m_BillboardParticleData;
   mutable ezArrayPtr<ezTangentQuadParticleShaderData> m_TangentParticleData;
+
+  /// The back to front order of the last extraction, which is the starting point for sorting in the next frame.
+  mutable ezDynamicArray<sod> m_SortedParticles;
+  mutable ezDynamicArray<sod> m_SortScratch;
 };
@@ -575,6 +575,14 @@ bool ezPhysXWorldModule::OverlapTestSphere(float fSphereRadius, const ezVec3& vP
   return OverlapTest(sphere, transform, params);
 }
 
+bool ezPhysXWorldModule::OverlapTestBox(ezVec3 vBoxExtends, const ezTransform& transform, const ezPhysicsQueryParameters& params) const
+{
+  PxBoxGeometry box;
+  box.halfExtents = ezPxConversionUtils::ToVec3(vBoxExtends * 0.5f);
+
+  return OverlapTest(box, ezPxConversionUtils::ToTransform(transform), params);
+}
+
 bool ezPhysXWorldModule::OverlapTestCapsule(float fCapsuleRadius, float fCapsuleHeight, const ezTransform& transform, const ezPhysicsQueryParameters& params) const
 {
   PxCapsuleGeometry capsule;
@@ -0,0 +1,369 @@
+#include <ProcGenPlugin/ProcGenPluginPCH.h>
+
+#include <Core/Interfaces/PhysicsWorldModule.h>
+#include <Foundation/Algorithm/HashStream.h>
+#include <Foundation/CodeUtils/Expression/ExpressionByteCode.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <ProcGenPlugin/Components/Implementation/PlacementTileCache.h>
+#include <ProcGenPlugin/Components/VolumeCollection.h>
+#include <ProcGenPlugin/Tasks/PlacementData.h>
+
+namespace
+{
+  struct FileHeader
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    static constexpr ezUInt32 MagicValue = 0x4C495450; // 'PTIL'
+    static constexpr ezUInt32 CurrentVersion = 1;
+
+    ezUInt32 m_uiMagic;
+    ezUInt32 m_uiVersion;
+    ezUInt64 m_uiKey;
+    ezUInt32 m_uiTransformSize;
+    ezUInt32 m_uiNumTransforms;
+    ezUInt32 m_uiPadding[10];
+  };
+
+  // the transforms directly follow the header and have to be aligned to use them in place
+  EZ_CHECK_AT_COMPILETIME(sizeof(FileHeader) == 64);
+} // namespace
+
+namespace ezProcGenInternal
+{
+  PlacementTileCache::PlacementTileCache() = default;
+  PlacementTileCache::~PlacementTileCache() = default;
+
+  void PlacementTileCache::Initialize(ezStringView sCacheDirectory, ezUInt32 uiMaxTilesInMemory, ezUInt32 uiMaxTilesOnDisk)
+  {
+    EZ_LOCK(m_Mutex);
+
+    m_sCacheDirectory = sCacheDirectory;
+    m_uiMaxTilesInMemory = ezMath::Max(uiMaxTilesInMemory, 1u);
+
+    if (!m_sCacheDirectory.IsEmpty() && ezOSFile::CreateDirectoryStructure(m_sCacheDirectory).Failed())
+    {
+      ezLog::Warning("Failed to create the procedural placement tile cache directory '{}'", m_sCacheDirectory);
+      m_sCacheDirectory.Clear();
+    }
+
+    PruneDiskCache(uiMaxTilesOnDisk);
+  }
+
+  void PlacementTileCache::Clear()
+  {
+    EZ_LOCK(m_Mutex);
+
+    m_Tiles.Clear();
+    m_uiUseCounter = 0;
+  }
+
+  void PlacementTileCache::ClearDiskCache()
+  {
+    EZ_LOCK(m_Mutex);
+
+    m_Tiles.Clear();
+    m_uiUseCounter = 0;
+
+    PruneDiskCache(0);
+  }
+
+  // static
+  ezUInt64 PlacementTileCache::ComputeKey(const PlacementData& data)
+  {
+    EZ_PROFILE_SCOPE("ComputeTileCacheKey");
+
+    const PlacementOutput& output = *data.m_pOutput;
+
+    ezHashStreamWriter64 writer;
+
+    // graph output
+    output.m_pByteCode->Save(writer);
+
+    writer << output.m_sName;
+    writer << output.m_pPattern->m_fSize;
+    writer << output.m_pPattern->m_Points.GetCount();
+    writer << output.m_fFootprint;
+    writer << output.m_vMinOffset;
+    writer << output.m_vMaxOffset;
+    writer << output.m_YawRotationSnap;
+    writer << output.m_fAlignToNormal;
+    writer << output.m_vMinScale;
+    writer << output.m_vMaxScale;
+    writer << output.m_uiCollisionLayer;
+    writer << output.m_Mode.GetValue();
+
+    for (auto& hObject : output.m_ObjectsToPlace)
+    {
+      writer << hObject.GetResourceIDHash();
+    }
+
+    writer << output.m_hColorGradient.GetResourceIDHash();
+    writer << output.m_hSurface.GetResourceIDHash();
+
+    // tile position and placement boxes
+    writer << data.m_uiTileSeed;
+    writer << data.m_TileBoundingBox.m_vMin;
+    writer << data.m_TileBoundingBox.m_vMax;
+    writer.WriteBytes(data.m_GlobalToLocalBoxTransforms.GetData(), data.m_GlobalToLocalBoxTransforms.GetCount() * sizeof(ezSimdMat4f)).IgnoreResult();
+
+    // volumes
+    for (const ezVolumeCollection& volumeCollection : data.m_VolumeCollections)
+    {
+      writer << volumeCollection.ComputeHash();
+    }
+
+    // static collision geometry
+    if (data.m_pPhysicsModule != nullptr && output.m_Mode == ezProcPlacementMode::Raycast)
+    {
+      const ezBoundingSphere sphere = data.m_TileBoundingBox.GetBoundingSphere();
+
+      ezPhysicsOverlapResultArray overlaps;
+      data.m_pPhysicsModule->QueryShapesInSphere(overlaps, sphere.m_fRadius, sphere.m_vCenter, ezPhysicsQueryParameters(output.m_uiCollisionLayer, ezPhysicsShapeType::Static));
+
+      // the order of the query results is not defined, so the hashes of the shapes are combined order independently
+      ezUInt64 uiCollisionHash = overlaps.m_Results.GetCount();
+      for (const ezPhysicsOverlapResult& overlap : overlaps.m_Results)
+      {
+        ezHashStreamWriter64 shapeWriter;
+        shapeWriter << overlap.m_vCenterPosition;
+
+        const ezGameObject* pShapeObject = nullptr;
+        if (data.m_pWorld->TryGetObject(overlap.m_hShapeObject, pShapeObject))
+        {
+          shapeWriter << pShapeObject->GetGlobalTransform();
+        }
+
+        uiCollisionHash += shapeWriter.GetHashValue();
+      }
+
+      writer << uiCollisionHash;
+    }
+
+    return writer.GetHashValue();
+  }
+
+  ezSharedPtr<const PlacementTileCache::CachedTile> PlacementTileCache::Find(ezUInt64 uiKey)
+  {
+    {
+      EZ_LOCK(m_Mutex);
+
+      if (Entry* pEntry = m_Tiles.GetValue(uiKey))
+      {
+        pEntry->m_uiLastUsed = ++m_uiUseCounter;
+        return pEntry->m_pTile;
+      }
+
+      if (m_sCacheDirectory.IsEmpty())
+        return nullptr;
+    }
+
+    // don't block other tasks while reading the file
+    ezSharedPtr<const CachedTile> pTile = LoadFromDisk(uiKey);
+    if (pTile == nullptr)
+      return nullptr;
+
+    EZ_LOCK(m_Mutex);
+
+    // another task may have loaded the same tile in the meantime
+    if (Entry* pEntry = m_Tiles.GetValue(uiKey))
+    {
+      pEntry->m_uiLastUsed = ++m_uiUseCounter;
+      return pEntry->m_pTile;
+    }
+
+    InsertTile(uiKey, pTile);
+    return pTile;
+  }
+
+  void PlacementTileCache::Store(ezUInt64 uiKey, ezArrayPtr<const PlacementTransform> transforms)
+  {
+    EZ_PROFILE_SCOPE("StoreTileInCache");
+
+    ezSharedPtr<CachedTile> pTile = EZ_DEFAULT_NEW(CachedTile);
+    pTile->m_OwnedTransforms = transforms;
+    pTile->m_Transforms = pTile->m_OwnedTransforms;
+
+    ezStringBuilder sPath;
+    {
+      EZ_LOCK(m_Mutex);
+
+      InsertTile(uiKey, pTile);
+
+      if (m_sCacheDirectory.IsEmpty())
+        return;
+
+      GetFilePath(uiKey, sPath);
+    }
+
+    FileHeader header;
+    ezMemoryUtils::ZeroFill(&header, 1);
+    header.m_uiMagic = FileHeader::MagicValue;
+    header.m_uiVersion = FileHeader::CurrentVersion;
+    header.m_uiKey = uiKey;
+    header.m_uiTransformSize = sizeof(PlacementTransform);
+    header.m_uiNumTransforms = transforms.GetCount();
+
+    // write to a temporary file first, so that a file with the final name is always complete
+    ezStringBuilder sTempPath = sPath;
+    sTempPath.Append(".tmp");
+
+    {
+      ezOSFile file;
+      if (file.Open(sTempPath, ezFileOpenMode::Write).Failed())
+        return;
+
+      if (file.Write(&header, sizeof(header)).Failed() || file.Write(transforms.GetPtr(), transforms.ToByteArray().GetCount()).Failed())
+      {
+        file.Close();
+        ezOSFile::DeleteFile(sTempPath).IgnoreResult();
+        return;
+      }
+    }
+
+    if (ezOSFile::MoveFileOrDirectory(sTempPath, sPath).Failed())
+    {
+      ezOSFile::DeleteFile(sTempPath).IgnoreResult();
+    }
+  }
+
+  void PlacementTileCache::GetFilePath(ezUInt64 uiKey, ezStringBuilder& out_sPath) const
+  {
+    out_sPath.Format("{}/{}.ezProcGenTile", m_sCacheDirectory, ezArgU(uiKey, 16, true, 16));
+  }
+
+  void PlacementTileCache::PruneDiskCache(ezUInt32 uiMaxTilesOnDisk)
+  {
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS) && EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
+    if (m_sCacheDirectory.IsEmpty())
+      return;
+
+    EZ_PROFILE_SCOPE("PruneTileCache");
+
+    struct TileFile
+    {
+      ezString m_sPath;
+      ezInt64 m_iModificationTime;
+    };
+
+    ezDynamicArray<TileFile> tileFiles;
+    ezStringBuilder sPath;
+
+    ezFileSystemIterator it;
+    for (it.StartSearch(m_sCacheDirectory, ezFileSystemIteratorFlags::ReportFiles); it.IsValid(); it.Next())
+    {
+      it.GetStats().GetFullPath(sPath);
+
+      // left over from an interrupted write
+      if (sPath.HasExtension(".tmp"))
+      {
+        ezOSFile::DeleteFile(sPath).IgnoreResult();
+        continue;
+      }
+
+      if (!sPath.HasExtension(".ezProcGenTile"))
+        continue;
+
+      auto& tileFile = tileFiles.ExpandAndGetRef();
+      tileFile.m_sPath = sPath;
+      tileFile.m_iModificationTime = it.GetStats().m_LastModificationTime.GetInt64(ezSIUnitOfTime::Second);
+    }
+
+    if (tileFiles.GetCount() <= uiMaxTilesOnDisk)
+      return;
+
+    // delete the oldest files first
+    tileFiles.Sort([](const TileFile& a, const TileFile& b) { return a.m_iModificationTime < b.m_iModificationTime; });
+
+    const ezUInt32 uiNumFilesToDelete = tileFiles.GetCount() - uiMaxTilesOnDisk;
+    for (ezUInt32 i = 0; i < uiNumFilesToDelete; ++i)
+    {
+      ezOSFile::DeleteFile(tileFiles[i].m_sPath).IgnoreResult();
+    }
+
+    ezLog::Dev("Deleted {} of {} procedural placement tile cache files", uiNumFilesToDelete, tileFiles.GetCount());
+#endif
+  }
+
+  ezSharedPtr<PlacementTileCache::CachedTile> PlacementTileCache::LoadFromDisk(ezUInt64 uiKey) const
+  {
+    ezStringBuilder sPath;
+    GetFilePath(uiKey, sPath);
+
+    if (!ezOSFile::ExistsFile(sPath))
+      return nullptr;
+
+    EZ_PROFILE_SCOPE("LoadTileFromCache");
+
+    ezSharedPtr<CachedTile> pTile = EZ_DEFAULT_NEW(CachedTile);
+    ezArrayPtr<const ezUInt8> fileData;
+
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+    if (pTile->m_MappedFile.Open(sPath, ezMemoryMappedFile::Mode::ReadOnly).Failed())
+      return nullptr;
+
+    fileData = ezArrayPtr<const ezUInt8>(static_cast<const ezUInt8*>(pTile->m_MappedFile.GetReadPointer()), static_cast<ezUInt32>(pTile->m_MappedFile.GetFileSize()));
+#else
+    ezDynamicArray<ezUInt8> fileContent;
+    {
+      ezOSFile file;
+      if (file.Open(sPath, ezFileOpenMode::Read).Failed())
+        return nullptr;
+
+      file.ReadAll(fileContent);
+    }
+
+    fileData = fileContent;
+#endif
+
+    if (fileData.GetCount() < sizeof(FileHeader))
+      return nullptr;
+
+    FileHeader header;
+    ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&header), fileData.GetPtr(), sizeof(FileHeader));
+
+    if (header.m_uiMagic != FileHeader::MagicValue || header.m_uiVersion != FileHeader::CurrentVersion || header.m_uiKey != uiKey ||
+        header.m_uiTransformSize != sizeof(PlacementTransform) || fileData.GetCount() != sizeof(FileHeader) + header.m_uiNumTransforms * sizeof(PlacementTransform))
+    {
+      ezLog::Warning("Ignoring invalid procedural placement tile cache file '{}'", sPath);
+      return nullptr;
+    }
+
+    const PlacementTransform* pTransforms = reinterpret_cast<const PlacementTransform*>(fileData.GetPtr() + sizeof(FileHeader));
+
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+    pTile->m_Transforms = ezArrayPtr<const PlacementTransform>(pTransforms, header.m_uiNumTransforms);
+#else
+    pTile->m_OwnedTransforms = ezArrayPtr<const PlacementTransform>(pTransforms, header.m_uiNumTransforms);
+    pTile->m_Transforms = pTile->m_OwnedTransforms;
+#endif
+
+    return pTile;
+  }
+
+  void PlacementTileCache::InsertTile(ezUInt64 uiKey, const ezSharedPtr<const CachedTile>& pTile)
+  {
+    // evict the least recently used tile, tiles that are still in use stay alive through their shared pointers
+    if (m_Tiles.GetCount() >= m_uiMaxTilesInMemory && !m_Tiles.Contains(uiKey))
+    {
+      ezUInt64 uiOldestKey = 0;
+      ezUInt64 uiOldestUse = ezMath::MaxValue<ezUInt64>();
+
+      for (auto it : m_Tiles)
+      {
+        if (it.Value().m_uiLastUsed < uiOldestUse)
+        {
+          uiOldestKey = it.Key();
+          uiOldestUse = it.Value().m_uiLastUsed;
+        }
+      }
+
+      m_Tiles.Remove(uiOldestKey);
+    }
+
+    Entry& entry = m_Tiles[uiKey];
+    entry.m_pTile = pTile;
+    entry.m_uiLastUsed = ++m_uiUseCounter;
+  }
+} // namespace ezProcGenInternal
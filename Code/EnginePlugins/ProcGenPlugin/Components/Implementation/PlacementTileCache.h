@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/IO/MemoryMappedFile.h>
+#include <Foundation/Threading/Mutex.h>
+#include <ProcGenPlugin/Declarations.h>
+
+namespace ezProcGenInternal
+{
+  /// \brief Caches the placement transforms of tiles in memory and on disk, so that a tile which has been computed before, even in a previous
+  /// session, doesn't need to be raycast and evaluated again.
+  ///
+  /// Every tile is stored in its own file, a small header followed by the raw transforms, which is memory mapped when it is loaded.
+  /// The most recently used tiles are kept in memory, the least recently used ones are evicted once there are more than the given maximum.
+  /// Tile files whose key can't be hit anymore, e.g. after the graph or a volume has changed, are never read again. To keep the directory from
+  /// growing without limit, the oldest files are deleted on initialization once there are more than the given maximum on disk.
+  /// All functions are thread-safe.
+  class PlacementTileCache
+  {
+  public:
+    struct CachedTile : public ezRefCounted
+    {
+      ezArrayPtr<const PlacementTransform> m_Transforms;
+
+    private:
+      friend class PlacementTileCache;
+
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+      ezMemoryMappedFile m_MappedFile;
+#endif
+      ezDynamicArray<PlacementTransform, ezAlignedAllocatorWrapper> m_OwnedTransforms;
+    };
+
+    PlacementTileCache();
+    ~PlacementTileCache();
+
+    /// \brief Sets the absolute path of the directory in which the tile files are stored. An empty path disables the disk cache.
+    ///
+    /// If there are more than uiMaxTilesOnDisk tile files in the directory, the oldest ones are deleted.
+    void Initialize(ezStringView sCacheDirectory, ezUInt32 uiMaxTilesInMemory, ezUInt32 uiMaxTilesOnDisk);
+
+    /// \brief Removes all tiles from memory. The files on disk are kept.
+    void Clear();
+
+    /// \brief Removes all tiles from memory and deletes all tile files on disk.
+    void ClearDiskCache();
+
+    /// \brief Computes the key of the tile described by the prepared placement data.
+    ///
+    /// The key covers the graph output (bytecode and placement settings), the tile position, the placement boxes, the volumes overlapping the tile
+    /// and the static collision shapes overlapping the tile.
+    static ezUInt64 ComputeKey(const PlacementData& data);
+
+    /// \brief Returns the cached tile with the given key from memory or disk, or nullptr if the tile has never been stored.
+    ezSharedPtr<const CachedTile> Find(ezUInt64 uiKey);
+
+    /// \brief Stores the placement result of a tile in memory and on disk.
+    void Store(ezUInt64 uiKey, ezArrayPtr<const PlacementTransform> transforms);
+
+  private:
+    void GetFilePath(ezUInt64 uiKey, ezStringBuilder& out_sPath) const;
+    void PruneDiskCache(ezUInt32 uiMaxTilesOnDisk);
+    ezSharedPtr<CachedTile> LoadFromDisk(ezUInt64 uiKey) const;
+    void InsertTile(ezUInt64 uiKey, const ezSharedPtr<const CachedTile>& pTile);
+
+    struct Entry
+    {
+      ezSharedPtr<const CachedTile> m_pTile;
+      ezUInt64 m_uiLastUsed = 0;
+    };
+
+    ezMutex m_Mutex;
+    ezHashTable<ezUInt64, Entry> m_Tiles;
+    ezUInt64 m_uiUseCounter = 0;
+    ezUInt32 m_uiMaxTilesInMemory = 0;
+    ezString m_sCacheDirectory;
+  };
+} // namespace ezProcGenInternal
@@ -5,8 +5,10 @@
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Core/WorldSerializer/WorldWriter.h>
 #include <Foundation/Configuration/CVar.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <ProcGenPlugin/Components/Implementation/PlacementTile.h>
+#include <ProcGenPlugin/Components/Implementation/PlacementTileCache.h>
 #include <ProcGenPlugin/Components/ProcPlacementComponent.h>
 #include <ProcGenPlugin/Tasks/FindPlacementTilesTask.h>
 #include <ProcGenPlugin/Tasks/PlacementData.h>
@@ -21,6 +23,9 @@ using namespace ezProcGenInternal;
 
 ezCVarInt cvar_ProcGenProcessingMaxTiles("ProcGen.Processing.MaxTiles", 8, ezCVarFlags::Default, "Maximum number of tiles in process");
 ezCVarInt cvar_ProcGenProcessingMaxNewObjectsPerFrame("ProcGen.Processing.MaxNewObjectsPerFrame", 128, ezCVarFlags::Default, "Maximum number of objects placed per frame");
+ezCVarBool cvar_ProcGenTileCacheEnable("ProcGen.TileCache.Enable", true, ezCVarFlags::Default, "Enables caching of placement results per tile in memory and on disk");
+ezCVarInt cvar_ProcGenTileCacheMaxTilesInMemory("ProcGen.TileCache.MaxTilesInMemory", 256, ezCVarFlags::Default, "Maximum number of cached tiles kept in memory");
+ezCVarInt cvar_ProcGenTileCacheMaxTilesOnDisk("ProcGen.TileCache.MaxTilesOnDisk", 65536, ezCVarFlags::Save, "Maximum number of cached tiles kept on disk, the oldest ones are deleted when a world is initialized. Set to 0 to clear the disk cache.");
 ezCVarBool cvar_ProcGenVisTiles("ProcGen.VisTiles", false, ezCVarFlags::Default, "Enables debug visualization of procedural placement tiles");
 
 ezProcPlacementComponentManager::ezProcPlacementComponentManager(ezWorld* pWorld)
@@ -57,18 +62,41 @@ void ezProcPlacementComponentManager::Initialize()
   }
 
   ezResourceManager::GetResourceEvents().AddEventHandler(ezMakeDelegate(&ezProcPlacementComponentManager::OnResourceEvent, this));
+
+  {
+    ezStringBuilder sCacheDirectory;
+    if (ezFileSystem::ResolvePath(":appdata/ProcGenTileCache", &sCacheDirectory, nullptr).Failed())
+    {
+      sCacheDirectory.Clear();
+    }
+
+    m_pTileCache = EZ_DEFAULT_NEW(PlacementTileCache);
+    m_pTileCache->Initialize(sCacheDirectory, ezMath::Max(cvar_ProcGenTileCacheMaxTilesInMemory.GetValue(), 1), ezMath::Max(cvar_ProcGenTileCacheMaxTilesOnDisk.GetValue(), 0));
+  }
 }
 
 void ezProcPlacementComponentManager::Deinitialize()
 {
   ezResourceManager::GetResourceEvents().RemoveEventHandler(ezMakeDelegate(&ezProcPlacementComponentManager::OnResourceEvent, this));
 
+  // placement tasks still in flight reference the tiles and the tile cache
+  for (auto& processingTask : m_ProcessingTasks)
+  {
+    if (processingTask.IsScheduled())
+    {
+      ezTaskSystem::WaitForGroup(processingTask.m_PlacementTaskGroupID);
+      processingTask.m_PlacementTaskGroupID.Invalidate();
+    }
+  }
+
   for (auto& activeTile : m_ActiveTiles)
   {
     activeTile.Deinitialize(*GetWorld());
   }
   m_ActiveTiles.Clear();
 
+  m_pTileCache = nullptr;
+
   SUPER::Deinitialize();
 }
 
@@ -273,6 +301,13 @@ void ezProcPlacementComponentManager::PreparePlace(const ezWorldModule::UpdateCo
         auto& activeTile = m_ActiveTiles[processingTask.m_uiTileIndex];
         activeTile.PreparePlacementData(pWorld, pWorld->GetModuleReadOnly<ezPhysicsWorldModuleInterface>(), *processingTask.m_pData);
 
+        // without a physics module raycast placement finds nothing, that result must not end up in the cache
+        auto& data = *processingTask.m_pData;
+        if (cvar_ProcGenTileCacheEnable && (data.m_pPhysicsModule != nullptr || data.m_pOutput->m_Mode == ezProcPlacementMode::Fixed))
+        {
+          data.m_pCache = m_pTileCache.Borrow();
+        }
+
         ezTaskSystem::AddTaskToGroup(prepareTaskGroupID, processingTask.m_pPrepareTask);
       }
 
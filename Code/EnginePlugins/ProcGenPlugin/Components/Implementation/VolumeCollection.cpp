@@ -1,5 +1,6 @@
 #include <ProcGenPlugin/ProcGenPluginPCH.h>
 
+#include <Foundation/Algorithm/HashStream.h>
 #include <GameEngine/Utils/ImageDataResource.h>
 #include <GameEngine/Volumes/VolumeSampler.h>
 #include <ProcGenPlugin/Components/VolumeCollection.h>
@@ -287,6 +288,27 @@ void ezVolumeCollection::AddImage(const ezSimdTransform& transform, const ezVec3
   }
 }
 
+ezUInt64 ezVolumeCollection::ComputeHash() const
+{
+  ezHashStreamWriter64 writer;
+
+  writer << m_Spheres.GetCount();
+  writer.WriteBytes(m_Spheres.GetData(), m_Spheres.GetCount() * sizeof(Sphere)).IgnoreResult();
+
+  writer << m_Boxes.GetCount();
+  writer.WriteBytes(m_Boxes.GetData(), m_Boxes.GetCount() * sizeof(Box)).IgnoreResult();
+
+  // the image struct contains pointers, so only the box part and the resource id are hashed
+  writer << m_Images.GetCount();
+  for (const Image& image : m_Images)
+  {
+    writer.WriteBytes(static_cast<const Box*>(&image), sizeof(Box)).IgnoreResult();
+    writer << image.m_Image.GetResourceIDHash();
+  }
+
+  return writer.GetHashValue();
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 EZ_IMPLEMENT_MESSAGE_TYPE(ezMsgExtractVolumes);
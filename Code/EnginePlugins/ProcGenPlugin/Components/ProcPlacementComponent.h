@@ -92,6 +92,8 @@ private:
 
   ezDynamicArray<ezProcGenInternal::PlacementTileDesc, ezAlignedAllocatorWrapper> m_NewTiles;
   ezTaskGroupID m_UpdateTilesTaskGroupID;
+
+  ezUniquePtr<ezProcGenInternal::PlacementTileCache> m_pTileCache;
 };
 
 //////////////////////////////////////////////////////////////////////////
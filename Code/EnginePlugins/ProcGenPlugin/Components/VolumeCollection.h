@@ -74,6 +74,9 @@ public:
 
   void AddImage(const ezSimdTransform& transform, const ezVec3& vExtents, ezEnum<ezProcGenBlendMode> blendMode, float fSortOrder, float fValue, const ezVec3& vFadeOutStart, const ezImageDataResourceHandle& hImage);
 
+  /// \brief Computes a hash over all shapes and the ids of the referenced images. Used to detect whether the volumes of a tile have changed.
+  ezUInt64 ComputeHash() const;
+
 private:
   ezDynamicArray<Sphere, ezAlignedAllocatorWrapper> m_Spheres;
   ezDynamicArray<Box, ezAlignedAllocatorWrapper> m_Boxes;
@@ -122,6 +122,7 @@ EZ_DECLARE_REFLECTABLE_TYPE(EZ_PROCGENPLUGIN_DLL, ezProcVolumeImageMode);
 namespace ezProcGenInternal
 {
   class PlacementTile;
+  class PlacementTileCache;
   class FindPlacementTilesTask;
   class PreparePlacementTask;
   class PlacementTask;
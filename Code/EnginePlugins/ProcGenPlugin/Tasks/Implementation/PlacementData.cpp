@@ -20,5 +20,9 @@ namespace ezProcGenInternal
 
     m_VolumeCollections.Clear();
     m_GlobalData.Clear();
+
+    m_pCache = nullptr;
+    m_uiCacheKey = 0;
+    m_pCachedTile = nullptr;
   }
 } // namespace ezProcGenInternal
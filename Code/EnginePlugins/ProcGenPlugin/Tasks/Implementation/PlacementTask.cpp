@@ -34,13 +34,33 @@ void PlacementTask::Clear()
   m_ValidPoints.Clear();
 }
 
+ezArrayPtr<const PlacementTransform> PlacementTask::GetOutputTransforms() const
+{
+  if (m_pData->m_pCachedTile != nullptr)
+  {
+    return m_pData->m_pCachedTile->m_Transforms;
+  }
+
+  return m_OutputTransforms;
+}
+
 void PlacementTask::Execute()
 {
+  // the result of this tile has been computed before
+  if (m_pData->m_pCachedTile != nullptr)
+    return;
+
   FindPlacementPoints();
 
   if (!m_InputPoints.IsEmpty())
   {
-    ExecuteVM();
+    if (ExecuteVM().Failed())
+      return;
+  }
+
+  if (m_pData->m_pCache != nullptr)
+  {
+    m_pData->m_pCache->Store(m_pData->m_uiCacheKey, m_OutputTransforms);
   }
 }
 
@@ -131,7 +151,7 @@ void PlacementTask::FindPlacementPoints()
   }
 }
 
-void PlacementTask::ExecuteVM()
+ezResult PlacementTask::ExecuteVM()
 {
   auto pOutput = m_pData->m_pOutput;
 
@@ -167,7 +187,7 @@ void PlacementTask::ExecuteVM()
     // Execute expression bytecode
     if (m_VM.Execute(*(pOutput->m_pByteCode), inputs, outputs, uiNumInstances, m_pData->m_GlobalData).Failed())
     {
-      return;
+      return EZ_FAILURE;
     }
 
     // Test density against point threshold and fill remaining input point data from expression
@@ -187,7 +207,7 @@ void PlacementTask::ExecuteVM()
 
   if (m_ValidPoints.IsEmpty())
   {
-    return;
+    return EZ_SUCCESS;
   }
 
   EZ_PROFILE_SCOPE("Construct final transforms");
@@ -263,4 +283,6 @@ void PlacementTask::ExecuteVM()
       placementTransform.m_bHasValidColor = true;
     }
   }
+
+  return EZ_SUCCESS;
 }
@@ -23,4 +23,10 @@ void PreparePlacementTask::Execute()
 
   ezProcGenInternal::ExtractVolumeCollections(world, box, output, m_pData->m_VolumeCollections, m_pData->m_GlobalData);
   ezProcGenInternal::SetInstanceSeed(m_pData->m_uiTileSeed, m_pData->m_GlobalData);
+
+  if (m_pData->m_pCache != nullptr)
+  {
+    m_pData->m_uiCacheKey = PlacementTileCache::ComputeKey(*m_pData);
+    m_pData->m_pCachedTile = m_pData->m_pCache->Find(m_pData->m_uiCacheKey);
+  }
 }
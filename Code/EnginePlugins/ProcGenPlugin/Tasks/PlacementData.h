@@ -1,7 +1,7 @@
 #pragma once
 
 #include <Foundation/CodeUtils/Expression/ExpressionDeclarations.h>
-#include <ProcGenPlugin/Declarations.h>
+#include <ProcGenPlugin/Components/Implementation/PlacementTileCache.h>
 
 class ezPhysicsWorldModuleInterface;
 class ezVolumeCollection;
@@ -26,5 +26,9 @@ namespace ezProcGenInternal
 
     ezDeque<ezVolumeCollection> m_VolumeCollections;
     ezExpression::GlobalData m_GlobalData;
+
+    PlacementTileCache* m_pCache = nullptr;
+    ezUInt64 m_uiCacheKey = 0;
+    ezSharedPtr<const PlacementTileCache::CachedTile> m_pCachedTile;
   };
 } // namespace ezProcGenInternal
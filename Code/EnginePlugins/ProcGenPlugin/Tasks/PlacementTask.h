@@ -18,13 +18,13 @@ namespace ezProcGenInternal
     void Clear();
 
     ezArrayPtr<const PlacementPoint> GetInputPoints() const { return m_InputPoints; }
-    ezArrayPtr<const PlacementTransform> GetOutputTransforms() const { return m_OutputTransforms; }
+    ezArrayPtr<const PlacementTransform> GetOutputTransforms() const;
 
   private:
     virtual void Execute() override;
 
     void FindPlacementPoints();
-    void ExecuteVM();
+    ezResult ExecuteVM();
 
     ezProcessingStream MakeInputStream(const ezHashedString& sName, ezUInt32 uiOffset, ezProcessingStream::DataType dataType = ezProcessingStream::DataType::Float)
     {
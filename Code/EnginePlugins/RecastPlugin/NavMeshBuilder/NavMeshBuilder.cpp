@@ -1,6 +1,9 @@
 #include <RecastPlugin/RecastPluginPCH.h>
 
 #include <Core/World/World.h>
+#include <Foundation/Algorithm/HashStream.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/GraphicsUtils.h>
@@ -31,6 +34,7 @@ EZ_BEGIN_STATIC_REFLECTED_TYPE(ezRecastConfig, ezNoBase, 1, ezRTTIDefaultAllocat
     EZ_MEMBER_PROPERTY("SampleErrorFactor", m_fDetailMeshSampleErrorFactor)->AddAttributes(new ezDefaultValueAttribute(1.0f)),
     EZ_MEMBER_PROPERTY("MaxSimplification", m_fMaxSimplificationError)->AddAttributes(new ezDefaultValueAttribute(1.3f)),
     EZ_MEMBER_PROPERTY("MaxEdgeLength", m_fMaxEdgeLength)->AddAttributes(new ezDefaultValueAttribute(4.0f)),
+    EZ_MEMBER_PROPERTY("TileSize", m_uiTileSize),
   }
   EZ_END_PROPERTIES;
 }
@@ -84,9 +88,10 @@ ezResult ezRecastNavMeshBuilder::ExtractWorldGeometry(const ezWorld& world, ezWo
 }
 
 ezResult ezRecastNavMeshBuilder::Build(const ezRecastConfig& config, const ezWorldGeoExtractionUtil::MeshObjectList& geo,
-  ezRecastNavMeshResourceDescriptor& out_navMeshDesc, ezProgress& ref_progress)
+  ezRecastNavMeshResourceDescriptor& out_navMeshDesc, ezProgress& ref_progress, const ezRecastNavMeshResourceDescriptor* pPreviousNavMesh)
 {
   EZ_LOG_BLOCK("ezRecastNavMeshBuilder::Build");
+  EZ_ASSERT_DEV(pPreviousNavMesh != &out_navMeshDesc, "The previous navmesh must not be the output descriptor");
 
   ezProgressRange pg("Generating NavMesh", 4, true, &ref_progress);
   pg.SetStepWeighting(0, 0.1f);
@@ -119,15 +124,24 @@ ezResult ezRecastNavMeshBuilder::Build(const ezRecastConfig& config, const ezWor
   if (!pg.BeginNextStep("Build Poly Mesh"))
     return EZ_FAILURE;
 
+  if (config.m_uiTileSize > 0)
+  {
+    // the tiles contain both the polygons and the Detour data
+    return BuildTiled(config, out_navMeshDesc, ref_progress, pPreviousNavMesh);
+  }
+
+  rcConfig cfg;
+  FillOutConfig(cfg, config, m_BoundingBox);
+
   out_navMeshDesc.m_pNavMeshPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
 
-  if (BuildRecastPolyMesh(config, *out_navMeshDesc.m_pNavMeshPolygons, ref_progress).Failed())
+  if (BuildRecastPolyMesh(cfg, m_pRecastContext, m_Vertices, m_Triangles, m_TriangleAreaIDs, *out_navMeshDesc.m_pNavMeshPolygons, &ref_progress).Failed())
     return EZ_FAILURE;
 
   if (!pg.BeginNextStep("Build NavMesh"))
     return EZ_FAILURE;
 
-  if (BuildDetourNavMeshData(config, *out_navMeshDesc.m_pNavMeshPolygons, out_navMeshDesc.m_DetourNavmeshData).Failed())
+  if (BuildDetourNavMeshData(config, *out_navMeshDesc.m_pNavMeshPolygons, 0, 0, out_navMeshDesc.m_DetourNavmeshData).Failed())
     return EZ_FAILURE;
 
   return EZ_SUCCESS;
@@ -272,21 +286,299 @@ void ezRecastNavMeshBuilder::FillOutConfig(rcConfig& cfg, const ezRecastConfig&
   rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 }
 
-ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& config, rcPolyMesh& out_PolyMesh, ezProgress& progress)
+ezUInt64 ezRecastNavMeshBuilder::ComputeConfigHash(const ezRecastConfig& config)
+{
+  ezHashStreamWriter64 stream;
+  config.Serialize(stream).IgnoreResult();
+  return stream.GetHashValue();
+}
+
+ezResult ezRecastNavMeshBuilder::BuildTiled(const ezRecastConfig& config, ezRecastNavMeshResourceDescriptor& out_navMeshDesc, ezProgress& ref_progress,
+  const ezRecastNavMeshResourceDescriptor* pPreviousNavMesh)
 {
-  ezProgressRange pgRange("Build Poly Mesh", 13, true, &progress);
+  using Tile = ezRecastNavMeshResourceDescriptor::Tile;
+
+  ezProgressRange pgRange("Build Tiles", 3, true, &ref_progress);
+  pgRange.SetStepWeighting(0, 0.1f);
+  pgRange.SetStepWeighting(1, 0.8f);
+  pgRange.SetStepWeighting(2, 0.1f);
+
+  if (!pgRange.BeginNextStep("Assign Triangles to Tiles"))
+    return EZ_FAILURE;
 
   rcConfig cfg;
   FillOutConfig(cfg, config, m_BoundingBox);
 
-  ezRcBuildContext* pContext = m_pRecastContext;
-  const float* pVertices = &m_Vertices[0].x;
-  const ezInt32* pTriangles = &m_Triangles[0].m_VertexIdx[0];
+  // Every tile is rasterized with a border that overlaps its neighbors, so that the erosion by the agent radius
+  // and the region borders are the same on both sides of a tile edge.
+  cfg.tileSize = static_cast<int>(config.m_uiTileSize);
+  cfg.borderSize = cfg.walkableRadius + 3;
+  cfg.width = cfg.tileSize + cfg.borderSize * 2;
+  cfg.height = cfg.tileSize + cfg.borderSize * 2;
+
+  const float fTileWorldSize = cfg.tileSize * cfg.cs;
+  const float fBorderWorldSize = cfg.borderSize * cfg.cs;
+
+  // The tiles are placed on a global grid and the heightfields start at a multiple of the cell height, so that adding or removing geometry
+  // somewhere else does not change the result for a tile.
+  cfg.bmin[1] = ezMath::Floor(cfg.bmin[1] / cfg.ch) * cfg.ch;
+
+  const ezInt32 iMinTileX = static_cast<ezInt32>(ezMath::Floor(m_BoundingBox.m_vMin.x / fTileWorldSize));
+  const ezInt32 iMinTileY = static_cast<ezInt32>(ezMath::Floor(m_BoundingBox.m_vMin.z / fTileWorldSize));
+  const ezInt32 iMaxTileX = static_cast<ezInt32>(ezMath::Floor(m_BoundingBox.m_vMax.x / fTileWorldSize));
+  const ezInt32 iMaxTileY = static_cast<ezInt32>(ezMath::Floor(m_BoundingBox.m_vMax.z / fTileWorldSize));
+  const ezUInt32 uiNumTilesX = static_cast<ezUInt32>(iMaxTileX - iMinTileX + 1);
+  const ezUInt32 uiNumTilesY = static_cast<ezUInt32>(iMaxTileY - iMinTileY + 1);
+
+  if (static_cast<ezUInt64>(uiNumTilesX) * uiNumTilesY > (1u << 20))
+  {
+    ezLog::Error("The navmesh would consist of {0} x {1} tiles, increase the tile size.", uiNumTilesX, uiNumTilesY);
+    return EZ_FAILURE;
+  }
+
+  // assign all triangles to the tiles that they overlap, including the border
+  ezDynamicArray<ezDynamicArray<ezUInt32>> trianglesPerTile;
+  trianglesPerTile.SetCount(uiNumTilesX * uiNumTilesY);
+
+  for (ezUInt32 t = 0; t < m_Triangles.GetCount(); ++t)
+  {
+    const Triangle& tri = m_Triangles[t];
+    const ezVec3& v0 = m_Vertices[tri.m_VertexIdx[0]];
+    const ezVec3& v1 = m_Vertices[tri.m_VertexIdx[1]];
+    const ezVec3& v2 = m_Vertices[tri.m_VertexIdx[2]];
+
+    const ezInt32 iTileX0 = ezMath::Max(iMinTileX, static_cast<ezInt32>(ezMath::Floor((ezMath::Min(v0.x, v1.x, v2.x) - fBorderWorldSize) / fTileWorldSize)));
+    const ezInt32 iTileY0 = ezMath::Max(iMinTileY, static_cast<ezInt32>(ezMath::Floor((ezMath::Min(v0.z, v1.z, v2.z) - fBorderWorldSize) / fTileWorldSize)));
+    const ezInt32 iTileX1 = ezMath::Min(iMaxTileX, static_cast<ezInt32>(ezMath::Floor((ezMath::Max(v0.x, v1.x, v2.x) + fBorderWorldSize) / fTileWorldSize)));
+    const ezInt32 iTileY1 = ezMath::Min(iMaxTileY, static_cast<ezInt32>(ezMath::Floor((ezMath::Max(v0.z, v1.z, v2.z) + fBorderWorldSize) / fTileWorldSize)));
+
+    for (ezInt32 y = iTileY0; y <= iTileY1; ++y)
+    {
+      for (ezInt32 x = iTileX0; x <= iTileX1; ++x)
+      {
+        trianglesPerTile[(y - iMinTileY) * uiNumTilesX + (x - iMinTileX)].PushBack(t);
+      }
+    }
+  }
+
+  const ezUInt64 uiConfigHash = ComputeConfigHash(config);
+
+  // tiles of the previous navmesh can only be taken over if they were built with the same settings
+  ezHashTable<ezUInt64, const Tile*> previousTiles;
+  if (pPreviousNavMesh != nullptr && pPreviousNavMesh->m_uiTileConfigHash == uiConfigHash)
+  {
+    for (const Tile& tile : pPreviousNavMesh->m_Tiles)
+    {
+      previousTiles.Insert(ezRecastNavMeshResourceDescriptor::GetTileKey(tile.m_iX, tile.m_iY), &tile);
+    }
+  }
+
+  out_navMeshDesc.m_uiTileConfigHash = uiConfigHash;
+  out_navMeshDesc.m_fTileWorldSize = fTileWorldSize;
+
+  ezDynamicArray<ezUInt32> tilesToBuild;
+
+  for (ezUInt32 y = 0; y < uiNumTilesY; ++y)
+  {
+    for (ezUInt32 x = 0; x < uiNumTilesX; ++x)
+    {
+      const ezDynamicArray<ezUInt32>& triangles = trianglesPerTile[y * uiNumTilesX + x];
+      if (triangles.IsEmpty())
+        continue;
+
+      Tile& tile = out_navMeshDesc.m_Tiles.ExpandAndGetRef();
+      tile.m_iX = iMinTileX + static_cast<ezInt32>(x);
+      tile.m_iY = iMinTileY + static_cast<ezInt32>(y);
+
+      ezHashStreamWriter64 inputHash;
+      for (ezUInt32 t : triangles)
+      {
+        for (ezUInt32 v = 0; v < 3; ++v)
+        {
+          inputHash << m_Vertices[m_Triangles[t].m_VertexIdx[v]];
+        }
+      }
+
+      tile.m_uiInputHash = inputHash.GetHashValue();
+
+      const Tile* pPreviousTile = nullptr;
+      if (previousTiles.TryGetValue(ezRecastNavMeshResourceDescriptor::GetTileKey(tile.m_iX, tile.m_iY), pPreviousTile) &&
+          pPreviousTile->m_uiInputHash == tile.m_uiInputHash)
+      {
+        tile.m_DetourTileData = pPreviousTile->m_DetourTileData;
+
+        if (pPreviousTile->m_pPolygons != nullptr)
+        {
+          tile.m_pPolygons = ezRecastNavMeshResourceDescriptor::ClonePolyMesh(*pPreviousTile->m_pPolygons);
+        }
+      }
+      else
+      {
+        tilesToBuild.PushBack(out_navMeshDesc.m_Tiles.GetCount() - 1);
+      }
+    }
+  }
+
+  if (!pgRange.BeginNextStep("Build Tiles"))
+    return EZ_FAILURE;
+
+  ezAtomicBool bAnyTileFailed;
+
+  auto BuildTiles = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+  {
+    // rcContext is not thread-safe
+    ezRcBuildContext context;
+    ezDynamicArray<Triangle> triangles;
+    ezDynamicArray<ezUInt8> triangleAreaIDs;
+
+    for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+    {
+      Tile& tile = out_navMeshDesc.m_Tiles[tilesToBuild[i]];
+
+      triangles.Clear();
+      for (ezUInt32 t : trianglesPerTile[(tile.m_iY - iMinTileY) * uiNumTilesX + (tile.m_iX - iMinTileX)])
+      {
+        triangles.PushBack(m_Triangles[t]);
+      }
+
+      triangleAreaIDs.Clear();
+      triangleAreaIDs.SetCount(triangles.GetCount());
+
+      rcConfig tileCfg = cfg;
+      tileCfg.bmin[0] = tile.m_iX * fTileWorldSize - fBorderWorldSize;
+      tileCfg.bmin[2] = tile.m_iY * fTileWorldSize - fBorderWorldSize;
+      tileCfg.bmax[0] = (tile.m_iX + 1) * fTileWorldSize + fBorderWorldSize;
+      tileCfg.bmax[2] = (tile.m_iY + 1) * fTileWorldSize + fBorderWorldSize;
+
+      rcPolyMesh* pPolyMesh = EZ_DEFAULT_NEW(rcPolyMesh);
+
+      if (BuildRecastPolyMesh(tileCfg, &context, m_Vertices, triangles, triangleAreaIDs, *pPolyMesh, nullptr).Failed())
+      {
+        ezLog::Error("Failed to build navmesh tile ({0}, {1})", tile.m_iX, tile.m_iY);
+        EZ_DEFAULT_DELETE(pPolyMesh);
+        bAnyTileFailed = true;
+        continue;
+      }
+
+      // nothing walkable in this tile, it is still stored to not rebuild it again next time
+      if (pPolyMesh->npolys == 0)
+      {
+        EZ_DEFAULT_DELETE(pPolyMesh);
+        continue;
+      }
+
+      tile.m_pPolygons = pPolyMesh;
+
+      if (BuildDetourNavMeshData(config, *pPolyMesh, tile.m_iX, tile.m_iY, tile.m_DetourTileData).Failed())
+      {
+        bAnyTileFailed = true;
+      }
+    }
+  };
+
+  ezParallelForParams parallelForParams;
+  parallelForParams.m_uiBinSize = 1;
+  parallelForParams.m_uiMaxTasksPerThread = 4;
+
+  ezTaskSystem::ParallelForIndexed(0u, tilesToBuild.GetCount(), BuildTiles, "Build NavMesh Tiles", parallelForParams);
+
+  if (bAnyTileFailed)
+    return EZ_FAILURE;
+
+  ezLog::Info("Built {0} of {1} navmesh tiles", tilesToBuild.GetCount(), out_navMeshDesc.m_Tiles.GetCount());
+
+  if (!pgRange.BeginNextStep("Merge Tile Polygons"))
+    return EZ_FAILURE;
+
+  ezHybridArray<rcPolyMesh*, 64> tilePolygons;
+  ezUInt32 uiMaxPolysPerTile = 1;
+  ezUInt32 uiTotalVertices = 0;
+
+  for (const Tile& tile : out_navMeshDesc.m_Tiles)
+  {
+    if (tile.m_pPolygons != nullptr)
+    {
+      tilePolygons.PushBack(tile.m_pPolygons);
+      uiMaxPolysPerTile = ezMath::Max<ezUInt32>(uiMaxPolysPerTile, tile.m_pPolygons->npolys);
+      uiTotalVertices += tile.m_pPolygons->nverts;
+    }
+  }
+
+  // Detour stores the tile index, the polygon index and a salt value in 32 bit polygon references and needs at least 10 bits for the salt.
+  out_navMeshDesc.m_uiMaxPolysPerTile = ezMath::PowerOfTwo_Ceil(uiMaxPolysPerTile);
+
+  const ezUInt32 uiTileBits = ezMath::Log2i(ezMath::PowerOfTwo_Ceil(ezMath::Max(1u, tilePolygons.GetCount())));
+  const ezUInt32 uiPolyBits = ezMath::Log2i(out_navMeshDesc.m_uiMaxPolysPerTile);
+  if (uiTileBits + uiPolyBits > 22)
+  {
+    ezLog::Error("The navmesh has too many tiles ({0}) or too many polygons per tile ({1}), adjust the tile size.", tilePolygons.GetCount(), uiMaxPolysPerTile);
+    return EZ_FAILURE;
+  }
+
+  if (tilePolygons.IsEmpty())
+    return EZ_SUCCESS;
+
+  // the merged polygons are only needed for visualization and the points of interest, which is not worth failing the build for
+  if (uiTotalVertices >= 0xFFFE)
+  {
+    ezLog::Warning("The navmesh has too many vertices ({0}) to merge the tile polygons, it can't be visualized.", uiTotalVertices);
+    return EZ_SUCCESS;
+  }
+
+  // rcMergePolyMeshes only offsets the vertices of a tile in x and z and assumes that all tiles share bmin[1].
+  // Tiles taken over from the previous navmesh may have been built with a different bmin[1], if the geometry that defines
+  // the lowest point has changed. Since bmin[1] is always a multiple of the cell height, their vertices can be rebased exactly.
+  float fMinHeight = tilePolygons[0]->bmin[1];
+  for (const rcPolyMesh* pMesh : tilePolygons)
+  {
+    fMinHeight = ezMath::Min(fMinHeight, pMesh->bmin[1]);
+  }
+
+  for (rcPolyMesh* pMesh : tilePolygons)
+  {
+    const ezUInt16 uiHeightOffset = static_cast<ezUInt16>(ezMath::Round((pMesh->bmin[1] - fMinHeight) / pMesh->ch));
+    if (uiHeightOffset == 0)
+      continue;
+
+    for (int i = 0; i < pMesh->nverts; ++i)
+    {
+      pMesh->verts[i * 3 + 1] += uiHeightOffset;
+    }
+
+    pMesh->bmin[1] = fMinHeight;
+  }
+
+  out_navMeshDesc.m_pNavMeshPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
+
+  if (!rcMergePolyMeshes(m_pRecastContext, tilePolygons.GetData(), tilePolygons.GetCount(), *out_navMeshDesc.m_pNavMeshPolygons))
+  {
+    ezLog::Warning("Failed to merge the navmesh tile polygons, the navmesh can't be visualized.");
+    EZ_DEFAULT_DELETE(out_navMeshDesc.m_pNavMeshPolygons);
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const rcConfig& cfg, ezRcBuildContext* pContext, ezArrayPtr<const ezVec3> vertices,
+  ezArrayPtr<const Triangle> triangles, ezArrayPtr<ezUInt8> triangleAreaIDs, rcPolyMesh& out_PolyMesh, ezProgress* pProgress)
+{
+  // tiles are built in parallel without progress reporting
+  ezUniquePtr<ezProgressRange> pgRange;
+  if (pProgress != nullptr)
+  {
+    pgRange = EZ_DEFAULT_NEW(ezProgressRange, "Build Poly Mesh", 13, true, pProgress);
+  }
+
+  auto BeginNextStep = [&](const char* szStepName)
+  { return pgRange == nullptr || pgRange->BeginNextStep(szStepName); };
+
+  const float* pVertices = &vertices[0].x;
+  const ezInt32* pTriangles = &triangles[0].m_VertexIdx[0];
 
   rcHeightfield* heightfield = rcAllocHeightfield();
   EZ_SCOPE_EXIT(rcFreeHeightField(heightfield));
 
-  if (!pgRange.BeginNextStep("Creating Heightfield"))
+  if (!BeginNextStep("Creating Heightfield"))
     return EZ_FAILURE;
 
   if (!rcCreateHeightfield(pContext, *heightfield, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch))
@@ -295,18 +587,18 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     return EZ_FAILURE;
   }
 
-  if (!pgRange.BeginNextStep("Mark Walkable Area"))
+  if (!BeginNextStep("Mark Walkable Area"))
     return EZ_FAILURE;
 
   // TODO Instead of this, it should use area IDs and then clear the non-walkable triangles
   rcMarkWalkableTriangles(
-    pContext, cfg.walkableSlopeAngle, pVertices, m_Vertices.GetCount(), pTriangles, m_Triangles.GetCount(), m_TriangleAreaIDs.GetData());
+    pContext, cfg.walkableSlopeAngle, pVertices, vertices.GetCount(), pTriangles, triangles.GetCount(), triangleAreaIDs.GetPtr());
 
-  if (!pgRange.BeginNextStep("Rasterize Triangles"))
+  if (!BeginNextStep("Rasterize Triangles"))
     return EZ_FAILURE;
 
   if (!rcRasterizeTriangles(
-        pContext, pVertices, m_Vertices.GetCount(), pTriangles, m_TriangleAreaIDs.GetData(), m_Triangles.GetCount(), *heightfield, cfg.walkableClimb))
+        pContext, pVertices, vertices.GetCount(), pTriangles, triangleAreaIDs.GetPtr(), triangles.GetCount(), *heightfield, cfg.walkableClimb))
   {
     pContext->log(RC_LOG_ERROR, "Could not rasterize triangles");
     return EZ_FAILURE;
@@ -314,26 +606,26 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
 
   // Optional stuff
   {
-    if (!pgRange.BeginNextStep("Filter Low Hanging Obstacles"))
+    if (!BeginNextStep("Filter Low Hanging Obstacles"))
       return EZ_FAILURE;
 
     // if (m_filterLowHangingObstacles)
     rcFilterLowHangingWalkableObstacles(pContext, cfg.walkableClimb, *heightfield);
 
-    if (!pgRange.BeginNextStep("Filter Ledge Spans"))
+    if (!BeginNextStep("Filter Ledge Spans"))
       return EZ_FAILURE;
 
     // if (m_filterLedgeSpans)
     rcFilterLedgeSpans(pContext, cfg.walkableHeight, cfg.walkableClimb, *heightfield);
 
-    if (!pgRange.BeginNextStep("Filter Low Height Spans"))
+    if (!BeginNextStep("Filter Low Height Spans"))
       return EZ_FAILURE;
 
     // if (m_filterWalkableLowHeightSpans)
     rcFilterWalkableLowHeightSpans(pContext, cfg.walkableHeight, *heightfield);
   }
 
-  if (!pgRange.BeginNextStep("Build Compact Heightfield"))
+  if (!BeginNextStep("Build Compact Heightfield"))
     return EZ_FAILURE;
 
   rcCompactHeightfield* compactHeightfield = rcAllocCompactHeightfield();
@@ -345,7 +637,7 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     return EZ_FAILURE;
   }
 
-  if (!pgRange.BeginNextStep("Erode Walkable Area"))
+  if (!BeginNextStep("Erode Walkable Area"))
     return EZ_FAILURE;
 
   if (!rcErodeWalkableArea(pContext, cfg.walkableRadius, *compactHeightfield))
@@ -368,7 +660,7 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
   {
     // PARTITION_WATERSHED
     {
-      if (!pgRange.BeginNextStep("Build Distance Field"))
+      if (!BeginNextStep("Build Distance Field"))
         return EZ_FAILURE;
 
       // Prepare for region partitioning, by calculating distance field along the walkable surface.
@@ -378,11 +670,12 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
         return EZ_FAILURE;
       }
 
-      if (!pgRange.BeginNextStep("Build Regions"))
+      if (!BeginNextStep("Build Regions"))
         return EZ_FAILURE;
 
       // Partition the walkable surface into simple regions without holes.
-      if (!rcBuildRegions(pContext, *compactHeightfield, 0, cfg.minRegionArea, cfg.mergeRegionArea))
+      // For tiles, the border makes sure that the regions line up with the ones of the neighboring tiles.
+      if (!rcBuildRegions(pContext, *compactHeightfield, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
       {
         pContext->log(RC_LOG_ERROR, "Could not build watershed regions.");
         return EZ_FAILURE;
@@ -411,7 +704,7 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     //}
   }
 
-  if (!pgRange.BeginNextStep("Build Contours"))
+  if (!BeginNextStep("Build Contours"))
     return EZ_FAILURE;
 
   rcContourSet* contourSet = rcAllocContourSet();
@@ -423,7 +716,11 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
     return EZ_FAILURE;
   }
 
-  if (!pgRange.BeginNextStep("Build Poly Mesh"))
+  // nothing walkable, e.g. a tile that only contains walls
+  if (contourSet->nconts == 0)
+    return EZ_SUCCESS;
+
+  if (!BeginNextStep("Build Poly Mesh"))
     return EZ_FAILURE;
 
   if (!rcBuildPolyMesh(pContext, *contourSet, cfg.maxVertsPerPoly, out_PolyMesh))
@@ -435,7 +732,7 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
   //////////////////////////////////////////////////////////////////////////
   // Detour Navmesh
 
-  if (!pgRange.BeginNextStep("Set Area Flags"))
+  if (!BeginNextStep("Set Area Flags"))
     return EZ_FAILURE;
 
   // TODO modify area IDs and flags
@@ -451,7 +748,8 @@ ezResult ezRecastNavMeshBuilder::BuildRecastPolyMesh(const ezRecastConfig& confi
   return EZ_SUCCESS;
 }
 
-ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData)
+ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(
+  const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezInt32 iTileX, ezInt32 iTileY, ezDataBuffer& NavmeshData)
 {
   dtNavMeshCreateParams params;
   ezMemoryUtils::ZeroFill(&params, 1);
@@ -471,6 +769,8 @@ ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(const ezRecastConfig& co
   params.cs = config.m_fCellSize;
   params.ch = config.m_fCellHeight;
   params.buildBvTree = true;
+  params.tileX = iTileX;
+  params.tileY = iTileY;
 
   ezUInt8* navData = nullptr;
   ezInt32 navDataSize = 0;
@@ -490,7 +790,7 @@ ezResult ezRecastNavMeshBuilder::BuildDetourNavMeshData(const ezRecastConfig& co
 
 ezResult ezRecastConfig::Serialize(ezStreamWriter& inout_stream) const
 {
-  inout_stream.WriteVersion(1);
+  inout_stream.WriteVersion(2);
 
   inout_stream << m_fAgentHeight;
   inout_stream << m_fAgentRadius;
@@ -504,13 +804,14 @@ ezResult ezRecastConfig::Serialize(ezStreamWriter& inout_stream) const
   inout_stream << m_fRegionMergeSize;
   inout_stream << m_fDetailMeshSampleDistanceFactor;
   inout_stream << m_fDetailMeshSampleErrorFactor;
+  inout_stream << m_uiTileSize;
 
   return EZ_SUCCESS;
 }
 
 ezResult ezRecastConfig::Deserialize(ezStreamReader& inout_stream)
 {
-  inout_stream.ReadVersion(1);
+  const ezTypeVersion version = inout_stream.ReadVersion(2);
 
   inout_stream >> m_fAgentHeight;
   inout_stream >> m_fAgentRadius;
@@ -525,5 +826,10 @@ ezResult ezRecastConfig::Deserialize(ezStreamReader& inout_stream)
   inout_stream >> m_fDetailMeshSampleDistanceFactor;
   inout_stream >> m_fDetailMeshSampleErrorFactor;
 
+  if (version >= 2)
+  {
+    inout_stream >> m_uiTileSize;
+  }
+
   return EZ_SUCCESS;
 }
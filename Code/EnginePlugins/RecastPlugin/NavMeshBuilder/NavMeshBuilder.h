@@ -8,6 +8,7 @@
 class ezRcBuildContext;
 struct rcPolyMesh;
 struct rcPolyMeshDetail;
+struct rcConfig;
 class ezWorld;
 class dtNavMesh;
 struct ezRecastNavMeshResourceDescriptor;
@@ -30,6 +31,12 @@ struct EZ_RECASTPLUGIN_DLL ezRecastConfig
   float m_fDetailMeshSampleDistanceFactor = 1.0f;
   float m_fDetailMeshSampleErrorFactor = 1.0f;
 
+  /// \brief If not zero, the navmesh is built as a set of square tiles with this many cells per side.
+  ///
+  /// Tiles are built in parallel and only the tiles whose input geometry changed have to be rebuilt, see ezRecastNavMeshBuilder::Build().
+  /// Zero builds a single mesh for the entire world.
+  ezUInt32 m_uiTileSize = 0;
+
   ezResult Serialize(ezStreamWriter& inout_stream) const;
   ezResult Deserialize(ezStreamReader& inout_stream);
 };
@@ -46,17 +53,24 @@ public:
 
   static ezResult ExtractWorldGeometry(const ezWorld& world, ezWorldGeoExtractionUtil::MeshObjectList& out_worldGeo);
 
+  /// \brief Builds the navmesh from the given geometry.
+  ///
+  /// If config.m_uiTileSize is not zero, the navmesh is built from tiles in parallel. If pPreviousNavMesh is given in that case, all tiles
+  /// of it that were built with the same configuration and whose input geometry did not change are taken over instead of being rebuilt.
   ezResult Build(const ezRecastConfig& config, const ezWorldGeoExtractionUtil::MeshObjectList& worldGeo, ezRecastNavMeshResourceDescriptor& out_navMeshDesc,
-    ezProgress& ref_progress);
+    ezProgress& ref_progress, const ezRecastNavMeshResourceDescriptor* pPreviousNavMesh = nullptr);
 
 private:
-  static void FillOutConfig(struct rcConfig& cfg, const ezRecastConfig& config, const ezBoundingBox& bbox);
+  static void FillOutConfig(rcConfig& cfg, const ezRecastConfig& config, const ezBoundingBox& bbox);
+  static ezUInt64 ComputeConfigHash(const ezRecastConfig& config);
 
   void Clear();
   void GenerateTriangleMeshFromDescription(const ezWorldGeoExtractionUtil::MeshObjectList& objects);
   void ComputeBoundingBox();
-  ezResult BuildRecastPolyMesh(const ezRecastConfig& config, rcPolyMesh& out_PolyMesh, ezProgress& progress);
-  static ezResult BuildDetourNavMeshData(const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezDataBuffer& NavmeshData);
+  ezResult BuildTiled(const ezRecastConfig& config, ezRecastNavMeshResourceDescriptor& out_navMeshDesc, ezProgress& ref_progress,
+    const ezRecastNavMeshResourceDescriptor* pPreviousNavMesh);
+  static ezResult BuildDetourNavMeshData(
+    const ezRecastConfig& config, const rcPolyMesh& polyMesh, ezInt32 iTileX, ezInt32 iTileY, ezDataBuffer& NavmeshData);
 
   struct Triangle
   {
@@ -73,6 +87,11 @@ private:
     ezInt32 m_VertexIdx[3];
   };
 
+  /// \brief Rasterizes the triangles into the area described by cfg and builds the polygons for it. Only accesses its parameters, so it can
+  /// be used for multiple tiles in parallel.
+  static ezResult BuildRecastPolyMesh(const rcConfig& cfg, ezRcBuildContext* pContext, ezArrayPtr<const ezVec3> vertices,
+    ezArrayPtr<const Triangle> triangles, ezArrayPtr<ezUInt8> triangleAreaIDs, rcPolyMesh& out_PolyMesh, ezProgress* pProgress);
+
   ezBoundingBox m_BoundingBox;
   ezDynamicArray<ezVec3> m_Vertices;
   ezDynamicArray<Triangle> m_Triangles;
@@ -29,33 +29,81 @@ ezRecastNavMeshResourceDescriptor::~ezRecastNavMeshResourceDescriptor()
 
 void ezRecastNavMeshResourceDescriptor::operator=(ezRecastNavMeshResourceDescriptor&& rhs)
 {
+  Clear();
+
   m_DetourNavmeshData = std::move(rhs.m_DetourNavmeshData);
 
   m_pNavMeshPolygons = rhs.m_pNavMeshPolygons;
   rhs.m_pNavMeshPolygons = nullptr;
+
+  m_Tiles = std::move(rhs.m_Tiles);
+  m_fTileWorldSize = rhs.m_fTileWorldSize;
+  m_uiMaxPolysPerTile = rhs.m_uiMaxPolysPerTile;
+  m_uiTileConfigHash = rhs.m_uiTileConfigHash;
 }
 
 void ezRecastNavMeshResourceDescriptor::Clear()
 {
   m_DetourNavmeshData.Clear();
   EZ_DEFAULT_DELETE(m_pNavMeshPolygons);
+
+  for (Tile& tile : m_Tiles)
+  {
+    EZ_DEFAULT_DELETE(tile.m_pPolygons);
+  }
+
+  m_Tiles.Clear();
+  m_fTileWorldSize = 0.0f;
+  m_uiMaxPolysPerTile = 0;
+  m_uiTileConfigHash = 0;
+}
+
+rcPolyMesh* ezRecastNavMeshResourceDescriptor::ClonePolyMesh(const rcPolyMesh& mesh)
+{
+  rcPolyMesh* pClone = EZ_DEFAULT_NEW(rcPolyMesh);
+  rcPolyMesh& clone = *pClone;
+
+  clone.nverts = mesh.nverts;
+  clone.npolys = mesh.npolys;
+  clone.maxpolys = mesh.maxpolys;
+  clone.nvp = mesh.nvp;
+  rcVcopy(clone.bmin, mesh.bmin);
+  rcVcopy(clone.bmax, mesh.bmax);
+  clone.cs = mesh.cs;
+  clone.ch = mesh.ch;
+  clone.borderSize = mesh.borderSize;
+  clone.maxEdgeError = mesh.maxEdgeError;
+
+  clone.verts = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.nverts * 3, RC_ALLOC_PERM);
+  clone.polys = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys * mesh.nvp * 2, RC_ALLOC_PERM);
+  clone.regs = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys, RC_ALLOC_PERM);
+  clone.flags = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys, RC_ALLOC_PERM);
+  clone.areas = (ezUInt8*)rcAlloc(sizeof(ezUInt8) * mesh.maxpolys, RC_ALLOC_PERM);
+
+  ezMemoryUtils::Copy(clone.verts, mesh.verts, mesh.nverts * 3);
+  ezMemoryUtils::Copy(clone.polys, mesh.polys, mesh.maxpolys * mesh.nvp * 2);
+  ezMemoryUtils::Copy(clone.regs, mesh.regs, mesh.maxpolys);
+  ezMemoryUtils::Copy(clone.flags, mesh.flags, mesh.maxpolys);
+  ezMemoryUtils::Copy(clone.areas, mesh.areas, mesh.maxpolys);
+
+  return pClone;
 }
 
 //////////////////////////////////////////////////////////////////////////
 
-ezResult ezRecastNavMeshResourceDescriptor::Serialize(ezStreamWriter& inout_stream) const
+namespace
 {
-  inout_stream.WriteVersion(1);
-  EZ_SUCCEED_OR_RETURN(inout_stream.WriteArray(m_DetourNavmeshData));
+  ezResult WritePolyMesh(ezStreamWriter& inout_stream, const rcPolyMesh* pMesh)
+  {
+    const bool hasPolygons = pMesh != nullptr;
+    inout_stream << hasPolygons;
 
-  const bool hasPolygons = m_pNavMeshPolygons != nullptr;
-  inout_stream << hasPolygons;
+    if (!hasPolygons)
+      return EZ_SUCCESS;
 
-  if (hasPolygons)
-  {
     EZ_CHECK_AT_COMPILETIME_MSG(sizeof(rcPolyMesh) == sizeof(void*) * 5 + sizeof(int) * 14, "rcPolyMesh data structure has changed");
 
-    const auto& mesh = *m_pNavMeshPolygons;
+    const auto& mesh = *pMesh;
 
     inout_stream << (int)mesh.nverts;
     inout_stream << (int)mesh.npolys;
@@ -79,29 +127,23 @@ ezResult ezRecastNavMeshResourceDescriptor::Serialize(ezStreamWriter& inout_stre
     EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(mesh.regs, sizeof(ezUInt16) * mesh.npolys));
     EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(mesh.flags, sizeof(ezUInt16) * mesh.npolys));
     EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(mesh.areas, sizeof(ezUInt8) * mesh.npolys));
-  }
-
-  return EZ_SUCCESS;
-}
 
-ezResult ezRecastNavMeshResourceDescriptor::Deserialize(ezStreamReader& inout_stream)
-{
-  Clear();
+    return EZ_SUCCESS;
+  }
 
-  const ezTypeVersion version = inout_stream.ReadVersion(1);
-  EZ_IGNORE_UNUSED(version);
-  EZ_SUCCEED_OR_RETURN(inout_stream.ReadArray(m_DetourNavmeshData));
+  ezResult ReadPolyMesh(ezStreamReader& inout_stream, rcPolyMesh*& out_pMesh)
+  {
+    bool hasPolygons = false;
+    inout_stream >> hasPolygons;
 
-  bool hasPolygons = false;
-  inout_stream >> hasPolygons;
+    if (!hasPolygons)
+      return EZ_SUCCESS;
 
-  if (hasPolygons)
-  {
     EZ_CHECK_AT_COMPILETIME_MSG(sizeof(rcPolyMesh) == sizeof(void*) * 5 + sizeof(int) * 14, "rcPolyMesh data structure has changed");
 
-    m_pNavMeshPolygons = EZ_DEFAULT_NEW(rcPolyMesh);
+    out_pMesh = EZ_DEFAULT_NEW(rcPolyMesh);
 
-    auto& mesh = *m_pNavMeshPolygons;
+    auto& mesh = *out_pMesh;
 
     inout_stream >> mesh.nverts;
     inout_stream >> mesh.npolys;
@@ -123,6 +165,7 @@ ezResult ezRecastNavMeshResourceDescriptor::Deserialize(ezStreamReader& inout_st
     mesh.verts = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.nverts * 3, RC_ALLOC_PERM);
     mesh.polys = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys * mesh.nvp * 2, RC_ALLOC_PERM);
     mesh.regs = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys, RC_ALLOC_PERM);
+    mesh.flags = (ezUInt16*)rcAlloc(sizeof(ezUInt16) * mesh.maxpolys, RC_ALLOC_PERM);
     mesh.areas = (ezUInt8*)rcAlloc(sizeof(ezUInt8) * mesh.maxpolys, RC_ALLOC_PERM);
 
     inout_stream.ReadBytes(mesh.verts, sizeof(ezUInt16) * mesh.nverts * 3);
@@ -130,6 +173,60 @@ ezResult ezRecastNavMeshResourceDescriptor::Deserialize(ezStreamReader& inout_st
     inout_stream.ReadBytes(mesh.regs, sizeof(ezUInt16) * mesh.maxpolys);
     inout_stream.ReadBytes(mesh.flags, sizeof(ezUInt16) * mesh.maxpolys);
     inout_stream.ReadBytes(mesh.areas, sizeof(ezUInt8) * mesh.maxpolys);
+
+    return EZ_SUCCESS;
+  }
+} // namespace
+
+ezResult ezRecastNavMeshResourceDescriptor::Serialize(ezStreamWriter& inout_stream) const
+{
+  inout_stream.WriteVersion(2);
+  EZ_SUCCEED_OR_RETURN(inout_stream.WriteArray(m_DetourNavmeshData));
+  EZ_SUCCEED_OR_RETURN(WritePolyMesh(inout_stream, m_pNavMeshPolygons));
+
+  inout_stream << m_Tiles.GetCount();
+  inout_stream << m_fTileWorldSize;
+  inout_stream << m_uiMaxPolysPerTile;
+  inout_stream << m_uiTileConfigHash;
+
+  for (const Tile& tile : m_Tiles)
+  {
+    inout_stream << tile.m_iX;
+    inout_stream << tile.m_iY;
+    inout_stream << tile.m_uiInputHash;
+    EZ_SUCCEED_OR_RETURN(inout_stream.WriteArray(tile.m_DetourTileData));
+    EZ_SUCCEED_OR_RETURN(WritePolyMesh(inout_stream, tile.m_pPolygons));
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRecastNavMeshResourceDescriptor::Deserialize(ezStreamReader& inout_stream)
+{
+  Clear();
+
+  const ezTypeVersion version = inout_stream.ReadVersion(2);
+  EZ_SUCCEED_OR_RETURN(inout_stream.ReadArray(m_DetourNavmeshData));
+  EZ_SUCCEED_OR_RETURN(ReadPolyMesh(inout_stream, m_pNavMeshPolygons));
+
+  if (version >= 2)
+  {
+    ezUInt32 uiNumTiles = 0;
+    inout_stream >> uiNumTiles;
+    inout_stream >> m_fTileWorldSize;
+    inout_stream >> m_uiMaxPolysPerTile;
+    inout_stream >> m_uiTileConfigHash;
+
+    m_Tiles.SetCount(uiNumTiles);
+
+    for (Tile& tile : m_Tiles)
+    {
+      inout_stream >> tile.m_iX;
+      inout_stream >> tile.m_iY;
+      inout_stream >> tile.m_uiInputHash;
+      EZ_SUCCEED_OR_RETURN(inout_stream.ReadArray(tile.m_DetourTileData));
+      EZ_SUCCEED_OR_RETURN(ReadPolyMesh(inout_stream, tile.m_pPolygons));
+    }
   }
 
   return EZ_SUCCESS;
@@ -156,8 +253,9 @@ ezResourceLoadDesc ezRecastNavMeshResource::UnloadData(Unload WhatToUnload)
   res.m_uiQualityLevelsLoadable = 0;
   res.m_State = ezResourceState::Unloaded;
 
-  m_DetourNavmeshData.Clear();
   EZ_DEFAULT_DELETE(m_pNavMesh);
+  m_DetourNavmeshData.Clear();
+  m_DetourTileData.Clear();
   EZ_DEFAULT_DELETE(m_pNavMeshPolygons);
 
   return res;
@@ -196,6 +294,11 @@ void ezRecastNavMeshResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage)
 {
   out_NewMemoryUsage.m_uiMemoryCPU = sizeof(ezRecastNavMeshResource);
   out_NewMemoryUsage.m_uiMemoryCPU += m_DetourNavmeshData.GetHeapMemoryUsage();
+  out_NewMemoryUsage.m_uiMemoryCPU += m_DetourTileData.GetHeapMemoryUsage();
+  for (const ezDataBuffer& tileData : m_DetourTileData)
+  {
+    out_NewMemoryUsage.m_uiMemoryCPU += tileData.GetHeapMemoryUsage();
+  }
   out_NewMemoryUsage.m_uiMemoryCPU += m_pNavMesh != nullptr ? sizeof(dtNavMesh) : 0;
   out_NewMemoryUsage.m_uiMemoryCPU += m_pNavMeshPolygons != nullptr ? sizeof(rcPolyMesh) : 0;
   out_NewMemoryUsage.m_uiMemoryGPU = 0;
@@ -221,6 +324,47 @@ ezResourceLoadDesc ezRecastNavMeshResource::CreateResource(ezRecastNavMeshResour
     const int dtMeshFlags = 0;
     m_pNavMesh->init(m_DetourNavmeshData.GetData(), m_DetourNavmeshData.GetCount(), dtMeshFlags);
   }
+  else if (!descriptor.m_Tiles.IsEmpty())
+  {
+    // empty tiles are only stored to not rebuild them
+    m_DetourTileData.Reserve(descriptor.m_Tiles.GetCount());
+    for (auto& tile : descriptor.m_Tiles)
+    {
+      if (!tile.m_DetourTileData.IsEmpty())
+      {
+        m_DetourTileData.PushBack(std::move(tile.m_DetourTileData));
+      }
+    }
+
+    // the tiles are placed on a global grid, see ezRecastNavMeshBuilder
+    dtNavMeshParams params;
+    ezMemoryUtils::ZeroFill(&params, 1);
+    params.tileWidth = descriptor.m_fTileWorldSize;
+    params.tileHeight = descriptor.m_fTileWorldSize;
+    params.maxTiles = ezMath::PowerOfTwo_Ceil(ezMath::Max(1u, m_DetourTileData.GetCount()));
+    params.maxPolys = descriptor.m_uiMaxPolysPerTile;
+
+    m_pNavMesh = EZ_DEFAULT_NEW(dtNavMesh);
+
+    if (dtStatusFailed(m_pNavMesh->init(&params)))
+    {
+      ezLog::Error("Failed to initialize tiled navmesh with {0} tiles and {1} polygons per tile", params.maxTiles, params.maxPolys);
+      EZ_DEFAULT_DELETE(m_pNavMesh);
+      m_DetourTileData.Clear();
+    }
+    else
+    {
+      for (ezDataBuffer& tileData : m_DetourTileData)
+      {
+        // the dtNavMesh does not need to free the data, the resource owns it
+        const int dtTileFlags = 0;
+        if (dtStatusFailed(m_pNavMesh->addTile(tileData.GetData(), tileData.GetCount(), dtTileFlags, 0, nullptr)))
+        {
+          ezLog::Error("Failed to add navmesh tile");
+        }
+      }
+    }
+  }
 
   return res;
 }
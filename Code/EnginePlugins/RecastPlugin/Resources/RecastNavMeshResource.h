@@ -23,6 +23,39 @@ struct EZ_RECASTPLUGIN_DLL ezRecastNavMeshResourceDescriptor
   /// \brief Optional, if available the navmesh can be visualized at runtime
   rcPolyMesh* m_pNavMeshPolygons = nullptr;
 
+  /// \brief One tile of a tiled navmesh, see ezRecastConfig::m_uiTileSize.
+  struct Tile
+  {
+    ezInt32 m_iX = 0;
+    ezInt32 m_iY = 0;
+
+    /// \brief Hash of the geometry that the tile was built from, used to decide whether it has to be rebuilt.
+    ezUInt64 m_uiInputHash = 0;
+
+    /// \brief Data that was created by dtCreateNavMeshData() and will be used for dtNavMesh::addTile(). Empty if nothing in the tile is walkable.
+    ezDataBuffer m_DetourTileData;
+
+    /// \brief The polygons of the tile, needed to merge them into m_pNavMeshPolygons again when other tiles get rebuilt.
+    rcPolyMesh* m_pPolygons = nullptr;
+  };
+
+  /// \brief If not empty, the navmesh consists of these tiles and m_DetourNavmeshData is empty.
+  ezDynamicArray<Tile> m_Tiles;
+
+  /// \brief Size of a tile in world units (along the ground plane).
+  float m_fTileWorldSize = 0.0f;
+
+  /// \brief Power of two that is large enough for the number of polygons in every tile.
+  ezUInt32 m_uiMaxPolysPerTile = 0;
+
+  /// \brief Hash of the ezRecastConfig that the tiles were built with.
+  ezUInt64 m_uiTileConfigHash = 0;
+
+  static ezUInt64 GetTileKey(ezInt32 iX, ezInt32 iY) { return (static_cast<ezUInt64>(static_cast<ezUInt32>(iX)) << 32) | static_cast<ezUInt32>(iY); }
+
+  /// \brief Creates a deep copy of the given polygons, to be freed with EZ_DEFAULT_DELETE.
+  static rcPolyMesh* ClonePolyMesh(const rcPolyMesh& mesh);
+
   void Clear();
 
   ezResult Serialize(ezStreamWriter& inout_stream) const;
@@ -48,6 +81,7 @@ private:
   virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override;
 
   ezDataBuffer m_DetourNavmeshData;
+  ezDynamicArray<ezDataBuffer> m_DetourTileData;
   dtNavMesh* m_pNavMesh = nullptr;
   rcPolyMesh* m_pNavMeshPolygons = nullptr;
 };
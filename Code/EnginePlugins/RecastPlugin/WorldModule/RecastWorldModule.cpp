@@ -59,7 +59,8 @@ void ezRecastWorldModule::UpdateNavMesh(const UpdateContext& ctxt)
 
     m_pDetourNavMesh = pNavMesh->GetNavMesh();
 
-    if (m_pDetourNavMesh)
+    // the polygons are missing when a tiled navmesh had too many vertices to merge them
+    if (m_pDetourNavMesh && pNavMesh->GetNavMeshPolygons() != nullptr)
     {
       m_pNavMeshPointsOfInterest = EZ_DEFAULT_NEW(ezNavMeshPointOfInterestGraph);
       m_pNavMeshPointsOfInterest->ExtractInterestPointsFromMesh(*pNavMesh->GetNavMeshPolygons());
@@ -1,12 +1,15 @@
 #include <VisualScriptPlugin/VisualScriptPluginPCH.h>
 
 #include <Core/Scripting/ScriptWorldModule.h>
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/IO/StringDeduplicationContext.h>
 #include <VisualScriptPlugin/Runtime/VisualScriptInstance.h>
 #include <VisualScriptPlugin/Runtime/VisualScriptNodeUserData.h>
 
 ezVisualScriptGraphDescription::ExecuteFunction GetExecuteFunction(ezVisualScriptNodeDescription::Type::Enum nodeType, ezVisualScriptDataType::Enum dataType);
 
+ezCVarBool cvar_VisualScriptUseBytecode("VisualScript.UseBytecode", true, ezCVarFlags::Default, "Execute visual scripts through their compiled instructions instead of walking the node graph.");
+
 namespace
 {
   static const char* s_NodeDescTypeNames[] = {
@@ -207,6 +210,8 @@ ezResult ezVisualScriptGraphDescription::Deserialize(ezStreamReader& inout_strea
 
   m_Nodes = nodes;
 
+  CompileInstructions();
+
   ezSharedPtr<ezVisualScriptDataDescription> pLocalDataDesc = EZ_DEFAULT_NEW(ezVisualScriptDataDescription);
   EZ_SUCCEED_OR_RETURN(pLocalDataDesc->Deserialize(inout_stream));
   m_pLocalDataDesc = pLocalDataDesc;
@@ -243,6 +248,8 @@ void ezVisualScriptExecutionContext::Initialize(ezVisualScriptInstance& inout_in
   }
 
   m_uiCurrentNode = pNode->GetExecutionIndex(0);
+  m_uiCurrentInstruction = m_pDesc->GetEntryInstruction();
+  m_bUseInstructions = cvar_VisualScriptUseBytecode;
 }
 
 void ezVisualScriptExecutionContext::Deinitialize()
@@ -262,6 +269,11 @@ ezVisualScriptExecutionContext::ExecResult ezVisualScriptExecutionContext::Execu
   ++m_uiExecutionCounter;
   m_DeltaTimeSinceLastExecution = deltaTimeSinceLastExecution;
 
+  return m_bUseInstructions ? ExecuteInstructions() : ExecuteNodes();
+}
+
+ezVisualScriptExecutionContext::ExecResult ezVisualScriptExecutionContext::ExecuteNodes()
+{
   auto pNode = m_pDesc->GetNode(m_uiCurrentNode);
   while (pNode != nullptr)
   {
@@ -279,3 +291,56 @@ ezVisualScriptExecutionContext::ExecResult ezVisualScriptExecutionContext::Execu
 
   return ExecResult::RunNext(0);
 }
+
+ezVisualScriptExecutionContext::ExecResult ezVisualScriptExecutionContext::ExecuteInstructions()
+{
+  using Instruction = ezVisualScriptGraphDescription::Instruction;
+
+  // the storages are not reallocated during execution, so operations can address their data slots relative to these
+  ezUInt8* pData[DataOffset::Source::Count];
+  for (ezUInt32 i = 0; i < DataOffset::Source::Count; ++i)
+  {
+    pData[i] = m_DataStorage[i] != nullptr ? m_DataStorage[i]->GetRawData() : nullptr;
+  }
+
+  const ezArrayPtr<const Instruction> instructions = m_pDesc->GetInstructions();
+
+  ezUInt32 uiCurrentInstruction = m_uiCurrentInstruction;
+  while (uiCurrentInstruction < instructions.GetCount())
+  {
+    const Instruction& instruction = instructions.GetPtr()[uiCurrentInstruction];
+
+    switch (instruction.m_OpCode)
+    {
+      case Instruction::OpCode::Operation:
+        instruction.m_Operation(instruction, pData);
+        uiCurrentInstruction = instruction.m_uiNext[0];
+        break;
+
+      case Instruction::OpCode::OperationAndBranch:
+        uiCurrentInstruction = instruction.m_uiNext[instruction.m_Operation(instruction, pData) ? 0 : 1];
+        break;
+
+      case Instruction::OpCode::Call:
+      {
+        m_uiCurrentInstruction = uiCurrentInstruction;
+
+        const ezVisualScriptGraphDescription::Node& node = *instruction.m_pNode;
+        ExecResult result = node.m_Function(*this, node);
+        if (result.m_NextExecAndState < ExecResult::State::Completed)
+        {
+          return result;
+        }
+
+        uiCurrentInstruction = m_pDesc->GetNextInstruction(instruction, result.m_NextExecAndState);
+        m_pCurrentCoroutine = nullptr;
+      }
+      break;
+
+        EZ_DEFAULT_CASE_NOT_IMPLEMENTED;
+    }
+  }
+
+  m_uiCurrentInstruction = uiCurrentInstruction;
+  return ExecResult::RunNext(0);
+}
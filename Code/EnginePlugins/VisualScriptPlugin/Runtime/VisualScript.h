@@ -183,14 +183,53 @@ public:
 
   const Node* GetNode(ezUInt32 uiIndex) const;
 
+  struct Instruction;
+  using OperationFunction = bool (*)(const Instruction& instruction, ezUInt8* const* pData);
+
+  /// \brief A node lowered into the linear instruction stream that is used for execution.
+  ///
+  /// Builtin nodes that work on numbers are executed as operations that access their data slots directly.
+  /// A comparison or logic operation that is directly followed by a branch on its result is fused into one instruction.
+  /// All other nodes are called through their execute function.
+  struct Instruction
+  {
+    struct OpCode
+    {
+      enum Enum : ezUInt8
+      {
+        Call,
+        Operation,
+        OperationAndBranch,
+      };
+    };
+
+    const Node* m_pNode = nullptr;
+    OperationFunction m_Operation = nullptr;
+    ezUInt32 m_uiNext[2] = {ezInvalidIndex, ezInvalidIndex};
+    DataOffset m_Inputs[2];
+    DataOffset m_Output;
+    OpCode::Enum m_OpCode = OpCode::Call;
+  };
+
+  ezArrayPtr<const Instruction> GetInstructions() const;
+  ezUInt32 GetEntryInstruction() const;
+  ezUInt32 GetNextInstruction(const Instruction& instruction, ezUInt32 uiExecSlot) const;
+
   bool IsCoroutine() const;
 
   const ezSharedPtr<const ezVisualScriptDataDescription>& GetLocalDataDesc() const;
 
 private:
+  void CompileInstructions();
+  ezUInt32 GetInstructionIndex(ezUInt32 uiNodeIndex) const;
+
   ezArrayPtr<const Node> m_Nodes;
   ezBlob m_Storage;
 
+  ezDynamicArray<Instruction> m_Instructions;
+  ezDynamicArray<ezUInt32> m_NodeToInstruction;
+  ezUInt32 m_uiEntryInstruction = ezInvalidIndex;
+
   ezSharedPtr<const ezVisualScriptDataDescription> m_pLocalDataDesc;
 };
 
@@ -235,9 +274,14 @@ public:
   ezTime GetDeltaTimeSinceLastExecution();
 
 private:
+  ExecResult ExecuteNodes();
+  ExecResult ExecuteInstructions();
+
   ezSharedPtr<const ezVisualScriptGraphDescription> m_pDesc;
   ezVisualScriptInstance* m_pInstance = nullptr;
   ezUInt32 m_uiCurrentNode = 0;
+  ezUInt32 m_uiCurrentInstruction = 0;
+  bool m_bUseInstructions = true;
   ezUInt32 m_uiExecutionCounter = 0;
   ezTime m_DeltaTimeSinceLastExecution;
 
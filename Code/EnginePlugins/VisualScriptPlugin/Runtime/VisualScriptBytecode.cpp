@@ -0,0 +1,425 @@
+#include <VisualScriptPlugin/VisualScriptPluginPCH.h>
+
+#include <VisualScriptPlugin/Runtime/VisualScriptNodeUserData.h>
+
+using Instruction = ezVisualScriptGraphDescription::Instruction;
+using OperationFunction = ezVisualScriptGraphDescription::OperationFunction;
+using OperationGetter = OperationFunction (*)(ezVisualScriptDataType::Enum dataType);
+using DataOffset = ezVisualScriptDataDescription::DataOffset;
+
+#define MAKE_OPERATION_GETTER(funcName, boolFunc)                                                                     \
+  OperationFunction EZ_CONCAT(funcName, _Getter)(ezVisualScriptDataType::Enum dataType)                               \
+  {                                                                                                                   \
+    static OperationFunction functionTable[] = {                                                                      \
+      boolFunc,                                                                                                       \
+      &funcName<ezUInt8>,                                                                                             \
+      &funcName<ezInt32>,                                                                                             \
+      &funcName<ezInt64>,                                                                                             \
+      &funcName<float>,                                                                                               \
+      &funcName<double>,                                                                                              \
+    };                                                                                                                \
+                                                                                                                      \
+    static_assert(EZ_ARRAY_SIZE(functionTable) == ezVisualScriptDataType::Double - ezVisualScriptDataType::Bool + 1); \
+    if (ezVisualScriptDataType::IsNumber(dataType))                                                                   \
+      return functionTable[dataType - ezVisualScriptDataType::Bool];                                                  \
+                                                                                                                      \
+    return nullptr;                                                                                                   \
+  }
+
+namespace
+{
+  template <typename T>
+  EZ_ALWAYS_INLINE static const T& Read(ezUInt8* const* pData, DataOffset dataOffset)
+  {
+    return *reinterpret_cast<const T*>(pData[dataOffset.m_uiSource] + dataOffset.m_uiByteOffset);
+  }
+
+  template <typename T>
+  EZ_ALWAYS_INLINE static void Write(ezUInt8* const* pData, DataOffset dataOffset, const T& value)
+  {
+    *reinterpret_cast<T*>(pData[dataOffset.m_uiSource] + dataOffset.m_uiByteOffset) = value;
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+
+  static bool Operation_Branch(const Instruction& instruction, ezUInt8* const* pData)
+  {
+    return Read<bool>(pData, instruction.m_Inputs[0]);
+  }
+
+  static bool Operation_And(const Instruction& instruction, ezUInt8* const* pData)
+  {
+    const bool bRes = Read<bool>(pData, instruction.m_Inputs[0]) && Read<bool>(pData, instruction.m_Inputs[1]);
+    Write(pData, instruction.m_Output, bRes);
+    return bRes;
+  }
+
+  static bool Operation_Or(const Instruction& instruction, ezUInt8* const* pData)
+  {
+    const bool bRes = Read<bool>(pData, instruction.m_Inputs[0]) || Read<bool>(pData, instruction.m_Inputs[1]);
+    Write(pData, instruction.m_Output, bRes);
+    return bRes;
+  }
+
+  static bool Operation_Not(const Instruction& instruction, ezUInt8* const* pData)
+  {
+    const bool bRes = !Read<bool>(pData, instruction.m_Inputs[0]);
+    Write(pData, instruction.m_Output, bRes);
+    return bRes;
+  }
+
+  // the comparison operator is a template argument, so the operation doesn't have to switch on it for every execution
+  template <typename T, ezComparisonOperator::Enum ComparisonOperator>
+  static bool Operation_Compare(const Instruction& instruction, ezUInt8* const* pData)
+  {
+    const T& a = Read<T>(pData, instruction.m_Inputs[0]);
+    const T& b = Read<T>(pData, instruction.m_Inputs[1]);
+    const bool bRes = ezComparisonOperator::Compare(ComparisonOperator, a, b);
+    Write(pData, instruction.m_Output, bRes);
+    return bRes;
+  }
+
+  template <typename T>
+  static OperationFunction GetCompareOperation(ezComparisonOperator::Enum comparisonOperator)
+  {
+    static OperationFunction functionTable[] = {
+      &Operation_Compare<T, ezComparisonOperator::Equal>,
+      &Operation_Compare<T, ezComparisonOperator::NotEqual>,
+      &Operation_Compare<T, ezComparisonOperator::Less>,
+      &Operation_Compare<T, ezComparisonOperator::LessEqual>,
+      &Operation_Compare<T, ezComparisonOperator::Greater>,
+      &Operation_Compare<T, ezComparisonOperator::GreaterEqual>,
+    };
+
+    static_assert(EZ_ARRAY_SIZE(functionTable) == ezComparisonOperator::GreaterEqual + 1);
+    if (comparisonOperator >= 0 && comparisonOperator < EZ_ARRAY_SIZE(functionTable))
+      return functionTable[comparisonOperator];
+
+    return nullptr;
+  }
+
+  static OperationFunction GetCompareOperation(ezVisualScriptDataType::Enum dataType, ezComparisonOperator::Enum comparisonOperator)
+  {
+    switch (dataType)
+    {
+      case ezVisualScriptDataType::Bool:
+        return GetCompareOperation<bool>(comparisonOperator);
+      case ezVisualScriptDataType::Byte:
+        return GetCompareOperation<ezUInt8>(comparisonOperator);
+      case ezVisualScriptDataType::Int:
+        return GetCompareOperation<ezInt32>(comparisonOperator);
+      case ezVisualScriptDataType::Int64:
+        return GetCompareOperation<ezInt64>(comparisonOperator);
+      case ezVisualScriptDataType::Float:
+        return GetCompareOperation<float>(comparisonOperator);
+      case ezVisualScriptDataType::Double:
+        return GetCompareOperation<double>(comparisonOperator);
+      default:
+        return nullptr;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+
+  template <typename T>
+  static bool Operation_Add(const Instruction& instruction, ezUInt8* const* pData)
+  {
+    Write(pData, instruction.m_Output, T(Read<T>(pData, instruction.m_Inputs[0]) + Read<T>(pData, instruction.m_Inputs[1])));
+    return true;
+  }
+
+  template <typename T>
+  static bool Operation_Sub(const Instruction& instruction, ezUInt8* const* pData)
+  {
+    Write(pData, instruction.m_Output, T(Read<T>(pData, instruction.m_Inputs[0]) - Read<T>(pData, instruction.m_Inputs[1])));
+    return true;
+  }
+
+  template <typename T>
+  static bool Operation_Mul(const Instruction& instruction, ezUInt8* const* pData)
+  {
+    Write(pData, instruction.m_Output, T(Read<T>(pData, instruction.m_Inputs[0]) * Read<T>(pData, instruction.m_Inputs[1])));
+    return true;
+  }
+
+  template <typename T>
+  static bool Operation_Div(const Instruction& instruction, ezUInt8* const* pData)
+  {
+    Write(pData, instruction.m_Output, T(Read<T>(pData, instruction.m_Inputs[0]) / Read<T>(pData, instruction.m_Inputs[1])));
+    return true;
+  }
+
+  // arithmetic is not defined for bool, these nodes keep using their execute function which reports the error
+  MAKE_OPERATION_GETTER(Operation_Add, nullptr);
+  MAKE_OPERATION_GETTER(Operation_Sub, nullptr);
+  MAKE_OPERATION_GETTER(Operation_Mul, nullptr);
+  MAKE_OPERATION_GETTER(Operation_Div, nullptr);
+
+  //////////////////////////////////////////////////////////////////////////
+
+  template <typename T>
+  static bool Operation_ToBool(const Instruction& instruction, ezUInt8* const* pData)
+  {
+    bool bRes = false;
+    if constexpr (std::is_same<T, bool>::value)
+    {
+      bRes = Read<T>(pData, instruction.m_Inputs[0]);
+    }
+    else
+    {
+      bRes = Read<T>(pData, instruction.m_Inputs[0]) != 0;
+    }
+
+    Write(pData, instruction.m_Output, bRes);
+    return bRes;
+  }
+
+  MAKE_OPERATION_GETTER(Operation_ToBool, &Operation_ToBool<bool>);
+
+  template <typename NumberType, typename T>
+  EZ_FORCE_INLINE static bool Operation_ToNumber(const Instruction& instruction, ezUInt8* const* pData)
+  {
+    NumberType res = 0;
+    if constexpr (std::is_same<T, bool>::value)
+    {
+      res = Read<T>(pData, instruction.m_Inputs[0]) ? 1 : 0;
+    }
+    else
+    {
+      res = static_cast<NumberType>(Read<T>(pData, instruction.m_Inputs[0]));
+    }
+
+    Write(pData, instruction.m_Output, res);
+    return true;
+  }
+
+#define MAKE_TONUMBER_OPERATION(NumberType, Name)                                                  \
+  template <typename T>                                                                            \
+  static bool EZ_CONCAT(Operation_To, Name)(const Instruction& instruction, ezUInt8* const* pData) \
+  {                                                                                                \
+    return Operation_ToNumber<NumberType, T>(instruction, pData);                                  \
+  }                                                                                                \
+                                                                                                   \
+  MAKE_OPERATION_GETTER(EZ_CONCAT(Operation_To, Name), &EZ_CONCAT(Operation_To, Name)<bool>)
+
+  MAKE_TONUMBER_OPERATION(ezUInt8, Byte);
+  MAKE_TONUMBER_OPERATION(ezInt32, Int);
+  MAKE_TONUMBER_OPERATION(ezInt64, Int64);
+  MAKE_TONUMBER_OPERATION(float, Float);
+  MAKE_TONUMBER_OPERATION(double, Double);
+
+  //////////////////////////////////////////////////////////////////////////
+
+  struct OperationContext
+  {
+    OperationFunction m_Func = nullptr;
+    OperationGetter m_FuncGetter = nullptr;
+    ezUInt8 m_uiNumInputs = 0;
+    ezVisualScriptDataType::Enum m_InputType = ezVisualScriptDataType::Invalid;  ///< Invalid means the deducted data type of the node
+    ezVisualScriptDataType::Enum m_OutputType = ezVisualScriptDataType::Invalid; ///< Invalid means the deducted data type of the node
+    bool m_bHasOutput = true;
+    bool m_bIsCondition = false; ///< Whether the result of the operation can directly drive a branch
+  };
+
+  static OperationContext GetOperationContext(ezVisualScriptNodeDescription::Type::Enum nodeType)
+  {
+    using Type = ezVisualScriptNodeDescription::Type;
+    using DataType = ezVisualScriptDataType;
+
+    switch (nodeType)
+    {
+      case Type::Builtin_Branch:
+        return {&Operation_Branch, nullptr, 1, DataType::Bool, DataType::Invalid, false, true};
+      case Type::Builtin_And:
+        return {&Operation_And, nullptr, 2, DataType::Bool, DataType::Bool, true, true};
+      case Type::Builtin_Or:
+        return {&Operation_Or, nullptr, 2, DataType::Bool, DataType::Bool, true, true};
+      case Type::Builtin_Not:
+        return {&Operation_Not, nullptr, 1, DataType::Bool, DataType::Bool, true, true};
+      case Type::Builtin_Compare:
+        // the operation depends on the comparison operator, see SetupOperation
+        return {nullptr, nullptr, 2, DataType::Invalid, DataType::Bool, true, true};
+
+      case Type::Builtin_Add:
+        return {nullptr, &Operation_Add_Getter, 2};
+      case Type::Builtin_Subtract:
+        return {nullptr, &Operation_Sub_Getter, 2};
+      case Type::Builtin_Multiply:
+        return {nullptr, &Operation_Mul_Getter, 2};
+      case Type::Builtin_Divide:
+        return {nullptr, &Operation_Div_Getter, 2};
+
+      case Type::Builtin_ToBool:
+        return {nullptr, &Operation_ToBool_Getter, 1, DataType::Invalid, DataType::Bool, true, true};
+      case Type::Builtin_ToByte:
+        return {nullptr, &Operation_ToByte_Getter, 1, DataType::Invalid, DataType::Byte};
+      case Type::Builtin_ToInt:
+        return {nullptr, &Operation_ToInt_Getter, 1, DataType::Invalid, DataType::Int};
+      case Type::Builtin_ToInt64:
+        return {nullptr, &Operation_ToInt64_Getter, 1, DataType::Invalid, DataType::Int64};
+      case Type::Builtin_ToFloat:
+        return {nullptr, &Operation_ToFloat_Getter, 1, DataType::Invalid, DataType::Float};
+      case Type::Builtin_ToDouble:
+        return {nullptr, &Operation_ToDouble_Getter, 1, DataType::Invalid, DataType::Double};
+
+      default:
+        return {};
+    }
+  }
+
+  /// Fills in the operation for the given node. Returns false if the node has to be called through its execute function instead,
+  /// e.g. because it works on non-number data or has unconnected data pins.
+  static bool SetupOperation(const ezVisualScriptGraphDescription::Node& node, Instruction& out_instruction, bool& out_bIsCondition)
+  {
+    const OperationContext context = GetOperationContext(node.m_Type);
+    const ezVisualScriptDataType::Enum dataType = node.m_DeductedDataType;
+
+    OperationFunction func = context.m_Func;
+    if (func == nullptr && context.m_FuncGetter != nullptr)
+    {
+      func = context.m_FuncGetter(dataType);
+    }
+    else if (node.m_Type == ezVisualScriptNodeDescription::Type::Builtin_Compare)
+    {
+      func = GetCompareOperation(dataType, node.GetUserData<NodeUserData_Comparison>().m_ComparisonOperator);
+    }
+
+    if (func == nullptr || node.m_NumInputDataOffsets != context.m_uiNumInputs)
+      return false;
+
+    const ezVisualScriptDataType::Enum inputType = context.m_InputType != ezVisualScriptDataType::Invalid ? context.m_InputType : dataType;
+    for (ezUInt32 i = 0; i < context.m_uiNumInputs; ++i)
+    {
+      DataOffset dataOffset = node.GetInputDataOffset(i);
+      if (dataOffset.IsValid() == false || dataOffset.GetType() != inputType)
+        return false;
+
+      out_instruction.m_Inputs[i] = dataOffset;
+    }
+
+    if (context.m_bHasOutput)
+    {
+      const ezVisualScriptDataType::Enum outputType = context.m_OutputType != ezVisualScriptDataType::Invalid ? context.m_OutputType : dataType;
+
+      DataOffset dataOffset = node.GetOutputDataOffset(0);
+      if (node.m_NumOutputDataOffsets != 1 || dataOffset.IsValid() == false || dataOffset.IsConstant() || dataOffset.GetType() != outputType)
+        return false;
+
+      out_instruction.m_Output = dataOffset;
+    }
+
+    out_instruction.m_Operation = func;
+    out_bIsCondition = context.m_bIsCondition;
+    return true;
+  }
+} // namespace
+
+void ezVisualScriptGraphDescription::CompileInstructions()
+{
+  m_Instructions.Clear();
+  m_NodeToInstruction.Clear();
+  m_NodeToInstruction.SetCount(m_Nodes.GetCount(), ezInvalidIndex);
+  m_uiEntryInstruction = ezInvalidIndex;
+
+  auto pEntryNode = GetNode(0);
+  if (pEntryNode == nullptr)
+    return;
+
+  // Returns the branch node that can be fused into the instruction of the given node. The branch node may still get its own
+  // instruction if it is also reachable from elsewhere.
+  auto GetFusedBranch = [&](const Node& node, const Instruction& instruction, bool bIsCondition) -> const Node*
+  {
+    if (bIsCondition == false || node.m_Type == ezVisualScriptNodeDescription::Type::Builtin_Branch)
+      return nullptr;
+
+    const Node* pNext = GetNode(node.GetExecutionIndex(0));
+    if (pNext == nullptr || pNext->m_Type != ezVisualScriptNodeDescription::Type::Builtin_Branch || pNext->m_NumInputDataOffsets != 1)
+      return nullptr;
+
+    const DataOffset condition = pNext->GetInputDataOffset(0);
+    if (condition.m_uiByteOffset != instruction.m_Output.m_uiByteOffset || condition.m_uiSource != instruction.m_Output.m_uiSource)
+      return nullptr;
+
+    return pNext;
+  };
+
+  // Lay out the instructions depth first, always continuing with the first execution slot, so that the common path is linear in memory.
+  ezHybridArray<ezUInt32, 64> instructionNodes;
+  ezHybridArray<ezUInt32, 16> pendingNodes;
+  pendingNodes.PushBack(pEntryNode->GetExecutionIndex(0));
+
+  while (pendingNodes.IsEmpty() == false)
+  {
+    ezUInt32 uiNodeIndex = pendingNodes.PeekBack();
+    pendingNodes.PopBack();
+
+    while (uiNodeIndex < m_Nodes.GetCount() && m_NodeToInstruction[uiNodeIndex] == ezInvalidIndex)
+    {
+      m_NodeToInstruction[uiNodeIndex] = instructionNodes.GetCount();
+      instructionNodes.PushBack(uiNodeIndex);
+
+      const Node& node = m_Nodes[uiNodeIndex];
+      const Node* pSuccessors = &node;
+
+      Instruction instruction;
+      bool bIsCondition = false;
+      if (SetupOperation(node, instruction, bIsCondition))
+      {
+        if (const Node* pBranch = GetFusedBranch(node, instruction, bIsCondition))
+        {
+          pSuccessors = pBranch;
+        }
+      }
+
+      for (ezUInt32 uiSlot = pSuccessors->m_NumExecutionIndices; uiSlot-- > 1;)
+      {
+        pendingNodes.PushBack(pSuccessors->GetExecutionIndex(uiSlot));
+      }
+
+      uiNodeIndex = pSuccessors->GetExecutionIndex(0);
+    }
+  }
+
+  m_Instructions.SetCount(instructionNodes.GetCount());
+
+  for (ezUInt32 i = 0; i < instructionNodes.GetCount(); ++i)
+  {
+    const Node& node = m_Nodes[instructionNodes[i]];
+    const Node* pSuccessors = &node;
+
+    Instruction& instruction = m_Instructions[i];
+    instruction.m_pNode = &node;
+
+    bool bIsCondition = false;
+    if (SetupOperation(node, instruction, bIsCondition))
+    {
+      instruction.m_OpCode = Instruction::OpCode::Operation;
+
+      if (node.m_Type == ezVisualScriptNodeDescription::Type::Builtin_Branch)
+      {
+        instruction.m_OpCode = Instruction::OpCode::OperationAndBranch;
+      }
+      else if (const Node* pBranch = GetFusedBranch(node, instruction, bIsCondition))
+      {
+        instruction.m_OpCode = Instruction::OpCode::OperationAndBranch;
+        pSuccessors = pBranch;
+      }
+    }
+    else
+    {
+      instruction = Instruction();
+      instruction.m_pNode = &node;
+      instruction.m_OpCode = Instruction::OpCode::Call;
+    }
+
+    for (ezUInt32 uiSlot = 0; uiSlot < EZ_ARRAY_SIZE(instruction.m_uiNext); ++uiSlot)
+    {
+      instruction.m_uiNext[uiSlot] = GetInstructionIndex(pSuccessors->GetExecutionIndex(uiSlot));
+    }
+  }
+
+  m_uiEntryInstruction = GetInstructionIndex(pEntryNode->GetExecutionIndex(0));
+}
+
+#undef MAKE_OPERATION_GETTER
+#undef MAKE_TONUMBER_OPERATION
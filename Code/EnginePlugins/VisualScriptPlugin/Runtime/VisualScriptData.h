@@ -116,6 +116,9 @@ public:
   ezVariant GetDataAsVariant(DataOffset dataOffset, const ezRTTI* pExpectedType, ezUInt32 uiExecutionCounter) const;
   void SetDataFromVariant(DataOffset dataOffset, const ezVariant& value, ezUInt32 uiExecutionCounter);
 
+  /// \brief Returns the start of the storage. Used by compiled instructions to access data slots without going through the typed accessors.
+  ezUInt8* GetRawData() { return m_Storage.GetByteBlobPtr().GetPtr(); }
+
 private:
   ezSharedPtr<const ezVisualScriptDataDescription> m_pDesc;
   ezBlob m_Storage;
@@ -111,6 +111,31 @@ EZ_ALWAYS_INLINE const ezVisualScriptGraphDescription::Node* ezVisualScriptGraph
   return uiIndex < m_Nodes.GetCount() ? &m_Nodes.GetPtr()[uiIndex] : nullptr;
 }
 
+EZ_ALWAYS_INLINE ezArrayPtr<const ezVisualScriptGraphDescription::Instruction> ezVisualScriptGraphDescription::GetInstructions() const
+{
+  return m_Instructions;
+}
+
+EZ_ALWAYS_INLINE ezUInt32 ezVisualScriptGraphDescription::GetEntryInstruction() const
+{
+  return m_uiEntryInstruction;
+}
+
+EZ_ALWAYS_INLINE ezUInt32 ezVisualScriptGraphDescription::GetNextInstruction(const Instruction& instruction, ezUInt32 uiExecSlot) const
+{
+  if (uiExecSlot < EZ_ARRAY_SIZE(instruction.m_uiNext))
+  {
+    return instruction.m_uiNext[uiExecSlot];
+  }
+
+  return GetInstructionIndex(instruction.m_pNode->GetExecutionIndex(uiExecSlot));
+}
+
+EZ_ALWAYS_INLINE ezUInt32 ezVisualScriptGraphDescription::GetInstructionIndex(ezUInt32 uiNodeIndex) const
+{
+  return uiNodeIndex < m_NodeToInstruction.GetCount() ? m_NodeToInstruction[uiNodeIndex] : ezInvalidIndex;
+}
+
 EZ_ALWAYS_INLINE bool ezVisualScriptGraphDescription::IsCoroutine() const
 {
   auto entryNodeType = GetNode(0)->m_Type;
@@ -0,0 +1,342 @@
+#include <TexConv/TexConvPCH.h>
+
+#include <TexConv/TexConv.h>
+
+#include <Foundation/Algorithm/HashStream.h>
+#include <Foundation/IO/FileSystem/DeferredFileWriter.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Utilities/CommandLineOptions.h>
+#include <Texture/TexConv/TexConvSourceImageCache.h>
+#include <Texture/Utils/TextureAtlasDesc.h>
+
+ezCommandLineOptionPath opt_Batch("_TexConv", "-batch",
+  "Path to a text file with one TexConv command line per line.\n\
+   All conversions are executed in parallel within this process.\n\
+   Empty lines and lines starting with # are ignored.\n\
+   The hashes of all inputs and options are stored next to the batch file (batch file name + '.cache'),\n\
+   conversions whose inputs and options did not change since the last run are skipped.",
+  "");
+
+namespace
+{
+  // increase this, when the output of the processor changes, to invalidate all cached entries
+  constexpr ezUInt8 s_uiBatchCacheVersion = 1;
+
+  struct BatchEntry
+  {
+    ezUInt32 m_uiLine = 0;
+    ezString m_sCommandLine;
+    ezString m_sOutputFile;
+    ezString m_sOutputLowResFile;
+    ezUniquePtr<ezTexConv::Job> m_pJob;
+    ezDynamicArray<ezString> m_InputFiles;
+    ezUInt64 m_uiHash = 0;
+    bool m_bHashValid = false;
+    bool m_bUpToDate = false;
+    bool m_bSucceeded = false;
+  };
+
+  void GatherInputFiles(const ezTexConv::Job& job, ezDynamicArray<ezString>& out_files)
+  {
+    const ezTexConvDesc& desc = job.m_Processor.m_Descriptor;
+
+    out_files.Clear();
+    out_files.PushBackRange(desc.m_InputFiles);
+
+    if (desc.m_OutputType == ezTexConvOutputType::Atlas)
+    {
+      out_files.PushBack(desc.m_sTextureAtlasDescFile);
+
+      ezTextureAtlasCreationDesc atlasDesc;
+      if (atlasDesc.Load(desc.m_sTextureAtlasDescFile).Succeeded())
+      {
+        for (const auto& item : atlasDesc.m_Items)
+        {
+          for (ezUInt32 layer = 0; layer < atlasDesc.m_Layers.GetCount(); ++layer)
+          {
+            if (!item.m_sLayerInput[layer].IsEmpty())
+            {
+              out_files.PushBack(item.m_sLayerInput[layer]);
+            }
+          }
+
+          if (!item.m_sAlphaInput.IsEmpty())
+          {
+            out_files.PushBack(item.m_sAlphaInput);
+          }
+        }
+      }
+    }
+  }
+
+  ezResult ComputeHash(const BatchEntry& entry, ezUInt64& out_uiHash)
+  {
+    ezHashStreamWriter64 writer;
+    writer << s_uiBatchCacheVersion;
+    writer << entry.m_sCommandLine;
+
+    ezDynamicArray<ezUInt8> buffer;
+    buffer.SetCountUninitialized(64 * 1024);
+
+    for (const ezString& sFile : entry.m_InputFiles)
+    {
+      writer << sFile;
+
+      ezFileReader file;
+      if (file.Open(sFile).Failed())
+        return EZ_FAILURE;
+
+      while (true)
+      {
+        const ezUInt64 uiRead = file.ReadBytes(buffer.GetData(), buffer.GetCount());
+        if (uiRead == 0)
+          break;
+
+        EZ_SUCCEED_OR_RETURN(writer.WriteBytes(buffer.GetData(), uiRead));
+      }
+    }
+
+    out_uiHash = writer.GetHashValue();
+    return EZ_SUCCESS;
+  }
+
+  /// The low-res file is not written when the image has too few mips. It is only required, if the previous conversion has written it.
+  bool AllOutputsExist(const ezTexConv::Job& job, const ezMap<ezString, ezUInt64>& cache)
+  {
+    for (const ezString& sFile : {job.m_sOutputFile, job.m_sOutputThumbnailFile, job.m_sOutputLowResFile})
+    {
+      if (sFile.IsEmpty() || (sFile == job.m_sOutputLowResFile && !cache.Contains(sFile)))
+        continue;
+
+      if (!ezOSFile::ExistsFile(sFile))
+        return false;
+    }
+
+    return true;
+  }
+
+  void LoadBatchCache(ezStringView sCacheFile, ezMap<ezString, ezUInt64>& out_cache)
+  {
+    out_cache.Clear();
+
+    ezFileReader file;
+    if (file.Open(sCacheFile).Failed())
+      return;
+
+    ezUInt8 uiVersion = 0;
+    file >> uiVersion;
+
+    if (uiVersion != s_uiBatchCacheVersion || file.ReadMap(out_cache).Failed())
+    {
+      ezLog::Warning("Ignoring outdated or invalid batch cache '{}'", sCacheFile);
+      out_cache.Clear();
+    }
+  }
+
+  ezResult SaveBatchCache(ezStringView sCacheFile, const ezMap<ezString, ezUInt64>& cache)
+  {
+    ezDeferredFileWriter file;
+    file.SetOutput(sCacheFile);
+
+    file << s_uiBatchCacheVersion;
+    EZ_SUCCEED_OR_RETURN(file.WriteMap(cache));
+
+    return file.Close();
+  }
+} // namespace
+
+bool ezTexConv::IsBatchMode() const
+{
+  return opt_Batch.IsOptionSpecified();
+}
+
+ezResult ezTexConv::RunBatch()
+{
+  const ezString sBatchFile = opt_Batch.GetOptionValue(ezCommandLineOption::LogMode::Always);
+
+  ezStringBuilder sContent;
+  {
+    ezFileReader file;
+    if (file.Open(sBatchFile).Failed())
+    {
+      ezLog::Error("Failed to open batch file '{}'", sBatchFile);
+      return EZ_FAILURE;
+    }
+
+    sContent.ReadAll(file);
+  }
+
+  ezStringBuilder sCacheFile = sBatchFile;
+  sCacheFile.Append(".cache");
+
+  ezMap<ezString, ezUInt64> cache;
+  LoadBatchCache(sCacheFile, cache);
+
+  ezDynamicArray<BatchEntry> entries;
+  ezUInt32 uiNumInvalid = 0;
+
+  // parse all command lines up front, the command line options can only be read through the global command line instance
+  {
+    ezHybridArray<ezStringView, 8> lines;
+    sContent.Split(true, lines, "\r\n", "\n");
+
+    ezDynamicArray<ezString> args;
+    ezDynamicArray<const char*> argsV;
+    ezStringBuilder sLine;
+
+    for (ezUInt32 i = 0; i < lines.GetCount(); ++i)
+    {
+      sLine = lines[i];
+      sLine.Trim(" \t\r");
+
+      if (sLine.IsEmpty() || sLine.StartsWith("#"))
+        continue;
+
+      args.Clear();
+      argsV.Clear();
+      ezCommandLineUtils::SplitCommandLineString(sLine, false, args, argsV);
+      ezCommandLineUtils::GetGlobalInstance()->SetCommandLine(args);
+
+      m_pJob = EZ_DEFAULT_NEW(Job);
+
+      if (ParseCommandLine().Failed())
+      {
+        ezLog::Error("Invalid command line in line {} of the batch file", i + 1);
+        ++uiNumInvalid;
+        continue;
+      }
+
+      BatchEntry& entry = entries.ExpandAndGetRef();
+      entry.m_uiLine = i + 1;
+      entry.m_sCommandLine = sLine;
+      entry.m_sOutputFile = m_pJob->m_sOutputFile;
+      entry.m_sOutputLowResFile = m_pJob->m_sOutputLowResFile;
+      entry.m_pJob = std::move(m_pJob);
+    }
+  }
+
+  ezParallelForParams params;
+  params.m_uiBinSize = 1;
+  params.m_NestingMode = ezTaskNesting::Maybe;
+
+  // reading all inputs for hashing is IO bound, so it runs in parallel as well
+  ezTaskSystem::ParallelForIndexed(
+    0, entries.GetCount(), [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+    {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        BatchEntry& entry = entries[i];
+        GatherInputFiles(*entry.m_pJob, entry.m_InputFiles);
+        entry.m_bHashValid = ComputeHash(entry, entry.m_uiHash).Succeeded();
+
+        if (entry.m_bHashValid && !entry.m_sOutputFile.IsEmpty() && AllOutputsExist(*entry.m_pJob, cache))
+        {
+          const ezUInt64* pCachedHash = cache.GetValue(entry.m_sOutputFile);
+          entry.m_bUpToDate = pCachedHash != nullptr && *pCachedHash == entry.m_uiHash;
+        }
+      }
+    },
+    "TexConv.HashInputs", params);
+
+  // only announce the inputs of the conversions that are executed, otherwise their decoded images would never be released
+  ezTexConvSourceImageCache sourceImageCache;
+  ezUInt32 uiNumUpToDate = 0;
+
+  for (BatchEntry& entry : entries)
+  {
+    if (entry.m_bUpToDate)
+    {
+      ++uiNumUpToDate;
+      entry.m_pJob.Clear();
+      continue;
+    }
+
+    ezTexConvDesc& desc = entry.m_pJob->m_Processor.m_Descriptor;
+    desc.m_pSourceImageCache = &sourceImageCache;
+
+    for (const ezString& sFile : entry.m_InputFiles)
+    {
+      // the atlas description is hashed, but not loaded as an image
+      if (sFile != desc.m_sTextureAtlasDescFile)
+      {
+        sourceImageCache.AddExpectedUse(sFile);
+      }
+    }
+  }
+
+  ezTaskSystem::ParallelForIndexed(
+    0, entries.GetCount(), [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+    {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        BatchEntry& entry = entries[i];
+        if (entry.m_bUpToDate)
+          continue;
+
+        {
+          EZ_LOG_BLOCK("Batch", entry.m_sOutputFile);
+
+          entry.m_bSucceeded = entry.m_pJob->m_Processor.Process().Succeeded() && WriteJobOutputs(*entry.m_pJob).Succeeded();
+
+          if (!entry.m_bSucceeded)
+          {
+            ezLog::Error("Failed to convert line {} of the batch file", entry.m_uiLine);
+          }
+        }
+
+        // release the images as early as possible, the whole batch may not fit into memory
+        entry.m_pJob.Clear();
+      }
+    },
+    "TexConv.Batch", params);
+
+  ezUInt32 uiNumConverted = 0;
+  ezUInt32 uiNumFailed = uiNumInvalid;
+
+  for (const BatchEntry& entry : entries)
+  {
+    if (entry.m_bUpToDate)
+      continue;
+
+    if (entry.m_bSucceeded)
+      ++uiNumConverted;
+    else
+      ++uiNumFailed;
+
+    if (entry.m_sOutputFile.IsEmpty())
+      continue;
+
+    if (entry.m_bSucceeded && entry.m_bHashValid)
+    {
+      cache[entry.m_sOutputFile] = entry.m_uiHash;
+    }
+    else
+    {
+      cache.Remove(entry.m_sOutputFile);
+    }
+
+    if (entry.m_sOutputLowResFile.IsEmpty())
+      continue;
+
+    // remember whether the low-res file was written, so that a deleted one is detected
+    if (entry.m_bSucceeded && entry.m_bHashValid && ezOSFile::ExistsFile(entry.m_sOutputLowResFile))
+    {
+      cache[entry.m_sOutputLowResFile] = entry.m_uiHash;
+    }
+    else
+    {
+      cache.Remove(entry.m_sOutputLowResFile);
+    }
+  }
+
+  if (SaveBatchCache(sCacheFile, cache).Failed())
+  {
+    ezLog::Warning("Failed to write batch cache '{}'", sCacheFile);
+  }
+
+  ezLog::Info("Batch finished: {} converted, {} up to date, {} failed", uiNumConverted, uiNumUpToDate, uiNumFailed);
+
+  return uiNumFailed == 0 ? EZ_SUCCESS : EZ_FAILURE;
+}
@@ -28,10 +28,10 @@ static ezStringView ToString(ezTexConvChannelValue::Enum e)
 
 ezResult ezTexConv::ParseChannelMappings()
 {
-  if (m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Atlas)
+  if (m_pJob->m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Atlas)
     return EZ_SUCCESS;
 
-  auto& mappings = m_Processor.m_Descriptor.m_ChannelMappings;
+  auto& mappings = m_pJob->m_Processor.m_Descriptor.m_ChannelMappings;
 
   EZ_SUCCEED_OR_RETURN(ParseChannelSliceMapping(-1));
 
@@ -66,7 +66,7 @@ ezResult ezTexConv::ParseChannelMappings()
 ezResult ezTexConv::ParseChannelSliceMapping(ezInt32 iSlice)
 {
   const auto pCmd = ezCommandLineUtils::GetGlobalInstance();
-  auto& mappings = m_Processor.m_Descriptor.m_ChannelMappings;
+  auto& mappings = m_pJob->m_Processor.m_Descriptor.m_ChannelMappings;
   ezStringBuilder tmp, param;
 
   const ezUInt32 uiMappingIdx = iSlice < 0 ? 0 : iSlice;
@@ -203,7 +203,7 @@ ezResult ezTexConv::ParseChannelMappingConfig(ezTexConvChannelMapping& out_mappi
     }
 
     // valid index after the 'in'
-    if (num >= 0 && num < (ezInt32)m_Processor.m_Descriptor.m_InputFiles.GetCount())
+    if (num >= 0 && num < (ezInt32)m_pJob->m_Processor.m_Descriptor.m_InputFiles.GetCount())
     {
       out_mapping.m_iInputImageIndex = (ezInt8)num;
     }
@@ -128,46 +128,46 @@ ezResult ezTexConv::ParseCommandLine()
 
 ezResult ezTexConv::ParseOutputType()
 {
-  if (m_sOutputFile.IsEmpty())
+  if (m_pJob->m_sOutputFile.IsEmpty())
   {
-    m_Processor.m_Descriptor.m_OutputType = ezTexConvOutputType::None;
+    m_pJob->m_Processor.m_Descriptor.m_OutputType = ezTexConvOutputType::None;
     return EZ_SUCCESS;
   }
 
   ezInt32 value = opt_Type.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
-  m_Processor.m_Descriptor.m_OutputType = static_cast<ezTexConvOutputType::Enum>(value);
+  m_pJob->m_Processor.m_Descriptor.m_OutputType = static_cast<ezTexConvOutputType::Enum>(value);
 
-  if (m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Texture2D)
+  if (m_pJob->m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Texture2D)
   {
-    if (!m_bOutputSupports2D)
+    if (!m_pJob->m_bOutputSupports2D)
     {
       ezLog::Error("2D textures are not supported by the chosen output file format.");
       return EZ_FAILURE;
     }
   }
-  else if (m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Cubemap)
+  else if (m_pJob->m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Cubemap)
   {
-    if (!m_bOutputSupportsCube)
+    if (!m_pJob->m_bOutputSupportsCube)
     {
       ezLog::Error("Cubemap textures are not supported by the chosen output file format.");
       return EZ_FAILURE;
     }
   }
-  else if (m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Atlas)
+  else if (m_pJob->m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Atlas)
   {
-    if (!m_bOutputSupportsAtlas)
+    if (!m_pJob->m_bOutputSupportsAtlas)
     {
       ezLog::Error("Atlas textures are not supported by the chosen output file format.");
       return EZ_FAILURE;
     }
 
-    if (!ParseFile("-atlasDesc", m_Processor.m_Descriptor.m_sTextureAtlasDescFile))
+    if (!ParseFile("-atlasDesc", m_pJob->m_Processor.m_Descriptor.m_sTextureAtlasDescFile))
       return EZ_FAILURE;
   }
-  else if (m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Volume)
+  else if (m_pJob->m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Volume)
   {
-    if (!m_bOutputSupports3D)
+    if (!m_pJob->m_bOutputSupports3D)
     {
       ezLog::Error("Volume textures are not supported by the chosen output file format.");
       return EZ_FAILURE;
@@ -184,13 +184,13 @@ ezResult ezTexConv::ParseOutputType()
 
 ezResult ezTexConv::ParseInputFiles()
 {
-  if (m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Atlas)
+  if (m_pJob->m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Atlas)
     return EZ_SUCCESS;
 
   ezStringBuilder tmp, res;
   const auto pCmd = ezCommandLineUtils::GetGlobalInstance();
 
-  auto& files = m_Processor.m_Descriptor.m_InputFiles;
+  auto& files = m_pJob->m_Processor.m_Descriptor.m_InputFiles;
 
   for (ezUInt32 i = 0; i < 64; ++i)
   {
@@ -218,7 +218,7 @@ ezResult ezTexConv::ParseInputFiles()
     }
   }
 
-  if (m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Cubemap)
+  if (m_pJob->m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Cubemap)
   {
     // 0 = +X = Right
     // 1 = -X = Left
@@ -258,7 +258,7 @@ ezResult ezTexConv::ParseInputFiles()
     ezLog::Info("Input file {}: '{}'", i, files[i]);
   }
 
-  if (m_Processor.m_Descriptor.m_InputFiles.IsEmpty())
+  if (m_pJob->m_Processor.m_Descriptor.m_InputFiles.IsEmpty())
   {
     ezLog::Error("No input files were specified. Use \'-in \"path/to/file\"' to specify an input file. Use '-in0', '-in1' etc. to specify "
                  "multiple input files.");
@@ -270,20 +270,20 @@ ezResult ezTexConv::ParseInputFiles()
 
 ezResult ezTexConv::ParseOutputFiles()
 {
-  m_sOutputFile = opt_Out.GetOptionValue(ezCommandLineOption::LogMode::Always);
+  m_pJob->m_sOutputFile = opt_Out.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
-  m_sOutputThumbnailFile = opt_ThumbnailOut.GetOptionValue(ezCommandLineOption::LogMode::Always);
+  m_pJob->m_sOutputThumbnailFile = opt_ThumbnailOut.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
-  if (!m_sOutputThumbnailFile.IsEmpty())
+  if (!m_pJob->m_sOutputThumbnailFile.IsEmpty())
   {
-    m_Processor.m_Descriptor.m_uiThumbnailOutputResolution = opt_ThumbnailRes.GetOptionValue(ezCommandLineOption::LogMode::Always);
+    m_pJob->m_Processor.m_Descriptor.m_uiThumbnailOutputResolution = opt_ThumbnailRes.GetOptionValue(ezCommandLineOption::LogMode::Always);
   }
 
-  m_sOutputLowResFile = opt_LowOut.GetOptionValue(ezCommandLineOption::LogMode::Always);
+  m_pJob->m_sOutputLowResFile = opt_LowOut.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
-  if (!m_sOutputLowResFile.IsEmpty())
+  if (!m_pJob->m_sOutputLowResFile.IsEmpty())
   {
-    m_Processor.m_Descriptor.m_uiLowResMipmaps = opt_LowMips.GetOptionValue(ezCommandLineOption::LogMode::Always);
+    m_pJob->m_Processor.m_Descriptor.m_uiLowResMipmaps = opt_LowMips.GetOptionValue(ezCommandLineOption::LogMode::Always);
   }
 
   return EZ_SUCCESS;
@@ -291,34 +291,34 @@ ezResult ezTexConv::ParseOutputFiles()
 
 ezResult ezTexConv::ParseUsage()
 {
-  if (m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Atlas)
+  if (m_pJob->m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Atlas)
     return EZ_SUCCESS;
 
   const ezInt32 value = opt_Usage.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
-  m_Processor.m_Descriptor.m_Usage = static_cast<ezTexConvUsage::Enum>(value);
+  m_pJob->m_Processor.m_Descriptor.m_Usage = static_cast<ezTexConvUsage::Enum>(value);
   return EZ_SUCCESS;
 }
 
 ezResult ezTexConv::ParseMipmapMode()
 {
-  if (!m_bOutputSupportsMipmaps)
+  if (!m_pJob->m_bOutputSupportsMipmaps)
   {
     ezLog::Info("Selected output format does not support -mipmap options.");
 
-    m_Processor.m_Descriptor.m_MipmapMode = ezTexConvMipmapMode::None;
+    m_pJob->m_Processor.m_Descriptor.m_MipmapMode = ezTexConvMipmapMode::None;
     return EZ_SUCCESS;
   }
 
   const ezInt32 value = opt_Mipmaps.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
-  m_Processor.m_Descriptor.m_MipmapMode = static_cast<ezTexConvMipmapMode::Enum>(value);
+  m_pJob->m_Processor.m_Descriptor.m_MipmapMode = static_cast<ezTexConvMipmapMode::Enum>(value);
 
-  m_Processor.m_Descriptor.m_bPreserveMipmapCoverage = opt_MipsPreserveCoverage.GetOptionValue(ezCommandLineOption::LogMode::Always);
+  m_pJob->m_Processor.m_Descriptor.m_bPreserveMipmapCoverage = opt_MipsPreserveCoverage.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
-  if (m_Processor.m_Descriptor.m_bPreserveMipmapCoverage)
+  if (m_pJob->m_Processor.m_Descriptor.m_bPreserveMipmapCoverage)
   {
-    m_Processor.m_Descriptor.m_fMipmapAlphaThreshold = opt_MipsAlphaThreshold.GetOptionValue(ezCommandLineOption::LogMode::Always);
+    m_pJob->m_Processor.m_Descriptor.m_fMipmapAlphaThreshold = opt_MipsAlphaThreshold.GetOptionValue(ezCommandLineOption::LogMode::Always);
   }
 
   return EZ_SUCCESS;
@@ -328,45 +328,45 @@ ezResult ezTexConv::ParseTargetPlatform()
 {
   ezInt32 value = opt_Platform.GetOptionValue(ezCommandLineOption::LogMode::AlwaysIfSpecified);
 
-  m_Processor.m_Descriptor.m_TargetPlatform = static_cast<ezTexConvTargetPlatform::Enum>(value);
+  m_pJob->m_Processor.m_Descriptor.m_TargetPlatform = static_cast<ezTexConvTargetPlatform::Enum>(value);
   return EZ_SUCCESS;
 }
 
 ezResult ezTexConv::ParseCompressionMode()
 {
-  if (!m_bOutputSupportsCompression)
+  if (!m_pJob->m_bOutputSupportsCompression)
   {
     ezLog::Info("Selected output format does not support -compression options.");
 
-    m_Processor.m_Descriptor.m_CompressionMode = ezTexConvCompressionMode::None;
+    m_pJob->m_Processor.m_Descriptor.m_CompressionMode = ezTexConvCompressionMode::None;
     return EZ_SUCCESS;
   }
 
   const ezInt32 value = opt_Compression.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
-  m_Processor.m_Descriptor.m_CompressionMode = static_cast<ezTexConvCompressionMode::Enum>(value);
+  m_pJob->m_Processor.m_Descriptor.m_CompressionMode = static_cast<ezTexConvCompressionMode::Enum>(value);
   return EZ_SUCCESS;
 }
 
 ezResult ezTexConv::ParseWrapModes()
 {
   // cubemaps do not require any wrap mode settings
-  if (m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Cubemap || m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Atlas || m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::None)
+  if (m_pJob->m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Cubemap || m_pJob->m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Atlas || m_pJob->m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::None)
     return EZ_SUCCESS;
 
   {
     ezInt32 value = opt_AddressU.GetOptionValue(ezCommandLineOption::LogMode::Always);
-    m_Processor.m_Descriptor.m_AddressModeU = static_cast<ezImageAddressMode::Enum>(value);
+    m_pJob->m_Processor.m_Descriptor.m_AddressModeU = static_cast<ezImageAddressMode::Enum>(value);
   }
   {
     ezInt32 value = opt_AddressV.GetOptionValue(ezCommandLineOption::LogMode::Always);
-    m_Processor.m_Descriptor.m_AddressModeV = static_cast<ezImageAddressMode::Enum>(value);
+    m_pJob->m_Processor.m_Descriptor.m_AddressModeV = static_cast<ezImageAddressMode::Enum>(value);
   }
 
-  if (m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Volume)
+  if (m_pJob->m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Volume)
   {
     ezInt32 value = opt_AddressW.GetOptionValue(ezCommandLineOption::LogMode::AlwaysIfSpecified);
-    m_Processor.m_Descriptor.m_AddressModeW = static_cast<ezImageAddressMode::Enum>(value);
+    m_pJob->m_Processor.m_Descriptor.m_AddressModeW = static_cast<ezImageAddressMode::Enum>(value);
   }
 
   return EZ_SUCCESS;
@@ -374,7 +374,7 @@ ezResult ezTexConv::ParseWrapModes()
 
 ezResult ezTexConv::ParseFilterModes()
 {
-  if (!m_bOutputSupportsFiltering)
+  if (!m_pJob->m_bOutputSupportsFiltering)
   {
     ezLog::Info("Selected output format does not support -filter options.");
     return EZ_SUCCESS;
@@ -382,54 +382,54 @@ ezResult ezTexConv::ParseFilterModes()
 
   ezInt32 value = opt_Filter.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
-  m_Processor.m_Descriptor.m_FilterMode = static_cast<ezTextureFilterSetting::Enum>(value);
+  m_pJob->m_Processor.m_Descriptor.m_FilterMode = static_cast<ezTextureFilterSetting::Enum>(value);
   return EZ_SUCCESS;
 }
 
 ezResult ezTexConv::ParseResolutionModifiers()
 {
-  if (m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::None)
+  if (m_pJob->m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::None)
     return EZ_SUCCESS;
 
-  m_Processor.m_Descriptor.m_uiMinResolution = opt_MinRes.GetOptionValue(ezCommandLineOption::LogMode::Always);
-  m_Processor.m_Descriptor.m_uiMaxResolution = opt_MaxRes.GetOptionValue(ezCommandLineOption::LogMode::Always);
-  m_Processor.m_Descriptor.m_uiDownscaleSteps = opt_Downscale.GetOptionValue(ezCommandLineOption::LogMode::Always);
+  m_pJob->m_Processor.m_Descriptor.m_uiMinResolution = opt_MinRes.GetOptionValue(ezCommandLineOption::LogMode::Always);
+  m_pJob->m_Processor.m_Descriptor.m_uiMaxResolution = opt_MaxRes.GetOptionValue(ezCommandLineOption::LogMode::Always);
+  m_pJob->m_Processor.m_Descriptor.m_uiDownscaleSteps = opt_Downscale.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
   return EZ_SUCCESS;
 }
 
 ezResult ezTexConv::ParseMiscOptions()
 {
-  if (m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Texture2D || m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::None)
+  if (m_pJob->m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Texture2D || m_pJob->m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::None)
   {
-    m_Processor.m_Descriptor.m_bFlipHorizontal = opt_FlipHorz.GetOptionValue(ezCommandLineOption::LogMode::Always);
+    m_pJob->m_Processor.m_Descriptor.m_bFlipHorizontal = opt_FlipHorz.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
-    m_Processor.m_Descriptor.m_bPremultiplyAlpha = opt_Premulalpha.GetOptionValue(ezCommandLineOption::LogMode::Always);
+    m_pJob->m_Processor.m_Descriptor.m_bPremultiplyAlpha = opt_Premulalpha.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
     if (opt_Dilate.GetOptionValue(ezCommandLineOption::LogMode::Always))
     {
-      m_Processor.m_Descriptor.m_uiDilateColor = static_cast<ezUInt8>(opt_DilateStrength.GetOptionValue(ezCommandLineOption::LogMode::Always));
+      m_pJob->m_Processor.m_Descriptor.m_uiDilateColor = static_cast<ezUInt8>(opt_DilateStrength.GetOptionValue(ezCommandLineOption::LogMode::Always));
     }
   }
 
-  if (m_Processor.m_Descriptor.m_Usage == ezTexConvUsage::Hdr)
+  if (m_pJob->m_Processor.m_Descriptor.m_Usage == ezTexConvUsage::Hdr)
   {
-    m_Processor.m_Descriptor.m_fHdrExposureBias = opt_HdrExposure.GetOptionValue(ezCommandLineOption::LogMode::Always);
+    m_pJob->m_Processor.m_Descriptor.m_fHdrExposureBias = opt_HdrExposure.GetOptionValue(ezCommandLineOption::LogMode::Always);
   }
 
-  m_Processor.m_Descriptor.m_fMaxValue = opt_Clamp.GetOptionValue(ezCommandLineOption::LogMode::Always);
+  m_pJob->m_Processor.m_Descriptor.m_fMaxValue = opt_Clamp.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
   return EZ_SUCCESS;
 }
 
 ezResult ezTexConv::ParseAssetHeader()
 {
-  const ezStringView ext = ezPathUtils::GetFileExtension(m_sOutputFile);
+  const ezStringView ext = ezPathUtils::GetFileExtension(m_pJob->m_sOutputFile);
 
   if (!ext.StartsWith_NoCase("ez"))
     return EZ_SUCCESS;
 
-  m_Processor.m_Descriptor.m_uiAssetVersion = (ezUInt16)opt_AssetVersion.GetOptionValue(ezCommandLineOption::LogMode::Always);
+  m_pJob->m_Processor.m_Descriptor.m_uiAssetVersion = (ezUInt16)opt_AssetVersion.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
   ezUInt32 uiHashLow = 0;
   ezUInt32 uiHashHigh = 0;
@@ -440,9 +440,9 @@ ezResult ezTexConv::ParseAssetHeader()
     return EZ_FAILURE;
   }
 
-  m_Processor.m_Descriptor.m_uiAssetHash = (static_cast<ezUInt64>(uiHashHigh) << 32) | static_cast<ezUInt64>(uiHashLow);
+  m_pJob->m_Processor.m_Descriptor.m_uiAssetHash = (static_cast<ezUInt64>(uiHashHigh) << 32) | static_cast<ezUInt64>(uiHashLow);
 
-  if (m_Processor.m_Descriptor.m_uiAssetHash == 0)
+  if (m_pJob->m_Processor.m_Descriptor.m_uiAssetHash == 0)
   {
     ezLog::Error("'-assetHashLow 0xHEX32' and '-assetHashHigh 0xHEX32' have not been specified correctly.");
     return EZ_FAILURE;
@@ -455,6 +455,6 @@ ezResult ezTexConv::ParseBumpMapFilter()
 {
   const ezInt32 value = opt_BumpMapFilter.GetOptionValue(ezCommandLineOption::LogMode::Always);
 
-  m_Processor.m_Descriptor.m_BumpMapFilter = static_cast<ezTexConvBumpMapFilter::Enum>(value);
+  m_pJob->m_Processor.m_Descriptor.m_BumpMapFilter = static_cast<ezTexConvBumpMapFilter::Enum>(value);
   return EZ_SUCCESS;
 }
@@ -38,90 +38,90 @@ void ezTexConv::BeforeCoreSystemsShutdown()
 
 ezResult ezTexConv::DetectOutputFormat()
 {
-  if (m_sOutputFile.IsEmpty())
+  if (m_pJob->m_sOutputFile.IsEmpty())
   {
-    m_Processor.m_Descriptor.m_OutputType = ezTexConvOutputType::None;
+    m_pJob->m_Processor.m_Descriptor.m_OutputType = ezTexConvOutputType::None;
     return EZ_SUCCESS;
   }
 
-  ezStringBuilder sExt = ezPathUtils::GetFileExtension(m_sOutputFile);
+  ezStringBuilder sExt = ezPathUtils::GetFileExtension(m_pJob->m_sOutputFile);
   sExt.ToUpper();
 
   if (sExt == "DDS")
   {
-    m_bOutputSupports2D = true;
-    m_bOutputSupports3D = true;
-    m_bOutputSupportsCube = true;
-    m_bOutputSupportsAtlas = false;
-    m_bOutputSupportsMipmaps = true;
-    m_bOutputSupportsFiltering = false;
-    m_bOutputSupportsCompression = true;
+    m_pJob->m_bOutputSupports2D = true;
+    m_pJob->m_bOutputSupports3D = true;
+    m_pJob->m_bOutputSupportsCube = true;
+    m_pJob->m_bOutputSupportsAtlas = false;
+    m_pJob->m_bOutputSupportsMipmaps = true;
+    m_pJob->m_bOutputSupportsFiltering = false;
+    m_pJob->m_bOutputSupportsCompression = true;
     return EZ_SUCCESS;
   }
   if (sExt == "TGA" || sExt == "PNG")
   {
-    m_bOutputSupports2D = true;
-    m_bOutputSupports3D = false;
-    m_bOutputSupportsCube = false;
-    m_bOutputSupportsAtlas = false;
-    m_bOutputSupportsMipmaps = false;
-    m_bOutputSupportsFiltering = false;
-    m_bOutputSupportsCompression = false;
+    m_pJob->m_bOutputSupports2D = true;
+    m_pJob->m_bOutputSupports3D = false;
+    m_pJob->m_bOutputSupportsCube = false;
+    m_pJob->m_bOutputSupportsAtlas = false;
+    m_pJob->m_bOutputSupportsMipmaps = false;
+    m_pJob->m_bOutputSupportsFiltering = false;
+    m_pJob->m_bOutputSupportsCompression = false;
     return EZ_SUCCESS;
   }
   if (sExt == "EZTEXTURE2D")
   {
-    m_bOutputSupports2D = true;
-    m_bOutputSupports3D = false;
-    m_bOutputSupportsCube = false;
-    m_bOutputSupportsAtlas = false;
-    m_bOutputSupportsMipmaps = true;
-    m_bOutputSupportsFiltering = true;
-    m_bOutputSupportsCompression = true;
+    m_pJob->m_bOutputSupports2D = true;
+    m_pJob->m_bOutputSupports3D = false;
+    m_pJob->m_bOutputSupportsCube = false;
+    m_pJob->m_bOutputSupportsAtlas = false;
+    m_pJob->m_bOutputSupportsMipmaps = true;
+    m_pJob->m_bOutputSupportsFiltering = true;
+    m_pJob->m_bOutputSupportsCompression = true;
     return EZ_SUCCESS;
   }
   if (sExt == "EZTEXTURE3D")
   {
-    m_bOutputSupports2D = false;
-    m_bOutputSupports3D = true;
-    m_bOutputSupportsCube = false;
-    m_bOutputSupportsAtlas = false;
-    m_bOutputSupportsMipmaps = true;
-    m_bOutputSupportsFiltering = true;
-    m_bOutputSupportsCompression = true;
+    m_pJob->m_bOutputSupports2D = false;
+    m_pJob->m_bOutputSupports3D = true;
+    m_pJob->m_bOutputSupportsCube = false;
+    m_pJob->m_bOutputSupportsAtlas = false;
+    m_pJob->m_bOutputSupportsMipmaps = true;
+    m_pJob->m_bOutputSupportsFiltering = true;
+    m_pJob->m_bOutputSupportsCompression = true;
     return EZ_SUCCESS;
   }
   if (sExt == "EZTEXTURECUBE")
   {
-    m_bOutputSupports2D = false;
-    m_bOutputSupports3D = false;
-    m_bOutputSupportsCube = true;
-    m_bOutputSupportsAtlas = false;
-    m_bOutputSupportsMipmaps = true;
-    m_bOutputSupportsFiltering = true;
-    m_bOutputSupportsCompression = true;
+    m_pJob->m_bOutputSupports2D = false;
+    m_pJob->m_bOutputSupports3D = false;
+    m_pJob->m_bOutputSupportsCube = true;
+    m_pJob->m_bOutputSupportsAtlas = false;
+    m_pJob->m_bOutputSupportsMipmaps = true;
+    m_pJob->m_bOutputSupportsFiltering = true;
+    m_pJob->m_bOutputSupportsCompression = true;
     return EZ_SUCCESS;
   }
   if (sExt == "EZTEXTUREATLAS")
   {
-    m_bOutputSupports2D = false;
-    m_bOutputSupports3D = false;
-    m_bOutputSupportsCube = false;
-    m_bOutputSupportsAtlas = true;
-    m_bOutputSupportsMipmaps = true;
-    m_bOutputSupportsFiltering = true;
-    m_bOutputSupportsCompression = true;
+    m_pJob->m_bOutputSupports2D = false;
+    m_pJob->m_bOutputSupports3D = false;
+    m_pJob->m_bOutputSupportsCube = false;
+    m_pJob->m_bOutputSupportsAtlas = true;
+    m_pJob->m_bOutputSupportsMipmaps = true;
+    m_pJob->m_bOutputSupportsFiltering = true;
+    m_pJob->m_bOutputSupportsCompression = true;
     return EZ_SUCCESS;
   }
   if (sExt == "EZIMAGEDATA")
   {
-    m_bOutputSupports2D = true;
-    m_bOutputSupports3D = false;
-    m_bOutputSupportsCube = false;
-    m_bOutputSupportsAtlas = false;
-    m_bOutputSupportsMipmaps = false;
-    m_bOutputSupportsFiltering = false;
-    m_bOutputSupportsCompression = false;
+    m_pJob->m_bOutputSupports2D = true;
+    m_pJob->m_bOutputSupports3D = false;
+    m_pJob->m_bOutputSupportsCube = false;
+    m_pJob->m_bOutputSupportsAtlas = false;
+    m_pJob->m_bOutputSupportsMipmaps = false;
+    m_pJob->m_bOutputSupportsFiltering = false;
+    m_pJob->m_bOutputSupportsCompression = false;
     return EZ_SUCCESS;
   }
 
@@ -129,26 +129,26 @@ ezResult ezTexConv::DetectOutputFormat()
   return EZ_FAILURE;
 }
 
-bool ezTexConv::IsTexFormat() const
+bool ezTexConv::IsTexFormat(const Job& job)
 {
-  const ezStringView ext = ezPathUtils::GetFileExtension(m_sOutputFile);
+  const ezStringView ext = ezPathUtils::GetFileExtension(job.m_sOutputFile);
 
   return ext.StartsWith_NoCase("ez");
 }
 
-ezResult ezTexConv::WriteTexFile(ezStreamWriter& inout_stream, const ezImage& image)
+ezResult ezTexConv::WriteTexFile(const Job& job, ezStreamWriter& inout_stream, const ezImage& image)
 {
   ezAssetFileHeader asset;
-  asset.SetFileHashAndVersion(m_Processor.m_Descriptor.m_uiAssetHash, m_Processor.m_Descriptor.m_uiAssetVersion);
+  asset.SetFileHashAndVersion(job.m_Processor.m_Descriptor.m_uiAssetHash, job.m_Processor.m_Descriptor.m_uiAssetVersion);
 
   EZ_SUCCEED_OR_RETURN(asset.Write(inout_stream));
 
   ezTexFormat texFormat;
   texFormat.m_bSRGB = ezImageFormat::IsSrgb(image.GetImageFormat());
-  texFormat.m_AddressModeU = m_Processor.m_Descriptor.m_AddressModeU;
-  texFormat.m_AddressModeV = m_Processor.m_Descriptor.m_AddressModeV;
-  texFormat.m_AddressModeW = m_Processor.m_Descriptor.m_AddressModeW;
-  texFormat.m_TextureFilter = m_Processor.m_Descriptor.m_FilterMode;
+  texFormat.m_AddressModeU = job.m_Processor.m_Descriptor.m_AddressModeU;
+  texFormat.m_AddressModeV = job.m_Processor.m_Descriptor.m_AddressModeV;
+  texFormat.m_AddressModeW = job.m_Processor.m_Descriptor.m_AddressModeW;
+  texFormat.m_TextureFilter = job.m_Processor.m_Descriptor.m_FilterMode;
 
   texFormat.WriteTextureHeader(inout_stream);
 
@@ -162,7 +162,7 @@ ezResult ezTexConv::WriteTexFile(ezStreamWriter& inout_stream, const ezImage& im
   return EZ_SUCCESS;
 }
 
-ezResult ezTexConv::WriteOutputFile(ezStringView sFile, const ezImage& image)
+ezResult ezTexConv::WriteOutputFile(const Job& job, ezStringView sFile, const ezImage& image)
 {
   if (sFile.HasExtension("ezImageData"))
   {
@@ -170,7 +170,7 @@ ezResult ezTexConv::WriteOutputFile(ezStringView sFile, const ezImage& image)
     file.SetOutput(sFile);
 
     ezAssetFileHeader asset;
-    asset.SetFileHashAndVersion(m_Processor.m_Descriptor.m_uiAssetHash, m_Processor.m_Descriptor.m_uiAssetVersion);
+    asset.SetFileHashAndVersion(job.m_Processor.m_Descriptor.m_uiAssetHash, job.m_Processor.m_Descriptor.m_uiAssetVersion);
 
     if (asset.Write(file).Failed())
     {
@@ -193,12 +193,12 @@ ezResult ezTexConv::WriteOutputFile(ezStringView sFile, const ezImage& image)
 
     return file.Close();
   }
-  else if (IsTexFormat())
+  else if (IsTexFormat(job))
   {
     ezDeferredFileWriter file;
     file.SetOutput(sFile);
 
-    EZ_SUCCEED_OR_RETURN(WriteTexFile(file, image));
+    EZ_SUCCEED_OR_RETURN(WriteTexFile(job, file, image));
 
     return file.Close();
   }
@@ -208,79 +208,98 @@ ezResult ezTexConv::WriteOutputFile(ezStringView sFile, const ezImage& image)
   }
 }
 
-ezApplication::Execution ezTexConv::Run()
+ezResult ezTexConv::WriteJobOutputs(const Job& job)
 {
-  SetReturnCode(-1);
-
-  if (ParseCommandLine().Failed())
-    return ezApplication::Execution::Quit;
+  const ezTexConvProcessor& processor = job.m_Processor;
 
-  if (m_Processor.Process().Failed())
-    return ezApplication::Execution::Quit;
-
-  if (m_Processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Atlas)
+  if (processor.m_Descriptor.m_OutputType == ezTexConvOutputType::Atlas)
   {
     ezDeferredFileWriter file;
-    file.SetOutput(m_sOutputFile);
+    file.SetOutput(job.m_sOutputFile);
 
     ezAssetFileHeader header;
-    header.SetFileHashAndVersion(m_Processor.m_Descriptor.m_uiAssetHash, m_Processor.m_Descriptor.m_uiAssetVersion);
+    header.SetFileHashAndVersion(processor.m_Descriptor.m_uiAssetHash, processor.m_Descriptor.m_uiAssetVersion);
 
     header.Write(file).IgnoreResult();
 
-    m_Processor.m_TextureAtlas.CopyToStream(file).IgnoreResult();
+    processor.m_TextureAtlas.CopyToStream(file).IgnoreResult();
 
-    if (file.Close().Succeeded())
-    {
-      SetReturnCode(0);
-    }
-    else
+    if (file.Close().Failed())
     {
       ezLog::Error("Failed to write atlas output image.");
+      return EZ_FAILURE;
     }
 
-    return ezApplication::Execution::Quit;
+    return EZ_SUCCESS;
   }
 
-  if (!m_sOutputFile.IsEmpty() && m_Processor.m_OutputImage.IsValid())
+  if (!job.m_sOutputFile.IsEmpty() && processor.m_OutputImage.IsValid())
   {
-    if (WriteOutputFile(m_sOutputFile, m_Processor.m_OutputImage).Failed())
+    if (WriteOutputFile(job, job.m_sOutputFile, processor.m_OutputImage).Failed())
     {
-      ezLog::Error("Failed to write main result to '{}'", m_sOutputFile);
-      return ezApplication::Execution::Quit;
+      ezLog::Error("Failed to write main result to '{}'", job.m_sOutputFile);
+      return EZ_FAILURE;
     }
 
-    ezLog::Success("Wrote main result to '{}'", m_sOutputFile);
+    ezLog::Success("Wrote main result to '{}'", job.m_sOutputFile);
   }
 
-  if (!m_sOutputThumbnailFile.IsEmpty() && m_Processor.m_ThumbnailOutputImage.IsValid())
+  if (!job.m_sOutputThumbnailFile.IsEmpty() && processor.m_ThumbnailOutputImage.IsValid())
   {
-    if (m_Processor.m_ThumbnailOutputImage.SaveTo(m_sOutputThumbnailFile).Failed())
+    if (processor.m_ThumbnailOutputImage.SaveTo(job.m_sOutputThumbnailFile).Failed())
     {
-      ezLog::Error("Failed to write thumbnail result to '{}'", m_sOutputThumbnailFile);
-      return ezApplication::Execution::Quit;
+      ezLog::Error("Failed to write thumbnail result to '{}'", job.m_sOutputThumbnailFile);
+      return EZ_FAILURE;
     }
 
-    ezLog::Success("Wrote thumbnail to '{}'", m_sOutputThumbnailFile);
+    ezLog::Success("Wrote thumbnail to '{}'", job.m_sOutputThumbnailFile);
   }
 
-  if (!m_sOutputLowResFile.IsEmpty())
+  if (!job.m_sOutputLowResFile.IsEmpty())
   {
     // the image may not exist, if we do not have enough mips, so make sure any old low-res file is cleaned up
-    ezOSFile::DeleteFile(m_sOutputLowResFile).IgnoreResult();
+    ezOSFile::DeleteFile(job.m_sOutputLowResFile).IgnoreResult();
 
-    if (m_Processor.m_LowResOutputImage.IsValid())
+    if (processor.m_LowResOutputImage.IsValid())
     {
-      if (WriteOutputFile(m_sOutputLowResFile, m_Processor.m_LowResOutputImage).Failed())
+      if (WriteOutputFile(job, job.m_sOutputLowResFile, processor.m_LowResOutputImage).Failed())
       {
-        ezLog::Error("Failed to write low-res result to '{}'", m_sOutputLowResFile);
-        return ezApplication::Execution::Quit;
+        ezLog::Error("Failed to write low-res result to '{}'", job.m_sOutputLowResFile);
+        return EZ_FAILURE;
       }
 
-      ezLog::Success("Wrote low-res result to '{}'", m_sOutputLowResFile);
+      ezLog::Success("Wrote low-res result to '{}'", job.m_sOutputLowResFile);
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezApplication::Execution ezTexConv::Run()
+{
+  SetReturnCode(-1);
+
+  if (IsBatchMode())
+  {
+    if (RunBatch().Succeeded())
+    {
+      SetReturnCode(0);
     }
+
+    return ezApplication::Execution::Quit;
   }
 
+  m_pJob = EZ_DEFAULT_NEW(Job);
+
+  if (ParseCommandLine().Failed())
+    return ezApplication::Execution::Quit;
+
+  if (m_pJob->m_Processor.Process().Failed())
+    return ezApplication::Execution::Quit;
+
+  if (WriteJobOutputs(*m_pJob).Failed())
+    return ezApplication::Execution::Quit;
+
   SetReturnCode(0);
   return ezApplication::Execution::Quit;
 }
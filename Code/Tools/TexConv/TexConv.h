@@ -21,6 +21,24 @@ public:
     ezInt32 m_iEnumValue = -1;
   };
 
+  /// \brief Everything that is needed to execute one conversion. Filled out by ParseCommandLine().
+  struct Job
+  {
+    ezString m_sOutputFile;
+    ezString m_sOutputThumbnailFile;
+    ezString m_sOutputLowResFile;
+
+    bool m_bOutputSupports2D = false;
+    bool m_bOutputSupports3D = false;
+    bool m_bOutputSupportsCube = false;
+    bool m_bOutputSupportsAtlas = false;
+    bool m_bOutputSupportsMipmaps = false;
+    bool m_bOutputSupportsFiltering = false;
+    bool m_bOutputSupportsCompression = false;
+
+    ezTexConvProcessor m_Processor;
+  };
+
   ezTexConv();
 
 public:
@@ -54,22 +72,18 @@ public:
   void PrintOptionValuesHelp(ezStringView sOption, const ezDynamicArray<KeyEnumValuePair>& allowed) const;
   bool ParseFile(ezStringView sOption, ezString& ref_sResult) const;
 
-  bool IsTexFormat() const;
-  ezResult WriteTexFile(ezStreamWriter& inout_stream, const ezImage& image);
-  ezResult WriteOutputFile(ezStringView sFile, const ezImage& image);
+  static bool IsTexFormat(const Job& job);
+  static ezResult WriteTexFile(const Job& job, ezStreamWriter& inout_stream, const ezImage& image);
+  static ezResult WriteOutputFile(const Job& job, ezStringView sFile, const ezImage& image);
+  static ezResult WriteJobOutputs(const Job& job);
+
+  /// \brief Returns true if a batch file was passed with -batch.
+  bool IsBatchMode() const;
+
+  /// \brief Converts all command lines of the batch file in parallel. Outputs that are up to date are skipped.
+  ezResult RunBatch();
 
 private:
-  ezString m_sOutputFile;
-  ezString m_sOutputThumbnailFile;
-  ezString m_sOutputLowResFile;
-
-  bool m_bOutputSupports2D = false;
-  bool m_bOutputSupports3D = false;
-  bool m_bOutputSupportsCube = false;
-  bool m_bOutputSupportsAtlas = false;
-  bool m_bOutputSupportsMipmaps = false;
-  bool m_bOutputSupportsFiltering = false;
-  bool m_bOutputSupportsCompression = false;
-
-  ezTexConvProcessor m_Processor;
+  /// The job that ParseCommandLine() fills out.
+  ezUniquePtr<Job> m_pJob;
 };
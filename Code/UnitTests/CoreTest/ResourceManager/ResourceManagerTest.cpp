@@ -1,6 +1,8 @@
 #include <CoreTest/CoreTestPCH.h>
 
 #include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Types/ScopeExit.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(ResourceManager);
@@ -23,6 +25,9 @@ namespace
   protected:
     virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override
     {
+      m_Data.Clear();
+      m_Data.Compact();
+
       ezResourceLoadDesc ld;
       ld.m_State = ezResourceState::Unloaded;
       ld.m_uiQualityLevelsDiscardable = 0;
@@ -69,7 +74,7 @@ namespace
 
     virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override
     {
-      out_NewMemoryUsage.m_uiMemoryCPU = sizeof(TestResource);
+      out_NewMemoryUsage.m_uiMemoryCPU = sizeof(TestResource) + m_Data.GetHeapMemoryUsage();
       out_NewMemoryUsage.m_uiMemoryGPU = 0;
     }
 
@@ -286,3 +291,297 @@ EZ_CREATE_SIMPLE_TEST(ResourceManager, NestedLoading)
     EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
   }
 }
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(ResourceManager, ConcurrentLookup)
+{
+  TestResourceTypeLoader TypeLoader;
+  ezResourceManager::SetResourceTypeLoader<TestResource>(&TypeLoader);
+  EZ_SCOPE_EXIT(ezResourceManager::SetResourceTypeLoader<TestResource>(nullptr));
+
+  const ezUInt32 uiNumResources = 64;
+
+  ezDynamicArray<TestResourceHandle> hResources;
+  ezStringBuilder sResourceID;
+  for (ezUInt32 i = 0; i < uiNumResources; ++i)
+  {
+    sResourceID.Format("Lookup-{}", i);
+    hResources.PushBack(ezResourceManager::LoadResource<TestResource>(sResourceID));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel Lookups")
+  {
+    ezAtomicInteger32 iNumMismatches;
+
+    ezTaskSystem::ParallelForIndexed(0u, 1024u * 16, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) //
+      {
+        ezStringBuilder sID;
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          const ezUInt32 uiResource = i % uiNumResources;
+          sID.Format("Lookup-{}", uiResource);
+
+          TestResourceHandle hLoaded = ezResourceManager::LoadResource<TestResource>(sID);
+          TestResourceHandle hExisting = ezResourceManager::GetExistingResource<TestResource>(sID);
+
+          if (hLoaded != hResources[uiResource] || hExisting != hResources[uiResource])
+          {
+            iNumMismatches.Increment();
+          }
+        }
+        //
+      });
+
+    EZ_TEST_INT(iNumMismatches, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Lookups While Freeing")
+  {
+    hResources.Clear();
+
+    ezAtomicInteger32 iStop;
+    ezAtomicInteger32 iNumMismatches;
+
+    auto lookupFunc = [&]()
+    {
+      ezStringBuilder sID;
+      for (ezUInt32 i = 0; iStop == 0; ++i)
+      {
+        sID.Format("Lookup-{}", i % uiNumResources);
+
+        TestResourceHandle hExisting = ezResourceManager::GetExistingResource<TestResource>(sID);
+        if (hExisting.IsValid())
+        {
+          // the resource must still be alive
+          if (hExisting.GetResourceID() != sID)
+          {
+            iNumMismatches.Increment();
+          }
+        }
+      }
+    };
+
+    ezTaskGroupID group = ezTaskSystem::CreateTaskGroup(ezTaskPriority::LongRunning);
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      ezTaskSystem::AddTaskToGroup(group, EZ_DEFAULT_NEW(ezDelegateTask<void>, "Lookup", ezTaskNesting::Never, lookupFunc));
+    }
+    ezTaskSystem::StartTaskGroup(group);
+
+    for (ezUInt32 i = 0; i < 100 && !ezResourceManager::GetAllResourcesOfType<TestResource>()->IsEmpty(); ++i)
+    {
+      ezResourceManager::FreeAllUnusedResources();
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1));
+    }
+
+    iStop = 1;
+    ezTaskSystem::WaitForGroup(group);
+
+    EZ_TEST_INT(iNumMismatches, 0);
+
+    ezResourceManager::FreeAllUnusedResources();
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Lookup Contention")
+  {
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      sResourceID.Format("Lookup-{}", i);
+      hResources.PushBack(ezResourceManager::LoadResource<TestResource>(sResourceID));
+    }
+
+    // typical for extraction: many components resolving handles to the same few resources
+    ezDynamicArray<ezHashedString> ids;
+    for (ezUInt32 i = 0; i < 1024 * 64; ++i)
+    {
+      sResourceID.Format("Lookup-{}", i % uiNumResources);
+      ids.ExpandAndGetRef().Assign(sResourceID);
+    }
+
+    const ezUInt32 threadCounts[] = {1, 2, 4, 8, 16, 32};
+
+    for (ezUInt32 uiThreads : threadCounts)
+    {
+      ezTaskSystem::SetWorkerThreadCount(uiThreads, 2);
+
+      for (ezUInt32 uiMode = 0; uiMode < 2; ++uiMode)
+      {
+        const bool bLocked = uiMode == 0;
+
+        ezParallelForParams params;
+        params.m_uiBinSize = 256;
+
+        const ezTime t0 = ezTime::Now();
+
+        ezTaskSystem::ParallelFor<const ezHashedString>(
+          ids.GetArrayPtr(), [bLocked](ezArrayPtr<const ezHashedString> items) //
+          {
+            for (const ezHashedString& sID : items)
+            {
+              if (bLocked)
+              {
+                // what every lookup had to do before
+                EZ_LOCK(ezResourceManager::GetMutex());
+                TestResourceHandle hResource = ezResourceManager::GetExistingResource<TestResource>(sID);
+              }
+              else
+              {
+                TestResourceHandle hResource = ezResourceManager::LoadResource<TestResource>(sID);
+              }
+            }
+            //
+          },
+          "LookupContention", params);
+
+        const ezTime t1 = ezTime::Now();
+
+        ezLog::Info("[test]{0} threads, {1}: {2} lookups/ms", uiThreads, bLocked ? "Global Mutex" : "Registry", ezArgF(ids.GetCount() / (t1 - t0).GetMilliseconds(), 1));
+      }
+    }
+
+    ezTaskSystem::SetWorkerThreadCount();
+
+    hResources.Clear();
+    ezResourceManager::FreeAllUnusedResources();
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(ResourceManager, MemoryBudget)
+{
+  TestResourceTypeLoader TypeLoader;
+  ezResourceManager::SetResourceTypeLoader<TestResource>(&TypeLoader);
+  EZ_SCOPE_EXIT(ezResourceManager::SetResourceTypeLoader<TestResource>(nullptr));
+  EZ_SCOPE_EXIT(ezResourceManager::SetResourceTypeMemoryBudget<TestResource>({}));
+  EZ_SCOPE_EXIT(ezResourceManager::SetMemoryBudget({}));
+  EZ_SCOPE_EXIT(ezResourceManager::SetMemoryBudgetUnloadThreshold(ezTime::MakeZero()));
+
+  const ezUInt32 uiNumResources = 20;
+
+  ezDynamicArray<TestResourceHandle> hResources;
+  ezUInt64 uiLoadedSize = 0;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Budget Settings")
+  {
+    ezResourceMemoryBudget budget;
+    budget.m_uiMaxMemoryCPU = 1024;
+    budget.m_uiMaxMemoryGPU = 2048;
+
+    ezResourceManager::SetMemoryBudget(budget);
+    EZ_TEST_INT(ezResourceManager::GetMemoryBudget().m_uiMaxMemoryCPU, 1024);
+    EZ_TEST_INT(ezResourceManager::GetMemoryBudget().m_uiMaxMemoryGPU, 2048);
+    EZ_TEST_INT(ezResourceManager::GetMemoryBudgetStats().m_Budget.m_uiMaxMemoryCPU, 1024);
+
+    ezResourceManager::SetMemoryBudget({});
+    EZ_TEST_BOOL(ezResourceManager::GetMemoryBudget().IsUnlimited());
+
+    ezResourceManager::SetResourceTypeMemoryBudget<TestResource>(budget);
+    EZ_TEST_INT(ezResourceManager::GetResourceTypeMemoryBudget(ezGetStaticRTTI<TestResource>()).m_uiMaxMemoryCPU, 1024);
+
+    ezResourceManager::SetResourceTypeMemoryBudget<TestResource>({});
+    EZ_TEST_BOOL(ezResourceManager::GetResourceTypeMemoryBudget(ezGetStaticRTTI<TestResource>()).IsUnlimited());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Delete Unreferenced")
+  {
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
+
+    ezStringBuilder sResourceID;
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      sResourceID.Format("Budget-{}", i);
+      hResources.PushBack(ezResourceManager::LoadResource<TestResource>(sResourceID));
+
+      ezResourceLock<TestResource> pTestResource(hResources[i], ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+      EZ_TEST_BOOL(pTestResource.GetAcquireResult() == ezResourceAcquireResult::Final);
+    }
+
+    // resources that are still being finalized by a loading task are not evicted
+    while (ezResourceManager::IsAnyLoadingInProgress())
+    {
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(10));
+    }
+
+    const ezResourceMemoryBudgetStats statsBefore = ezResourceManager::GetMemoryBudgetStats(ezGetStaticRTTI<TestResource>());
+    EZ_TEST_INT(statsBefore.m_uiNumResources, uiNumResources);
+
+    uiLoadedSize = statsBefore.m_uiMemoryCPU / uiNumResources;
+    EZ_TEST_BOOL(uiLoadedSize > sizeof(TestResource));
+
+    // release the first half
+    for (ezUInt32 i = 0; i < uiNumResources / 2; ++i)
+    {
+      hResources[i].Invalidate();
+    }
+
+    ezResourceMemoryBudget budget;
+    budget.m_uiMaxMemoryCPU = 5 * uiLoadedSize;
+    ezResourceManager::SetResourceTypeMemoryBudget<TestResource>(budget);
+
+    // referenced resources can't be evicted without an unload threshold, so all unreferenced ones get deleted and the budget is still exceeded
+    EZ_TEST_INT(ezResourceManager::EnforceMemoryBudgets(), uiNumResources / 2);
+
+    const ezResourceMemoryBudgetStats statsAfter = ezResourceManager::GetMemoryBudgetStats(ezGetStaticRTTI<TestResource>());
+    EZ_TEST_INT(statsAfter.m_uiNumResources, uiNumResources / 2);
+    EZ_TEST_INT(statsAfter.m_uiMemoryCPU, uiNumResources / 2 * uiLoadedSize);
+    EZ_TEST_INT(statsAfter.m_uiNumEvicted - statsBefore.m_uiNumEvicted, uiNumResources / 2);
+    EZ_TEST_INT(statsAfter.m_uiNumTimesExceeded - statsBefore.m_uiNumTimesExceeded, 1);
+    EZ_TEST_BOOL(statsAfter.m_bOverBudget);
+
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), uiNumResources / 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Unload Referenced")
+  {
+    // critical resources must never be evicted
+    const TestResourceHandle& hCritical = hResources[uiNumResources / 2];
+    {
+      ezResourceLock<TestResource> pTestResource(hCritical, ezResourceAcquireMode::PointerOnly);
+      pTestResource->SetPriority(ezResourcePriority::Critical);
+    }
+
+    ezResourceManager::SetMemoryBudgetUnloadThreshold(ezTime::MakeFromMilliseconds(1));
+    ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(10));
+
+    EZ_TEST_BOOL(ezResourceManager::EnforceMemoryBudgets() > 0);
+
+    const ezResourceMemoryBudgetStats stats = ezResourceManager::GetMemoryBudgetStats(ezGetStaticRTTI<TestResource>());
+    EZ_TEST_INT(stats.m_uiNumResources, uiNumResources / 2);
+    EZ_TEST_BOOL(stats.m_uiMemoryCPU <= 5 * uiLoadedSize);
+
+    EZ_TEST_BOOL(ezResourceManager::GetLoadingState(hCritical) == ezResourceState::Loaded);
+
+    // now within budget
+    EZ_TEST_INT(ezResourceManager::EnforceMemoryBudgets(), 0);
+    EZ_TEST_BOOL(!ezResourceManager::GetMemoryBudgetStats(ezGetStaticRTTI<TestResource>()).m_bOverBudget);
+
+    // unloaded resources get loaded again on demand
+    for (ezUInt32 i = uiNumResources / 2; i < uiNumResources; ++i)
+    {
+      ezResourceLock<TestResource> pTestResource(hResources[i], ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+      EZ_TEST_BOOL(pTestResource.GetAcquireResult() == ezResourceAcquireResult::Final);
+
+      pTestResource->Test();
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Global Budget")
+  {
+    ezResourceManager::SetResourceTypeMemoryBudget<TestResource>({});
+    ezResourceManager::SetMemoryBudgetUnloadThreshold(ezTime::MakeZero());
+
+    hResources.Clear();
+
+    ezResourceMemoryBudget budget;
+    budget.m_uiMaxMemoryCPU = 1;
+    ezResourceManager::SetMemoryBudget(budget);
+
+    ezResourceManager::EnforceMemoryBudgets();
+    EZ_TEST_BOOL(ezResourceManager::GetMemoryBudgetStats().m_bOverBudget);
+
+    // everything that is unreferenced got deleted
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
+  }
+}
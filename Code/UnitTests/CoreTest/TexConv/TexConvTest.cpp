@@ -4,6 +4,7 @@
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/OSFile.h>
 #include <Foundation/System/Process.h>
 #include <Foundation/System/ProcessGroup.h>
 #include <Texture/Image/Image.h>
@@ -29,6 +30,7 @@ private:
     LinearUsage,
     ExtractChannel,
     TGA,
+    Batch,
   };
 
   virtual void SetupSubTests() override;
@@ -65,7 +67,7 @@ private:
     return EZ_SUCCESS;
   }
 
-  void RunTexConv(ezProcessOptions& options, const char* szOutName)
+  bool LaunchTexConv(ezProcessOptions& options)
   {
 #  if EZ_ENABLED(EZ_PLATFORM_WINDOWS)
     const char* szTexConvExecutableName = "TexConv.exe";
@@ -77,25 +79,48 @@ private:
     sTexConvExe.MakeCleanPath();
 
     if (!EZ_TEST_BOOL_MSG(ezOSFile::ExistsFile(sTexConvExe), "%s does not exist", szTexConvExecutableName))
-      return;
+      return false;
 
     options.m_sProcess = sTexConvExe;
 
+    if (!EZ_TEST_BOOL(m_pState->m_TexConvGroup.Launch(options).Succeeded()))
+      return false;
+
+    if (!EZ_TEST_BOOL_MSG(m_pState->m_TexConvGroup.WaitToFinish(ezTime::MakeFromMinutes(1.0)).Succeeded(), "TexConv did not finish in time."))
+      return false;
+
+    return EZ_TEST_INT_MSG(m_pState->m_TexConvGroup.GetProcesses().PeekBack().GetExitCode(), 0, "TexConv failed to process the image");
+  }
+
+  void RunTexConv(ezProcessOptions& options, const char* szOutName)
+  {
     ezStringBuilder sOut = ezTestFramework::GetInstance()->GetAbsOutputPath();
     sOut.AppendPath("Temp", szOutName);
 
     options.AddArgument("-out");
     options.AddArgument(sOut);
 
-    if (!EZ_TEST_BOOL(m_pState->m_TexConvGroup.Launch(options).Succeeded()))
+    if (!LaunchTexConv(options))
       return;
 
-    if (!EZ_TEST_BOOL_MSG(m_pState->m_TexConvGroup.WaitToFinish(ezTime::MakeFromMinutes(1.0)).Succeeded(), "TexConv did not finish in time."))
-      return;
+    m_pState->m_image.LoadFrom(sOut).IgnoreResult();
+  }
 
-    EZ_TEST_INT_MSG(m_pState->m_TexConvGroup.GetProcesses().PeekBack().GetExitCode(), 0, "TexConv failed to process the image");
+  bool RunTexConvBatch(ezStringView sBatchFile, ezStringView sContent)
+  {
+    {
+      ezOSFile file;
+      if (!EZ_TEST_BOOL(file.Open(sBatchFile, ezFileOpenMode::Write).Succeeded()))
+        return false;
 
-    m_pState->m_image.LoadFrom(sOut).IgnoreResult();
+      file.Write(sContent.GetStartPointer(), sContent.GetElementCount()).IgnoreResult();
+    }
+
+    ezProcessOptions opt;
+    opt.AddArgument("-batch");
+    opt.AddArgument(sBatchFile);
+
+    return LaunchTexConv(opt);
   }
 
   struct State
@@ -114,6 +139,7 @@ void ezTexConvTest::SetupSubTests()
   AddSubTest("Linear Usage", SubTest::LinearUsage);
   AddSubTest("Extract Channel", SubTest::ExtractChannel);
   AddSubTest("TGA loading", SubTest::TGA);
+  AddSubTest("Batch", SubTest::Batch);
 }
 
 ezTestAppRun ezTexConvTest::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount)
@@ -307,6 +333,60 @@ ezTestAppRun ezTexConvTest::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocatio
     }
   }
 
+  if (iIdentifier == SubTest::Batch)
+  {
+    ezStringBuilder sTempDir = ezTestFramework::GetInstance()->GetAbsOutputPath();
+    sTempDir.AppendPath("Temp");
+    ezOSFile::CreateDirectoryStructure(sTempDir).IgnoreResult();
+
+    const ezStringBuilder sBatchFile(sTempDir, "/Batch.txt");
+    const ezStringBuilder sCacheFile(sBatchFile, ".cache");
+    const ezStringBuilder sOutA(sTempDir, "/BatchA.dds");
+    const ezStringBuilder sOutB(sTempDir, "/BatchB.dds");
+
+    ezOSFile::DeleteFile(sCacheFile).IgnoreResult();
+
+    // both conversions use the same input file, which is only decoded once
+    ezStringBuilder sBatch;
+    sBatch.AppendFormat("# comments and empty lines are ignored\n\n");
+    sBatch.AppendFormat("-in0 \"{}\" -rgba in0 -usage linear -mipmaps none -compression none -out \"{}\"\n", sPathEZ, sOutA);
+    sBatch.AppendFormat("-in0 \"{}\" -r in0.r -usage linear -mipmaps none -compression none -out \"{}\"\n", sPathEZ, sOutB);
+
+    if (RunTexConvBatch(sBatchFile, sBatch))
+    {
+      EZ_TEST_BOOL(ezOSFile::ExistsFile(sOutA));
+      EZ_TEST_BOOL(ezOSFile::ExistsFile(sOutB));
+      EZ_TEST_BOOL(ezOSFile::ExistsFile(sCacheFile));
+    }
+
+    ezFileStats statsA, statsB;
+    EZ_TEST_BOOL(ezOSFile::GetFileStats(sOutA, statsA).Succeeded());
+    EZ_TEST_BOOL(ezOSFile::GetFileStats(sOutB, statsB).Succeeded());
+
+    // nothing changed, so nothing is written
+    if (RunTexConvBatch(sBatchFile, sBatch))
+    {
+      ezFileStats stats;
+      EZ_TEST_BOOL(ezOSFile::GetFileStats(sOutA, stats).Succeeded() && stats.m_LastModificationTime.Compare(statsA.m_LastModificationTime, ezTimestamp::CompareMode::Identical));
+      EZ_TEST_BOOL(ezOSFile::GetFileStats(sOutB, stats).Succeeded() && stats.m_LastModificationTime.Compare(statsB.m_LastModificationTime, ezTimestamp::CompareMode::Identical));
+    }
+
+    // only the conversion with changed options is executed again
+    sBatch.Clear();
+    sBatch.AppendFormat("-in0 \"{}\" -rgba in0 -usage linear -mipmaps none -compression none -out \"{}\"\n", sPathEZ, sOutA);
+    sBatch.AppendFormat("-in0 \"{}\" -r in0.r -usage linear -mipmaps none -compression none -maxRes 64 -out \"{}\"\n", sPathEZ, sOutB);
+
+    if (RunTexConvBatch(sBatchFile, sBatch))
+    {
+      ezFileStats stats;
+      EZ_TEST_BOOL(ezOSFile::GetFileStats(sOutA, stats).Succeeded() && stats.m_LastModificationTime.Compare(statsA.m_LastModificationTime, ezTimestamp::CompareMode::Identical));
+
+      ezImage img;
+      EZ_TEST_BOOL(img.LoadFrom(sOutB).Succeeded());
+      EZ_TEST_INT(img.GetWidth(), 64);
+    }
+  }
+
   return ezTestAppRun::Quit;
 }
 
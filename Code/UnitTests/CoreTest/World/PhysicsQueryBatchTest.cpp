@@ -0,0 +1,267 @@
+#include <CoreTest/CoreTestPCH.h>
+
+#include <Core/Interfaces/PhysicsWorldModule.h>
+#include <Core/World/World.h>
+
+namespace
+{
+  /// The only obstacle is a static sphere with radius 1 at the origin. Swept boxes and capsules are approximated by their bounding spheres.
+  class TestPhysicsWorldModule : public ezPhysicsWorldModuleInterface
+  {
+  public:
+    TestPhysicsWorldModule(ezWorld* pWorld)
+      : ezPhysicsWorldModuleInterface(pWorld)
+    {
+    }
+
+    ~TestPhysicsWorldModule() = default;
+
+    virtual bool Raycast(ezPhysicsCastResult& out_result, const ezVec3& vStart, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection) const override
+    {
+      return CastSphere(out_result, 0.0f, vStart, vDir, fDistance);
+    }
+
+    virtual bool RaycastAll(ezPhysicsCastResultArray& out_results, const ezVec3& vStart, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params) const override
+    {
+      out_results.m_Results.Clear();
+
+      ezPhysicsCastResult result;
+      if (!CastSphere(result, 0.0f, vStart, vDir, fDistance))
+        return false;
+
+      out_results.m_Results.PushBack(result);
+      return true;
+    }
+
+    virtual bool SweepTestSphere(ezPhysicsCastResult& out_result, float fSphereRadius, const ezVec3& vStart, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection) const override
+    {
+      return CastSphere(out_result, fSphereRadius, vStart, vDir, fDistance);
+    }
+
+    virtual bool SweepTestBox(ezPhysicsCastResult& out_result, ezVec3 vBoxExtends, const ezTransform& transform, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection) const override
+    {
+      return CastSphere(out_result, vBoxExtends.GetLength() * 0.5f, transform.m_vPosition, vDir, fDistance);
+    }
+
+    virtual bool SweepTestCapsule(ezPhysicsCastResult& out_result, float fCapsuleRadius, float fCapsuleHeight, const ezTransform& transform, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection) const override
+    {
+      return CastSphere(out_result, fCapsuleRadius + fCapsuleHeight * 0.5f, transform.m_vPosition, vDir, fDistance);
+    }
+
+    virtual bool OverlapTestSphere(float fSphereRadius, const ezVec3& vPosition, const ezPhysicsQueryParameters& params) const override
+    {
+      return vPosition.GetLength() < 1.0f + fSphereRadius;
+    }
+
+    virtual bool OverlapTestBox(ezVec3 vBoxExtends, const ezTransform& transform, const ezPhysicsQueryParameters& params) const override
+    {
+      const ezVec3 vHalfExtents = vBoxExtends * 0.5f;
+      const ezVec3 vLocalCenter = transform.GetInverse().TransformPosition(ezVec3::MakeZero());
+      const ezVec3 vClosest = vLocalCenter.CompMax(-vHalfExtents).CompMin(vHalfExtents);
+
+      return (vClosest - vLocalCenter).GetLength() < 1.0f;
+    }
+
+    virtual bool OverlapTestCapsule(float fCapsuleRadius, float fCapsuleHeight, const ezTransform& transform, const ezPhysicsQueryParameters& params) const override
+    {
+      const ezVec3 vLocalCenter = transform.GetInverse().TransformPosition(ezVec3::MakeZero());
+      const float fHalfHeight = fCapsuleHeight * 0.5f;
+      const ezVec3 vClosest(0, 0, ezMath::Clamp(vLocalCenter.z, -fHalfHeight, fHalfHeight));
+
+      return (vClosest - vLocalCenter).GetLength() < 1.0f + fCapsuleRadius;
+    }
+
+    virtual void QueryShapesInSphere(ezPhysicsOverlapResultArray& out_results, float fSphereRadius, const ezVec3& vPosition, const ezPhysicsQueryParameters& params) const override
+    {
+      out_results.m_Results.Clear();
+
+      if (OverlapTestSphere(fSphereRadius, vPosition, params))
+      {
+        out_results.m_Results.ExpandAndGetRef().m_vCenterPosition = ezVec3::MakeZero();
+      }
+    }
+
+    virtual ezVec3 GetGravity() const override { return ezVec3(0, 0, -10); }
+
+  private:
+    static bool CastSphere(ezPhysicsCastResult& out_result, float fRadius, const ezVec3& vStart, const ezVec3& vDir, float fDistance)
+    {
+      const float fCombinedRadius = 1.0f + fRadius;
+      const float b = vStart.Dot(vDir);
+      const float c = vStart.GetLengthSquared() - fCombinedRadius * fCombinedRadius;
+      const float fDiscriminant = b * b - c;
+
+      if (fDiscriminant < 0.0f)
+        return false;
+
+      const float fHitDistance = ezMath::Max(-b - ezMath::Sqrt(fDiscriminant), 0.0f);
+      if (fHitDistance > fDistance || -b + ezMath::Sqrt(fDiscriminant) < 0.0f)
+        return false;
+
+      const ezVec3 vCenter = vStart + vDir * fHitDistance;
+      out_result.m_fDistance = fHitDistance;
+      out_result.m_vNormal = vCenter.GetNormalized();
+      out_result.m_vPosition = out_result.m_vNormal;
+      return true;
+    }
+  };
+
+  void CheckCastResults(bool bHitBatch, const ezPhysicsCastResult& batchResult, bool bHitSingle, const ezPhysicsCastResult& singleResult)
+  {
+    EZ_TEST_BOOL(bHitBatch == bHitSingle);
+
+    if (bHitBatch && bHitSingle)
+    {
+      EZ_TEST_FLOAT(batchResult.m_fDistance, singleResult.m_fDistance, 0.0f);
+      EZ_TEST_VEC3(batchResult.m_vPosition, singleResult.m_vPosition, 0.0f);
+      EZ_TEST_VEC3(batchResult.m_vNormal, singleResult.m_vNormal, 0.0f);
+    }
+  }
+
+  ezPhysicsQueryShape MakeQueryShape(ezUInt32 i, const ezVec3& vPosition)
+  {
+    ezPhysicsQueryShape shape;
+    shape.m_Type = static_cast<ezPhysicsQueryShape::Type>(i % 3);
+    shape.m_fRadius = 0.25f;
+    shape.m_fCapsuleHeight = 1.0f;
+    shape.m_vBoxExtents = ezVec3(0.5f, 1.0f, 1.5f);
+    shape.m_Transform = ezTransform(vPosition, ezQuat::MakeFromAxisAndAngle(ezVec3(0, 0, 1), ezAngle::MakeFromDegree(i * 15.0f)));
+    return shape;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, PhysicsQueryBatch)
+{
+  ezWorldDesc worldDesc("Test");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  TestPhysicsWorldModule testModule(&world);
+  const ezPhysicsWorldModuleInterface& module = testModule;
+  const ezPhysicsQueryParameters params;
+
+  // positions on a line through the obstacle, some overlap it, some don't
+  constexpr ezUInt32 uiNumQueries = 30;
+  ezVec3 positions[uiNumQueries];
+  for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+  {
+    positions[i] = ezVec3(-3.0f + i * 0.2f, 0.1f * (i % 4), 0.3f * (i % 3));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RaycastBatch")
+  {
+    ezDynamicArray<ezPhysicsRaycastQuery> queries;
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      ezPhysicsRaycastQuery& query = queries.ExpandAndGetRef();
+      query.m_vStart = positions[i] + ezVec3(0, 0, 5);
+      query.m_vDir = ezVec3(0, 0, -1);
+      query.m_fDistance = 2.0f + (i % 5);
+    }
+
+    ezDynamicArray<ezPhysicsCastResult> results;
+    results.SetCount(uiNumQueries);
+    ezDynamicArray<bool> hits;
+    hits.SetCount(uiNumQueries);
+
+    module.RaycastBatch(results, hits, queries, params);
+
+    ezUInt32 uiNumHits = 0;
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      ezPhysicsCastResult singleResult;
+      const bool bHit = module.Raycast(singleResult, queries[i].m_vStart, queries[i].m_vDir, queries[i].m_fDistance, params);
+
+      CheckCastResults(hits[i], results[i], bHit, singleResult);
+      uiNumHits += bHit ? 1 : 0;
+    }
+
+    EZ_TEST_BOOL(uiNumHits > 0 && uiNumHits < uiNumQueries);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SweepTestBatch")
+  {
+    ezDynamicArray<ezPhysicsSweepQuery> queries;
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      ezPhysicsSweepQuery& query = queries.ExpandAndGetRef();
+      query.m_Shape = MakeQueryShape(i, positions[i] + ezVec3(0, 0, 5));
+      query.m_vDir = ezVec3(0, 0, -1);
+      query.m_fDistance = 2.0f + (i % 5);
+    }
+
+    ezDynamicArray<ezPhysicsCastResult> results;
+    results.SetCount(uiNumQueries);
+    ezDynamicArray<bool> hits;
+    hits.SetCount(uiNumQueries);
+
+    module.SweepTestBatch(results, hits, queries, params);
+
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      const ezPhysicsSweepQuery& query = queries[i];
+      const ezPhysicsQueryShape& shape = query.m_Shape;
+
+      ezPhysicsCastResult singleResult;
+      bool bHit = false;
+
+      switch (shape.m_Type)
+      {
+        case ezPhysicsQueryShape::Type::Sphere:
+          bHit = module.SweepTestSphere(singleResult, shape.m_fRadius, shape.m_Transform.m_vPosition, query.m_vDir, query.m_fDistance, params);
+          break;
+        case ezPhysicsQueryShape::Type::Box:
+          bHit = module.SweepTestBox(singleResult, shape.m_vBoxExtents, shape.m_Transform, query.m_vDir, query.m_fDistance, params);
+          break;
+        case ezPhysicsQueryShape::Type::Capsule:
+          bHit = module.SweepTestCapsule(singleResult, shape.m_fRadius, shape.m_fCapsuleHeight, shape.m_Transform, query.m_vDir, query.m_fDistance, params);
+          break;
+      }
+
+      CheckCastResults(hits[i], results[i], bHit, singleResult);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "OverlapTestBatch")
+  {
+    ezDynamicArray<ezPhysicsQueryShape> shapes;
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      shapes.PushBack(MakeQueryShape(i, positions[i]));
+    }
+
+    ezDynamicArray<bool> overlaps;
+    overlaps.SetCount(uiNumQueries);
+
+    module.OverlapTestBatch(overlaps, shapes, params);
+
+    ezUInt32 uiNumOverlaps[3] = {};
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      const ezPhysicsQueryShape& shape = shapes[i];
+      bool bOverlap = false;
+
+      switch (shape.m_Type)
+      {
+        case ezPhysicsQueryShape::Type::Sphere:
+          bOverlap = module.OverlapTestSphere(shape.m_fRadius, shape.m_Transform.m_vPosition, params);
+          break;
+        case ezPhysicsQueryShape::Type::Box:
+          bOverlap = module.OverlapTestBox(shape.m_vBoxExtents, shape.m_Transform, params);
+          break;
+        case ezPhysicsQueryShape::Type::Capsule:
+          bOverlap = module.OverlapTestCapsule(shape.m_fRadius, shape.m_fCapsuleHeight, shape.m_Transform, params);
+          break;
+      }
+
+      EZ_TEST_BOOL(overlaps[i] == bOverlap);
+      uiNumOverlaps[static_cast<ezUInt32>(shape.m_Type)] += bOverlap ? 1 : 0;
+    }
+
+    // every shape type, boxes included, must have been tested with both outcomes
+    for (ezUInt32 uiType = 0; uiType < 3; ++uiType)
+    {
+      EZ_TEST_BOOL(uiNumOverlaps[uiType] > 0 && uiNumOverlaps[uiType] < uiNumQueries / 3);
+    }
+  }
+}
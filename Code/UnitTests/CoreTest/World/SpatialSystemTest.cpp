@@ -293,6 +293,141 @@ EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
     }
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindVisibleObjectsMultiView")
+  {
+    queryParams.m_uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
+
+    // the six faces of a cube map
+    const ezVec3 dirs[] = {ezVec3(1, 0, 0), ezVec3(-1, 0, 0), ezVec3(0, 1, 0), ezVec3(0, -1, 0), ezVec3(0, 0, 1), ezVec3(0, 0, -1)};
+    const ezVec3 ups[] = {ezVec3(0, 0, 1), ezVec3(0, 0, 1), ezVec3(0, 0, 1), ezVec3(0, 0, 1), ezVec3(1, 0, 0), ezVec3(1, 0, 0)};
+
+    ezMat4 projection = ezGraphicsUtils::CreatePerspectiveProjectionMatrixFromFovX(ezAngle::MakeFromDegree(90.0f), 1.0f, 1.0f, 8000.0f);
+
+    ezFrustum frusta[EZ_ARRAY_SIZE(dirs)];
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(dirs); ++i)
+    {
+      ezMat4 lookAt = ezGraphicsUtils::CreateLookAtViewMatrix(ezVec3(100, 200, 300), ezVec3(100, 200, 300) + dirs[i], ups[i]);
+      frusta[i] = ezFrustum::MakeFromMVP(projection * lookAt);
+    }
+
+    ezDynamicArray<const ezGameObject*> visibleObjects;
+    ezDynamicArray<ezUInt32> visibilityMasks;
+    world.GetSpatialSystem()->FindVisibleObjectsMultiView(ezMakeArrayPtr(frusta), queryParams, visibleObjects, visibilityMasks, ezVisibilityState::Indirect);
+
+    EZ_TEST_INT(visibleObjects.GetCount(), visibilityMasks.GetCount());
+    EZ_TEST_BOOL(!visibleObjects.IsEmpty());
+
+    ezHashTable<const ezGameObject*, ezUInt32> objectToMask;
+    for (ezUInt32 i = 0; i < visibleObjects.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(visibilityMasks[i] != 0);
+      EZ_TEST_BOOL(!objectToMask.Insert(visibleObjects[i], visibilityMasks[i]));
+    }
+
+    // must give exactly the same result as individual queries
+    ezDynamicArray<const ezGameObject*> singleViewObjects;
+    ezUInt32 uiNumSingleViewResults = 0;
+
+    for (ezUInt32 uiView = 0; uiView < EZ_ARRAY_SIZE(frusta); ++uiView)
+    {
+      singleViewObjects.Clear();
+      world.GetSpatialSystem()->FindVisibleObjects(frusta[uiView], queryParams, singleViewObjects, {}, ezVisibilityState::Indirect);
+
+      for (const ezGameObject* pObject : singleViewObjects)
+      {
+        ezUInt32 uiMask = 0;
+        EZ_TEST_BOOL(objectToMask.TryGetValue(pObject, uiMask));
+        EZ_TEST_BOOL((uiMask & EZ_BIT(uiView)) != 0);
+      }
+
+      uiNumSingleViewResults += singleViewObjects.GetCount();
+    }
+
+    ezUInt32 uiNumMultiViewResults = 0;
+    for (ezUInt32 uiMask : visibilityMasks)
+    {
+      uiNumMultiViewResults += ezMath::CountBits(uiMask);
+    }
+
+    EZ_TEST_INT(uiNumMultiViewResults, uiNumSingleViewResults);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MoveDynamicHierarchies")
+  {
+    // enough objects, such that the transform update is distributed over several tasks
+    constexpr ezUInt32 uiNumRoots = 2000;
+    constexpr ezUInt32 uiNumLevels = 4;
+
+    ezDynamicArray<ezGameObject*> roots;
+    ezDynamicArray<ezGameObject*> hierarchyObjects;
+
+    for (ezUInt32 i = 0; i < uiNumRoots; ++i)
+    {
+      ezGameObjectDesc desc;
+      desc.m_bDynamic = true;
+      desc.m_LocalPosition = ezVec3(i * 10.0f, 0, 0);
+
+      ezGameObject* pParent = nullptr;
+      world.CreateObject(desc, pParent);
+      roots.PushBack(pParent);
+
+      for (ezUInt32 uiLevel = 0; uiLevel < uiNumLevels; ++uiLevel)
+      {
+        TestBoundsComponent* pComponent = nullptr;
+        TestBoundsComponent::CreateComponent(pParent, pComponent);
+        hierarchyObjects.PushBack(pParent);
+
+        desc.m_hParent = pParent->GetHandle();
+        desc.m_LocalPosition = ezVec3(0, 0, 1);
+
+        world.CreateObject(desc, pParent);
+      }
+    }
+
+    world.Update();
+
+    // move all hierarchies far away, the bounds of all children need to be updated in the spatial system
+    const ezVec3 vOffset(0, 50000.0f, 0);
+    for (ezGameObject* pRoot : roots)
+    {
+      pRoot->SetLocalPosition(pRoot->GetLocalPosition() + vOffset);
+    }
+
+    world.Update();
+
+    ezSpatialSystem::QueryParams dynamicQueryParams;
+    dynamicQueryParams.m_uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
+
+    ezBoundingBox queryBox = ezBoundingBox::MakeFromMinMax(ezVec3(-1000.0f, 40000.0f, -1000.0f), ezVec3(uiNumRoots * 10.0f + 1000.0f, 60000.0f, 1000.0f));
+
+    ezDynamicArray<ezGameObject*> foundObjects;
+    world.GetSpatialSystem()->FindObjectsInBox(queryBox, dynamicQueryParams, foundObjects);
+
+    ezHashSet<ezGameObject*> foundSet;
+    for (ezGameObject* pObject : foundObjects)
+    {
+      foundSet.Insert(pObject);
+    }
+
+    ezUInt32 uiNumMissing = 0;
+    for (ezGameObject* pObject : hierarchyObjects)
+    {
+      if (!foundSet.Contains(pObject))
+        ++uiNumMissing;
+
+      EZ_TEST_BOOL(queryBox.Contains(pObject->GetGlobalPosition()));
+    }
+
+    EZ_TEST_INT(uiNumMissing, 0);
+
+    for (ezGameObject* pRoot : roots)
+    {
+      world.DeleteObjectNow(pRoot->GetHandle());
+    }
+
+    world.Update();
+  }
+
   // Test multiple categories for spatial data
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "MultipleCategories")
   {
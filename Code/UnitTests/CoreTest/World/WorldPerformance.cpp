@@ -1,6 +1,8 @@
 #include <CoreTest/CoreTestPCH.h>
 
+#include <Core/Messages/CommonMessages.h>
 #include <Core/World/World.h>
+#include <Foundation/Math/Random.h>
 #include <Foundation/Time/Clock.h>
 #include <Foundation/Time/Stopwatch.h>
 
@@ -288,3 +290,44 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(World, Profile_TimedMessages)
+{
+  EZ_TEST_BLOCK(EnableInRelease, "Update with 100,000 delayed messages")
+  {
+    ezWorldDesc worldDesc("Test");
+    ezWorld world(worldDesc);
+
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezGameObjectDesc gd;
+    ezGameObject* pObject = nullptr;
+    world.CreateObject(gd, pObject);
+
+    // like gameplay timers, e.g. delayed deaths, spawners and trigger delays
+    ezRandom rnd;
+    rnd.Initialize(42);
+
+    ezMsgSetFloatParameter msg;
+    for (ezUInt32 i = 0; i < 100000; ++i)
+    {
+      msg.m_fValue = static_cast<float>(i);
+      pObject->PostMessage(msg, ezTime::MakeFromSeconds(rnd.DoubleMinMax(0.1, 60.0)));
+    }
+
+    world.GetClock().SetFixedTimeStep(ezTime::MakeFromSeconds(1.0 / 60.0));
+
+    const ezUInt32 uiNumFrames = 120;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumFrames; ++i)
+    {
+      world.Update();
+    }
+
+    const ezTime tDiff = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Updating with 100,000 delayed messages: %.3fms per frame", tDiff.GetMilliseconds() / uiNumFrames);
+  }
+}
@@ -0,0 +1,227 @@
+#include <CoreTest/CoreTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+
+namespace
+{
+  class TestComponentSerialized;
+  using TestComponentSerializedManager = ezComponentManager<TestComponentSerialized, ezBlockStorageType::Compact>;
+
+  class TestComponentSerialized : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(TestComponentSerialized, ezComponent, TestComponentSerializedManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& inout_stream) const override
+    {
+      SUPER::SerializeComponent(inout_stream);
+
+      inout_stream.GetStream() << m_iValue;
+      inout_stream.WriteGameObjectHandle(m_hTarget);
+    }
+
+    virtual void DeserializeComponent(ezWorldReader& inout_stream) override
+    {
+      SUPER::DeserializeComponent(inout_stream);
+
+      inout_stream.GetStream() >> m_iValue;
+      m_hTarget = inout_stream.ReadGameObjectHandle();
+    }
+
+    virtual void Initialize() override { ++s_iNumInitialized; }
+
+    ezInt32 m_iValue = 0;
+    ezGameObjectHandle m_hTarget;
+
+    static ezInt32 s_iNumInitialized;
+  };
+
+  ezInt32 TestComponentSerialized::s_iNumInitialized = 0;
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(TestComponentSerialized, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+
+  void CreatePrefab(ezDefaultMemoryStreamStorage& ref_storage)
+  {
+    ezWorldDesc worldDesc("Prefab");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezGameObjectDesc desc;
+    desc.m_sName.Assign("Root");
+
+    ezGameObject* pRoot = nullptr;
+    ezGameObjectHandle hRoot = world.CreateObject(desc, pRoot);
+
+    desc.m_sName.Assign("Child");
+    desc.m_hParent = hRoot;
+    desc.m_LocalPosition.Set(0, 0, 1);
+
+    ezGameObject* pChild = nullptr;
+    ezGameObjectHandle hChild = world.CreateObject(desc, pChild);
+
+    TestComponentSerialized* pComponent = nullptr;
+    TestComponentSerialized::CreateComponent(pRoot, pComponent);
+    pComponent->m_iValue = 42;
+    pComponent->m_hTarget = hChild;
+
+    TestComponentSerialized::CreateComponent(pChild, pComponent);
+    pComponent->m_iValue = 23;
+    pComponent->m_hTarget = hRoot;
+
+    ezMemoryStreamWriter writer(&ref_storage);
+    ezWorldWriter worldWriter;
+    worldWriter.WriteWorld(writer, world);
+  }
+
+  void CheckInstances(ezWorld& ref_world, const ezDynamicArray<ezGameObject*>& rootObjects, const ezDynamicArray<ezGameObject*>& childObjects, ezArrayPtr<const ezTransform> rootTransforms)
+  {
+    if (!EZ_TEST_INT(rootObjects.GetCount(), rootTransforms.GetCount()) || !EZ_TEST_INT(childObjects.GetCount(), rootTransforms.GetCount()))
+      return;
+
+    for (ezUInt32 i = 0; i < rootTransforms.GetCount(); ++i)
+    {
+      ezGameObject* pRoot = rootObjects[i];
+      ezGameObject* pChild = childObjects[i];
+
+      EZ_TEST_VEC3(pRoot->GetLocalPosition(), rootTransforms[i].m_vPosition, 0.0001f);
+      EZ_TEST_BOOL(pChild->GetParent() == pRoot);
+
+      TestComponentSerialized* pRootComponent = nullptr;
+      TestComponentSerialized* pChildComponent = nullptr;
+      if (!EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pRootComponent)) || !EZ_TEST_BOOL(pChild->TryGetComponentOfBaseType(pChildComponent)))
+        continue;
+
+      // the handles must reference the objects of the same instance
+      EZ_TEST_INT(pRootComponent->m_iValue, 42);
+      EZ_TEST_BOOL(pRootComponent->m_hTarget == pChild->GetHandle());
+      EZ_TEST_INT(pChildComponent->m_iValue, 23);
+      EZ_TEST_BOOL(pChildComponent->m_hTarget == pRoot->GetHandle());
+    }
+
+    ref_world.Update();
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, WorldReader)
+{
+  ezDefaultMemoryStreamStorage storage;
+  CreatePrefab(storage);
+
+  ezWorldReader worldReader;
+  {
+    ezMemoryStreamReader reader(&storage);
+    EZ_TEST_BOOL(worldReader.ReadWorldDescription(reader).Succeeded());
+  }
+
+  ezHybridArray<ezTransform, 8> rootTransforms;
+  for (ezUInt32 i = 0; i < 8; ++i)
+  {
+    rootTransforms.PushBack(ezTransform(ezVec3(static_cast<float>(i), 2.0f, 0.0f)));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiatePrefabs")
+  {
+    ezWorldDesc worldDesc("Test");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezDynamicArray<ezGameObject*> rootObjects;
+    ezDynamicArray<ezGameObject*> childObjects;
+
+    ezPrefabInstantiationOptions options;
+    options.m_pCreatedRootObjectsOut = &rootObjects;
+    options.m_pCreatedChildObjectsOut = &childObjects;
+
+    TestComponentSerialized::s_iNumInitialized = 0;
+    worldReader.InstantiatePrefabs(world, rootTransforms, options);
+
+    EZ_TEST_INT(world.GetObjectCount(), rootTransforms.GetCount() * 2);
+    CheckInstances(world, rootObjects, childObjects, rootTransforms);
+    EZ_TEST_INT(TestComponentSerialized::s_iNumInitialized, rootTransforms.GetCount() * 2);
+
+    // single instantiation still works after a bulk instantiation
+    rootObjects.Clear();
+    childObjects.Clear();
+    worldReader.InstantiatePrefab(world, rootTransforms[0], options);
+    CheckInstances(world, rootObjects, childObjects, rootTransforms.GetArrayPtr().GetSubArray(0, 1));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiatePrefabs in parallel")
+  {
+    ezWorldDesc worldDesc("Test");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezDynamicArray<ezGameObject*> rootObjects;
+    ezDynamicArray<ezGameObject*> childObjects;
+
+    ezPrefabInstantiationOptions options;
+    options.m_pCreatedRootObjectsOut = &rootObjects;
+    options.m_pCreatedChildObjectsOut = &childObjects;
+    options.m_bDeserializeComponentsInParallel = true;
+
+    // enough instances to be split across several tasks
+    ezDynamicArray<ezTransform> manyRootTransforms;
+    for (ezUInt32 i = 0; i < 4096; ++i)
+    {
+      manyRootTransforms.PushBack(ezTransform(ezVec3(static_cast<float>(i % 64), static_cast<float>(i / 64), 0.0f)));
+    }
+
+    TestComponentSerialized::s_iNumInitialized = 0;
+    worldReader.InstantiatePrefabs(world, manyRootTransforms, options);
+
+    EZ_TEST_INT(world.GetObjectCount(), manyRootTransforms.GetCount() * 2);
+    CheckInstances(world, rootObjects, childObjects, manyRootTransforms);
+    EZ_TEST_INT(TestComponentSerialized::s_iNumInitialized, manyRootTransforms.GetCount() * 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ReadWorldDescription in place")
+  {
+    ezDynamicArray<ezUInt8> data;
+    data.SetCountUninitialized(storage.GetStorageSize32());
+    {
+      ezMemoryStreamReader reader(&storage);
+      reader.ReadBytes(data.GetData(), data.GetCount());
+    }
+
+    ezWorldReader inPlaceReader;
+    EZ_TEST_BOOL(inPlaceReader.ReadWorldDescription(data.GetArrayPtr()).Succeeded());
+    EZ_TEST_INT(inPlaceReader.GetRootObjectCount(), 1);
+    EZ_TEST_INT(inPlaceReader.GetChildObjectCount(), 1);
+
+    // A stream based reader that has read the same description and instantiated nothing has the same tables.
+    // The only difference is its copy of the component data, which the in-place reader does not allocate.
+    {
+      ezWorldReader streamReader;
+      ezMemoryStreamReader reader(&storage);
+      EZ_TEST_BOOL(streamReader.ReadWorldDescription(reader).Succeeded());
+
+      EZ_TEST_BOOL(inPlaceReader.GetHeapMemoryUsage() < streamReader.GetHeapMemoryUsage());
+    }
+
+    ezWorldDesc worldDesc("Test");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezDynamicArray<ezGameObject*> rootObjects;
+    ezDynamicArray<ezGameObject*> childObjects;
+
+    ezPrefabInstantiationOptions options;
+    options.m_pCreatedRootObjectsOut = &rootObjects;
+    options.m_pCreatedChildObjectsOut = &childObjects;
+
+    inPlaceReader.InstantiatePrefab(world, rootTransforms[0], options);
+    inPlaceReader.InstantiatePrefabs(world, rootTransforms.GetArrayPtr().GetSubArray(1), options);
+    CheckInstances(world, rootObjects, childObjects, rootTransforms);
+
+    // the names are resolved through the string table in the memory block
+    EZ_TEST_STRING(rootObjects[0]->GetName(), "Root");
+    EZ_TEST_STRING(childObjects[0]->GetName(), "Child");
+  }
+}
@@ -52,4 +52,61 @@ EZ_CREATE_SIMPLE_TEST(Algorithm, Sorting)
       EZ_TEST_BOOL(a2[i - 1] >= a2[i]);
     }
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RadixSort")
+  {
+    struct Element
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      ezUInt64 m_uiKey;
+      ezUInt16 m_uiSecondaryKey;
+      ezUInt32 m_uiOriginalIndex;
+    };
+
+    ezDynamicArray<Element> elements;
+    for (ezUInt32 i = 0; i < a1.GetCount(); ++i)
+    {
+      // few distinct keys with only some varying bytes, to test stability and skipped digits
+      const ezUInt64 uiKey = (static_cast<ezUInt64>(a1[i] % 7) << 40) | static_cast<ezUInt64>(a1[i] % 300);
+      elements.PushBack({uiKey, static_cast<ezUInt16>(a1[i] % 1000), i});
+    }
+
+    ezDynamicArray<Element> scratch;
+    scratch.SetCount(elements.GetCount());
+
+    ezDynamicArray<Element> sorted = elements;
+    ezSorting::RadixSort<Element>(sorted, scratch, [](const Element& e) { return e.m_uiKey; });
+
+    for (ezUInt32 i = 1; i < sorted.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(sorted[i - 1].m_uiKey <= sorted[i].m_uiKey);
+
+      if (sorted[i - 1].m_uiKey == sorted[i].m_uiKey)
+      {
+        EZ_TEST_BOOL(sorted[i - 1].m_uiOriginalIndex < sorted[i].m_uiOriginalIndex);
+      }
+    }
+
+    // sort by two keys, least significant first
+    sorted = elements;
+    ezSorting::RadixSort<Element>(sorted, scratch, [](const Element& e) { return e.m_uiSecondaryKey; });
+    ezSorting::RadixSort<Element>(sorted, scratch, [](const Element& e) { return e.m_uiKey; });
+
+    for (ezUInt32 i = 1; i < sorted.GetCount(); ++i)
+    {
+      const Element& a = sorted[i - 1];
+      const Element& b = sorted[i];
+      EZ_TEST_BOOL(a.m_uiKey < b.m_uiKey || (a.m_uiKey == b.m_uiKey && a.m_uiSecondaryKey <= b.m_uiSecondaryKey));
+    }
+
+    // all keys equal
+    sorted = elements;
+    ezSorting::RadixSort<Element>(sorted, scratch, [](const Element& e) { return 42u; });
+
+    for (ezUInt32 i = 0; i < sorted.GetCount(); ++i)
+    {
+      EZ_TEST_INT(sorted[i].m_uiOriginalIndex, i);
+    }
+  }
 }
@@ -400,6 +400,120 @@ namespace
     }
   }
 
+  template <typename T>
+  void TestAVX2CodePath(ezStringView sCode)
+  {
+    ezExpressionByteCode byteCode;
+    Compile<T>(sCode, byteCode);
+
+    // odd instance counts to cover the remainder and padding handling
+    const ezUInt32 instanceCounts[] = {1, 3, 4, 7, 8, 13, 37};
+    for (ezUInt32 uiCount : instanceCounts)
+    {
+      ezDynamicArray<T> a, b, c, d, o4, o8;
+      a.SetCountUninitialized(uiCount);
+      b.SetCountUninitialized(uiCount);
+      c.SetCountUninitialized(uiCount);
+      d.SetCountUninitialized(uiCount);
+      o4.SetCount(uiCount);
+      o8.SetCount(uiCount);
+
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        const int x = static_cast<int>(i);
+        a[i] = static_cast<T>((x - 10) * 0.75f);
+        b[i] = static_cast<T>((x % 9) + 1); // never zero, used as divisor and shift amount
+        c[i] = static_cast<T>((x % 5) - 2);
+        d[i] = static_cast<T>((x % 3) * 0.5f);
+      }
+
+      ezProcessingStream inputs[] = {
+        ezProcessingStream(s_sA, a.GetByteArrayPtr(), StreamDataTypeDeduction<T>::Type),
+        ezProcessingStream(s_sB, b.GetByteArrayPtr(), StreamDataTypeDeduction<T>::Type),
+        ezProcessingStream(s_sC, c.GetByteArrayPtr(), StreamDataTypeDeduction<T>::Type),
+        ezProcessingStream(s_sD, d.GetByteArrayPtr(), StreamDataTypeDeduction<T>::Type),
+      };
+
+      ezProcessingStream outputs4[] = {
+        ezProcessingStream(s_sOutput, o4.GetByteArrayPtr(), StreamDataTypeDeduction<T>::Type),
+      };
+
+      ezProcessingStream outputs8[] = {
+        ezProcessingStream(s_sOutput, o8.GetByteArrayPtr(), StreamDataTypeDeduction<T>::Type),
+      };
+
+      s_pVM->SetAllowAVX2(false);
+      EZ_TEST_BOOL(s_pVM->Execute(byteCode, inputs, outputs4, uiCount).Succeeded());
+
+      s_pVM->SetAllowAVX2(true);
+      EZ_TEST_BOOL(s_pVM->Execute(byteCode, inputs, outputs8, uiCount).Succeeded());
+
+      // both code paths have to produce bit identical results
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(o4.GetData(), o8.GetData(), uiCount));
+    }
+  }
+
+  template <typename T>
+  void TestJITCodePath(ezStringView sCode, bool bExpectNativeCode)
+  {
+    using ComponentType = std::conditional_t<std::is_same_v<T, int> || std::is_same_v<T, ezVec3I32>, int, float>;
+    constexpr ezUInt32 uiNumComponents = sizeof(T) / sizeof(ComponentType);
+
+    ezExpressionByteCode byteCode;
+    Compile<T>(sCode, byteCode);
+
+    bExpectNativeCode &= ezExpressionVM::IsJITSupported();
+
+    // the native code processes 4 instances at a time, the remainder is done by the interpreter
+    const ezUInt32 instanceCounts[] = {1, 4, 5, 7, 8, 13, 64};
+    for (ezUInt32 uiCount : instanceCounts)
+    {
+      ezDynamicArray<T> a, b, c, d, oInterpreter, oJIT;
+      a.SetCountUninitialized(uiCount);
+      b.SetCountUninitialized(uiCount);
+      c.SetCountUninitialized(uiCount);
+      d.SetCountUninitialized(uiCount);
+      oInterpreter.SetCount(uiCount);
+      oJIT.SetCount(uiCount);
+
+      for (ezUInt32 i = 0; i < uiCount * uiNumComponents; ++i)
+      {
+        const int x = static_cast<int>(i);
+        reinterpret_cast<ComponentType*>(a.GetData())[i] = static_cast<ComponentType>((x - 10) * 0.75f);
+        reinterpret_cast<ComponentType*>(b.GetData())[i] = static_cast<ComponentType>((x % 9) + 1); // never zero
+        reinterpret_cast<ComponentType*>(c.GetData())[i] = static_cast<ComponentType>((x % 5) - 2);
+        reinterpret_cast<ComponentType*>(d.GetData())[i] = static_cast<ComponentType>((x % 3) * 0.5f);
+      }
+
+      ezProcessingStream inputs[] = {
+        ezProcessingStream(s_sA, a.GetByteArrayPtr(), StreamDataTypeDeduction<T>::Type),
+        ezProcessingStream(s_sB, b.GetByteArrayPtr(), StreamDataTypeDeduction<T>::Type),
+        ezProcessingStream(s_sC, c.GetByteArrayPtr(), StreamDataTypeDeduction<T>::Type),
+        ezProcessingStream(s_sD, d.GetByteArrayPtr(), StreamDataTypeDeduction<T>::Type),
+      };
+
+      ezProcessingStream outputsInterpreter[] = {
+        ezProcessingStream(s_sOutput, oInterpreter.GetByteArrayPtr(), StreamDataTypeDeduction<T>::Type),
+      };
+
+      ezProcessingStream outputsJIT[] = {
+        ezProcessingStream(s_sOutput, oJIT.GetByteArrayPtr(), StreamDataTypeDeduction<T>::Type),
+      };
+
+      s_pVM->SetAllowJIT(false);
+      EZ_TEST_BOOL(s_pVM->Execute(byteCode, inputs, outputsInterpreter, uiCount).Succeeded());
+
+      s_pVM->SetAllowJIT(true);
+      EZ_TEST_BOOL(s_pVM->Execute(byteCode, inputs, outputsJIT, uiCount).Succeeded());
+      EZ_TEST_BOOL(s_pVM->GetLastExecutionUsedJIT() == (bExpectNativeCode && uiCount >= 4));
+
+      // native code and interpreter have to produce bit identical results
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(oInterpreter.GetData(), oJIT.GetData(), uiCount));
+    }
+
+    s_pVM->SetAllowJIT(false);
+  }
+
   static const ezEnum<ezExpression::RegisterType> s_TestFunc1InputTypes[] = {ezExpression::RegisterType::Float, ezExpression::RegisterType::Int};
   static const ezEnum<ezExpression::RegisterType> s_TestFunc2InputTypes[] = {ezExpression::RegisterType::Float, ezExpression::RegisterType::Float, ezExpression::RegisterType::Int};
 
@@ -1171,4 +1285,69 @@ EZ_CREATE_SIMPLE_TEST(CodeUtils, Expression)
     Compile<ezVec3>(testCode, testByteCode);
     EZ_TEST_VEC3(Execute<ezVec3>(testByteCode), ezVec3(61, 54, 54), ezMath::DefaultEpsilon<float>());
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "AVX2 code path")
+  {
+    if (ezExpressionVM::IsAVX2Supported() == false)
+    {
+      ezLog::Info("AVX2 is not supported, only the 4-wide code path is tested");
+    }
+
+    TestAVX2CodePath<float>("output = abs(a) + sqrt(b) + round(a) * floor(c) - ceil(d) / trunc(b)");
+    TestAVX2CodePath<float>("output = min(a, b) + max(c, 0.5) + clamp(a, c, b) + lerp(a, b, d)");
+    TestAVX2CodePath<float>("output = exp(d) + ln(b) + log2(b) + log10(b) + pow2(c) + sin(a) + cos(a) + tan(d) + asin(d) + acos(d) + atan(a)");
+    TestAVX2CodePath<float>("output = (a < b) ? a : ((a >= c) ? b : c)");
+    TestAVX2CodePath<float>("output = ((a == d || a != c) && (b > c || a <= 0.5)) ? a * 2 : b - 1");
+    TestAVX2CodePath<float>("output = a % b + mod(c, 1.5) + float(int(a) / int(b))");
+
+    TestAVX2CodePath<int>("output = abs(a) + a * b - a / b + a % 4 + (a << b) + (a >> 2) + (a << 3) + (a >> b)");
+    TestAVX2CodePath<int>("output = ((a & b) ^ (c | d)) + ~a + max(a, b) - min(c, 4) + clamp(a, c, b)");
+    TestAVX2CodePath<int>("output = ((a < b && c >= d) || (a > c) != (b <= d)) ? int(float(a) * 0.5) : b % 3");
+    TestAVX2CodePath<int>("bool x = a == b; bool y = c != d; output = (x == y) ? a : ((x && !y) ? b : c)");
+
+    // shift counts of 32 or more are masked to 5 bits in both code paths
+    TestAVX2CodePath<int>("output = (a << (b * 5)) + (c >> (b * 6)) + (a >> (b + 31))");
+    EZ_TEST_INT(TestInstruction<int>("output = a << b", 3, 33), 6);
+    EZ_TEST_INT(TestInstruction<int>("output = a >> b", -64, 36), -4);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "JIT code path")
+  {
+    if (ezExpressionVM::IsJITSupported() == false)
+    {
+      ezLog::Info("Native code generation is not supported on this platform, only the fallback to the interpreter is tested");
+    }
+
+    TestJITCodePath<float>("output = abs(a) + sqrt(b) + round(a) * floor(c) - ceil(d) / trunc(b)", true);
+    TestJITCodePath<float>("output = min(a, b) + max(c, 0.5) + clamp(a, c, b) + lerp(a, b, d)", true);
+    TestJITCodePath<float>("output = (a < b) ? a : ((a >= c) ? b : c)", true);
+    TestJITCodePath<float>("output = ((a == d || a != c) && (b > c || a <= 0.5)) ? a * 2 : b - 1", true);
+    TestJITCodePath<float>("output = a % b + mod(c, 1.5) + float(int(a) * int(b))", true);
+
+    TestJITCodePath<int>("output = abs(a) + a * b - a + (a >> 2) + (a << 3) + (c >> 40)", true);
+    TestJITCodePath<int>("output = ((a & b) ^ (c | d)) + ~a + max(a, b) - min(c, 4) + clamp(a, c, b)", true);
+    TestJITCodePath<int>("output = ((a < b && c >= d) || (a > c) != (b <= d)) ? int(float(a) * 0.5) : b & 3", true);
+    TestJITCodePath<int>("bool x = a == b; bool y = c != d; output = (x == y) ? a : ((x && !y) ? b : c)", true);
+
+    // strided streams
+    TestJITCodePath<ezVec3>("output = a * b.x + cross(c, d) - normalize(b) * dot(a, c)", true);
+    TestJITCodePath<ezVec3I32>("output = a * b.y + (c > d ? c : d)", true);
+
+    // more temp registers than SSE registers
+    TestJITCodePath<float>("var x0 = a * 1.1; var x1 = b * 1.2; var x2 = c * 1.3; var x3 = d * 1.4\n"
+                           "var x4 = a + 2.1; var x5 = b + 2.2; var x6 = c + 2.3; var x7 = d + 2.4\n"
+                           "var x8 = a - b; var x9 = b - c; var x10 = c - d; var x11 = d - a\n"
+                           "var x12 = a * c; var x13 = b * d; var x14 = a * d; var x15 = b * c\n"
+                           "output = x0 * x15 - x1 * x14 + x2 * x13 - x3 * x12 + x4 * x11 - x5 * x10 + x6 * x9 - x7 * x8",
+      true);
+
+    // not supported by the native code generator, has to fall back to the interpreter
+    TestJITCodePath<float>("output = sin(a) + b", false);
+    TestJITCodePath<int>("output = a / b", false);
+    TestJITCodePath<int>("output = a << b", false);
+
+    s_pParser->RegisterFunction(ezDefaultExpressionFunctions::s_PerlinNoiseFunc.m_Desc);
+    TestJITCodePath<float>("output = PerlinNoise(a, b, c, 2)", false);
+    s_pParser->UnregisterFunction(ezDefaultExpressionFunctions::s_PerlinNoiseFunc.m_Desc);
+  }
 }
@@ -0,0 +1,176 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Communication/PerThreadMessageQueue.h>
+#include <Foundation/Threading/Thread.h>
+
+namespace
+{
+  struct ezMsgPerThreadTest : public ezMessage
+  {
+    EZ_DECLARE_MESSAGE_TYPE(ezMsgPerThreadTest, ezMessage);
+  };
+
+  EZ_IMPLEMENT_MESSAGE_TYPE(ezMsgPerThreadTest);
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezMsgPerThreadTest, 1, ezRTTIDefaultAllocator<ezMsgPerThreadTest>)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+  struct MetaData
+  {
+    ezUInt32 m_uiThread;
+    ezUInt32 m_uiIndex;
+  };
+
+  using TestQueue = ezPerThreadMessageQueue<MetaData>;
+
+  constexpr ezUInt32 s_uiNumThreads = 4;
+  constexpr ezUInt32 s_uiMessagesPerThread = 10000;
+
+  class EnqueueThread : public ezThread
+  {
+  public:
+    EnqueueThread()
+      : ezThread("Enqueue Thread")
+    {
+    }
+
+    TestQueue* m_pQueue = nullptr;
+    ezMsgPerThreadTest* m_pMessage = nullptr;
+    ezUInt32 m_uiThread = 0;
+
+    virtual ezUInt32 Run() override
+    {
+      for (ezUInt32 i = 0; i < s_uiMessagesPerThread; ++i)
+      {
+        m_pQueue->Enqueue(m_pMessage, {m_uiThread, i});
+      }
+
+      return 0;
+    }
+  };
+
+  void EnqueueFromThreads(TestQueue& ref_queue, ezMsgPerThreadTest& ref_msg)
+  {
+    EnqueueThread threads[s_uiNumThreads];
+
+    for (ezUInt32 i = 0; i < s_uiNumThreads; ++i)
+    {
+      threads[i].m_pQueue = &ref_queue;
+      threads[i].m_pMessage = &ref_msg;
+      threads[i].m_uiThread = i;
+      threads[i].Start();
+    }
+
+    for (ezUInt32 i = 0; i < s_uiNumThreads; ++i)
+    {
+      threads[i].Join();
+    }
+  }
+
+  void CheckEntries(ezArrayPtr<const TestQueue::Entry> entries, ezMsgPerThreadTest* pMsg)
+  {
+    EZ_TEST_INT(entries.GetCount(), s_uiNumThreads * s_uiMessagesPerThread);
+
+    // the order within the lane of a thread is preserved
+    ezUInt32 uiNextIndex[s_uiNumThreads] = {};
+
+    for (const TestQueue::Entry& entry : entries)
+    {
+      EZ_TEST_BOOL(entry.m_pMessage == pMsg);
+      EZ_TEST_BOOL(entry.m_MetaData.m_uiThread < s_uiNumThreads);
+      EZ_TEST_INT(entry.m_MetaData.m_uiIndex, uiNextIndex[entry.m_MetaData.m_uiThread]);
+
+      ++uiNextIndex[entry.m_MetaData.m_uiThread];
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Communication, PerThreadMessageQueue)
+{
+  ezMsgPerThreadTest msg;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Enqueue / DequeueAll")
+  {
+    TestQueue q;
+    EZ_TEST_BOOL(q.IsEmpty());
+
+    q.Enqueue(&msg, {0, 0});
+    q.Enqueue(&msg, {0, 1});
+    EZ_TEST_INT(q.GetCount(), 2);
+
+    ezDynamicArray<TestQueue::Entry> entries;
+    q.DequeueAll(entries);
+    EZ_TEST_INT(entries.GetCount(), 2);
+    EZ_TEST_INT(entries[0].m_MetaData.m_uiIndex, 0);
+    EZ_TEST_INT(entries[1].m_MetaData.m_uiIndex, 1);
+    EZ_TEST_BOOL(q.IsEmpty());
+
+    // appends to the given array
+    q.Enqueue(&msg, {0, 2});
+    q.DequeueAll(entries);
+    EZ_TEST_INT(entries.GetCount(), 3);
+    EZ_TEST_INT(entries[2].m_MetaData.m_uiIndex, 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Enqueue from multiple threads")
+  {
+    TestQueue q;
+
+    ezDynamicArray<TestQueue::Entry> entries;
+
+    // the lanes stay alive after DequeueAll, a second round must not lose or duplicate any messages
+    for (ezUInt32 uiRound = 0; uiRound < 2; ++uiRound)
+    {
+      EnqueueFromThreads(q, msg);
+      EZ_TEST_INT(q.GetCount(), s_uiNumThreads * s_uiMessagesPerThread);
+
+      entries.Clear();
+      q.DequeueAll(entries);
+      EZ_TEST_BOOL(q.IsEmpty());
+
+      CheckEntries(entries, &msg);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "DequeueAll while other threads enqueue")
+  {
+    TestQueue q;
+
+    EnqueueThread threads[s_uiNumThreads];
+    for (ezUInt32 i = 0; i < s_uiNumThreads; ++i)
+    {
+      threads[i].m_pQueue = &q;
+      threads[i].m_pMessage = &msg;
+      threads[i].m_uiThread = i;
+      threads[i].Start();
+    }
+
+    ezDynamicArray<TestQueue::Entry> entries;
+    while (entries.GetCount() < s_uiNumThreads * s_uiMessagesPerThread)
+    {
+      q.DequeueAll(entries);
+    }
+
+    for (ezUInt32 i = 0; i < s_uiNumThreads; ++i)
+    {
+      threads[i].Join();
+    }
+
+    EZ_TEST_BOOL(q.IsEmpty());
+    CheckEntries(entries, &msg);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Clear")
+  {
+    TestQueue q;
+
+    EnqueueFromThreads(q, msg);
+    q.Enqueue(&msg, {0, 0});
+    EZ_TEST_INT(q.GetCount(), s_uiNumThreads * s_uiMessagesPerThread + 1);
+
+    q.Clear();
+    EZ_TEST_BOOL(q.IsEmpty());
+
+    q.Enqueue(&msg, {0, 0});
+    EZ_TEST_INT(q.GetCount(), 1);
+  }
+}
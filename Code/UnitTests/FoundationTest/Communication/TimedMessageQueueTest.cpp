@@ -0,0 +1,227 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Communication/TimedMessageQueue.h>
+#include <Foundation/Math/Random.h>
+
+namespace
+{
+  struct ezMsgTimedTest : public ezMessage
+  {
+    EZ_DECLARE_MESSAGE_TYPE(ezMsgTimedTest, ezMessage);
+
+    ezUInt32 m_uiIndex = 0;
+  };
+
+  EZ_IMPLEMENT_MESSAGE_TYPE(ezMsgTimedTest);
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezMsgTimedTest, 1, ezRTTIDefaultAllocator<ezMsgTimedTest>)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+  struct MetaData
+  {
+    ezTime m_Due;
+  };
+
+  using TestQueue = ezTimedMessageQueue<MetaData>;
+
+  void Enqueue(TestQueue& ref_queue, ezDynamicArray<ezMsgTimedTest>& ref_messages, ezDynamicArray<ezTime>& ref_dues, ezTime due)
+  {
+    const ezUInt32 uiIndex = ref_dues.GetCount();
+    ref_dues.PushBack(due);
+    ref_messages[uiIndex].m_uiIndex = uiIndex;
+
+    MetaData md;
+    md.m_Due = due;
+    ref_queue.Enqueue(&ref_messages[uiIndex], md);
+  }
+
+  // checks that exactly the messages that are due have been returned
+  void Check(TestQueue& ref_queue, ezTime now, const ezDynamicArray<ezTime>& dues, ezDynamicArray<bool>& ref_dequeued, ezArrayPtr<const TestQueue::Entry> entries)
+  {
+    for (const TestQueue::Entry& entry : entries)
+    {
+      const ezUInt32 uiIndex = static_cast<ezMsgTimedTest*>(entry.m_pMessage)->m_uiIndex;
+      EZ_TEST_BOOL(!ref_dequeued[uiIndex]);
+      EZ_TEST_BOOL(dues[uiIndex] <= now);
+      EZ_TEST_BOOL(entry.m_MetaData.m_Due == dues[uiIndex]);
+      ref_dequeued[uiIndex] = true;
+    }
+
+    ezUInt32 uiNumPending = 0;
+    for (ezUInt32 i = 0; i < dues.GetCount(); ++i)
+    {
+      if (!ref_dequeued[i])
+      {
+        EZ_TEST_BOOL(dues[i] > now);
+        ++uiNumPending;
+      }
+    }
+
+    EZ_TEST_INT(ref_queue.GetCount(), uiNumPending);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Communication, TimedMessageQueue)
+{
+  ezDynamicArray<ezMsgTimedTest> messages;
+  messages.SetCount(20000);
+
+  ezDynamicArray<ezTime> dues;
+  ezDynamicArray<bool> dequeued;
+  ezDynamicArray<TestQueue::Entry> entries;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "DequeueDue")
+  {
+    TestQueue q;
+    EZ_TEST_BOOL(q.IsEmpty());
+
+    ezRandom rnd;
+    rnd.Initialize(42);
+
+    dues.Clear();
+
+    // short delays, delays in the coarser levels, far beyond the range of the wheel and in the past
+    for (ezUInt32 i = 0; i < 2000; ++i)
+    {
+      Enqueue(q, messages, dues, ezTime::MakeFromSeconds(rnd.DoubleMinMax(-1.0, 10.0)));
+      Enqueue(q, messages, dues, ezTime::MakeFromSeconds(rnd.DoubleMinMax(10.0, 5000.0)));
+    }
+
+    for (ezUInt32 i = 0; i < 10; ++i)
+    {
+      Enqueue(q, messages, dues, ezTime::MakeFromHours(24.0 * 365.0 * (i + 1)));
+    }
+
+    // exactly on a bucket border
+    Enqueue(q, messages, dues, ezTime::MakeFromSeconds(1.0));
+
+    EZ_TEST_INT(q.GetCount(), dues.GetCount());
+
+    dequeued.Clear();
+    dequeued.SetCount(dues.GetCount());
+
+    ezTime now = ezTime::MakeZero();
+
+    while (now < ezTime::MakeFromSeconds(20.0))
+    {
+      entries.Clear();
+      q.DequeueDue(now, entries);
+      Check(q, now, dues, dequeued, entries);
+
+      // messages that are posted while processing are due at the earliest in the next frame
+      if (dues.GetCount() < 6000)
+      {
+        Enqueue(q, messages, dues, now + ezTime::MakeFromMilliseconds(1));
+        Enqueue(q, messages, dues, now + ezTime::MakeFromSeconds(rnd.DoubleMinMax(0.001, 30.0)));
+        dequeued.SetCount(dues.GetCount());
+      }
+
+      now += ezTime::MakeFromSeconds(rnd.DoubleMinMax(0.001, 0.05));
+    }
+
+    // large steps, which exercise the coarser levels and redistributing everything
+    const double steps[] = {3.0, 100.0, 0.01, 2000.0, 7000.0, 24.0 * 3600.0, 3.0 * 24.0 * 3600.0 * 365.0, 10.0 * 24.0 * 3600.0 * 365.0};
+    for (double fStep : steps)
+    {
+      now += ezTime::MakeFromSeconds(fStep);
+
+      entries.Clear();
+      q.DequeueDue(now, entries);
+      Check(q, now, dues, dequeued, entries);
+    }
+
+    EZ_TEST_BOOL(q.IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Steady frame rate")
+  {
+    TestQueue q;
+
+    dues.Clear();
+
+    ezTime now = ezTime::MakeFromSeconds(100.0);
+
+    for (ezUInt32 i = 0; i < 10000; ++i)
+    {
+      Enqueue(q, messages, dues, now + ezTime::MakeFromMilliseconds(i * 7 + 1));
+    }
+
+    dequeued.Clear();
+    dequeued.SetCount(dues.GetCount());
+
+    // 60 fps for more than the duration of the first level of the wheel
+    for (ezUInt32 uiFrame = 0; uiFrame < 60 * 80; ++uiFrame)
+    {
+      now += ezTime::MakeFromSeconds(1.0 / 60.0);
+
+      entries.Clear();
+      q.DequeueDue(now, entries);
+      Check(q, now, dues, dequeued, entries);
+    }
+
+    EZ_TEST_BOOL(q.IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Coarse levels")
+  {
+    TestQueue q;
+
+    ezRandom rnd;
+    rnd.Initialize(7);
+
+    dues.Clear();
+
+    ezTime now = ezTime::MakeFromSeconds(1000.0);
+
+    entries.Clear();
+    q.DequeueDue(now, entries);
+
+    for (ezUInt32 i = 0; i < 2000; ++i)
+    {
+      Enqueue(q, messages, dues, now + ezTime::MakeFromSeconds(rnd.DoubleMinMax(0.0, 3500.0)));
+    }
+
+    dequeued.Clear();
+    dequeued.SetCount(dues.GetCount());
+
+    // small enough steps to never skip a full rotation of the first level, so the messages go through all the coarser buckets
+    while (now < ezTime::MakeFromSeconds(4600.0))
+    {
+      now += ezTime::MakeFromSeconds(rnd.DoubleMinMax(0.5, 3.5));
+
+      entries.Clear();
+      q.DequeueDue(now, entries);
+      Check(q, now, dues, dequeued, entries);
+    }
+
+    EZ_TEST_BOOL(q.IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "DequeueAll")
+  {
+    TestQueue q;
+
+    dues.Clear();
+
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      Enqueue(q, messages, dues, ezTime::MakeFromSeconds(i * 1.5));
+    }
+
+    entries.Clear();
+    q.DequeueDue(ezTime::MakeFromSeconds(10.0), entries);
+    EZ_TEST_INT(entries.GetCount(), 7);
+
+    entries.Clear();
+    q.DequeueAll(entries);
+    EZ_TEST_INT(entries.GetCount(), 993);
+    EZ_TEST_BOOL(q.IsEmpty());
+
+    // the queue can be used again afterwards
+    Enqueue(q, messages, dues, ezTime::MakeFromSeconds(20.0));
+
+    entries.Clear();
+    q.DequeueDue(ezTime::MakeFromSeconds(20.0), entries);
+    EZ_TEST_INT(entries.GetCount(), 1);
+    EZ_TEST_BOOL(q.IsEmpty());
+  }
+}
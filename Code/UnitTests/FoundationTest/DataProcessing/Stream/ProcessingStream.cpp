@@ -51,6 +51,93 @@ protected:
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(AddOneStreamProcessor, 1, ezRTTIDefaultAllocator<AddOneStreamProcessor>)
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 
+// Chunk safe processor, which initializes elements to (index % 4), adds one and removes all elements that reach 4
+
+class AddOneAndRemoveStreamProcessor : public ezProcessingStreamProcessor
+{
+  EZ_ADD_DYNAMIC_REFLECTION(AddOneAndRemoveStreamProcessor, ezProcessingStreamProcessor);
+
+public:
+  AddOneAndRemoveStreamProcessor() = default;
+
+  void SetStreamName(ezHashedString sStreamName) { m_sStreamName = sStreamName; }
+
+  virtual bool IsChunkSafe() const override { return true; }
+
+  ezUInt32 m_uiNumPrepareChunks = 0;
+  ezUInt32 m_uiNumFinishChunks = 0;
+  ezUInt64 m_uiNumRemoved = 0;
+
+protected:
+  virtual ezResult UpdateStreamBindings() override
+  {
+    m_pStream = m_pStreamGroup->GetStreamByName(m_sStreamName);
+
+    return m_pStream ? EZ_SUCCESS : EZ_FAILURE;
+  }
+
+  virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override
+  {
+    ezProcessingStreamIterator<float> streamIterator(m_pStream, uiNumElements, uiStartIndex);
+
+    for (ezUInt64 i = uiStartIndex; !streamIterator.HasReachedEnd(); ++i)
+    {
+      streamIterator.Current() = static_cast<float>(i % 4);
+
+      streamIterator.Advance();
+    }
+  }
+
+  virtual void Process(ezUInt64 uiNumElements) override
+  {
+    PrepareChunks(1);
+    ProcessChunk(0, 0, uiNumElements);
+    FinishChunks();
+  }
+
+  virtual void PrepareChunks(ezUInt32 uiNumChunks) override
+  {
+    ++m_uiNumPrepareChunks;
+    m_NumRemovedPerChunk.Clear();
+    m_NumRemovedPerChunk.SetCount(uiNumChunks);
+  }
+
+  virtual void ProcessChunk(ezUInt32 uiChunkIndex, ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override
+  {
+    ezProcessingStreamIterator<float> streamIterator(m_pStream, uiNumElements, uiStartIndex);
+
+    for (ezUInt64 i = uiStartIndex; !streamIterator.HasReachedEnd(); ++i)
+    {
+      streamIterator.Current() += 1.0f;
+
+      if (streamIterator.Current() >= 4.0f)
+      {
+        m_pStreamGroup->RemoveElement(i);
+        ++m_NumRemovedPerChunk[uiChunkIndex];
+      }
+
+      streamIterator.Advance();
+    }
+  }
+
+  virtual void FinishChunks() override
+  {
+    ++m_uiNumFinishChunks;
+
+    for (ezUInt64 uiNumRemoved : m_NumRemovedPerChunk)
+    {
+      m_uiNumRemoved += uiNumRemoved;
+    }
+  }
+
+  ezHashedString m_sStreamName;
+  ezProcessingStream* m_pStream = nullptr;
+  ezDynamicArray<ezUInt64> m_NumRemovedPerChunk;
+};
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(AddOneAndRemoveStreamProcessor, 1, ezRTTIDefaultAllocator<AddOneAndRemoveStreamProcessor>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
 EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStream)
 {
   ezProcessingStreamGroup Group;
@@ -156,3 +243,67 @@ EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStream)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStreamChunks)
+{
+  constexpr ezUInt32 uiNumElements = 1000;
+
+  ezProcessingStreamGroup serialGroup;
+  ezProcessingStreamGroup chunkedGroup;
+  chunkedGroup.SetChunkSize(64);
+
+  ezProcessingStream* pSerialStream = serialGroup.AddStream("Stream", ezProcessingStream::DataType::Float);
+  ezProcessingStream* pChunkedStream = chunkedGroup.AddStream("Stream", ezProcessingStream::DataType::Float);
+
+  AddOneAndRemoveStreamProcessor* pSerialProcessor = EZ_DEFAULT_NEW(AddOneAndRemoveStreamProcessor);
+  pSerialProcessor->SetStreamName(pSerialStream->GetName());
+  serialGroup.AddProcessor(pSerialProcessor);
+
+  AddOneAndRemoveStreamProcessor* pChunkedProcessor = EZ_DEFAULT_NEW(AddOneAndRemoveStreamProcessor);
+  pChunkedProcessor->SetStreamName(pChunkedStream->GetName());
+  chunkedGroup.AddProcessor(pChunkedProcessor);
+
+  serialGroup.SetSize(uiNumElements);
+  chunkedGroup.SetSize(uiNumElements);
+
+  serialGroup.InitializeElements(uiNumElements);
+  chunkedGroup.InitializeElements(uiNumElements);
+
+  // spawns the elements
+  serialGroup.Process();
+  chunkedGroup.Process();
+
+  EZ_TEST_INT(chunkedGroup.GetNumActiveElements(), uiNumElements);
+
+  pSerialProcessor->m_uiNumPrepareChunks = 0;
+  pChunkedProcessor->m_uiNumPrepareChunks = 0;
+  pChunkedProcessor->m_uiNumFinishChunks = 0;
+  pChunkedProcessor->m_uiNumRemoved = 0;
+
+  for (ezUInt32 uiStep = 0; uiStep < 2; ++uiStep)
+  {
+    serialGroup.Process();
+    chunkedGroup.Process();
+
+    EZ_TEST_INT(chunkedGroup.GetNumActiveElements(), serialGroup.GetNumActiveElements());
+
+    ezProcessingStreamIterator<float> serialIterator(pSerialStream, serialGroup.GetNumActiveElements(), 0);
+    ezProcessingStreamIterator<float> chunkedIterator(pChunkedStream, chunkedGroup.GetNumActiveElements(), 0);
+
+    // the elements are removed in the same order, so the data must be identical
+    while (!serialIterator.HasReachedEnd())
+    {
+      EZ_TEST_FLOAT(chunkedIterator.Current(), serialIterator.Current(), 0.0f);
+
+      serialIterator.Advance();
+      chunkedIterator.Advance();
+    }
+  }
+
+  // the first step removes a quarter of all elements, the second one a third of the rest
+  EZ_TEST_INT(chunkedGroup.GetNumActiveElements(), uiNumElements / 2);
+  EZ_TEST_INT(pChunkedProcessor->m_uiNumRemoved, uiNumElements / 2);
+  EZ_TEST_INT(pChunkedProcessor->m_uiNumPrepareChunks, 2);
+  EZ_TEST_INT(pChunkedProcessor->m_uiNumFinishChunks, 2);
+  EZ_TEST_INT(pSerialProcessor->m_uiNumPrepareChunks, 2);
+}
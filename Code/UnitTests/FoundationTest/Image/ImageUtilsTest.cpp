@@ -3,6 +3,7 @@
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Texture/Image/ImageFilter.h>
 #include <Texture/Image/ImageUtils.h>
 
 
@@ -116,5 +117,46 @@ EZ_CREATE_SIMPLE_TEST(Image, ImageUtils)
     EZ_TEST_INT(uiError, 1433);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Scale3D Depth")
+  {
+    ezImageHeader header;
+    header.SetImageFormat(ezImageFormat::R32G32B32A32_FLOAT);
+    header.SetWidth(4);
+    header.SetHeight(4);
+    header.SetDepth(4);
+
+    ezImage image;
+    image.ResetAndAlloc(header);
+
+    for (ezUInt32 z = 0; z < 4; ++z)
+    {
+      for (ezUInt32 y = 0; y < 4; ++y)
+      {
+        for (ezUInt32 x = 0; x < 4; ++x)
+        {
+          const float fValue = static_cast<float>(z);
+          *image.GetPixelPointer<ezColor>(0, 0, 0, x, y, z) = ezColor(fValue, fValue, fValue, 1.0f);
+        }
+      }
+    }
+
+    ezImageFilterBox filter;
+    ezImage scaled;
+    EZ_TEST_BOOL(ezImageUtils::Scale3D(image, scaled, 4, 4, 2, &filter).Succeeded());
+    EZ_TEST_INT(scaled.GetDepth(), 2);
+
+    // every target slice is the average of two source slices
+    for (ezUInt32 z = 0; z < 2; ++z)
+    {
+      for (ezUInt32 y = 0; y < 4; ++y)
+      {
+        for (ezUInt32 x = 0; x < 4; ++x)
+        {
+          EZ_TEST_FLOAT(scaled.GetPixelPointer<ezColor>(0, 0, 0, x, y, z)->r, z * 2.0f + 0.5f, 0.0001f);
+        }
+      }
+    }
+  }
+
   ezFileSystem::RemoveDataDirectoryGroup("ImageTest");
 }
@@ -1,8 +1,12 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Memory/LargeBlockAllocator.h>
+#include <Foundation/Memory/PerThreadStackAllocator.h>
 #include <Foundation/Memory/StackAllocator.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Threading/Thread.h>
 
 struct alignas(EZ_ALIGNMENT_MINIMUM) NonAlignedVector
 {
@@ -37,6 +41,36 @@ struct alignas(16) AlignedVector
   float w;
 };
 
+struct ThreadSafeCounter
+{
+  ThreadSafeCounter() { s_iAlive.Increment(); }
+  ~ThreadSafeCounter() { s_iAlive.Decrement(); }
+
+  static ezAtomicInteger32 s_iAlive;
+};
+
+ezAtomicInteger32 ThreadSafeCounter::s_iAlive;
+
+class DeallocateThread : public ezThread
+{
+public:
+  DeallocateThread(ezAllocatorBase* pAllocator, void* pPtr)
+    : ezThread("DeallocateThread")
+    , m_pAllocator(pAllocator)
+    , m_pPtr(pPtr)
+  {
+  }
+
+  virtual ezUInt32 Run() override
+  {
+    m_pAllocator->Deallocate(m_pPtr);
+    return 0;
+  }
+
+  ezAllocatorBase* m_pAllocator;
+  void* m_pPtr;
+};
+
 template <typename T>
 void TestAlignmentHelper(size_t uiExpectedAlignment)
 {
@@ -240,4 +274,129 @@ EZ_CREATE_SIMPLE_TEST(Memory, Allocator)
 
     EZ_TEST_BOOL(ezConstructionCounter::HasDestructed(50));
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "PerThreadStackAllocator")
+  {
+    ezPerThreadStackAllocator allocator("TestPerThreadStackAllocator", ezFoundation::GetAlignedAllocator());
+
+    ezDynamicArray<ezConstructionCounter*> counters;
+    counters.Reserve(100);
+
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      counters.PushBack(EZ_NEW(&allocator, ezConstructionCounter));
+      EZ_TEST_BOOL(ezMemoryUtils::IsAligned(counters.PeekBack(), EZ_ALIGNMENT_OF(ezConstructionCounter)));
+    }
+
+    AlignedVector* pAligned = EZ_NEW(&allocator, AlignedVector);
+    EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pAligned, 16));
+
+    EZ_TEST_BOOL(ezConstructionCounter::HasConstructed(100));
+
+    for (ezUInt32 i = 0; i < 50; ++i)
+    {
+      EZ_DELETE(&allocator, counters[i * 2]);
+    }
+
+    EZ_TEST_BOOL(ezConstructionCounter::HasDestructed(50));
+
+    allocator.Reset();
+
+    EZ_TEST_BOOL(ezConstructionCounter::HasDestructed(50));
+    EZ_TEST_INT(allocator.GetNumLanes(), 1);
+
+    // memory that is deallocated on another thread is counted in the lane of the allocating thread
+    {
+      ezUInt8* pBuffer = EZ_NEW_RAW_BUFFER(&allocator, ezUInt8, 100);
+      EZ_TEST_INT(allocator.AllocatedSize(pBuffer), 100);
+
+      DeallocateThread thread(&allocator, pBuffer);
+      thread.Start();
+      thread.Join();
+
+      EZ_TEST_INT(allocator.GetNumLanes(), 1);
+      EZ_TEST_INT(allocator.GetStats().m_uiNumDeallocations, 1);
+
+      allocator.Reset();
+    }
+
+    // allocate from many threads in parallel, every thread gets its own lane
+    ezAtomicInteger32 iNumErrors;
+
+    ezParallelForParams params;
+    params.m_uiBinSize = 16;
+
+    ezTaskSystem::ParallelForIndexed(
+      0u, 1024u, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          ezUInt32* pData = EZ_NEW_RAW_BUFFER(&allocator, ezUInt32, 16);
+          for (ezUInt32 j = 0; j < 16; ++j)
+          {
+            pData[j] = i;
+          }
+
+          EZ_NEW(&allocator, ThreadSafeCounter);
+
+          // let other threads write their data in between
+          ezThreadUtils::YieldTimeSlice();
+
+          for (ezUInt32 j = 0; j < 16; ++j)
+          {
+            if (pData[j] != i)
+              iNumErrors.Increment();
+          }
+        } },
+      "PerThreadStackAllocatorTest", params);
+
+    EZ_TEST_INT(iNumErrors, 0);
+    EZ_TEST_INT(ThreadSafeCounter::s_iAlive, 1024);
+    EZ_TEST_BOOL(allocator.GetNumLanes() >= 1);
+
+    ezDynamicArray<ezPerThreadStackAllocator::LaneStats> laneStats;
+    allocator.GetLaneStats(laneStats);
+    EZ_TEST_INT(laneStats.GetCount(), allocator.GetNumLanes());
+
+    ezUInt64 uiNumAllocations = 0;
+    for (const auto& stats : laneStats)
+    {
+      uiNumAllocations += stats.m_uiNumAllocations;
+      EZ_TEST_BOOL(stats.m_uiAllocationSize <= stats.m_uiReservedSize);
+    }
+    EZ_TEST_INT(uiNumAllocations, 2048);
+    EZ_TEST_INT(allocator.GetStats().m_uiNumAllocations, 2048);
+
+    allocator.Reset();
+
+    EZ_TEST_INT(ThreadSafeCounter::s_iAlive, 0);
+    EZ_TEST_INT(allocator.GetStats().m_uiNumAllocations, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "DoubleBufferedStackAllocator with PerThreadLanes")
+  {
+    ezDoubleBufferedStackAllocator allocator("TestDoubleBuffered", ezFoundation::GetAlignedAllocator(), ezStackAllocatorThreading::PerThreadLanes);
+    EZ_TEST_INT(allocator.GetThreading(), ezStackAllocatorThreading::PerThreadLanes);
+
+    ezAllocatorBase* pFirst = allocator.GetCurrentAllocator();
+    EZ_NEW(pFirst, ezConstructionCounter);
+
+    allocator.Swap();
+    EZ_TEST_BOOL(allocator.GetCurrentAllocator() != pFirst);
+    EZ_TEST_BOOL(ezConstructionCounter::HasDestructed(0));
+
+    EZ_NEW(allocator.GetCurrentAllocator(), ezConstructionCounter);
+
+    ezDynamicArray<ezPerThreadStackAllocator::LaneStats> laneStats;
+    allocator.GetCurrentLaneStats(laneStats);
+    EZ_TEST_INT(laneStats.GetCount(), 1);
+    EZ_TEST_INT(laneStats[0].m_uiNumAllocations, 1);
+
+    // the first allocator is reset now
+    allocator.Swap();
+    EZ_TEST_BOOL(ezConstructionCounter::HasDone(1, 1));
+
+    allocator.Reset();
+    EZ_TEST_BOOL(ezConstructionCounter::HasDestructed(1));
+  }
 }
@@ -0,0 +1,213 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/CodeUtils/Expression/ExpressionByteCode.h>
+#include <Foundation/CodeUtils/Expression/ExpressionCompiler.h>
+#include <Foundation/CodeUtils/Expression/ExpressionParser.h>
+#include <Foundation/CodeUtils/Expression/ExpressionVM.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum constants
+  {
+    NUM_INSTANCES = 1024 * 1024,
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    NUM_RUNS = 2,
+#else
+    NUM_RUNS = 10,
+#endif
+  };
+
+  static ezHashedString s_sPosition = ezMakeHashedString("position");
+  static ezHashedString s_sVelocity = ezMakeHashedString("velocity");
+  static ezHashedString s_sAge = ezMakeHashedString("age");
+  static ezHashedString s_sOutPosition = ezMakeHashedString("outPosition");
+  static ezHashedString s_sOutVelocity = ezMakeHashedString("outVelocity");
+  static ezHashedString s_sOutAlpha = ezMakeHashedString("outAlpha");
+  static ezHashedString s_sPointIndex = ezMakeHashedString("pointIndex");
+  static ezHashedString s_sDensity = ezMakeHashedString("density");
+  static ezHashedString s_sScale = ezMakeHashedString("scale");
+
+  // Similar to what a particle behavior does every frame: integrate with gravity and drag, fade out towards the end of the lifetime.
+  static const char* s_szParticleCode = "var vel = velocity * 0.98 + vec3(0, 0, -9.81) * 0.016\n"
+                                        "outPosition = position + vel * 0.016\n"
+                                        "outVelocity = vel\n"
+                                        "var t = saturate(age / 2.5)\n"
+                                        "outAlpha = lerp(1, 0, t * t) * (age < 2.5 ? 1 : 0)";
+
+  // Similar to a procedural placement output: noise based density, filtered by height and slope, with a random scale per point.
+  static const char* s_szProcGenCode = "var noise = PerlinNoise(position.x * 0.05, position.y * 0.05, position.z * 0.05, 2)\n"
+                                       "var slope = abs(velocity.z) / max(length(velocity), 0.001)\n"
+                                       "var heightMask = saturate((position.z + 10) * 0.1) * saturate((50 - position.z) * 0.05)\n"
+                                       "density = (slope > 0.7 && noise > 0.3) ? noise * heightMask : 0\n"
+                                       "scale = lerp(0.8, 1.2, Random(pointIndex, 42)) * (1 + floor(noise * 4) * 0.25)";
+
+  void Compile(ezExpressionParser& ref_parser, ezStringView sCode, ezArrayPtr<ezExpression::StreamDesc> inputs, ezArrayPtr<ezExpression::StreamDesc> outputs, ezExpressionByteCode& out_byteCode)
+  {
+    ezExpressionAST ast;
+    EZ_TEST_BOOL(ref_parser.Parse(sCode, inputs, outputs, {}, ast).Succeeded());
+
+    ezExpressionCompiler compiler;
+    EZ_TEST_BOOL(compiler.Compile(ast, out_byteCode).Succeeded());
+  }
+
+  void RunBenchmark(ezExpressionVM& ref_vm, const ezExpressionByteCode& byteCode, ezArrayPtr<const ezProcessingStream> inputs, ezArrayPtr<ezProcessingStream> outputs, ezStringView sName)
+  {
+    enum class Mode
+    {
+      SSE,
+      AVX2,
+      JIT,
+    };
+
+    const Mode modes[] = {Mode::SSE, Mode::AVX2, Mode::JIT};
+    for (Mode mode : modes)
+    {
+      if (mode == Mode::AVX2 && ezExpressionVM::IsAVX2Supported() == false)
+      {
+        ezLog::Info("[test]{0}: AVX2 is not supported", sName);
+        continue;
+      }
+
+      if (mode == Mode::JIT && ezExpressionVM::IsJITSupported() == false)
+      {
+        ezLog::Info("[test]{0}: JIT is not supported", sName);
+        continue;
+      }
+
+      ref_vm.SetAllowAVX2(mode == Mode::AVX2);
+      ref_vm.SetAllowJIT(mode == Mode::JIT);
+
+      // warm up, so that all registers are allocated and the native code is generated
+      EZ_TEST_BOOL(ref_vm.Execute(byteCode, inputs, outputs, NUM_INSTANCES).Succeeded());
+
+      if (mode == Mode::JIT && ref_vm.GetLastExecutionUsedJIT() == false)
+      {
+        ezLog::Info("[test]{0}: byte code is not supported by the JIT", sName);
+        continue;
+      }
+
+      const ezTime t0 = ezTime::Now();
+
+      for (ezUInt32 i = 0; i < NUM_RUNS; ++i)
+      {
+        ref_vm.Execute(byteCode, inputs, outputs, NUM_INSTANCES).IgnoreResult();
+      }
+
+      const ezTime t1 = ezTime::Now();
+      const double fMilliseconds = (t1 - t0).GetMilliseconds() / NUM_RUNS;
+
+      const char* szModeNames[] = {"4-wide SSE", "8-wide AVX2", "JIT"};
+      ezLog::Info("[test]{0}, {1}: {2}ms, {3} instances/ms", sName, szModeNames[static_cast<int>(mode)], ezArgF(fMilliseconds, 3), ezArgF(NUM_INSTANCES / fMilliseconds, 0));
+    }
+
+    ref_vm.SetAllowAVX2(true);
+    ref_vm.SetAllowJIT(false);
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Performance, ExpressionVM)
+{
+  ezExpressionParser parser;
+  parser.RegisterFunction(ezDefaultExpressionFunctions::s_RandomFunc.m_Desc);
+  parser.RegisterFunction(ezDefaultExpressionFunctions::s_PerlinNoiseFunc.m_Desc);
+
+  ezExpressionVM vm;
+
+  ezDynamicArray<ezVec3> positions;
+  ezDynamicArray<ezVec3> velocities;
+  ezDynamicArray<float> ages;
+  ezDynamicArray<int> pointIndices;
+  positions.SetCountUninitialized(NUM_INSTANCES);
+  velocities.SetCountUninitialized(NUM_INSTANCES);
+  ages.SetCountUninitialized(NUM_INSTANCES);
+  pointIndices.SetCountUninitialized(NUM_INSTANCES);
+
+  for (ezUInt32 i = 0; i < NUM_INSTANCES; ++i)
+  {
+    const float f = static_cast<float>(i);
+    positions[i].Set(ezMath::Sin(ezAngle::MakeFromRadian(f * 0.01f)) * 100.0f, ezMath::Cos(ezAngle::MakeFromRadian(f * 0.013f)) * 100.0f, static_cast<float>(i % 64));
+    velocities[i].Set(static_cast<float>(i % 7) - 3.0f, static_cast<float>(i % 5) - 2.0f, static_cast<float>(i % 11) * 0.5f);
+    ages[i] = static_cast<float>(i % 300) * 0.01f;
+    pointIndices[i] = static_cast<int>(i);
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Particle Update 1M")
+  {
+    ezExpression::StreamDesc inputDescs[] = {
+      {s_sPosition, ezProcessingStream::DataType::Float3},
+      {s_sVelocity, ezProcessingStream::DataType::Float3},
+      {s_sAge, ezProcessingStream::DataType::Float},
+    };
+
+    ezExpression::StreamDesc outputDescs[] = {
+      {s_sOutPosition, ezProcessingStream::DataType::Float3},
+      {s_sOutVelocity, ezProcessingStream::DataType::Float3},
+      {s_sOutAlpha, ezProcessingStream::DataType::Float},
+    };
+
+    ezExpressionByteCode byteCode;
+    Compile(parser, s_szParticleCode, inputDescs, outputDescs, byteCode);
+
+    ezDynamicArray<ezVec3> outPositions;
+    ezDynamicArray<ezVec3> outVelocities;
+    ezDynamicArray<float> outAlphas;
+    outPositions.SetCount(NUM_INSTANCES);
+    outVelocities.SetCount(NUM_INSTANCES);
+    outAlphas.SetCount(NUM_INSTANCES);
+
+    ezProcessingStream inputs[] = {
+      ezProcessingStream(s_sPosition, positions.GetByteArrayPtr(), ezProcessingStream::DataType::Float3),
+      ezProcessingStream(s_sVelocity, velocities.GetByteArrayPtr(), ezProcessingStream::DataType::Float3),
+      ezProcessingStream(s_sAge, ages.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+    };
+
+    ezProcessingStream outputs[] = {
+      ezProcessingStream(s_sOutPosition, outPositions.GetByteArrayPtr(), ezProcessingStream::DataType::Float3),
+      ezProcessingStream(s_sOutVelocity, outVelocities.GetByteArrayPtr(), ezProcessingStream::DataType::Float3),
+      ezProcessingStream(s_sOutAlpha, outAlphas.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+    };
+
+    RunBenchmark(vm, byteCode, inputs, outputs, "Particle Update 1M");
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "ProcGen Placement 1M")
+  {
+    ezExpression::StreamDesc inputDescs[] = {
+      {s_sPosition, ezProcessingStream::DataType::Float3},
+      {s_sVelocity, ezProcessingStream::DataType::Float3},
+      {s_sPointIndex, ezProcessingStream::DataType::Int},
+    };
+
+    ezExpression::StreamDesc outputDescs[] = {
+      {s_sDensity, ezProcessingStream::DataType::Float},
+      {s_sScale, ezProcessingStream::DataType::Float},
+    };
+
+    ezExpressionByteCode byteCode;
+    Compile(parser, s_szProcGenCode, inputDescs, outputDescs, byteCode);
+
+    ezDynamicArray<float> densities;
+    ezDynamicArray<float> scales;
+    densities.SetCount(NUM_INSTANCES);
+    scales.SetCount(NUM_INSTANCES);
+
+    // the velocity is used as the surface normal here
+    ezProcessingStream inputs[] = {
+      ezProcessingStream(s_sPosition, positions.GetByteArrayPtr(), ezProcessingStream::DataType::Float3),
+      ezProcessingStream(s_sVelocity, velocities.GetByteArrayPtr(), ezProcessingStream::DataType::Float3),
+      ezProcessingStream(s_sPointIndex, pointIndices.GetByteArrayPtr(), ezProcessingStream::DataType::Int),
+    };
+
+    ezProcessingStream outputs[] = {
+      ezProcessingStream(s_sDensity, densities.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+      ezProcessingStream(s_sScale, scales.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+    };
+
+    RunBenchmark(vm, byteCode, inputs, outputs, "ProcGen Placement 1M");
+  }
+}
@@ -0,0 +1,83 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  constexpr ezUInt32 NUM_STRINGS = 1024 * 16;
+  constexpr ezUInt32 NUM_LOOKUPS_PER_STRING = 4;
+#else
+  constexpr ezUInt32 NUM_STRINGS = 1024 * 128;
+  constexpr ezUInt32 NUM_LOOKUPS_PER_STRING = 16;
+#endif
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Performance, HashedString)
+{
+  // format all strings up front, so that only the hashed string operations are measured
+  ezDynamicArray<ezString> strings;
+  strings.SetCount(NUM_STRINGS);
+  {
+    ezStringBuilder sTemp;
+    for (ezUInt32 i = 0; i < NUM_STRINGS; ++i)
+    {
+      sTemp.Format("PerformanceHashedString_{}", i);
+      strings[i] = sTemp;
+    }
+  }
+
+  ezDynamicArray<ezHashedString> hashedStrings;
+  hashedStrings.SetCount(NUM_STRINGS);
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Insert (multi-threaded)")
+  {
+    ezTime t0 = ezTime::Now();
+
+    ezTaskSystem::ParallelForIndexed(0u, NUM_STRINGS, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        hashedStrings[i].Assign(strings[i]);
+      }
+    });
+
+    ezTime t1 = ezTime::Now();
+    ezLog::Info("[test]Inserting {0} hashed strings: {1}ms", NUM_STRINGS, ezArgF((t1 - t0).GetMilliseconds(), 2));
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Lookup (multi-threaded)")
+  {
+    ezTime t0 = ezTime::Now();
+
+    ezTaskSystem::ParallelForIndexed(0u, NUM_STRINGS * NUM_LOOKUPS_PER_STRING, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      ezHashedString sHashed;
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        sHashed.Assign(strings[i % NUM_STRINGS]);
+      }
+    });
+
+    ezTime t1 = ezTime::Now();
+    ezLog::Info("[test]Looking up {0} existing hashed strings: {1}ms", NUM_STRINGS * NUM_LOOKUPS_PER_STRING, ezArgF((t1 - t0).GetMilliseconds(), 2));
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Lookup (single-threaded)")
+  {
+    ezTime t0 = ezTime::Now();
+
+    ezHashedString sHashed;
+    for (ezUInt32 i = 0; i < NUM_STRINGS * NUM_LOOKUPS_PER_STRING; ++i)
+    {
+      sHashed.Assign(strings[i % NUM_STRINGS]);
+    }
+
+    ezTime t1 = ezTime::Now();
+    ezLog::Info("[test]Looking up {0} existing hashed strings on one thread: {1}ms", NUM_STRINGS * NUM_LOOKUPS_PER_STRING, ezArgF((t1 - t0).GetMilliseconds(), 2));
+  }
+}
@@ -0,0 +1,80 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Time.h>
+#include <Texture/Image/ImageFilter.h>
+#include <Texture/Image/ImageUtils.h>
+
+namespace
+{
+  void CreateNoiseImage(ezUInt32 uiSize, ezImageFormat::Enum format, ezImage& out_image)
+  {
+    ezImageHeader header;
+    header.SetImageFormat(ezImageFormat::R32G32B32A32_FLOAT);
+    header.SetWidth(uiSize);
+    header.SetHeight(uiSize);
+
+    out_image.ResetAndAlloc(header);
+
+    ezRandom rnd;
+    rnd.Initialize(42);
+
+    for (ezColor& color : out_image.GetBlobPtr<ezColor>())
+    {
+      color = ezColor(static_cast<float>(rnd.FloatZeroToOneExclusive()), static_cast<float>(rnd.FloatZeroToOneExclusive()), static_cast<float>(rnd.FloatZeroToOneExclusive()), 1.0f);
+    }
+
+    out_image.Convert(format).IgnoreResult();
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+// Note: the 8k runs need a few GB of memory, since all filtering is done on 32 bit float images.
+EZ_CREATE_SIMPLE_TEST(Performance, ImageUtils)
+{
+  const ezUInt32 sizes[] = {1024, 4096, 8192};
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Scale")
+  {
+    for (ezUInt32 uiSize : sizes)
+    {
+      ezImage source;
+      CreateNoiseImage(uiSize, ezImageFormat::R8G8B8A8_UNORM_SRGB, source);
+
+      ezImageFilterSincWithKaiserWindow filter;
+      ezImage target;
+
+      const ezTime t0 = ezTime::Now();
+      EZ_TEST_BOOL(ezImageUtils::Scale(source, target, uiSize / 2, uiSize / 2, &filter).Succeeded());
+      const ezTime tScale = ezTime::Now() - t0;
+
+      EZ_TEST_INT(target.GetWidth(), uiSize / 2);
+      ezLog::Info("[test]Scale {0}x{0} RGBA8 to half size (Kaiser): {1}ms", uiSize, ezArgF(tScale.GetMilliseconds(), 1));
+    }
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "GenerateMipMaps")
+  {
+    for (ezUInt32 uiSize : sizes)
+    {
+      ezImage source;
+      CreateNoiseImage(uiSize, ezImageFormat::R32G32B32A32_FLOAT, source);
+
+      ezImageUtils::MipMapOptions options;
+      ezImageFilterSincWithKaiserWindow filter;
+      options.m_filter = &filter;
+
+      ezImage target;
+
+      const ezTime t0 = ezTime::Now();
+      ezImageUtils::GenerateMipMaps(source, target, options);
+      const ezTime tMipMaps = ezTime::Now() - t0;
+
+      EZ_TEST_INT(target.GetNumMipLevels(), source.GetHeader().ComputeNumberOfMipMaps());
+      ezLog::Info("[test]GenerateMipMaps {0}x{0} RGBA32F (Kaiser): {1}ms", uiSize, ezArgF(tMipMaps.GetMilliseconds(), 1));
+    }
+  }
+}
@@ -0,0 +1,106 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Communication/PerThreadMessageQueue.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  struct ezMsgPerThreadPerfTest : public ezMessage
+  {
+    EZ_DECLARE_MESSAGE_TYPE(ezMsgPerThreadPerfTest, ezMessage);
+  };
+
+  EZ_IMPLEMENT_MESSAGE_TYPE(ezMsgPerThreadPerfTest);
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezMsgPerThreadPerfTest, 1, ezRTTIDefaultAllocator<ezMsgPerThreadPerfTest>)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+  struct MetaData
+  {
+    ezUInt64 m_uiReceiver;
+  };
+
+  enum constants
+  {
+    NUM_THREADS = 8,
+    NUM_MESSAGES_PER_THREAD = 200000,
+  };
+
+  template <typename QueueType>
+  class PostThread : public ezThread
+  {
+  public:
+    PostThread()
+      : ezThread("Post Thread")
+    {
+    }
+
+    QueueType* m_pQueue = nullptr;
+    ezMsgPerThreadPerfTest* m_pMessage = nullptr;
+
+    virtual ezUInt32 Run() override
+    {
+      for (ezUInt32 i = 0; i < NUM_MESSAGES_PER_THREAD; ++i)
+      {
+        m_pQueue->Enqueue(m_pMessage, {i});
+      }
+
+      return 0;
+    }
+  };
+
+  // like the async phase of a world update, where many components post messages at the same time
+  template <typename QueueType>
+  ezTime MeasurePosting(QueueType& ref_queue, ezMsgPerThreadPerfTest& ref_msg)
+  {
+    PostThread<QueueType> threads[NUM_THREADS];
+
+    const ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 i = 0; i < NUM_THREADS; ++i)
+    {
+      threads[i].m_pQueue = &ref_queue;
+      threads[i].m_pMessage = &ref_msg;
+      threads[i].Start();
+    }
+
+    for (ezUInt32 i = 0; i < NUM_THREADS; ++i)
+    {
+      threads[i].Join();
+    }
+
+    return ezTime::Now() - t0;
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Performance, PerThreadMessageQueue)
+{
+  ezMsgPerThreadPerfTest msg;
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Posting from 8 threads")
+  {
+    ezTime tMutex;
+    {
+      ezMessageQueue<MetaData> queue;
+
+      tMutex = MeasurePosting(queue, msg);
+      EZ_TEST_INT(queue.GetCount(), NUM_THREADS * NUM_MESSAGES_PER_THREAD);
+    }
+
+    ezTime tPerThread;
+    {
+      ezPerThreadMessageQueue<MetaData> queue;
+
+      tPerThread = MeasurePosting(queue, msg);
+      EZ_TEST_INT(queue.GetCount(), NUM_THREADS * NUM_MESSAGES_PER_THREAD);
+    }
+
+    ezLog::Info("[test]{0} threads posting {1} messages each: mutex queue {2}ms, per-thread queue {3}ms, speedup {4}x", NUM_THREADS,
+      NUM_MESSAGES_PER_THREAD, ezArgF(tMutex.GetMilliseconds(), 2), ezArgF(tPerThread.GetMilliseconds(), 2),
+      ezArgF(tMutex.GetMilliseconds() / tPerThread.GetMilliseconds(), 1));
+  }
+}
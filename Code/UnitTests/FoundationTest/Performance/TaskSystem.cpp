@@ -0,0 +1,101 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  enum constants
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    NUM_FRAMES = 10,
+    NUM_PARALLEL_FOR_ITEMS = 1024 * 16,
+    NUM_SMALL_TASKS = 1024,
+#else
+    NUM_FRAMES = 100,
+    NUM_PARALLEL_FOR_ITEMS = 1024 * 64,
+    NUM_SMALL_TASKS = 1024 * 4,
+#endif
+  };
+
+  const char* GetSchedulerModeName(ezTaskSchedulerMode::Enum mode)
+  {
+    return mode == ezTaskSchedulerMode::WorkStealing ? "WorkStealing" : "GlobalQueue";
+  }
+
+  /// Simulates a frame with many tiny work items: one large ParallelFor and a burst of individual tasks.
+  void RunBenchmarkFrame(ezDynamicArray<float>& ref_data)
+  {
+    ezParallelForParams params;
+    params.m_uiBinSize = 64;
+    params.m_uiMaxTasksPerThread = 4;
+
+    ezTaskSystem::ParallelFor<float>(
+      ref_data.GetArrayPtr(), [](ezArrayPtr<float> items)
+      {
+        for (float& f : items)
+        {
+          f = f * 0.5f + 1.0f;
+        } },
+      "BenchmarkParallelFor", params);
+
+    ezTaskGroupID group = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+
+    for (ezUInt32 i = 0; i < NUM_SMALL_TASKS; ++i)
+    {
+      ezSharedPtr<ezTask> pTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "BenchmarkTask", ezTaskNesting::Never, []() {});
+      ezTaskSystem::AddTaskToGroup(group, pTask);
+    }
+
+    ezTaskSystem::StartTaskGroup(group);
+    ezTaskSystem::WaitForGroup(group);
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Performance, TaskSystem)
+{
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Scheduler Throughput")
+  {
+    ezDynamicArray<float> data;
+    data.SetCount(NUM_PARALLEL_FOR_ITEMS, 1.0f);
+
+    const ezUInt32 threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+    const ezTaskSchedulerMode::Enum modes[] = {ezTaskSchedulerMode::GlobalQueue, ezTaskSchedulerMode::WorkStealing};
+
+    for (ezUInt32 uiThreads : threadCounts)
+    {
+      ezTaskSystem::SetWorkerThreadCount(uiThreads, 2);
+
+      for (ezTaskSchedulerMode::Enum mode : modes)
+      {
+        ezTaskSystem::SetSchedulerMode(mode);
+
+        // warm up, so that all threads are allocated
+        RunBenchmarkFrame(data);
+        ezTaskSystem::FinishFrameTasks();
+
+        const ezTime t0 = ezTime::Now();
+
+        for (ezUInt32 uiFrame = 0; uiFrame < NUM_FRAMES; ++uiFrame)
+        {
+          RunBenchmarkFrame(data);
+          ezTaskSystem::FinishFrameTasks();
+        }
+
+        const ezTime t1 = ezTime::Now();
+        const double fTasksPerFrame = NUM_SMALL_TASKS + uiThreads * 4.0;
+
+        ezLog::Info("[test]{0} threads, {1}: {2}ms per frame, {3} tasks/ms", uiThreads, GetSchedulerModeName(mode),
+          ezArgF((t1 - t0).GetMilliseconds() / NUM_FRAMES, 4), ezArgF(fTasksPerFrame * NUM_FRAMES / (t1 - t0).GetMilliseconds(), 1));
+      }
+    }
+
+    ezTaskSystem::SetSchedulerMode(ezTaskSchedulerMode::Default);
+    ezTaskSystem::SetWorkerThreadCount();
+  }
+}
@@ -0,0 +1,143 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Communication/TimedMessageQueue.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+  struct ezMsgTimedPerfTest : public ezMessage
+  {
+    EZ_DECLARE_MESSAGE_TYPE(ezMsgTimedPerfTest, ezMessage);
+  };
+
+  EZ_IMPLEMENT_MESSAGE_TYPE(ezMsgTimedPerfTest);
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezMsgTimedPerfTest, 1, ezRTTIDefaultAllocator<ezMsgTimedPerfTest>)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+  struct MetaData
+  {
+    ezUInt64 m_uiReceiver;
+    ezTime m_Due;
+  };
+
+  using SortedQueue = ezMessageQueue<MetaData>;
+  using TimedQueue = ezTimedMessageQueue<MetaData>;
+
+  // same order as the one that ezWorld uses for its queued messages
+  struct MessageComparer
+  {
+    EZ_FORCE_INLINE bool Less(const SortedQueue::Entry& a, const SortedQueue::Entry& b) const
+    {
+      if (a.m_MetaData.m_Due != b.m_MetaData.m_Due)
+        return a.m_MetaData.m_Due < b.m_MetaData.m_Due;
+
+      return a.m_MetaData.m_uiReceiver < b.m_MetaData.m_uiReceiver;
+    }
+  };
+
+  enum constants
+  {
+    NUM_PENDING = 100000,
+    NUM_FRAMES = 120,
+  };
+
+  // like gameplay timers, e.g. delayed deaths, spawners and trigger delays, which post the next message once one is processed
+  ezTime GetDelay(ezRandom& ref_rnd)
+  {
+    return ezTime::MakeFromSeconds(ref_rnd.DoubleMinMax(0.1, 60.0));
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(Performance, TimedMessageQueue)
+{
+  ezMsgTimedPerfTest msg;
+  const ezTime frameTime = ezTime::MakeFromSeconds(1.0 / 60.0);
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "100k pending messages")
+  {
+    ezUInt32 uiProcessedSorted = 0;
+    ezUInt32 uiProcessedTimed = 0;
+
+    ezTime tSorted;
+    {
+      ezRandom rnd;
+      rnd.Initialize(42);
+
+      SortedQueue queue;
+      ezTime now = ezTime::MakeZero();
+
+      for (ezUInt32 i = 0; i < NUM_PENDING; ++i)
+      {
+        queue.Enqueue(&msg, {i, now + GetDelay(rnd)});
+      }
+
+      for (ezUInt32 uiFrame = 0; uiFrame < NUM_FRAMES; ++uiFrame)
+      {
+        now += frameTime;
+
+        const ezTime t0 = ezTime::Now();
+
+        // what ezWorld did before: sort all pending messages, then process the ones that are due
+        queue.Sort(MessageComparer());
+
+        while (!queue.IsEmpty() && queue.Peek().m_MetaData.m_Due <= now)
+        {
+          const ezUInt64 uiReceiver = queue.Peek().m_MetaData.m_uiReceiver;
+          queue.Dequeue();
+
+          queue.Enqueue(&msg, {uiReceiver, now + GetDelay(rnd)});
+          ++uiProcessedSorted;
+        }
+
+        tSorted += ezTime::Now() - t0;
+      }
+    }
+
+    ezTime tTimed;
+    {
+      ezRandom rnd;
+      rnd.Initialize(42);
+
+      TimedQueue queue;
+      ezTime now = ezTime::MakeZero();
+
+      for (ezUInt32 i = 0; i < NUM_PENDING; ++i)
+      {
+        queue.Enqueue(&msg, {i, now + GetDelay(rnd)});
+      }
+
+      ezDynamicArray<TimedQueue::Entry> dueMessages;
+
+      for (ezUInt32 uiFrame = 0; uiFrame < NUM_FRAMES; ++uiFrame)
+      {
+        now += frameTime;
+
+        const ezTime t0 = ezTime::Now();
+
+        dueMessages.Clear();
+        queue.DequeueDue(now, dueMessages);
+        dueMessages.Sort(MessageComparer());
+
+        for (const TimedQueue::Entry& entry : dueMessages)
+        {
+          queue.Enqueue(&msg, {entry.m_MetaData.m_uiReceiver, now + GetDelay(rnd)});
+          ++uiProcessedTimed;
+        }
+
+        tTimed += ezTime::Now() - t0;
+      }
+    }
+
+    EZ_TEST_INT(uiProcessedSorted, uiProcessedTimed);
+
+    const double fSortedMs = tSorted.GetMilliseconds() / NUM_FRAMES;
+    const double fTimedMs = tTimed.GetMilliseconds() / NUM_FRAMES;
+    ezLog::Info("[test]{0} pending messages, {1} processed per frame: sorted queue {2}ms, timing wheel {3}ms per frame, speedup {4}x", NUM_PENDING,
+      uiProcessedTimed / NUM_FRAMES, ezArgF(fSortedMs, 3), ezArgF(fTimedMs, 3), ezArgF(fSortedMs / fTimedMs, 1));
+  }
+}
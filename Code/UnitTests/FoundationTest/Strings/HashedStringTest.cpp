@@ -1,6 +1,7 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 EZ_CREATE_SIMPLE_TEST(Strings, HashedString)
 {
@@ -185,6 +186,36 @@ EZ_CREATE_SIMPLE_TEST(Strings, HashedString)
     EZ_TEST_STRING(s3.GetString().GetData(), "tut");
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Concurrent Assign")
+  {
+    constexpr ezUInt32 uiNumStrings = 2000;
+
+    ezDynamicArray<ezHashedString> strings1;
+    ezDynamicArray<ezHashedString> strings2;
+    strings1.SetCount(uiNumStrings);
+    strings2.SetCount(uiNumStrings);
+
+    // every string is added twice, by tasks working on different halves of the index range
+    ezTaskSystem::ParallelForIndexed(0, uiNumStrings * 2, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      ezStringBuilder sTemp;
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        sTemp.Format("ConcurrentHashedString_{}", i % uiNumStrings);
+        (i < uiNumStrings ? strings1 : strings2)[i % uiNumStrings].Assign(sTemp);
+      }
+    });
+
+    ezStringBuilder sTemp;
+    for (ezUInt32 i = 0; i < uiNumStrings; ++i)
+    {
+      sTemp.Format("ConcurrentHashedString_{}", i);
+
+      EZ_TEST_BOOL(strings1[i] == strings2[i]);
+      EZ_TEST_STRING(strings1[i].GetData(), sTemp);
+      EZ_TEST_BOOL(strings1[i] == ezTempHashedString(sTemp));
+    }
+  }
+
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "ClearUnusedStrings")
   {
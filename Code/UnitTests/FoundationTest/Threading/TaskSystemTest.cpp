@@ -2,6 +2,7 @@
 
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Threading/DelegateTask.h>
 #include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Time.h>
 #include <Foundation/Utilities/DGMLWriter.h>
@@ -550,6 +551,55 @@ EZ_CREATE_SIMPLE_TEST(Threading, TaskSystem)
     EZ_TEST_BOOL(t[2]->IsMultiplicityDone());
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Work Stealing Scheduler")
+  {
+    ezTaskSystem::SetSchedulerMode(ezTaskSchedulerMode::WorkStealing);
+    EZ_TEST_BOOL(ezTaskSystem::GetSchedulerMode() == ezTaskSchedulerMode::WorkStealing);
+
+    ezAtomicInteger32 iNumInnerItems = 0;
+    ezAtomicInteger32 iNumOuterTasks = 0;
+
+    // outer tasks may wait, so they stay in the locked lists, the ParallelFor tasks that they start go into the worker deques
+    auto OuterTask = [&]() {
+      ezTaskSystem::ParallelForIndexed(0u, 1000u, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) { iNumInnerItems.Add(uiEndIndex - uiStartIndex); });
+      iNumOuterTasks.Increment();
+    };
+
+    ezHybridArray<ezTaskGroupID, 32> groups;
+
+    for (ezUInt32 i = 0; i < 32; ++i)
+    {
+      ezSharedPtr<ezTask> pTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "Outer", ezTaskNesting::Maybe, OuterTask);
+      groups.PushBack(ezTaskSystem::StartSingleTask(pTask, (ezTaskPriority::Enum)(i % 3)));
+    }
+
+    // tasks that never wait go through the injection queues, when started from the main thread
+    ezSharedPtr<ezTestTask> pMultiTask = EZ_DEFAULT_NEW(ezTestTask);
+    pMultiTask->ConfigureTask("Multiplicity", ezTaskNesting::Never);
+    pMultiTask->SetMultiplicity(5000);
+    groups.PushBack(ezTaskSystem::StartSingleTask(pMultiTask, ezTaskPriority::EarlyThisFrame));
+
+    for (const ezTaskGroupID& group : groups)
+    {
+      ezTaskSystem::WaitForGroup(group);
+    }
+
+    EZ_TEST_INT(iNumOuterTasks, 32);
+    EZ_TEST_INT(iNumInnerItems, 32 * 1000);
+    EZ_TEST_BOOL(pMultiTask->IsMultiplicityDone());
+
+    // when switching back, all tasks that are still queued have to be executed as well
+    iNumInnerItems = 0;
+    ezTaskGroupID lastGroup = ezTaskSystem::StartSingleTask(EZ_DEFAULT_NEW(ezDelegateTask<void>, "Outer", ezTaskNesting::Never, [&]() { iNumInnerItems.Increment(); }), ezTaskPriority::LateThisFrame);
+
+    ezTaskSystem::SetSchedulerMode(ezTaskSchedulerMode::GlobalQueue);
+    ezTaskSystem::WaitForGroup(lastGroup);
+    ezTaskSystem::FinishFrameTasks();
+
+    EZ_TEST_INT(iNumInnerItems, 1);
+    EZ_TEST_BOOL(ezTaskSystem::GetSchedulerMode() == ezTaskSchedulerMode::GlobalQueue);
+  }
+
   // capture profiling info for testing
   /*ezStringBuilder sOutputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
 
@@ -0,0 +1,263 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#ifdef BUILDSYSTEM_ENABLE_JOLT_SUPPORT
+
+#  include <Foundation/Threading/DelegateTask.h>
+#  include <Foundation/Threading/TaskSystem.h>
+#  include <Jolt.h>
+#  include <Jolt/Physics/Body/BodyLock.h>
+#  include <Jolt/Physics/PhysicsSystem.h>
+#  include <JoltPlugin/Actors/JoltStaticActorComponent.h>
+#  include <JoltPlugin/Shapes/JoltShapeSphereComponent.h>
+#  include <JoltPlugin/System/JoltWorldModule.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Physics);
+
+namespace
+{
+  // Enough queries to be split across several tasks by the batch functions.
+  constexpr ezUInt32 s_uiNumQueries = 2000;
+
+  /// A grid of static spheres with radius 0.5 in the XY plane, two units apart.
+  void CreateObstacles(ezWorld& ref_world)
+  {
+    for (ezInt32 y = -2; y <= 2; ++y)
+    {
+      for (ezInt32 x = -2; x <= 2; ++x)
+      {
+        ezGameObjectDesc desc;
+        desc.m_LocalPosition = ezVec3(x * 2.0f, y * 2.0f, 0.0f);
+
+        ezGameObject* pObject = nullptr;
+        ref_world.CreateObject(desc, pObject);
+
+        ezJoltStaticActorComponent* pActor = nullptr;
+        ezJoltStaticActorComponent::CreateComponent(pObject, pActor);
+
+        ezJoltShapeSphereComponent* pSphere = nullptr;
+        ezJoltShapeSphereComponent::CreateComponent(pObject, pSphere);
+        pSphere->SetRadius(0.5f);
+      }
+    }
+  }
+
+  ezVec3 GetQueryPosition(ezUInt32 i)
+  {
+    return ezVec3(-5.0f + (i % 50) * 0.2f, -5.0f + (i / 50) * 0.25f, 0.0f);
+  }
+
+  ezPhysicsQueryShape MakeQueryShape(ezUInt32 i, const ezVec3& vPosition)
+  {
+    ezPhysicsQueryShape shape;
+    shape.m_Type = static_cast<ezPhysicsQueryShape::Type>(i % 3);
+    shape.m_fRadius = 0.2f;
+    shape.m_fCapsuleHeight = 0.5f;
+    shape.m_vBoxExtents = ezVec3(0.3f, 0.4f, 0.5f);
+    shape.m_Transform = ezTransform(vPosition, ezQuat::MakeFromAxisAndAngle(ezVec3(0, 0, 1), ezAngle::MakeFromDegree(i * 15.0f)));
+    return shape;
+  }
+
+  void CheckCastResults(bool bHitBatch, const ezPhysicsCastResult& batchResult, bool bHitSingle, const ezPhysicsCastResult& singleResult)
+  {
+    EZ_TEST_BOOL(bHitBatch == bHitSingle);
+
+    if (bHitBatch && bHitSingle)
+    {
+      EZ_TEST_FLOAT(batchResult.m_fDistance, singleResult.m_fDistance, 0.0f);
+      EZ_TEST_VEC3(batchResult.m_vPosition, singleResult.m_vPosition, 0.0f);
+      EZ_TEST_VEC3(batchResult.m_vNormal, singleResult.m_vNormal, 0.0f);
+      EZ_TEST_BOOL(batchResult.m_hActorObject == singleResult.m_hActorObject);
+      EZ_TEST_BOOL(batchResult.m_pInternalPhysicsActor == singleResult.m_pInternalPhysicsActor);
+    }
+  }
+
+  void CreateRaycastQueries(ezDynamicArray<ezPhysicsRaycastQuery>& out_queries)
+  {
+    out_queries.Clear();
+    for (ezUInt32 i = 0; i < s_uiNumQueries; ++i)
+    {
+      ezPhysicsRaycastQuery& query = out_queries.ExpandAndGetRef();
+      query.m_vStart = GetQueryPosition(i) + ezVec3(0, 0, 5);
+      query.m_vDir = ezVec3(0, 0, -1);
+      query.m_fDistance = 10.0f;
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Physics, JoltQueryBatch)
+{
+  ezWorldDesc worldDesc("JoltQueryBatch");
+  ezWorld world(worldDesc);
+
+  {
+    EZ_LOCK(world.GetWriteMarker());
+    world.SetWorldSimulationEnabled(true);
+    CreateObstacles(world);
+  }
+
+  // the static bodies are created when the simulation starts and added to the physics system in the next update
+  for (ezUInt32 i = 0; i < 2; ++i)
+  {
+    EZ_LOCK(world.GetWriteMarker());
+    world.Update();
+  }
+
+  EZ_LOCK(world.GetReadMarker());
+
+  const ezPhysicsWorldModuleInterface* pModule = world.GetModuleReadOnly<ezPhysicsWorldModuleInterface>();
+  if (!EZ_TEST_BOOL(pModule != nullptr && pModule->IsInstanceOf<ezJoltWorldModule>()))
+    return;
+
+  const ezPhysicsQueryParameters params(0, ezPhysicsShapeType::Static);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RaycastBatch")
+  {
+    ezDynamicArray<ezPhysicsRaycastQuery> queries;
+    CreateRaycastQueries(queries);
+
+    ezDynamicArray<ezPhysicsCastResult> results;
+    results.SetCount(s_uiNumQueries);
+    ezDynamicArray<bool> hits;
+    hits.SetCount(s_uiNumQueries);
+
+    pModule->RaycastBatch(results, hits, queries, params);
+
+    ezUInt32 uiNumHits = 0;
+    for (ezUInt32 i = 0; i < s_uiNumQueries; ++i)
+    {
+      ezPhysicsCastResult singleResult;
+      const bool bHit = pModule->Raycast(singleResult, queries[i].m_vStart, queries[i].m_vDir, queries[i].m_fDistance, params);
+
+      CheckCastResults(hits[i], results[i], bHit, singleResult);
+      uiNumHits += bHit ? 1 : 0;
+    }
+
+    EZ_TEST_BOOL(uiNumHits > 0 && uiNumHits < s_uiNumQueries);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SweepTestBatch")
+  {
+    ezDynamicArray<ezPhysicsSweepQuery> queries;
+    for (ezUInt32 i = 0; i < s_uiNumQueries; ++i)
+    {
+      ezPhysicsSweepQuery& query = queries.ExpandAndGetRef();
+      query.m_Shape = MakeQueryShape(i, GetQueryPosition(i) + ezVec3(0, 0, 5));
+      query.m_vDir = ezVec3(0, 0, -1);
+      query.m_fDistance = 10.0f;
+    }
+
+    ezDynamicArray<ezPhysicsCastResult> results;
+    results.SetCount(s_uiNumQueries);
+    ezDynamicArray<bool> hits;
+    hits.SetCount(s_uiNumQueries);
+
+    pModule->SweepTestBatch(results, hits, queries, params);
+
+    for (ezUInt32 i = 0; i < s_uiNumQueries; ++i)
+    {
+      const ezPhysicsSweepQuery& query = queries[i];
+      const ezPhysicsQueryShape& shape = query.m_Shape;
+
+      ezPhysicsCastResult singleResult;
+      bool bHit = false;
+
+      switch (shape.m_Type)
+      {
+        case ezPhysicsQueryShape::Type::Sphere:
+          bHit = pModule->SweepTestSphere(singleResult, shape.m_fRadius, shape.m_Transform.m_vPosition, query.m_vDir, query.m_fDistance, params);
+          break;
+        case ezPhysicsQueryShape::Type::Box:
+          bHit = pModule->SweepTestBox(singleResult, shape.m_vBoxExtents, shape.m_Transform, query.m_vDir, query.m_fDistance, params);
+          break;
+        case ezPhysicsQueryShape::Type::Capsule:
+          bHit = pModule->SweepTestCapsule(singleResult, shape.m_fRadius, shape.m_fCapsuleHeight, shape.m_Transform, query.m_vDir, query.m_fDistance, params);
+          break;
+      }
+
+      CheckCastResults(hits[i], results[i], bHit, singleResult);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "OverlapTestBatch")
+  {
+    ezDynamicArray<ezPhysicsQueryShape> shapes;
+    for (ezUInt32 i = 0; i < s_uiNumQueries; ++i)
+    {
+      shapes.PushBack(MakeQueryShape(i, GetQueryPosition(i)));
+    }
+
+    ezDynamicArray<bool> overlaps;
+    overlaps.SetCount(s_uiNumQueries);
+
+    pModule->OverlapTestBatch(overlaps, shapes, params);
+
+    ezUInt32 uiNumOverlaps = 0;
+    for (ezUInt32 i = 0; i < s_uiNumQueries; ++i)
+    {
+      const ezPhysicsQueryShape& shape = shapes[i];
+      bool bOverlap = false;
+
+      switch (shape.m_Type)
+      {
+        case ezPhysicsQueryShape::Type::Sphere:
+          bOverlap = pModule->OverlapTestSphere(shape.m_fRadius, shape.m_Transform.m_vPosition, params);
+          break;
+        case ezPhysicsQueryShape::Type::Box:
+          bOverlap = pModule->OverlapTestBox(shape.m_vBoxExtents, shape.m_Transform, params);
+          break;
+        case ezPhysicsQueryShape::Type::Capsule:
+          bOverlap = pModule->OverlapTestCapsule(shape.m_fRadius, shape.m_fCapsuleHeight, shape.m_Transform, params);
+          break;
+      }
+
+      EZ_TEST_BOOL(overlaps[i] == bOverlap);
+      uiNumOverlaps += bOverlap ? 1 : 0;
+    }
+
+    EZ_TEST_BOOL(uiNumOverlaps > 0 && uiNumOverlaps < s_uiNumQueries);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Concurrent body writes")
+  {
+    ezDynamicArray<ezPhysicsRaycastQuery> queries;
+    CreateRaycastQueries(queries);
+
+    ezDynamicArray<ezPhysicsCastResult> results;
+    results.SetCount(s_uiNumQueries);
+    ezDynamicArray<bool> hits;
+    hits.SetCount(s_uiNumQueries);
+
+    ezPhysicsCastResult hitResult;
+    if (!EZ_TEST_BOOL(pModule->Raycast(hitResult, ezVec3(0, 0, 5), ezVec3(0, 0, -1), 10.0f, params)))
+      return;
+
+    const JPH::BodyID bodyId(static_cast<JPH::uint32>(reinterpret_cast<size_t>(hitResult.m_pInternalPhysicsActor)));
+    const JPH::BodyLockInterface& lockInterface = static_cast<const ezJoltWorldModule*>(pModule)->GetJoltSystem()->GetBodyLockInterface();
+
+    // The batch waits for its tasks by executing other tasks on this thread. Tasks that write to bodies must not deadlock on a lock the batch holds.
+    auto writeBody = [&]() {
+      JPH::BodyLockWrite bodyLock(lockInterface, bodyId);
+      EZ_TEST_BOOL(bodyLock.Succeeded());
+    };
+
+    ezTaskGroupID writeGroup = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
+    for (ezUInt32 i = 0; i < 64; ++i)
+    {
+      ezTaskSystem::AddTaskToGroup(writeGroup, EZ_DEFAULT_NEW(ezDelegateTask<void>, "Write Jolt Body", ezTaskNesting::Never, writeBody));
+    }
+
+    ezTaskSystem::StartTaskGroup(writeGroup);
+    pModule->RaycastBatch(results, hits, queries, params);
+    ezTaskSystem::WaitForGroup(writeGroup);
+
+    for (ezUInt32 i = 0; i < s_uiNumQueries; ++i)
+    {
+      ezPhysicsCastResult singleResult;
+      const bool bHit = pModule->Raycast(singleResult, queries[i].m_vStart, queries[i].m_vDir, queries[i].m_fDistance, params);
+
+      CheckCastResults(hits[i], results[i], bHit, singleResult);
+    }
+  }
+}
+
+#endif
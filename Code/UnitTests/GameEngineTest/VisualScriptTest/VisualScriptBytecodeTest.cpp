@@ -0,0 +1,219 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <VisualScriptPlugin/Runtime/VisualScriptInstance.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(VisualScript);
+
+namespace
+{
+  using DataOffset = ezVisualScriptDataDescription::DataOffset;
+  using NodeType = ezVisualScriptNodeDescription::Type;
+
+  enum
+  {
+    NUM_LOOP_ITERATIONS = 100,
+  };
+
+  struct TestScript
+  {
+    ezSharedPtr<ezVisualScriptDataDescription> m_pLocalDataDesc;
+    ezSharedPtr<ezVisualScriptDataDescription> m_pConstantDataDesc;
+    ezSharedPtr<ezVisualScriptDataStorage> m_pConstantDataStorage;
+    ezSharedPtr<ezVisualScriptGraphDescription> m_pGraphDesc;
+  };
+
+  ezVisualScriptNodeDescription& AddNode(ezDynamicArray<ezVisualScriptNodeDescription>& ref_nodes, NodeType::Enum type, ezVisualScriptDataType::Enum dataType, std::initializer_list<ezUInt16> exec,
+    std::initializer_list<DataOffset> inputs, std::initializer_list<DataOffset> outputs)
+  {
+    auto& node = ref_nodes.ExpandAndGetRef();
+    node.m_Type = type;
+    node.m_DeductedDataType = dataType;
+    node.m_ExecutionIndices = ezMakeArrayPtr(exec.begin(), static_cast<ezUInt32>(exec.size()));
+    node.m_InputDataOffsets = ezMakeArrayPtr(inputs.begin(), static_cast<ezUInt32>(inputs.size()));
+    node.m_OutputDataOffsets = ezMakeArrayPtr(outputs.begin(), static_cast<ezUInt32>(outputs.size()));
+    return node;
+  }
+
+  // A loop that is typical for gameplay scripts: some arithmetic, a comparison and a branch on its result.
+  //
+  //   i = 0;
+  //   x = 0;
+  //   do
+  //   {
+  //     x = x * 0.5 + x;
+  //     x = (x > 10) ? x - 10 : x + 0.5;
+  //     i = i + 1;
+  //   } while (i < NUM_LOOP_ITERATIONS);
+  void CreateTestScript(TestScript& out_script)
+  {
+    out_script.m_pLocalDataDesc = EZ_DEFAULT_NEW(ezVisualScriptDataDescription);
+    out_script.m_pLocalDataDesc->m_PerTypeInfo[ezVisualScriptDataType::Bool].m_uiCount = 2;
+    out_script.m_pLocalDataDesc->m_PerTypeInfo[ezVisualScriptDataType::Int].m_uiCount = 1;
+    out_script.m_pLocalDataDesc->m_PerTypeInfo[ezVisualScriptDataType::Float].m_uiCount = 3;
+    out_script.m_pLocalDataDesc->CalculatePerTypeStartOffsets();
+
+    out_script.m_pConstantDataDesc = EZ_DEFAULT_NEW(ezVisualScriptDataDescription);
+    out_script.m_pConstantDataDesc->m_PerTypeInfo[ezVisualScriptDataType::Int].m_uiCount = 3;
+    out_script.m_pConstantDataDesc->m_PerTypeInfo[ezVisualScriptDataType::Float].m_uiCount = 3;
+    out_script.m_pConstantDataDesc->CalculatePerTypeStartOffsets();
+
+    auto Local = [&](ezVisualScriptDataType::Enum dataType, ezUInt32 uiIndex)
+    { return out_script.m_pLocalDataDesc->GetOffset(dataType, uiIndex, DataOffset::Source::Local); };
+    auto Constant = [&](ezVisualScriptDataType::Enum dataType, ezUInt32 uiIndex)
+    { return out_script.m_pConstantDataDesc->GetOffset(dataType, uiIndex, DataOffset::Source::Constant); };
+
+    out_script.m_pConstantDataStorage = EZ_DEFAULT_NEW(ezVisualScriptDataStorage, out_script.m_pConstantDataDesc);
+    out_script.m_pConstantDataStorage->AllocateStorage();
+    out_script.m_pConstantDataStorage->SetData(Constant(ezVisualScriptDataType::Int, 0), 1);
+    out_script.m_pConstantDataStorage->SetData(Constant(ezVisualScriptDataType::Int, 1), static_cast<ezInt32>(NUM_LOOP_ITERATIONS));
+    out_script.m_pConstantDataStorage->SetData(Constant(ezVisualScriptDataType::Float, 0), 0.5f);
+    out_script.m_pConstantDataStorage->SetData(Constant(ezVisualScriptDataType::Int, 2), 0);
+    out_script.m_pConstantDataStorage->SetData(Constant(ezVisualScriptDataType::Float, 1), 10.0f);
+    out_script.m_pConstantDataStorage->SetData(Constant(ezVisualScriptDataType::Float, 2), 0.0f);
+
+    const DataOffset x = Local(ezVisualScriptDataType::Float, 0);
+    const DataOffset tmp0 = Local(ezVisualScriptDataType::Float, 1);
+    const DataOffset tmp1 = Local(ezVisualScriptDataType::Float, 2);
+    const DataOffset i = Local(ezVisualScriptDataType::Int, 0);
+    const DataOffset cond0 = Local(ezVisualScriptDataType::Bool, 0);
+    const DataOffset cond1 = Local(ezVisualScriptDataType::Bool, 1);
+    const ezUInt16 end = ezSmallInvalidIndex;
+
+    ezDynamicArray<ezVisualScriptNodeDescription> nodes;
+    AddNode(nodes, NodeType::EntryCall, ezVisualScriptDataType::Invalid, {1}, {}, {});
+    AddNode(nodes, NodeType::Builtin_ToInt, ezVisualScriptDataType::Int, {2}, {Constant(ezVisualScriptDataType::Int, 2)}, {i});
+    AddNode(nodes, NodeType::Builtin_ToFloat, ezVisualScriptDataType::Float, {3}, {Constant(ezVisualScriptDataType::Float, 2)}, {x});
+    AddNode(nodes, NodeType::Builtin_Multiply, ezVisualScriptDataType::Float, {4}, {x, Constant(ezVisualScriptDataType::Float, 0)}, {tmp0});
+    AddNode(nodes, NodeType::Builtin_Add, ezVisualScriptDataType::Float, {5}, {tmp0, x}, {tmp1});
+    AddNode(nodes, NodeType::Builtin_Compare, ezVisualScriptDataType::Float, {6}, {tmp1, Constant(ezVisualScriptDataType::Float, 1)}, {cond0}).m_ComparisonOperator = ezComparisonOperator::Greater;
+    AddNode(nodes, NodeType::Builtin_Branch, ezVisualScriptDataType::Bool, {7, 8}, {cond0}, {});
+    AddNode(nodes, NodeType::Builtin_Subtract, ezVisualScriptDataType::Float, {9}, {tmp1, Constant(ezVisualScriptDataType::Float, 1)}, {x});
+    AddNode(nodes, NodeType::Builtin_Add, ezVisualScriptDataType::Float, {9}, {tmp1, Constant(ezVisualScriptDataType::Float, 0)}, {x});
+    AddNode(nodes, NodeType::Builtin_Add, ezVisualScriptDataType::Int, {10}, {i, Constant(ezVisualScriptDataType::Int, 0)}, {i});
+    AddNode(nodes, NodeType::Builtin_Compare, ezVisualScriptDataType::Int, {11}, {i, Constant(ezVisualScriptDataType::Int, 1)}, {cond1}).m_ComparisonOperator = ezComparisonOperator::Less;
+    AddNode(nodes, NodeType::Builtin_Branch, ezVisualScriptDataType::Bool, {3, end}, {cond1}, {});
+
+    ezDefaultMemoryStreamStorage streamStorage;
+    ezMemoryStreamWriter writer(&streamStorage);
+    EZ_TEST_BOOL(ezVisualScriptGraphDescription::Serialize(nodes, *out_script.m_pLocalDataDesc, writer).Succeeded());
+
+    ezMemoryStreamReader reader(&streamStorage);
+    out_script.m_pGraphDesc = EZ_DEFAULT_NEW(ezVisualScriptGraphDescription);
+    EZ_TEST_BOOL(out_script.m_pGraphDesc->Deserialize(reader).Succeeded());
+  }
+
+  struct TestActor
+  {
+    TestActor(ezReflectedClass& ref_owner, const TestScript& script)
+      : m_Instance(ref_owner, nullptr, script.m_pConstantDataStorage, nullptr)
+      , m_LocalDataStorage(script.m_pGraphDesc->GetLocalDataDesc())
+      , m_Context(script.m_pGraphDesc)
+    {
+      m_LocalDataStorage.AllocateStorage();
+    }
+
+    void Execute()
+    {
+      m_Context.Initialize(m_Instance, m_LocalDataStorage, ezArrayPtr<ezVariant>());
+      m_Context.Execute(ezTime::MakeZero());
+    }
+
+    ezVisualScriptInstance m_Instance;
+    ezVisualScriptDataStorage m_LocalDataStorage;
+    ezVisualScriptExecutionContext m_Context;
+  };
+
+  ezTime ExecuteActors(const TestScript& script, bool bUseBytecode, ezUInt32 uiNumActors, ezUInt32 uiNumFrames, float& out_fResult)
+  {
+    ezCVarBool* pUseBytecode = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("VisualScript.UseBytecode"));
+    const bool bPrevUseBytecode = *pUseBytecode;
+    *pUseBytecode = bUseBytecode;
+
+    ezReflectedClass owner;
+    ezDynamicArray<ezUniquePtr<TestActor>> actors;
+    for (ezUInt32 i = 0; i < uiNumActors; ++i)
+    {
+      actors.PushBack(EZ_DEFAULT_NEW(TestActor, owner, script));
+    }
+
+    ezStopwatch sw;
+
+    for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      for (auto& pActor : actors)
+      {
+        pActor->Execute();
+      }
+    }
+
+    const ezTime duration = sw.GetRunningTotal();
+
+    const DataOffset x = script.m_pLocalDataDesc->GetOffset(ezVisualScriptDataType::Float, 0, DataOffset::Source::Local);
+    const DataOffset i = script.m_pLocalDataDesc->GetOffset(ezVisualScriptDataType::Int, 0, DataOffset::Source::Local);
+    EZ_TEST_INT(actors[0]->m_LocalDataStorage.GetData<ezInt32>(i), NUM_LOOP_ITERATIONS);
+    out_fResult = actors[0]->m_LocalDataStorage.GetData<float>(x);
+
+    *pUseBytecode = bPrevUseBytecode;
+    return duration;
+  }
+} // namespace
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+EZ_CREATE_SIMPLE_TEST(VisualScript, Bytecode)
+{
+  TestScript script;
+  CreateTestScript(script);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compile")
+  {
+    using Instruction = ezVisualScriptGraphDescription::Instruction;
+    auto instructions = script.m_pGraphDesc->GetInstructions();
+
+    // both branches are fused into the comparisons before them
+    EZ_TEST_INT(instructions.GetCount(), 9);
+    EZ_TEST_INT(script.m_pGraphDesc->GetEntryInstruction(), 0);
+
+    ezUInt32 uiNumBranches = 0;
+    for (auto& instruction : instructions)
+    {
+      EZ_TEST_BOOL(instruction.m_OpCode != Instruction::OpCode::Call);
+
+      if (instruction.m_OpCode == Instruction::OpCode::OperationAndBranch)
+      {
+        EZ_TEST_INT(instruction.m_pNode->m_Type, NodeType::Builtin_Compare);
+        ++uiNumBranches;
+      }
+    }
+
+    EZ_TEST_INT(uiNumBranches, 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Execute")
+  {
+    float fNodeResult = 0.0f;
+    float fBytecodeResult = 0.0f;
+    ExecuteActors(script, false, 1, 2, fNodeResult);
+    ExecuteActors(script, true, 1, 2, fBytecodeResult);
+
+    EZ_TEST_FLOAT(fNodeResult, 2.7072592f, 0.0001f);
+    EZ_TEST_FLOAT(fBytecodeResult, fNodeResult, 0.0f);
+  }
+
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "Many actors")
+  {
+    const ezUInt32 uiNumActors = 5000;
+    const ezUInt32 uiNumFrames = 20;
+
+    float fResult = 0.0f;
+    const ezTime tNodes = ExecuteActors(script, false, uiNumActors, uiNumFrames, fResult);
+    const ezTime tBytecode = ExecuteActors(script, true, uiNumActors, uiNumFrames, fResult);
+
+    ezLog::Info("[test]{0} actors, {1} frames: node graph {2}ms, bytecode {3}ms, speedup {4}x", uiNumActors, uiNumFrames, ezArgF(tNodes.GetMilliseconds(), 2),
+      ezArgF(tBytecode.GetMilliseconds(), 2), ezArgF(tNodes.GetMilliseconds() / tBytecode.GetMilliseconds(), 1));
+  }
+}
@@ -0,0 +1,180 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Foundation/Algorithm/Sorting.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Memory/FrameAllocator.h>
+#include <Foundation/Time/Time.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
+
+// Enable when needed
+#define EZ_PERFORMANCE_TESTS_STATE ezTestBlock::DisabledNoWarning
+
+namespace
+{
+  // Same layout as ezRenderDataBatch::SortableRenderData, which is private.
+  struct SortableRenderData
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    const ezRenderData* m_pRenderData;
+    ezUInt64 m_uiSortingKey;
+  };
+
+  // The comparison sort that ezExtractedRenderData used for all categories before the radix sort.
+  struct RenderDataComparer
+  {
+    EZ_FORCE_INLINE bool Less(const SortableRenderData& a, const SortableRenderData& b) const
+    {
+      if (a.m_uiSortingKey == b.m_uiSortingKey)
+      {
+        return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
+      }
+
+      return a.m_uiSortingKey < b.m_uiSortingKey;
+    }
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, RenderDataSorting)
+{
+  EZ_TEST_BLOCK(EZ_PERFORMANCE_TESTS_STATE, "SortAndBatch vs. QuickSort")
+  {
+    // categories have very different sizes in a typical scene
+    const ezRenderData::Category categories[] = {
+      ezDefaultRenderDataCategories::LitOpaque,
+      ezDefaultRenderDataCategories::LitOpaque,
+      ezDefaultRenderDataCategories::LitOpaque,
+      ezDefaultRenderDataCategories::LitOpaque,
+      ezDefaultRenderDataCategories::LitMasked,
+      ezDefaultRenderDataCategories::LitMasked,
+      ezDefaultRenderDataCategories::LitTransparent,
+      ezDefaultRenderDataCategories::SimpleOpaque,
+    };
+
+    const ezRenderData::Category uniqueCategories[] = {
+      ezDefaultRenderDataCategories::LitOpaque,
+      ezDefaultRenderDataCategories::LitMasked,
+      ezDefaultRenderDataCategories::LitTransparent,
+      ezDefaultRenderDataCategories::SimpleOpaque,
+    };
+
+    const ezUInt32 counts[] = {1000, 10000, 100000, 1000000};
+    for (ezUInt32 uiCount : counts)
+    {
+      ezRandom rnd;
+      rnd.Initialize(42);
+
+      // a few hundred different materials and meshes, spread out in front of the camera
+      ezDynamicArray<ezRenderData> renderData;
+      renderData.SetCount(uiCount);
+      for (auto& data : renderData)
+      {
+        data.m_uiBatchId = rnd.UInt() % 500;
+        data.m_uiSortingKey = data.m_uiBatchId % 64;
+        data.m_GlobalTransform.m_vPosition = ezVec3(static_cast<float>(rnd.DoubleMinMax(1.0, 1000.0)), 0, 0);
+      }
+
+      // render data is extracted in an order that has nothing to do with the sorting order
+      struct ExtractedItem
+      {
+        const ezRenderData* m_pRenderData;
+        ezRenderData::Category m_Category;
+      };
+
+      ezDynamicArray<ExtractedItem> extractionOrder;
+      extractionOrder.SetCount(uiCount);
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        extractionOrder[i].m_pRenderData = &renderData[rnd.UInt() % uiCount];
+        extractionOrder[i].m_Category = categories[rnd.UInt() % EZ_ARRAY_SIZE(categories)];
+      }
+
+      ezCamera camera;
+      camera.LookAt(ezVec3::MakeZero(), ezVec3(1, 0, 0), ezVec3(0, 0, 1));
+
+      // the baseline gets the same data per category as the extracted render data
+      ezDynamicArray<SortableRenderData> baselineInput[EZ_ARRAY_SIZE(uniqueCategories)];
+      for (const ExtractedItem& item : extractionOrder)
+      {
+        for (ezUInt32 c = 0; c < EZ_ARRAY_SIZE(uniqueCategories); ++c)
+        {
+          if (item.m_Category == uniqueCategories[c])
+          {
+            baselineInput[c].PushBack({item.m_pRenderData, item.m_pRenderData->GetCategorySortingKey(item.m_Category, camera)});
+          }
+        }
+      }
+
+      ezExtractedRenderData extractedData;
+      extractedData.SetCamera(camera);
+
+      const ezUInt32 uiNumRuns = ezMath::Max(1u, 2000000u / uiCount);
+
+      ezTime tQuickSort;
+      ezTime tSortAndBatch;
+      ezDynamicArray<SortableRenderData> baselineData[EZ_ARRAY_SIZE(uniqueCategories)];
+
+      for (ezUInt32 r = 0; r < uiNumRuns; ++r)
+      {
+        for (ezUInt32 c = 0; c < EZ_ARRAY_SIZE(uniqueCategories); ++c)
+        {
+          baselineData[c] = baselineInput[c];
+        }
+
+        {
+          const ezTime t0 = ezTime::Now();
+          for (ezUInt32 c = 0; c < EZ_ARRAY_SIZE(uniqueCategories); ++c)
+          {
+            ezSorting::QuickSort(baselineData[c], RenderDataComparer());
+          }
+          tQuickSort += ezTime::Now() - t0;
+        }
+
+        extractedData.Clear();
+        for (const ExtractedItem& item : extractionOrder)
+        {
+          extractedData.AddRenderData(item.m_pRenderData, item.m_Category);
+        }
+
+        {
+          const ezTime t0 = ezTime::Now();
+          extractedData.SortAndBatch();
+          tSortAndBatch += ezTime::Now() - t0;
+        }
+
+        // both have to produce the same order, ties between equal batch ids may differ since the quick sort is not stable
+        for (ezUInt32 c = 0; c < EZ_ARRAY_SIZE(uniqueCategories); ++c)
+        {
+          ezRenderDataBatchList batchList = extractedData.GetRenderDataBatchesWithCategory(uniqueCategories[c]);
+
+          ezUInt32 uiIndex = 0;
+          bool bSameOrder = true;
+          for (ezUInt32 b = 0; b < batchList.GetBatchCount(); ++b)
+          {
+            const ezRenderDataBatch batch = batchList.GetBatch(b);
+            for (auto it = batch.GetIterator<ezRenderData>(); it.IsValid() && uiIndex < baselineData[c].GetCount(); ++it)
+            {
+              const SortableRenderData& expected = baselineData[c][uiIndex++];
+              bSameOrder &= it->m_uiBatchId == expected.m_pRenderData->m_uiBatchId;
+              bSameOrder &= it->GetCategorySortingKey(uniqueCategories[c], camera) == expected.m_uiSortingKey;
+            }
+          }
+
+          EZ_TEST_INT(uiIndex, baselineData[c].GetCount());
+          EZ_TEST_BOOL(bSameOrder);
+        }
+
+        // reclaim the temporary memory of the sort
+        ezFrameAllocator::Swap();
+      }
+
+      extractedData.Clear();
+
+      // SortAndBatch also finds the batches, so the speedup of the sort itself is slightly higher
+      const double fQuickSortMs = tQuickSort.GetMilliseconds() / uiNumRuns;
+      const double fSortAndBatchMs = tSortAndBatch.GetMilliseconds() / uiNumRuns;
+      ezLog::Info("[test]{0} render data in {1} categories: QuickSort {2}ms, SortAndBatch {3}ms, {4}x", uiCount, EZ_ARRAY_SIZE(uniqueCategories), ezArgF(fQuickSortMs, 3), ezArgF(fSortAndBatchMs, 3), ezArgF(fQuickSortMs / fSortAndBatchMs, 2));
+    }
+  }
+}